@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+#
+# XIMAZ PROJECTS, 2024
+# amalgamate.py
+# File description:
+# Generates the single header distribution of the library, every function
+# being `static inline` so that the hot paths are inlined without LTO.
+#
+# Usage : amalgamate.py <output> <include directory> <sources...>
+
+import os
+import re
+import sys
+
+BANNER = """/*
+** XIMAZ PROJECTS, 2024
+** dict_amalgamated.h
+** File description:
+** Single header distribution of the dict, generated by amalgamate.py from
+** include/dict.h, include/murmurhash1.h and the library sources. Do not edit.
+**
+** Every function is `DICT_API`, `static inline` by default, so that each
+** translation unit gets its own copy and the compiler is free to inline the
+** hot paths (hashing, bucket lookups, insertions) without LTO. The process
+** wide state, such as `dict_intern_global`, is then per translation unit.
+**
+** Define `DICT_API` as empty in a single translation unit to compile the
+** library there instead, the other ones including `dict.h`.
+**
+** The header must be included before any system header, as it sets the
+** feature test macros the implementation relies on.
+*/
+"""
+
+HEADERS = ("dict.h", "murmurhash1.h")
+LOCAL_INCLUDE = re.compile(r'^#include\s+"(dict|murmurhash1)\.h"\s*$')
+FEATURE_MACRO = re.compile(r"^#define\s+(_POSIX_C_SOURCE|_DEFAULT_SOURCE|"
+                           r"_GNU_SOURCE)\b")
+PRIVATE_MACRO = re.compile(r"^#\s*define\s+((?:DICT|MURMURHASH1)_\w+)")
+PROTOTYPE = re.compile(r"^(?!typedef\b|extern\b|static\b)[A-Za-z_][\w\s\*]*?"
+                       r"\b(\w+)\s*\(")
+DEFINITION = re.compile(r"^(?!typedef\b|static\b|inline\b|return\b|"
+                        r"__attribute__\b)[A-Za-z_][\w\s\*]*?\b(\w+)\s*\(")
+STATIC_NAME = re.compile(r"^(?:inline\s+)?static(?:\s+inline)?\s*\n"
+                         r"[\w\s\*]*?\b(\w+)\s*\(|"
+                         r"^static\s+[\w\s\*]*?\b(\w+)\s*(?:\(|=|;|\[)",
+                         re.M)
+
+
+def amalgamate_header(path):
+    """Returns the header, with `DICT_API` in front of its prototypes."""
+    lines = []
+
+    with open(path) as header:
+        for line in header.read().split("\n"):
+            if PROTOTYPE.match(line) and not line.rstrip().endswith("\\"):
+                line = "DICT_API " + line
+            lines.append(line)
+    return "\n".join(lines)
+
+
+def amalgamate_source(path):
+    """Returns the source, with `DICT_API` in front of its definitions, and
+    the private macros it defines undefined at its end."""
+    lines = []
+    macros = []
+    previous = ""
+
+    with open(path) as source:
+        for line in source.read().split("\n"):
+            if LOCAL_INCLUDE.match(line) or FEATURE_MACRO.match(line):
+                continue
+            if "inline" == line.strip():
+                line = "DICT_API"
+            elif DEFINITION.match(line) and "DICT_API" != previous and \
+                    "static" not in previous and \
+                    not line.rstrip().endswith(";"):
+                line = "DICT_API " + line
+            match = PRIVATE_MACRO.match(line)
+            if match:
+                macros.append(match.group(1))
+            lines.append(line)
+            previous = line
+    for macro in sorted(set(macros)):
+        lines.append("#undef " + macro)
+    return "\n".join(lines)
+
+
+def check_static_names(sources):
+    """Fails if two sources define a static function or variable with the
+    same name, as they now share a translation unit."""
+    owners = {}
+
+    for path in sources:
+        with open(path) as source:
+            for match in STATIC_NAME.finditer(source.read()):
+                name = match.group(1) or match.group(2)
+                if name in owners and owners[name] != path:
+                    sys.exit("amalgamate.py: '%s' is static in both %s and %s"
+                             % (name, owners[name], path))
+                owners[name] = path
+
+
+def main(argv):
+    if 4 > len(argv):
+        sys.exit("usage: amalgamate.py <output> <include directory> "
+                 "<sources...>")
+    output, include, sources = argv[1], argv[2], argv[3:]
+    check_static_names(sources)
+    parts = [BANNER, "#ifndef __DICT_AMALGAMATED_H_",
+             "#define __DICT_AMALGAMATED_H_", "",
+             "#ifndef _DEFAULT_SOURCE", "#define _DEFAULT_SOURCE", "#endif",
+             "#ifndef _POSIX_C_SOURCE", "#define _POSIX_C_SOURCE 200809L",
+             "#endif", "", "#ifndef DICT_API", "#define DICT_API static inline",
+             "#endif", ""]
+    for header in HEADERS:
+        parts.append(amalgamate_header(os.path.join(include, header)))
+    for source in sources:
+        parts.append(amalgamate_source(source))
+    parts += ["#undef R", "#undef M", "#undef C", "",
+              "#endif /* !__DICT_AMALGAMATED_H_ */", ""]
+    with open(output, "w") as amalgamation:
+        amalgamation.write("\n".join(parts))
+
+
+if __name__ == "__main__":
+    main(sys.argv)
@@ -0,0 +1,80 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench.h
+** File description:
+** Helpers shared by the benchmarks.
+*/
+
+#ifndef __BENCH_H_
+#define __BENCH_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief Returns a monotonic timestamp in nanoseconds.
+ */
+static inline
+uint64_t bench_now(void)
+{
+    struct timespec now = { 0, 0 };
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+/**
+ * @brief Allocates `count` keys formatted as `<prefix><index>`.
+ *
+ * @param prefix The prefix of every key.
+ * @param count The number of keys to generate.
+ * @return The keys array, each key being allocated on its own.
+ */
+static inline
+char **bench_keys(const char *prefix, uint64_t count)
+{
+    uint64_t index = 0;
+    char **keys = (char **) calloc(count, sizeof(char *));
+
+    for (; NULL != keys && index < count; ++index) {
+        keys[index] = (char *) malloc(32);
+        snprintf(keys[index], 32, "%s%llu", prefix,
+            (unsigned long long) index);
+    }
+    return keys;
+}
+
+/**
+ * @brief Releases the keys allocated by `bench_keys`.
+ *
+ * @param keys The keys array.
+ * @param count The number of keys inside the array.
+ */
+static inline
+void bench_free_keys(char **keys, uint64_t count)
+{
+    uint64_t index = 0;
+
+    for (; index < count; ++index)
+        free(keys[index]);
+    free(keys);
+}
+
+/**
+ * @brief Prints a benchmark result line.
+ *
+ * @param name The name of the measured operation.
+ * @param ops The number of operations performed.
+ * @param elapsed The elapsed time in nanoseconds.
+ */
+static inline
+void bench_report(const char *name, uint64_t ops, uint64_t elapsed)
+{
+    printf("%-40s %12llu ops %10.2f ns/op %12.0f ops/s\n", name,
+        (unsigned long long) ops, (double) elapsed / (double) ops,
+        (double) ops * 1e9 / (double) elapsed);
+}
+
+#endif /* !__BENCH_H_ */
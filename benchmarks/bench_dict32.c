@@ -0,0 +1,112 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict32.c
+** File description:
+** Compares the memory footprint and the lookup latency of the dict and of the
+** compact dict.
+*/
+
+#include <string.h>
+#include "bench.h"
+#include "dict.h"
+
+#define DEFAULT_ENTRIES 2000000
+
+/**
+ * @brief Estimated bookkeeping bytes the allocator adds to each allocation.
+ */
+#define MALLOC_OVERHEAD 16
+
+/**
+ * @brief Tracks the memory held through the allocator hooks. Each allocation
+ * is prefixed with its size, so that releases can be accounted for.
+ */
+typedef struct s_bench_memory {
+    uint64_t allocations;
+    uint64_t bytes;
+} bench_memory_t;
+
+static
+void *bench_allocate(void *ctx, size_t size)
+{
+    bench_memory_t *memory = (bench_memory_t *) ctx;
+    size_t *ptr = (size_t *) malloc(size + MALLOC_OVERHEAD);
+
+    if (NULL == ptr)
+        return NULL;
+    ++memory->allocations;
+    memory->bytes += size;
+    *ptr = size;
+    return (char *) ptr + MALLOC_OVERHEAD;
+}
+
+static
+void bench_release(void *ctx, void *ptr)
+{
+    bench_memory_t *memory = (bench_memory_t *) ctx;
+    size_t *header = (size_t *) ((char *) ptr - MALLOC_OVERHEAD);
+
+    --memory->allocations;
+    memory->bytes -= *header;
+    free(header);
+}
+
+static
+void *bench_reallocate(void *ctx, void *ptr, size_t old_size,
+    size_t new_size)
+{
+    void *moved = bench_allocate(ctx, new_size);
+
+    if (NULL == moved)
+        return NULL;
+    memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    bench_release(ctx, ptr);
+    return moved;
+}
+
+/**
+ * @brief Prints the memory held per entry, keys excluded, counting the
+ * estimated bookkeeping bytes of each live allocation.
+ */
+static
+void bench_memory_report(const char *name, const bench_memory_t *memory,
+    uint64_t count)
+{
+    printf("%-40s %10.1f bytes/entry (%llu allocations)\n", name,
+        (double) (memory->bytes + memory->allocations * MALLOC_OVERHEAD) / \
+        (double) count, (unsigned long long) memory->allocations);
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t count = 1 < argc ? strtoull(argv[1], NULL, 10) : DEFAULT_ENTRIES;
+    char **keys = bench_keys("key:", count);
+    bench_memory_t memory = { 0, 0 };
+    dict_allocator_t allocator = { bench_allocate, bench_reallocate,
+        bench_release, &memory, NULL, NULL };
+    dict_t *dict = dict_ctor_with_allocator(&allocator);
+    dict32_t *dict32 = NULL;
+    uint64_t index = 0;
+    uint64_t found = 0;
+    uint64_t start = 0;
+
+    for (; index < count; ++index)
+        dict_insert(dict, keys[index], strlen(keys[index]), NULL);
+    bench_memory_report("dict_t", &memory, count);
+    start = bench_now();
+    for (index = 0; index < count; ++index)
+        found += dict_has_key(dict, keys[index], strlen(keys[index]));
+    bench_report("dict_t lookup hit", count, bench_now() - start);
+    dict_dtor(dict, NULL);
+    dict32 = dict32_ctor(&allocator);
+    for (index = 0; index < count; ++index)
+        dict32_insert(dict32, keys[index], strlen(keys[index]), NULL);
+    bench_memory_report("dict32_t", &memory, count);
+    start = bench_now();
+    for (index = 0; index < count; ++index)
+        found += dict32_has_key(dict32, keys[index], strlen(keys[index]));
+    bench_report("dict32_t lookup hit", count, bench_now() - start);
+    dict32_dtor(dict32, NULL);
+    bench_free_keys(keys, count);
+    return 2 * count == found ? 0 : 1;
+}
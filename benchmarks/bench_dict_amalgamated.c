@@ -0,0 +1,104 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict_amalgamated.c
+** File description:
+** Measures the hot paths, built once against the static library and once
+** against the single header distribution, see amalgamate.py.
+*/
+
+#ifdef BENCH_AMALGAMATED
+    #include "dict_amalgamated.h"
+    #define BENCH_BUILD "header"
+#else
+    #include "dict.h"
+    #include "murmurhash1.h"
+    #define BENCH_BUILD "library"
+#endif
+
+#include <string.h>
+#include "bench.h"
+
+#define SMALL_ENTRIES 10000
+#define LARGE_ENTRIES 1000000
+#define OPERATIONS 10000000
+
+/**
+ * @brief Inserts, looks up, misses and deletes keys, cycling over the table
+ * until `OPERATIONS` calls of each kind were made.
+ *
+ * @param size The name of the table size.
+ * @param hits The keys inserted.
+ * @param misses The keys never inserted.
+ * @param lengths The length of the keys, the same for hits and misses.
+ * @param count The number of keys.
+ * @return The number of keys found, to keep the loops from being optimized
+ * out.
+ */
+static
+uint64_t bench_table(const char *size, char **hits, char **misses,
+    const uint64_t *lengths, uint64_t count)
+{
+    dict_t *dict = dict_ctor();
+    uint64_t rounds = OPERATIONS / count;
+    uint64_t round = 0;
+    uint64_t index = 0;
+    uint64_t found = 0;
+    uint64_t start = 0;
+    char name[64] = { 0 };
+
+    for (; index < count; ++index)
+        dict_insert(dict, hits[index], lengths[index], NULL);
+    start = bench_now();
+    for (; round < rounds; ++round)
+        for (index = 0; index < count; ++index)
+            found += dict_has_key(dict, hits[index], lengths[index]);
+    snprintf(name, sizeof(name), "%s: hit, %s", BENCH_BUILD, size);
+    bench_report(name, rounds * count, bench_now() - start);
+    start = bench_now();
+    for (round = 0; round < rounds; ++round)
+        for (index = 0; index < count; ++index)
+            found += dict_has_key(dict, misses[index], lengths[index]);
+    snprintf(name, sizeof(name), "%s: miss, %s", BENCH_BUILD, size);
+    bench_report(name, rounds * count, bench_now() - start);
+    start = bench_now();
+    for (round = 0; round < rounds; ++round)
+        for (index = 0; index < count; ++index) {
+            dict_delete(dict, hits[index], lengths[index], NULL);
+            dict_insert(dict, hits[index], lengths[index], NULL);
+        }
+    snprintf(name, sizeof(name), "%s: delete + insert, %s", BENCH_BUILD,
+        size);
+    bench_report(name, rounds * count, bench_now() - start);
+    dict_dtor(dict, NULL);
+    return found;
+}
+
+int main(void)
+{
+    char **hits = bench_keys("hit:", LARGE_ENTRIES);
+    char **misses = bench_keys("mis:", LARGE_ENTRIES);
+    uint64_t *lengths = (uint64_t *) malloc(LARGE_ENTRIES * sizeof(uint64_t));
+    uint64_t index = 0;
+    uint32_t hash = 0;
+    uint64_t start = 0;
+
+    if (NULL == hits || NULL == misses || NULL == lengths)
+        return 1;
+    for (; index < LARGE_ENTRIES; ++index)
+        lengths[index] = strlen(hits[index]);
+    start = bench_now();
+    for (index = 0; index < OPERATIONS; ++index)
+        hash += murmurhash1(hits[index % SMALL_ENTRIES],
+            lengths[index % SMALL_ENTRIES], hash);
+    bench_report(BENCH_BUILD ": murmurhash1", OPERATIONS,
+        bench_now() - start);
+    if (SMALL_ENTRIES * (OPERATIONS / SMALL_ENTRIES) != bench_table("10k",
+        hits, misses, lengths, SMALL_ENTRIES) || 0 == hash || \
+        LARGE_ENTRIES * (OPERATIONS / LARGE_ENTRIES) != bench_table("1M",
+        hits, misses, lengths, LARGE_ENTRIES))
+        return 1;
+    free(lengths);
+    bench_free_keys(hits, LARGE_ENTRIES);
+    bench_free_keys(misses, LARGE_ENTRIES);
+    return 0;
+}
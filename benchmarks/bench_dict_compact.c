@@ -0,0 +1,126 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict_compact.c
+** File description:
+** Measures the lookup and scan speed of a dict fragmented by insertions and
+** deletions, before and after `dict_compact`.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "dict.h"
+
+#define DEFAULT_ENTRIES 1000000
+#define CHURN_ROUNDS 8
+
+/**
+ * @brief A xorshift generator, so that the churn is the same on every run.
+ */
+static
+uint64_t bench_random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/**
+ * @brief Fills the dict, then deletes and inserts again a random half of the
+ * keys a few times, so that the nodes are scattered across the heap.
+ *
+ * @param dict The dict to fill.
+ * @param keys The keys to insert.
+ * @param count The number of keys.
+ */
+static
+void bench_churn(dict_t *dict, char **keys, uint64_t count)
+{
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    uint64_t round = 0;
+    uint64_t index = 0;
+    uint64_t picked = 0;
+
+    for (; index < count; ++index)
+        dict_insert(dict, keys[index], strlen(keys[index]), keys[index]);
+    for (; round < CHURN_ROUNDS; ++round)
+        for (index = 0; index < count / 2; ++index) {
+            picked = bench_random(&state) % count;
+            dict_delete(dict, keys[picked], strlen(keys[picked]), NULL);
+            picked = bench_random(&state) % count;
+            dict_insert(dict, keys[picked], strlen(keys[picked]),
+                keys[picked]);
+        }
+}
+
+/**
+ * @brief Counts the scanned entries, keeping every one of them.
+ */
+static
+int bench_count(__attribute__((unused)) const char *key,
+    __attribute__((unused)) uint64_t key_length,
+    __attribute__((unused)) void *value, void *ctx)
+{
+    ++*(uint64_t *) ctx;
+    return 1;
+}
+
+/**
+ * @brief Looks up every key once, then scans every entry once.
+ *
+ * @param label The state of the dict.
+ * @param dict The dict to query.
+ * @param keys The keys to look up.
+ * @param count The number of keys.
+ * @return The number of keys found, to keep the loops from being optimized
+ * out.
+ */
+static
+uint64_t bench_queries(const char *label, dict_t *dict, char **keys,
+    uint64_t count)
+{
+    char name[64] = { 0 };
+    uint64_t index = 0;
+    uint64_t found = 0;
+    uint64_t start = bench_now();
+
+    for (; index < count; ++index)
+        found += dict_has_key(dict, keys[index], strlen(keys[index]));
+    snprintf(name, sizeof(name), "lookup (%s)", label);
+    bench_report(name, count, bench_now() - start);
+    start = bench_now();
+    dict_retain(dict, bench_count, &found, NULL);
+    snprintf(name, sizeof(name), "scan (%s)", label);
+    bench_report(name, dict->items, bench_now() - start);
+    return found;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t count = 1 < argc ? strtoull(argv[1], NULL, 10) : DEFAULT_ENTRIES;
+    char **keys = bench_keys("key:", count);
+    dict_t *dict = dict_ctor();
+    uint64_t found = 0;
+    uint64_t start = 0;
+    int64_t reclaimed = 0;
+
+    if (NULL == keys || NULL == dict)
+        return 1;
+    bench_churn(dict, keys, count);
+    found += bench_queries("churned", dict, keys, count);
+    start = bench_now();
+    reclaimed = dict_compact(dict, 0);
+    bench_report("dict_compact", dict->items, bench_now() - start);
+    printf("reclaimed %lld bytes\n", (long long) reclaimed);
+    found += bench_queries("compacted", dict, keys, count);
+    start = bench_now();
+    while (0 <= dict_compact(dict, 4096) && NULL != dict->compaction)
+        continue;
+    bench_report("dict_compact (4096 nodes steps)", dict->items,
+        bench_now() - start);
+    found += bench_queries("compacted again", dict, keys, count);
+    dict_dtor(dict, NULL);
+    bench_free_keys(keys, count);
+    return 0 == found;
+}
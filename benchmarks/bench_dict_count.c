@@ -0,0 +1,148 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict_count.c
+** File description:
+** Counts the words of a generated corpus, with heap allocated counters and
+** with the counting dict, one key at a time, in batches and across threads.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "dict.h"
+
+#define DEFAULT_TOKENS 20000000
+#define VOCABULARY 200000
+#define THREADS 4
+
+/**
+ * @brief A xorshift generator, so that the corpus is the same on every run.
+ */
+static
+uint64_t bench_random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/**
+ * @brief Generates the corpus, whose word frequencies roughly follow a Zipf
+ * law : the rank of each token is drawn as the product of two uniform draws.
+ *
+ * @param words The vocabulary.
+ * @param tokens Where to store the tokens, borrowed from the vocabulary.
+ * @param lengths Where to store the length of each token.
+ * @param count The number of tokens.
+ */
+static
+void bench_corpus(char **words, char **tokens, uint64_t *lengths,
+    uint64_t count)
+{
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    uint64_t index = 0;
+    uint64_t rank = 0;
+
+    for (; index < count; ++index) {
+        rank = (bench_random(&state) % VOCABULARY) * \
+            (bench_random(&state) % VOCABULARY) / VOCABULARY;
+        tokens[index] = words[rank];
+        lengths[index] = strlen(words[rank]);
+    }
+}
+
+/**
+ * @brief Releases a heap allocated counter.
+ */
+static
+void bench_free_counter(__attribute__((unused)) char *key, void *value)
+{
+    free(value);
+}
+
+/**
+ * @brief Counts the way it had to be done before the counting dict : a
+ * lookup, then an insertion of a new counter for the unseen words.
+ *
+ * @return The number of distinct words.
+ */
+static
+uint64_t bench_count_heap(char **tokens, uint64_t *lengths, uint64_t count)
+{
+    dict_t *dict = dict_ctor();
+    uint64_t *counter = NULL;
+    uint64_t index = 0;
+    uint64_t start = bench_now();
+    uint64_t words = 0;
+
+    for (; index < count; ++index) {
+        if (0 == dict_get(dict, tokens[index], lengths[index],
+            (void **) &counter)) {
+            ++*counter;
+            continue;
+        }
+        counter = (uint64_t *) malloc(sizeof(uint64_t));
+        *counter = 1;
+        dict_insert(dict, tokens[index], lengths[index], counter);
+    }
+    bench_report("dict_get + dict_insert", count, bench_now() - start);
+    words = dict->items;
+    dict_dtor(dict, bench_free_counter);
+    return words;
+}
+
+/**
+ * @brief Counts the tokens with the counting dict.
+ *
+ * @param name The name of the measure.
+ * @param mode 0 for `dict_incr`, 1 for `dict_incr_many`, otherwise the
+ * number of threads given to `dict_incr_parallel`.
+ * @return The number of distinct words.
+ */
+static
+uint64_t bench_count(const char *name, int mode, char **tokens,
+    uint64_t *lengths, uint64_t count)
+{
+    dict_t *dict = dict_ctor_with_value_size(sizeof(uint64_t));
+    uint64_t index = 0;
+    uint64_t start = bench_now();
+    uint64_t words = 0;
+
+    if (0 == mode)
+        for (; index < count; ++index)
+            dict_incr(dict, tokens[index], lengths[index], 1, NULL);
+    else if (1 == mode)
+        dict_incr_many(dict, tokens, lengths, count, 1, NULL);
+    else
+        dict_incr_parallel(dict, tokens, lengths, count, mode, NULL);
+    bench_report(name, count, bench_now() - start);
+    words = dict->items;
+    dict_dtor(dict, NULL);
+    return words;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t count = 1 < argc ? strtoull(argv[1], NULL, 10) : DEFAULT_TOKENS;
+    char **words = bench_keys("word", VOCABULARY);
+    char **tokens = (char **) malloc(count * sizeof(char *));
+    uint64_t *lengths = (uint64_t *) malloc(count * sizeof(uint64_t));
+    uint64_t distinct = 0;
+
+    if (NULL == words || NULL == tokens || NULL == lengths)
+        return 1;
+    bench_corpus(words, tokens, lengths, count);
+    distinct = bench_count_heap(tokens, lengths, count);
+    printf("%llu distinct words\n", (unsigned long long) distinct);
+    if (distinct != bench_count("dict_incr", 0, tokens, lengths, count) || \
+        distinct != bench_count("dict_incr_many", 1, tokens, lengths,
+        count) || distinct != bench_count("dict_incr_parallel (4 threads)",
+        THREADS, tokens, lengths, count))
+        return 1;
+    free(tokens);
+    free(lengths);
+    bench_free_keys(words, VOCABULARY);
+    return 0;
+}
@@ -0,0 +1,128 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict_huge.c
+** File description:
+** Measures the lookup latency and the data TLB misses of a dict whose large
+** arrays are allocated by the standard library or mapped on huge pages.
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <string.h>
+#include <unistd.h>
+#include "bench.h"
+#include "dict.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#define DEFAULT_ENTRIES 4000000
+
+/**
+ * @brief Opens a counter of the data TLB load misses of the process.
+ *
+ * @return The counter file descriptor, -1 if unavailable.
+ */
+static
+int bench_tlb_open(void)
+{
+#ifdef __linux__
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | \
+        (PERF_COUNT_HW_CACHE_OP_READ << 8) | \
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @brief Looks up every key, reporting the latency and the TLB misses.
+ *
+ * @return The number of keys found.
+ */
+static
+uint64_t bench_lookups(const char *name, dict_t *dict, char **keys,
+    uint64_t count)
+{
+    int tlb = bench_tlb_open();
+    long long misses = -1;
+    uint64_t found = 0;
+    uint64_t index = 0;
+    uint64_t start = 0;
+
+#ifdef __linux__
+    if (-1 != tlb) {
+        ioctl(tlb, PERF_EVENT_IOC_RESET, 0);
+        ioctl(tlb, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+    start = bench_now();
+    for (; index < count; ++index)
+        found += dict_has_key(dict, keys[index], strlen(keys[index]));
+    bench_report(name, count, bench_now() - start);
+    if (-1 != tlb) {
+        if (sizeof(misses) != read(tlb, &misses, sizeof(misses)))
+            misses = -1;
+        close(tlb);
+    }
+    if (-1 == misses)
+        printf("%-40s %12s\n", "  dTLB load misses", "unavailable");
+    else
+        printf("%-40s %12.3f per lookup\n", "  dTLB load misses",
+            (double) misses / (double) count);
+    return found;
+}
+
+/**
+ * @brief Fills a dict built on the allocator, then measures its lookups.
+ *
+ * @return The number of keys found.
+ */
+static
+uint64_t bench_dict(const char *name, const dict_allocator_t *allocator,
+    char **keys, uint64_t count)
+{
+    dict_t *dict = dict_ctor_with_allocator(allocator);
+    uint64_t found = 0;
+    uint64_t index = 0;
+
+    if (NULL == dict)
+        return 0;
+    for (; index < count; ++index)
+        dict_insert(dict, keys[index], strlen(keys[index]), NULL);
+    found = bench_lookups(name, dict, keys, count);
+    dict_dtor(dict, NULL);
+    return found;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t count = 1 < argc ? strtoull(argv[1], NULL, 10) : DEFAULT_ENTRIES;
+    char **keys = bench_keys("key:", count);
+    dict_huge_pages_t huge = { 0, 1, DICT_NUMA_INTERLEAVE, ~(uint64_t) 0,
+        0, 0, 0 };
+    dict_allocator_t allocator = { 0 };
+    uint64_t found = 0;
+
+    dict_huge_allocator(&huge, &allocator);
+    found += bench_dict("lookup hit (malloc)", NULL, keys, count);
+    found += bench_dict("lookup hit (huge pages)", &allocator, keys, count);
+    printf("mapped arrays %llu, huge page failures %llu, NUMA failures %llu\n",
+        (unsigned long long) huge.mapped,
+        (unsigned long long) huge.huge_page_failures,
+        (unsigned long long) huge.numa_failures);
+    bench_free_keys(keys, count);
+    return 2 * count == found ? 0 : 1;
+}
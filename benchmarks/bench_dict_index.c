@@ -0,0 +1,131 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict_index.c
+** File description:
+** Measures the cost of keeping the ordered index up to date, and compares a
+** prefix scan through it to a filtered walk of every key.
+*/
+
+#include <string.h>
+#include "bench.h"
+#include "dict.h"
+
+#define DEFAULT_ENTRIES 1000000
+
+/**
+ * @brief The number of tenants the keys are spread over.
+ */
+#define TENANTS 1000
+
+/**
+ * @brief The number of prefix queries of each pass.
+ */
+#define QUERIES 200
+
+/**
+ * @brief The size of a key, enough for the literal and two 20 digits numbers.
+ */
+#define TENANT_KEY_SIZE (sizeof("/tenant//") + 2 * 20)
+
+static
+int count_entry(__attribute__((unused)) const char *key,
+    __attribute__((unused)) uint64_t key_length,
+    __attribute__((unused)) void *value, void *ctx)
+{
+    ++*(uint64_t *) ctx;
+    return 0;
+}
+
+/**
+ * @brief Allocates `count` keys formatted as `/tenant/<tenant>/<index>`,
+ * returns a `NULL` pointer on error.
+ */
+static
+char **bench_tenant_keys(uint64_t count)
+{
+    uint64_t index = 0;
+    char **keys = (char **) calloc(count, sizeof(char *));
+
+    for (; NULL != keys && index < count; ++index) {
+        keys[index] = (char *) malloc(TENANT_KEY_SIZE);
+        if (NULL == keys[index]) {
+            bench_free_keys(keys, index);
+            return NULL;
+        }
+        snprintf(keys[index], TENANT_KEY_SIZE, "/tenant/%llu/%llu",
+            (unsigned long long) (index % TENANTS),
+            (unsigned long long) index);
+    }
+    return keys;
+}
+
+/**
+ * @brief Fills a dict with the keys, with or without its ordered index.
+ */
+static
+dict_t *bench_fill(char **keys, uint64_t count, int indexed)
+{
+    dict_t *dict = dict_ctor();
+    uint64_t index = 0;
+    uint64_t start = 0;
+
+    if (indexed)
+        dict_enable_index(dict);
+    start = bench_now();
+    for (; index < count; ++index)
+        dict_insert(dict, keys[index], strlen(keys[index]), NULL);
+    bench_report(indexed ? "dict_insert (indexed)" : "dict_insert", count,
+        bench_now() - start);
+    return dict;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t count = 1 < argc ? strtoull(argv[1], NULL, 10) : DEFAULT_ENTRIES;
+    char **keys = bench_tenant_keys(count);
+    dict_t *dict = NULL;
+    dict_keys_t *all = NULL;
+    dict_stats_t stats;
+    char prefix[32];
+    uint64_t found = 0;
+    uint64_t scanned = 0;
+    uint64_t query = 0;
+    uint64_t index = 0;
+    uint64_t start = 0;
+
+    if (NULL == keys)
+        return 1;
+    dict = bench_fill(keys, count, 0);
+    start = bench_now();
+    for (; query < QUERIES; ++query) {
+        snprintf(prefix, sizeof(prefix), "/tenant/%llu/",
+            (unsigned long long) (query * 7 % TENANTS));
+        all = dict_get_keys(dict);
+        for (index = 0; index < all->size; ++index)
+            found += all->lengths[index] >= strlen(prefix) && \
+                0 == memcmp(all->keys[index], prefix, strlen(prefix));
+        dict_free_keys(all);
+    }
+    bench_report("prefix query, dict_get_keys + filter", QUERIES,
+        bench_now() - start);
+    dict_dtor(dict, NULL);
+    dict = bench_fill(keys, count, 1);
+    dict_stats(dict, &stats);
+    printf("%-40s %10.1f bytes/entry\n", "ordered index",
+        (double) stats.index_bytes / (double) count);
+    start = bench_now();
+    for (query = 0; query < QUERIES; ++query) {
+        snprintf(prefix, sizeof(prefix), "/tenant/%llu/",
+            (unsigned long long) (query * 7 % TENANTS));
+        dict_scan_prefix(dict, prefix, strlen(prefix), count_entry, &scanned);
+    }
+    bench_report("prefix query, dict_scan_prefix", QUERIES,
+        bench_now() - start);
+    start = bench_now();
+    all = dict_get_sorted_keys(dict);
+    bench_report("dict_get_sorted_keys", count, bench_now() - start);
+    dict_free_keys(all);
+    dict_dtor(dict, NULL);
+    bench_free_keys(keys, count);
+    return found == scanned ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict_inline.c
+** File description:
+** Compares the values allocated on their own with the values stored inline,
+** for 32 bytes records.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "dict.h"
+
+#define DEFAULT_ENTRIES 1000000
+
+typedef struct s_record {
+    uint64_t id;
+    uint64_t hits;
+    double score;
+    uint64_t flags;
+} record_t;
+
+/**
+ * @brief Releases a value allocated on its own.
+ */
+static
+void bench_free_value(__attribute__((unused)) char *key, void *value)
+{
+    free(value);
+}
+
+/**
+ * @brief Inserts every key, with a record allocated on its own or copied
+ * into the node.
+ *
+ * @param name The name of the measure.
+ * @param dict The dict to fill.
+ * @param keys The keys to insert.
+ * @param count The number of keys.
+ */
+static
+void bench_fill(const char *name, dict_t *dict, char **keys, uint64_t count)
+{
+    record_t record = { 0, 0, 0.5, 0 };
+    record_t *value = &record;
+    uint64_t index = 0;
+    uint64_t start = bench_now();
+
+    for (; index < count; ++index) {
+        record.id = index;
+        if (0 == dict->value_size) {
+            value = (record_t *) malloc(sizeof(record_t));
+            *value = record;
+        }
+        dict_insert(dict, keys[index], strlen(keys[index]), value);
+    }
+    bench_report(name, count, bench_now() - start);
+}
+
+/**
+ * @brief Looks up every key and reads its record.
+ *
+ * @param name The name of the measure.
+ * @param dict The dict to query.
+ * @param keys The keys to look up.
+ * @param count The number of keys.
+ * @return The sum of the record ids, to keep the loop from being optimized
+ * out.
+ */
+static
+uint64_t bench_read(const char *name, dict_t *dict, char **keys,
+    uint64_t count)
+{
+    void *value = NULL;
+    uint64_t index = 0;
+    uint64_t sum = 0;
+    uint64_t start = bench_now();
+
+    for (; index < count; ++index)
+        if (0 == dict_get(dict, keys[index], strlen(keys[index]), &value))
+            sum += ((const record_t *) value)->id;
+    bench_report(name, count, bench_now() - start);
+    return sum;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t count = 1 < argc ? strtoull(argv[1], NULL, 10) : DEFAULT_ENTRIES;
+    char **keys = bench_keys("key:", count);
+    dict_t *pointers = dict_ctor();
+    dict_t *inlined = dict_ctor_with_value_size(sizeof(record_t));
+    uint64_t sum = 0;
+
+    if (NULL == keys || NULL == pointers || NULL == inlined)
+        return 1;
+    bench_fill("insert (allocated values)", pointers, keys, count);
+    bench_fill("insert (inline values)", inlined, keys, count);
+    sum += bench_read("lookup + read (allocated values)", pointers, keys,
+        count);
+    sum += bench_read("lookup + read (inline values)", inlined, keys,
+        count);
+    dict_dtor(pointers, bench_free_value);
+    dict_dtor(inlined, NULL);
+    bench_free_keys(keys, count);
+    return 0 == sum;
+}
@@ -0,0 +1,119 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict_intern.c
+** File description:
+** Interns a vocabulary, then compares the lookups of a table keyed by the
+** strings with the lookups of a table keyed by their symbol IDs.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "dict.h"
+
+#define DEFAULT_KEYS 1000000
+#define ROUNDS 4
+
+/**
+ * @brief Interns every key, twice, the second round only hitting the table.
+ *
+ * @return 0 on success, 1 on error.
+ */
+static
+int bench_intern(dict_intern_t *intern, char **keys, uint32_t *ids,
+    uint64_t count)
+{
+    uint64_t index = 0;
+    uint64_t start = bench_now();
+    uint32_t again = 0;
+
+    for (; index < count; ++index)
+        if (-1 == dict_intern(intern, keys[index], strlen(keys[index]),
+            &(ids[index])))
+            return 1;
+    bench_report("dict_intern (new strings)", count, bench_now() - start);
+    start = bench_now();
+    for (index = 0; index < count; ++index)
+        if (-1 == dict_intern(intern, keys[index], strlen(keys[index]),
+            &again) || again != ids[index])
+            return 1;
+    bench_report("dict_intern (interned strings)", count,
+        bench_now() - start);
+    return 0;
+}
+
+/**
+ * @brief Looks every key up in a table keyed by the strings.
+ *
+ * @return The number of keys found.
+ */
+static
+uint64_t bench_by_string(char **keys, uint64_t count)
+{
+    dict_t *dict = dict_ctor();
+    uint64_t index = 0;
+    uint64_t found = 0;
+    uint64_t start = 0;
+    int round = 0;
+
+    for (; index < count; ++index)
+        dict_insert(dict, keys[index], strlen(keys[index]), keys[index]);
+    start = bench_now();
+    for (; round < ROUNDS; ++round)
+        for (index = 0; index < count; ++index)
+            found += 0 == dict_get(dict, keys[index], strlen(keys[index]),
+                NULL);
+    bench_report("lookups keyed by string", ROUNDS * count,
+        bench_now() - start);
+    dict_dtor(dict, NULL);
+    return found;
+}
+
+/**
+ * @brief Looks every key up in a table keyed by the symbol IDs.
+ *
+ * @return The number of keys found.
+ */
+static
+uint64_t bench_by_id(uint32_t *ids, uint64_t count)
+{
+    dict_t *dict = dict_ctor();
+    uint64_t index = 0;
+    uint64_t found = 0;
+    uint64_t start = 0;
+    int round = 0;
+
+    for (; index < count; ++index)
+        dict_insert(dict, (char *) &(ids[index]), sizeof(uint32_t),
+            &(ids[index]));
+    start = bench_now();
+    for (; round < ROUNDS; ++round)
+        for (index = 0; index < count; ++index)
+            found += 0 == dict_get(dict, (const char *) &(ids[index]),
+                sizeof(uint32_t), NULL);
+    bench_report("lookups keyed by symbol ID", ROUNDS * count,
+        bench_now() - start);
+    dict_dtor(dict, NULL);
+    return found;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t count = 1 < argc ? strtoull(argv[1], NULL, 10) : DEFAULT_KEYS;
+    char **keys = bench_keys("symbol.", count);
+    uint32_t *ids = (uint32_t *) malloc(count * sizeof(uint32_t));
+    dict_intern_t *intern = dict_intern_ctor();
+    int status = 0;
+
+    if (NULL == keys || NULL == ids || NULL == intern)
+        return 1;
+    status = bench_intern(intern, keys, ids, count);
+    if (0 == status && (ROUNDS * count != bench_by_string(keys, count) || \
+        ROUNDS * count != bench_by_id(ids, count)))
+        status = 1;
+    dict_intern_dtor(intern);
+    free(ids);
+    bench_free_keys(keys, count);
+    return status;
+}
@@ -0,0 +1,115 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict_load.c
+** File description:
+** Compares loading a key/value file line per line with `dict_insert` against
+** the mapped bulk loader.
+*/
+
+#include <string.h>
+#include <unistd.h>
+#include "bench.h"
+#include "dict.h"
+
+#define DEFAULT_LINES 5000000
+
+/**
+ * @brief Writes `count` lines formatted as `key:<index>\t<index>`.
+ *
+ * @param path The path of the file to write.
+ * @param count The number of lines.
+ * @return 0 on success, -1 on error.
+ */
+static
+int bench_write_file(const char *path, uint64_t count)
+{
+    uint64_t index = 0;
+    FILE *file = fopen(path, "w");
+
+    if (NULL == file)
+        return -1;
+    for (; index < count; ++index)
+        fprintf(file, "key:%llu\t%llu\n", (unsigned long long) index,
+            (unsigned long long) index);
+    return fclose(file);
+}
+
+/**
+ * @brief Releases the pairs copied by `bench_getline`.
+ */
+static
+void bench_free_pair(char *key, void *value)
+{
+    free(key);
+    free(value);
+}
+
+/**
+ * @brief Loads the file the naive way : `getline`, then a copy of the key
+ * and of the value per line.
+ *
+ * @param path The path of the file to load.
+ * @return The number of loaded entries.
+ */
+static
+uint64_t bench_getline(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    dict_t *dict = dict_ctor();
+    char *line = NULL;
+    size_t capacity = 0;
+    ssize_t length = 0;
+    char *tab = NULL;
+    uint64_t items = 0;
+
+    while (NULL != file && 0 < (length = getline(&line, &capacity, file))) {
+        line[--length] = '\0';
+        tab = strchr(line, '\t');
+        *tab = '\0';
+        dict_insert(dict, strdup(line), tab - line, strdup(tab + 1));
+    }
+    free(line);
+    if (NULL != file)
+        fclose(file);
+    items = dict->items;
+    dict_dtor(dict, bench_free_pair);
+    return items;
+}
+
+/**
+ * @brief Loads the file with `dict_load_file`.
+ *
+ * @param path The path of the file to load.
+ * @return The number of loaded entries.
+ */
+static
+uint64_t bench_mapped(const char *path)
+{
+    dict_t *dict = dict_ctor();
+    uint64_t items = 0;
+
+    dict_load_file(dict, path, NULL, NULL);
+    items = dict->items;
+    dict_dtor(dict, NULL);
+    return items;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t count = 1 < argc ? strtoull(argv[1], NULL, 10) : DEFAULT_LINES;
+    const char *path = 2 < argc ? argv[2] : "/tmp/bench_dict_load.tsv";
+    uint64_t start = 0;
+
+    if (-1 == bench_write_file(path, count))
+        return 1;
+    start = bench_now();
+    if (count != bench_getline(path))
+        return 1;
+    bench_report("load getline + strdup", count, bench_now() - start);
+    start = bench_now();
+    if (count != bench_mapped(path))
+        return 1;
+    bench_report("load mapped (dict_load_file)", count, bench_now() - start);
+    unlink(path);
+    return 0;
+}
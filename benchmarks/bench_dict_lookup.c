@@ -0,0 +1,63 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict_lookup.c
+** File description:
+** Measures the lookup latency of hits and misses, with and without the
+** membership filter.
+*/
+
+#include <string.h>
+#include "bench.h"
+#include "dict.h"
+
+#define ENTRIES 1000000
+
+/**
+ * @brief Looks up every key once and reports the average latency.
+ *
+ * @param name The name of the measure.
+ * @param dict The dict to query.
+ * @param keys The keys to look up.
+ * @param count The number of keys.
+ * @return The number of keys found, to keep the loop from being optimized out.
+ */
+static
+uint64_t bench_lookups(const char *name, dict_t *dict, char **keys,
+    uint64_t count)
+{
+    uint64_t index = 0;
+    uint64_t found = 0;
+    uint64_t start = bench_now();
+
+    for (; index < count; ++index)
+        found += dict_has_key(dict, keys[index], strlen(keys[index]));
+    bench_report(name, count, bench_now() - start);
+    return found;
+}
+
+int main(void)
+{
+    uint64_t index = 0;
+    dict_t *dict = dict_ctor();
+    char **hits = bench_keys("hit:", ENTRIES);
+    char **misses = bench_keys("miss:", ENTRIES);
+    dict_stats_t stats = { 0 };
+
+    if (NULL == dict || NULL == hits || NULL == misses)
+        return 1;
+    for (; index < ENTRIES; ++index)
+        dict_insert(dict, hits[index], strlen(hits[index]), NULL);
+    bench_lookups("lookup hit", dict, hits, ENTRIES);
+    bench_lookups("lookup miss", dict, misses, ENTRIES);
+    dict_enable_filter(dict);
+    bench_lookups("lookup hit (filter)", dict, hits, ENTRIES);
+    bench_lookups("lookup miss (filter)", dict, misses, ENTRIES);
+    dict_stats(dict, &stats);
+    printf("filter: %llu bytes, expected fpr %.4f%%, observed fpr %.4f%%\n",
+        (unsigned long long) stats.filter_bytes, stats.filter_fpr * 100.0,
+        100.0 * (double) stats.filter_false_positives / (double) ENTRIES);
+    dict_dtor(dict, NULL);
+    bench_free_keys(hits, ENTRIES);
+    bench_free_keys(misses, ENTRIES);
+    return 0;
+}
@@ -0,0 +1,125 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict_map.cpp
+** File description:
+** Compares the C++ front-end of the dict with the C library and with
+** std::unordered_map.
+*/
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "bench.h"
+#include "dict.h"
+#include "dict.hpp"
+
+#define ENTRIES 1000000
+
+/**
+ * @brief Copies the keys generated by `bench_keys` into strings.
+ */
+static
+std::vector<std::string> bench_strings(const char *prefix, uint64_t count)
+{
+    char **keys = bench_keys(prefix, count);
+    std::vector<std::string> strings(keys, keys + count);
+
+    bench_free_keys(keys, count);
+    return strings;
+}
+
+/**
+ * @brief Measures the inserts, then the hit and miss lookups of a map type
+ * exposing `try_emplace` and `find`.
+ */
+template <typename Map, typename Key>
+static
+uint64_t bench_map(const char *name, const std::vector<Key> &hits,
+    const std::vector<Key> &misses)
+{
+    Map map;
+    uint64_t found = 0;
+    uint64_t start = bench_now();
+    std::string label(name);
+
+    for (uint64_t index = 0; index < hits.size(); ++index)
+        map.try_emplace(hits[index], index);
+    bench_report((label + " insert").c_str(), hits.size(), bench_now() - start);
+    start = bench_now();
+    for (const Key &key : hits)
+        found += nullptr != map.find(key);
+    bench_report((label + " hit").c_str(), hits.size(), bench_now() - start);
+    start = bench_now();
+    for (const Key &key : misses)
+        found += nullptr != map.find(key);
+    bench_report((label + " miss").c_str(), misses.size(),
+        bench_now() - start);
+    return found;
+}
+
+/**
+ * @brief Measures the same operations on the C library, the keys being
+ * borrowed from the strings.
+ */
+static
+uint64_t bench_dict(const std::vector<std::string> &hits,
+    const std::vector<std::string> &misses)
+{
+    dict_t *dict = dict_ctor();
+    uint64_t found = 0;
+    uint64_t start = bench_now();
+
+    for (uint64_t index = 0; index < hits.size(); ++index)
+        dict_insert(dict, const_cast<char *>(hits[index].data()),
+            hits[index].size(), reinterpret_cast<void *>(index));
+    bench_report("dict_t insert", hits.size(), bench_now() - start);
+    start = bench_now();
+    for (const std::string &key : hits)
+        found += dict_has_key(dict, key.data(), key.size());
+    bench_report("dict_t hit", hits.size(), bench_now() - start);
+    start = bench_now();
+    for (const std::string &key : misses)
+        found += dict_has_key(dict, key.data(), key.size());
+    bench_report("dict_t miss", misses.size(), bench_now() - start);
+    dict_dtor(dict, NULL);
+    return found;
+}
+
+/**
+ * @brief Adapts `std::unordered_map::find` to the pointer-returning `find`
+ * of `dict::map`, so that both go through `bench_map`.
+ */
+template <typename K>
+struct unordered : std::unordered_map<K, uint64_t> {
+    const uint64_t *find(const K &key) const
+    {
+        auto found = std::unordered_map<K, uint64_t>::find(key);
+
+        return this->end() == found ? nullptr : &found->second;
+    }
+};
+
+int main(void)
+{
+    std::vector<std::string> hits = bench_strings("hit:", ENTRIES);
+    std::vector<std::string> misses = bench_strings("miss:", ENTRIES);
+    std::vector<uint64_t> numbers(ENTRIES);
+    std::vector<uint64_t> others(ENTRIES);
+    uint64_t found = 0;
+
+    for (uint64_t index = 0; index < ENTRIES; ++index) {
+        numbers[index] = index * 7919;
+        others[index] = index * 7919 + 1;
+    }
+    found += bench_dict(hits, misses);
+    found += bench_map<dict::map<std::string, uint64_t>>("dict::map string",
+        hits, misses);
+    found += bench_map<unordered<std::string>>("unordered_map string", hits,
+        misses);
+    found += bench_map<dict::map<uint64_t, uint64_t>>("dict::map u64",
+        numbers, others);
+    found += bench_map<unordered<uint64_t>>("unordered_map u64", numbers,
+        others);
+    return 5 * ENTRIES == found ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict_parallel.c
+** File description:
+** Sums the values of a large dict with a serial loop over the keys, then
+** with dict_parallel_reduce on a growing number of threads.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "dict.h"
+
+#define DEFAULT_ENTRIES 100000000
+#define MAX_THREADS 16
+
+/**
+ * @brief Folds an entry value into the sum.
+ */
+static
+void bench_add(__attribute__((unused)) const char *key,
+    __attribute__((unused)) uint64_t key_length, void *value, void *acc,
+    __attribute__((unused)) void *ctx)
+{
+    *(uint64_t *) acc += *(const uint64_t *) value;
+}
+
+/**
+ * @brief Folds the sum of a thread into the total.
+ */
+static
+void bench_merge(void *acc, const void *partial,
+    __attribute__((unused)) void *ctx)
+{
+    *(uint64_t *) acc += *(const uint64_t *) partial;
+}
+
+/**
+ * @brief Sums the values the way it had to be done before : walking the
+ * keys returned by `dict_get_keys` and looking each of them up.
+ *
+ * @return The sum of the values.
+ */
+static
+uint64_t bench_serial(dict_t *dict)
+{
+    uint64_t start = bench_now();
+    dict_keys_t *keys = dict_get_keys(dict);
+    uint64_t index = 0;
+    uint64_t sum = 0;
+    void *value = NULL;
+
+    for (; NULL != keys && index < keys->size; ++index)
+        if (0 == dict_get(dict, keys->keys[index], keys->lengths[index],
+            &value))
+            sum += *(const uint64_t *) value;
+    bench_report("dict_get_keys + dict_get", dict->items,
+        bench_now() - start);
+    if (NULL != keys)
+        dict_free_keys(keys);
+    return sum;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t count = 1 < argc ? strtoull(argv[1], NULL, 10) : \
+        DEFAULT_ENTRIES;
+    uint64_t *keys = (uint64_t *) malloc(count * sizeof(uint64_t));
+    dict_t *dict = dict_ctor_with_value_size(sizeof(uint64_t));
+    uint64_t expected = 0;
+    uint64_t index = 0;
+    uint64_t sum = 0;
+    uint64_t start = 0;
+    uint64_t threads = 1;
+    char name[64] = { 0 };
+
+    if (NULL == keys || NULL == dict)
+        return 1;
+    for (; index < count; ++index) {
+        keys[index] = index * 0x9E3779B97F4A7C15ULL;
+        dict_insert(dict, (char *) &(keys[index]), sizeof(uint64_t), &index);
+    }
+    expected = bench_serial(dict);
+    for (; threads <= MAX_THREADS; threads *= 2) {
+        sum = 0;
+        start = bench_now();
+        dict_parallel_reduce(dict, bench_add, bench_merge, &sum,
+            sizeof(uint64_t), NULL, threads);
+        snprintf(name, sizeof(name), "dict_parallel_reduce (%llu threads)",
+            (unsigned long long) threads);
+        bench_report(name, count, bench_now() - start);
+        if (sum != expected)
+            return 1;
+    }
+    dict_dtor(dict, NULL);
+    free(keys);
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict_retain.c
+** File description:
+** Compares removing half of the entries with a `dict_delete` loop against a
+** single `dict_retain` pass.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "dict.h"
+
+#define DEFAULT_ENTRIES 2000000
+
+/**
+ * @brief Fills a dict with `count` keys, the value being the key index.
+ *
+ * @param keys The keys to insert.
+ * @param count The number of keys.
+ * @return The filled dict.
+ */
+static
+dict_t *bench_fill(char **keys, uint64_t count)
+{
+    dict_t *dict = dict_ctor();
+    uint64_t index = 0;
+
+    for (; index < count; ++index)
+        dict_insert(dict, keys[index], strlen(keys[index]),
+            (void *) (uintptr_t) index);
+    return dict;
+}
+
+/**
+ * @brief Keeps the entries whose index is even.
+ */
+static
+int bench_keep_even(__attribute__((unused)) const char *key,
+    __attribute__((unused)) uint64_t key_length, void *value,
+    __attribute__((unused)) void *ctx)
+{
+    return 0 == (uintptr_t) value % 2;
+}
+
+/**
+ * @brief Removes the odd entries the way it had to be done before
+ * `dict_retain` : a snapshot of the keys, then a `dict_delete` per key.
+ *
+ * @param dict The dict to filter.
+ */
+static
+void bench_delete_loop(dict_t *dict)
+{
+    dict_keys_t *keys = dict_get_keys(dict);
+    uint64_t index = 0;
+    char *key = NULL;
+    void *value = NULL;
+
+    for (; NULL != keys && index < keys->size; ++index) {
+        key = (char *) keys->keys[index];
+        dict_get(dict, key, strlen(key), &value);
+        if (!bench_keep_even(key, strlen(key), value, NULL))
+            dict_delete(dict, key, strlen(key), NULL);
+    }
+    dict_free_keys(keys);
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t count = 1 < argc ? strtoull(argv[1], NULL, 10) : DEFAULT_ENTRIES;
+    char **keys = bench_keys("key:", count);
+    dict_t *dict = NULL;
+    uint64_t start = 0;
+
+    if (NULL == keys)
+        return 1;
+    dict = bench_fill(keys, count);
+    start = bench_now();
+    bench_delete_loop(dict);
+    bench_report("dict_get_keys + dict_delete", count, bench_now() - start);
+    if (count / 2 != dict->items)
+        return 1;
+    dict_dtor(dict, NULL);
+    dict = bench_fill(keys, count);
+    start = bench_now();
+    dict_retain(dict, bench_keep_even, NULL, NULL);
+    bench_report("dict_retain", count, bench_now() - start);
+    if (count / 2 != dict->items)
+        return 1;
+    dict_dtor(dict, NULL);
+    bench_free_keys(keys, count);
+    return 0;
+}
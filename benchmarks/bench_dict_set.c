@@ -0,0 +1,156 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict_set.c
+** File description:
+** Compares the memory footprint and the throughput of a deduplication through
+** the dict, the compact dict and the set, then times the bulk set operations.
+*/
+
+#include <string.h>
+#include "bench.h"
+#include "dict.h"
+
+#define DEFAULT_ENTRIES 2000000
+
+/**
+ * @brief Each distinct key is seen this many times by the deduplication.
+ */
+#define DUPLICATES 4
+
+/**
+ * @brief Estimated bookkeeping bytes the allocator adds to each allocation.
+ */
+#define MALLOC_OVERHEAD 16
+
+/**
+ * @brief Tracks the memory held through the allocator hooks. Each allocation
+ * is prefixed with its size, so that releases can be accounted for.
+ */
+typedef struct s_bench_memory {
+    uint64_t allocations;
+    uint64_t bytes;
+} bench_memory_t;
+
+static
+void *bench_allocate(void *ctx, size_t size)
+{
+    bench_memory_t *memory = (bench_memory_t *) ctx;
+    size_t *ptr = (size_t *) malloc(size + MALLOC_OVERHEAD);
+
+    if (NULL == ptr)
+        return NULL;
+    ++memory->allocations;
+    memory->bytes += size;
+    *ptr = size;
+    return (char *) ptr + MALLOC_OVERHEAD;
+}
+
+static
+void bench_release(void *ctx, void *ptr)
+{
+    bench_memory_t *memory = (bench_memory_t *) ctx;
+    size_t *header = (size_t *) ((char *) ptr - MALLOC_OVERHEAD);
+
+    --memory->allocations;
+    memory->bytes -= *header;
+    free(header);
+}
+
+static
+void *bench_reallocate(void *ctx, void *ptr, size_t old_size,
+    size_t new_size)
+{
+    void *moved = bench_allocate(ctx, new_size);
+
+    if (NULL == moved)
+        return NULL;
+    memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    bench_release(ctx, ptr);
+    return moved;
+}
+
+/**
+ * @brief Prints the memory held per entry, keys excluded, counting the
+ * estimated bookkeeping bytes of each live allocation.
+ */
+static
+void bench_memory_report(const char *name, const bench_memory_t *memory,
+    uint64_t count)
+{
+    printf("%-40s %10.1f bytes/entry (%llu allocations)\n", name,
+        (double) (memory->bytes + memory->allocations * MALLOC_OVERHEAD) / \
+        (double) count, (unsigned long long) memory->allocations);
+}
+
+/**
+ * @brief Feeds every key `DUPLICATES` times to the set, counting the new ones.
+ */
+static
+uint64_t bench_dedup_set(dict_set_t *set, char **keys, uint64_t count)
+{
+    uint64_t added = 0;
+    uint64_t index = 0;
+
+    for (; index < count * DUPLICATES; ++index)
+        added += 0 == dict_set_add(set, keys[index % count],
+            strlen(keys[index % count]));
+    return added;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t count = 1 < argc ? strtoull(argv[1], NULL, 10) : DEFAULT_ENTRIES;
+    char **keys = bench_keys("key:", count);
+    bench_memory_t memory = { 0, 0 };
+    dict_allocator_t allocator = { bench_allocate, bench_reallocate,
+        bench_release, &memory, NULL, NULL };
+    dict_t *dict = dict_ctor_with_allocator(&allocator);
+    dict32_t *dict32 = NULL;
+    dict_set_t *set = NULL;
+    dict_set_t *other = NULL;
+    uint64_t index = 0;
+    uint64_t added = 0;
+    uint64_t start = bench_now();
+
+    for (; index < count * DUPLICATES; ++index)
+        added += 0 == dict_insert(dict, keys[index % count],
+            strlen(keys[index % count]), NULL);
+    bench_report("dict_t dedup", count * DUPLICATES, bench_now() - start);
+    bench_memory_report("dict_t", &memory, count);
+    dict_dtor(dict, NULL);
+    dict32 = dict32_ctor(&allocator);
+    start = bench_now();
+    for (index = 0; index < count * DUPLICATES; ++index)
+        added += 0 == dict32_insert(dict32, keys[index % count],
+            strlen(keys[index % count]), NULL);
+    bench_report("dict32_t dedup", count * DUPLICATES, bench_now() - start);
+    bench_memory_report("dict32_t", &memory, count);
+    dict32_dtor(dict32, NULL);
+    set = dict_set_ctor(&allocator);
+    start = bench_now();
+    added += bench_dedup_set(set, keys, count);
+    bench_report("dict_set_t dedup", count * DUPLICATES, bench_now() - start);
+    bench_memory_report("dict_set_t", &memory, count);
+    other = dict_set_ctor(&allocator);
+    for (index = 0; index < count; index += 2)
+        dict_set_add(other, keys[index], strlen(keys[index]));
+    start = bench_now();
+    added += 0 == dict_set_union(other, set);
+    bench_report("dict_set_union (half missing)", count, bench_now() - start);
+    start = bench_now();
+    added += dict_set_difference(other, set, NULL);
+    bench_report("dict_set_difference (all removed)", count,
+        bench_now() - start);
+    dict_set_dtor(other, NULL);
+    other = dict_set_ctor(&allocator);
+    for (index = 0; index < count; index += 2)
+        dict_set_add(other, keys[index], strlen(keys[index]));
+    start = bench_now();
+    added += dict_set_intersection(set, other, NULL);
+    bench_report("dict_set_intersection (half removed)", count,
+        bench_now() - start);
+    dict_set_dtor(other, NULL);
+    dict_set_dtor(set, NULL);
+    bench_free_keys(keys, count);
+    return 3 * count + 1 + count + count / 2 == added ? 0 : 1;
+}
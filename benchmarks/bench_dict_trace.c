@@ -0,0 +1,89 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict_trace.c
+** File description:
+** Measures the cost of recording a trace, on a mix of insertions, lookups
+** and deletions. The last trace is kept, to be given to dict_replay.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "dict.h"
+
+#define DEFAULT_OPS 5000000
+#define KEYS_COUNT 500000
+
+/**
+ * @brief A xorshift generator, so that the workload is the same on every run.
+ */
+static
+uint64_t bench_random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/**
+ * @brief Runs the workload : 60% of lookups, 30% of insertions and 10% of
+ * deletions, on keys drawn with a skewed distribution.
+ *
+ * @param name The name of the measure.
+ * @param keys The keys.
+ * @param count The number of operations.
+ * @param path The trace file, `NULL` pointer not to record.
+ * @param mode The trace mode.
+ * @return 0 on success, 1 on error.
+ */
+static
+int bench_workload(const char *name, char **keys, uint64_t count,
+    const char *path, int mode)
+{
+    dict_t *dict = dict_ctor();
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    uint64_t index = 0;
+    uint64_t key = 0;
+    uint64_t draw = 0;
+    uint64_t start = 0;
+
+    if (NULL == dict || (NULL != path && -1 == dict_trace_start(dict, path,
+        mode)))
+        return 1;
+    start = bench_now();
+    for (; index < count; ++index) {
+        key = (bench_random(&state) % KEYS_COUNT) * \
+            (bench_random(&state) % KEYS_COUNT) / KEYS_COUNT;
+        draw = bench_random(&state) % 10;
+        if (6 > draw)
+            dict_get(dict, keys[key], strlen(keys[key]), NULL);
+        else if (9 > draw)
+            dict_insert(dict, keys[key], strlen(keys[key]), keys[key]);
+        else
+            dict_delete(dict, keys[key], strlen(keys[key]), NULL);
+    }
+    if (NULL != path && -1 == dict_trace_stop(dict))
+        return 1;
+    bench_report(name, count, bench_now() - start);
+    dict_dtor(dict, NULL);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = 2 < argc ? argv[2] : "/tmp/bench_dict_trace.trace";
+    uint64_t count = 1 < argc ? strtoull(argv[1], NULL, 10) : DEFAULT_OPS;
+    char **keys = bench_keys("session:", KEYS_COUNT);
+    int status = 0;
+
+    if (NULL == keys)
+        return 1;
+    status = bench_workload("not recording", keys, count, NULL, 0) || \
+        bench_workload("recording the hashes", keys, count, path,
+        DICT_TRACE_HASHES) || bench_workload("recording the keys", keys,
+        count, path, DICT_TRACE_KEYS);
+    bench_free_keys(keys, KEYS_COUNT);
+    return status;
+}
@@ -0,0 +1,109 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_dict_wal.c
+** File description:
+** Measures the write throughput of the durable dict under every sync policy,
+** along with its compaction and recovery times.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "bench.h"
+#include "dict.h"
+
+#define DEFAULT_ENTRIES 200000
+
+/**
+ * @brief The number of entries written under `DICT_WAL_SYNC_ALWAYS`, which
+ * issues one sync per entry.
+ */
+#define ALWAYS_ENTRIES 2000
+
+/**
+ * @brief Inserts `count` keys into a fresh durable dict, and reports the
+ * throughput.
+ *
+ * @param path The base path of the durable dict.
+ * @param name The name of the measure.
+ * @param policy The sync policy.
+ * @param keys The keys to insert.
+ * @param count The number of keys.
+ * @return The durable dict.
+ */
+static
+dict_wal_t *bench_write(const char *path, const char *name, int policy,
+    char **keys, uint64_t count)
+{
+    dict_wal_t *wal = dict_wal_open(path, policy, 0, NULL);
+    uint64_t index = 0;
+    uint64_t start = bench_now();
+
+    for (; NULL != wal && index < count; ++index)
+        dict_wal_insert(wal, keys[index], strlen(keys[index]), &index,
+            sizeof(index));
+    if (NULL != wal)
+        dict_wal_sync(wal);
+    bench_report(name, count, bench_now() - start);
+    if (NULL != wal)
+        printf("%-40s %12llu syncs\n", "", (unsigned long long) wal->syncs);
+    return wal;
+}
+
+/**
+ * @brief Removes the files of a durable dict.
+ *
+ * @param path The base path of the durable dict.
+ */
+static
+void bench_remove(const char *path)
+{
+    char file[256] = { 0 };
+    int generation = 0;
+
+    snprintf(file, sizeof(file), "%s.snap", path);
+    unlink(file);
+    for (generation = 1; generation < 4; ++generation) {
+        snprintf(file, sizeof(file), "%s.%d.log", path, generation);
+        unlink(file);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t count = 1 < argc ? strtoull(argv[1], NULL, 10) : DEFAULT_ENTRIES;
+    const char *path = 2 < argc ? argv[2] : "bench_dict_wal";
+    char **keys = bench_keys("key:", count);
+    dict_wal_t *wal = NULL;
+    uint64_t start = 0;
+
+    if (NULL == keys)
+        return 1;
+    bench_remove(path);
+    dict_wal_close(bench_write(path, "insert (sync always)",
+        DICT_WAL_SYNC_ALWAYS, keys, count < ALWAYS_ENTRIES ? count :
+        ALWAYS_ENTRIES));
+    bench_remove(path);
+    dict_wal_close(bench_write(path, "insert (sync batch)",
+        DICT_WAL_SYNC_BATCH, keys, count));
+    bench_remove(path);
+    wal = bench_write(path, "insert (sync none)", DICT_WAL_SYNC_NONE, keys,
+        count);
+    dict_wal_close(wal);
+    start = bench_now();
+    wal = dict_wal_open(path, DICT_WAL_SYNC_NONE, 0, NULL);
+    bench_report("recover from log", count, bench_now() - start);
+    start = bench_now();
+    dict_wal_compact(wal);
+    dict_wal_compact_wait(wal);
+    bench_report("compact", count, bench_now() - start);
+    dict_wal_close(wal);
+    start = bench_now();
+    wal = dict_wal_open(path, DICT_WAL_SYNC_NONE, 0, NULL);
+    bench_report("recover from snapshot", count, bench_now() - start);
+    dict_wal_close(wal);
+    bench_remove(path);
+    bench_free_keys(keys, count);
+    return 0;
+}
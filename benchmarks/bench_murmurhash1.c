@@ -0,0 +1,82 @@
+/*
+** XIMAZ PROJECTS, 2024
+** bench_murmurhash1.c
+** File description:
+** Compares hashing keys one at a time with `murmurhash1` against hashing them
+** in SIMD lanes with `murmurhash1_many`, per key length.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "murmurhash1.h"
+
+#define DEFAULT_KEYS 1000000
+#define BATCH 256
+
+/**
+ * @brief Builds `count` keys of `length` bytes, taken from a shared buffer at
+ * varying offsets.
+ *
+ * @param data The buffer holding the bytes of the keys.
+ * @param keys The keys to fill.
+ * @param lengths The lengths to fill.
+ * @param count The number of keys.
+ * @param length The length of every key.
+ */
+static
+void bench_fill(const char *data, const void **keys, uint64_t *lengths,
+    uint64_t count, uint64_t length)
+{
+    uint64_t index = 0;
+
+    for (; index < count; ++index) {
+        keys[index] = data + (index * 61) % 4096;
+        lengths[index] = length;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t count = 1 < argc ? strtoull(argv[1], NULL, 10) : DEFAULT_KEYS;
+    uint64_t sizes[] = { 4, 8, 16, 32, 64, 128 };
+    char *data = malloc(4096 + 128);
+    const void **keys = malloc(count * sizeof(void *));
+    uint64_t *lengths = malloc(count * sizeof(uint64_t));
+    uint32_t *hashes = malloc(count * sizeof(uint32_t));
+    uint32_t check = 0;
+    uint64_t start = 0;
+    uint64_t size = 0;
+    uint64_t index = 0;
+    char name[64] = { 0 };
+
+    if (NULL == data || NULL == keys || NULL == lengths || NULL == hashes)
+        return 1;
+    for (; index < 4096 + 128; ++index)
+        data[index] = (char) (index * 131 + 17);
+    for (; size < sizeof(sizes) / sizeof(sizes[0]); ++size) {
+        bench_fill(data, keys, lengths, count, sizes[size]);
+        start = bench_now();
+        for (index = 0; index < count; ++index)
+            hashes[index] = murmurhash1(keys[index], lengths[index], 0);
+        snprintf(name, sizeof(name), "murmurhash1      %3lu bytes",
+            (unsigned long) sizes[size]);
+        bench_report(name, count, bench_now() - start);
+        check = hashes[count - 1];
+        start = bench_now();
+        for (index = 0; index < count; index += BATCH)
+            murmurhash1_many(keys + index, lengths + index,
+                count - index < BATCH ? count - index : BATCH, 0,
+                hashes + index);
+        snprintf(name, sizeof(name), "murmurhash1_many %3lu bytes",
+            (unsigned long) sizes[size]);
+        bench_report(name, count, bench_now() - start);
+        if (check != hashes[count - 1])
+            return 1;
+    }
+    free(data);
+    free(keys);
+    free(lengths);
+    free(hashes);
+    return 0;
+}
@@ -8,9 +8,14 @@
 #ifndef __DICT_H_
 #define __DICT_H_
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /** @cond INTERNAL */
 
 /**
@@ -38,7 +43,8 @@
  *
  * @param D The dict to evaluate.
  */
-#define DICT_MUST_GROW(D) ((float) (D)->items / (float) (D)->size) > DICT_HIGH
+#define DICT_MUST_GROW(D) \
+    (((float) (D)->items / (float) (D)->size) > DICT_HIGH)
 
 /**
  * @brief Returns whether the dict must shirnk to save some memory upon entry
@@ -46,7 +52,8 @@
  *
  * @param D The dict to evaluate.
  */
-#define DICT_MUST_SHRINK(D) ((float) (D)->items / (float) (D)->size) < DICT_LOW
+#define DICT_MUST_SHRINK(D) ((D)->size > DICT_MIN_SIZE && \
+    ((float) (D)->items / (float) (D)->size) < DICT_LOW)
 
 /**
  * @brief The hash seed to use. Mostly for security, but it has to be the same
@@ -63,12 +70,171 @@
 #define DICT_BUCKET_IDX(H, S) (H) % (S)
 
 /**
- * @brief Returns whether two keys from a dict are matching.
+ * @brief Returns whether the key of an entry matches a key. Keys are compared
+ * by length first, then byte per byte, so they do not have to be NUL
+ * terminated.
+ *
+ * @param B The entry whose key to compare.
+ * @param K The key to compare.
+ * @param L The length of the key to compare.
+ */
+#define DICT_KEY_MATCH(B, K, L) \
+    ((B)->key_length == (L) && 0 == memcmp((B)->key, (K), (L)))
+
+/**
+ * @brief The number of bits in a membership filter block. A block matches the
+ * size of a cache line so that a lookup only reads one line of the filter.
+ */
+#define DICT_FILTER_BLOCK_BITS 512
+
+/**
+ * @brief The number of 64 bits words in a membership filter block.
+ */
+#define DICT_FILTER_BLOCK_WORDS (DICT_FILTER_BLOCK_BITS / 64)
+
+/**
+ * @brief The number of dict buckets covered by a single filter block. As the
+ * dict never holds more than `DICT_HIGH` items per bucket, it gives at least 16
+ * bits per key.
+ */
+#define DICT_FILTER_BUCKETS_PER_BLOCK 64
+
+/**
+ * @brief The number of bits set in a block for each key.
+ */
+#define DICT_FILTER_HASHES 6
+
+/**
+ * @brief Spreads the 32 bits key hash over 64 bits so that the block index and
+ * the bit positions inside the block are not correlated with the bucket index.
+ *
+ * @param H The key hash.
+ */
+#define DICT_FILTER_MIX(H) ((uint64_t) (H) * 0x9E3779B97F4A7C15ULL)
+
+/**
+ * @brief The number of keys hashed at once by `dict_incr_many`.
+ */
+#define DICT_INCR_BATCH 64
+
+/**
+ * @brief The number of buckets handed at once to a thread of
+ * `dict_parallel_foreach` and `dict_parallel_reduce`.
+ */
+#define DICT_PARALLEL_CHUNK 4096
+
+/**
+ * @brief The number of threads actually walking the dict in parallel : there
+ * is no point in having more threads than chunks of buckets.
+ *
+ * @param D The dict.
+ * @param T The requested number of threads.
+ */
+#define DICT_PARALLEL_WORKERS(D, T) (2 > (T) ? 1 : \
+    ((D)->size + DICT_PARALLEL_CHUNK - 1) / DICT_PARALLEL_CHUNK < (T) ? \
+    ((D)->size + DICT_PARALLEL_CHUNK - 1) / DICT_PARALLEL_CHUNK : (T))
+
+/**
+ * @brief Entry flag set upon lookup when the cache mode is enabled, and
+ * cleared by the CLOCK hand. Entries without it are evicted first.
+ */
+#define DICT_BUCKET_REFERENCED (1 << 0)
+
+/**
+ * @brief Entry flag set on the nodes copied from a chain shared with a clone.
+ * Their pair belongs to the shared snapshot, so `free_pair` is not called on
+ * it when the node is removed. It's released along with the snapshot instead,
+ * unless the node owns its value, see `DICT_BUCKET_OWNS_VALUE`.
+ */
+#define DICT_BUCKET_BORROWED (1 << 1)
+
+/**
+ * @brief Entry flag set on the nodes moved into a pack by `dict_compact`.
+ * They are not released one by one, the whole pack is released once no dict
+ * refers to it anymore.
+ */
+#define DICT_BUCKET_PACKED (1 << 2)
+
+/**
+ * @brief Entry flag set on the borrowed nodes whose value belongs to the dict
+ * anyway : the value was written through the slot given by `dict_entry`, or
+ * made by the `load_value` function of `dict_load_file`. Only the key is left
+ * out when releasing them, `free_pair` getting a `NULL` pointer key.
+ */
+#define DICT_BUCKET_OWNS_VALUE (1 << 3)
+
+/**
+ * @brief Releases the pair of an entry with `free_pair`, leaving out what the
+ * entry borrows, see `DICT_BUCKET_BORROWED` and `DICT_BUCKET_OWNS_VALUE`.
+ *
+ * @param F The function releasing the pair, must not be a `NULL` pointer.
+ * @param B The entry.
+ */
+#define DICT_BUCKET_FREE_PAIR(F, B) \
+    (0 == ((B)->flags & DICT_BUCKET_BORROWED) ? (F)((B)->key, (B)->value) : \
+    0 != ((B)->flags & DICT_BUCKET_OWNS_VALUE) ? (F)(NULL, (B)->value) : \
+    (void) 0)
+
+/**
+ * @brief Returns the size of the nodes holding the entries of a dict, their
+ * inline value storage and expiry date included, rounded so that the nodes
+ * stay aligned.
+ *
+ * @param D The dict.
+ */
+#define DICT_NODE_SIZE(D) \
+    (sizeof(bucket_t) + (((D)->value_size + 7) & ~(uint64_t) 7) + \
+    (D)->expiry_size)
+
+/**
+ * @brief Returns the expiry date of an entry, stored after its inline value
+ * storage, 0 if it never expires. Only valid if `expiry_size` is not 0.
+ *
+ * @param D The dict holding the entry.
+ * @param B The entry.
+ */
+#define DICT_BUCKET_EXPIRES_AT(D, B) (*(uint64_t *) ((char *) (B) + \
+    sizeof(bucket_t) + (((D)->value_size + 7) & ~(uint64_t) 7)))
+
+/**
+ * @brief Returns whether the bucket at the given index is still shared with
+ * the snapshot, according to the copy-on-write bitmap.
+ *
+ * @param BITS The copy-on-write bitmap.
+ * @param I The index of the bucket.
+ */
+#define DICT_COW_SHARED(BITS, I) (((BITS)[(I) / 64] >> ((I) % 64)) & 1)
+
+/**
+ * @brief Returns whether the dict owns the bucket at the given index, rather
+ * than sharing its nodes with a clone, in which case they must not be written.
+ *
+ * @param D The dict.
+ * @param I The index of the bucket.
+ */
+#define DICT_OWNS_BUCKET(D, I) (NULL == (D)->shared || \
+    ((D)->buckets != (D)->shared->buckets && \
+    (NULL == (D)->cow_bits || !DICT_COW_SHARED((D)->cow_bits, I))))
+
+/**
+ * @brief Returns whether an entry has expired.
  *
- * @param K1 The first key to compare.
- * @param K2 The second key to compare.
+ * @param D The dict holding the entry.
+ * @param B The entry to evaluate.
+ * @param NOW The current date, as returned by the dict clock.
  */
-#define DICT_KEY_MATCH(K1, K2) (0 == strcmp((K1), (K2)))
+#define DICT_BUCKET_EXPIRED(D, B, NOW) (0 != (D)->expiry_size && \
+    0 != DICT_BUCKET_EXPIRES_AT(D, B) && DICT_BUCKET_EXPIRES_AT(D, B) <= (NOW))
+
+/**
+ * @brief The alignment of the allocations handed out by an arena.
+ */
+#define DICT_ARENA_ALIGN 16
+
+/**
+ * @brief The default minimum size of the chunks of an arena.
+ */
+#define DICT_ARENA_CHUNK_SIZE (1 << 20)
 
 /** @endcond INTERNAL */
 
@@ -85,9 +251,126 @@
  * memory allcoated to an entry value. If the value was not allocated (e.g. the
  * value is an integer), then you may use a `NULL` pointer instead to indicate
  * that the value has not to be free.
+ *
+ * @note The key is a `NULL` pointer for the entries which only own their value,
+ * see `DICT_BUCKET_OWNS_VALUE`.
  */
 typedef void (*free_pair_t)(char *key, void *value);
 
+/**
+ * @brief Such function prototype represents the function to use to release the
+ * memory allocated to a key of a set. If the keys were not allocated, then you
+ * may use a `NULL` pointer instead.
+ */
+typedef void (*free_key_t)(char *key);
+
+/**
+ * @brief Such function prototype returns the number of bytes an entry is
+ * charged against the memory budget of a cache mode dict. It must return the
+ * same amount each time it is called on the same pair.
+ */
+typedef uint64_t (*size_pair_t)(const char *key, uint64_t key_length,
+    const void *value);
+
+/**
+ * @brief Such function prototype returns the current date used to expire the
+ * entries. The unit is up to the programmer, as long as the time to live given
+ * to the dict uses the same one. It must never go backward.
+ */
+typedef uint64_t (*dict_clock_t)(void);
+
+/**
+ * @brief Such function prototype turns the value field of a line loaded by
+ * `dict_load_file` into the value to store. The bytes belong to the mapped
+ * file and are not NUL terminated.
+ */
+typedef void *(*load_value_t)(const char *bytes, uint64_t length, void *ctx);
+
+/**
+ * @brief This structure holds the hash of a key, along with the seed it was
+ * computed with, see `dict_hash_key`. A hash can be given to any dict hashing
+ * its keys with the same seed, and is rejected by the others.
+ */
+typedef struct s_dict_hash {
+    /** The hash of the key. */
+    uint32_t value;
+
+    /** The seed the hash was computed with. */
+    uint32_t seed;
+} dict_hash_t;
+
+/**
+ * @brief Such function prototype tells `dict_retain` whether to keep an
+ * entry. It returns non-zero to keep it, 0 to remove it. It must not modify
+ * the dict.
+ */
+typedef int (*retain_pair_t)(const char *key, uint64_t key_length,
+    void *value, void *ctx);
+
+/**
+ * @brief Such function prototype is called by `dict_parallel_foreach` on each
+ * entry, possibly from several threads at once. It must not modify the dict,
+ * but may modify the value it's given.
+ */
+typedef void (*foreach_pair_t)(const char *key, uint64_t key_length,
+    void *value, void *ctx);
+
+/**
+ * @brief Such function prototype folds an entry into the accumulator of its
+ * chunk of buckets, see `dict_parallel_reduce`. It must not modify the dict.
+ */
+typedef void (*reduce_pair_t)(const char *key, uint64_t key_length,
+    void *value, void *acc, void *ctx);
+
+/**
+ * @brief Such function prototype folds the accumulator of a chunk of buckets
+ * into the final accumulator, see `dict_parallel_reduce`.
+ */
+typedef void (*merge_acc_t)(void *acc, const void *partial, void *ctx);
+
+/**
+ * @brief Such function prototype is called by `dict_scan_prefix` and
+ * `dict_scan_range` on each entry, in keys order. It returns non-zero to stop
+ * the scan. It must not insert nor delete entries.
+ */
+typedef int (*scan_pair_t)(const char *key, uint64_t key_length,
+    void *value, void *ctx);
+
+/**
+ * @brief This structure represents the allocator a dict routes all of its
+ * internal allocations through. Every function receives the `ctx` pointer, and
+ * the returned memory must be suitably aligned for any type, like `malloc`.
+ */
+typedef struct s_dict_allocator {
+    /** Allocates `size` bytes, returns a `NULL` pointer on error. */
+    void *(*allocate)(void *ctx, size_t size);
+
+    /**
+     * Resizes an allocation of `old_size` bytes to `new_size` bytes, returns
+     * a `NULL` pointer on error, the allocation being left unchanged.
+     */
+    void *(*reallocate)(void *ctx, void *ptr, size_t old_size,
+        size_t new_size);
+
+    /** Releases an allocation, never called with a `NULL` pointer. */
+    void (*release)(void *ctx, void *ptr);
+
+    /** The context given to the functions of the allocator. */
+    void *ctx;
+
+    /**
+     * Optional, allocates `size` zeroed bytes for a large array (buckets
+     * array, compact dict pool). `allocate` is used if it's `NULL`.
+     */
+    void *(*allocate_large)(void *ctx, size_t size);
+
+    /**
+     * Optional, releases an allocation of `allocate_large` of `size` bytes.
+     * `release` is used if it's `NULL`.
+     */
+    void (*release_large)(void *ctx, void *ptr, size_t size);
+} dict_allocator_t;
+
 /** @cond INTERNAL */
 
 /**
@@ -98,6 +381,15 @@ typedef struct s_bucket {
     /** The key used to refer to the value. */
     char *key;
 
+    /** The length of the key, at most `UINT32_MAX`. */
+    uint32_t key_length;
+
+    /**
+     * Entry state bits, see the `DICT_BUCKET_*` flags. They share the word of
+     * the key length, so that they cost no memory.
+     */
+    uint32_t flags;
+
     /** The value to store, refered at via the key. */
     void *value;
 
@@ -120,9 +412,11 @@ typedef struct s_bucket {
  *
  * @param buckets The pre-allocated buckets array.
  * @param size The number of buckets to allocate inside the buckets array.
+ * @param allocator The allocator of the sentinel nodes.
  * @return 0 on success, -1 on error.
  */
-int dict_buckets_ctor(bucket_t **buckets, uint64_t size);
+int dict_buckets_ctor(bucket_t **buckets, uint64_t size,
+    const dict_allocator_t *allocator);
 
 /**
  * @brief Deallocates buckets linked list from the array.
@@ -131,63 +425,47 @@ int dict_buckets_ctor(bucket_t **buckets, uint64_t size);
  *
  * @note This function will not free the buckets array, just it's elements.
  *
+ * @note The `free_pair` function is not given what the borrowed entries
+ * borrow, see `DICT_BUCKET_BORROWED`.
+ *
  * @param buckets The pre-allocated buckets array.
  * @param size The nuber of buckets to deallocate from the buckets array.
  * @param free_pair The function to use to free pair, may be `NULL`.
+ * @param allocator The allocator of the nodes.
  */
 void dict_buckets_dtor(bucket_t **buckets, uint64_t size,
-    free_pair_t free_pair);
+    free_pair_t free_pair, const dict_allocator_t *allocator);
 
 /**
- * @brief Returns whether a key is present in the bucket.
- *
- * @warning If a `NULL` pointer is passed for bucket, the function will crash.
+ * @brief Deallocates the buckets linked lists owned by a dict or a snapshot,
+ * skipping the buckets still marked as shared in the copy-on-write bitmap.
  *
- * @note If the key is `NULL` a falsy value may be returned. Make sure it's not
- * before calling the function.
+ * @note This function will not free the buckets array, just it's elements.
  *
- * @param bucket The bucket in which to look for the key.
- * @param key The key to look for in the bucket.
- * @return 1 if present, 0 if not present.
+ * @param buckets The buckets array.
+ * @param size The number of buckets inside the buckets array.
+ * @param cow_bits The copy-on-write bitmap, `NULL` if no bucket is shared.
+ * @param free_pair The function to use to free pair, may be `NULL`.
+ * @param allocator The allocator of the nodes.
  */
-int dict_bucket_has_key(const bucket_t *bucket, const char *key);
+void dict_owned_buckets_dtor(bucket_t **buckets, uint64_t size,
+    const uint64_t *cow_bits, free_pair_t free_pair,
+    const dict_allocator_t *allocator);
 
 /**
- * @brief Inserts an entry into a dict bucket.
+ * @brief Looks for the link pointing to the node matching the key inside the
+ * bucket, so that the node can be unlinked.
  *
  * @warning If a `NULL` pointer is passed for bucket, the function will crash.
  *
- * @note If it failed to allocate the linked list bucket node, the bucket is
- * left unchanged and the function returns -1.
- *
- * @param bucket The pointer to the allocated bucket.
- * @param key The key of the pair.
- * @param value The value of the pair.
- * @return 0 on success, -1 on error.
- */
-int dict_bucket_insert(bucket_t **bucket, char *key, void *value);
-
-/**
- * @brief Deletes an entry from the bucket based on the key.
- *
- * If no node matched the key, -1 is returned as an error and the bucket is
- * unchanged.
- *
- * @warning If a `NULL` pointer is passed for either the bucket or the key, the
- * function will crash.
- *
- * @note The key is not marked as const as it may get free'd by the `free_pair`
- * function, but bear in mind the current function will not modify the key.
- *
- * @note If the `free_pair` function is a `NULL` pointer, it's not called. It
- * may be useful if neither the key nor the value were allocated.
- *
- * @param bucket The bucket from which to remove the entry.
- * @param key The key used to match the entry to be removed.
- * @param free_pair The function called to release the key and value memory.
- * @return 0 on success, -1 on error.
+ * @param bucket The address of the bucket in which to look for the key.
+ * @param key The key to look for in the bucket.
+ * @param key_length The length of the key.
+ * @return The address of the pointer to the matching node, or a `NULL`
+ * pointer if the key is not present.
  */
-int dict_bucket_delete(bucket_t **bucket, char *key, free_pair_t free_pair);
+bucket_t **dict_bucket_find_link(bucket_t **bucket, const char *key,
+    uint64_t key_length);
 
 /**
  * @brief This function prints the content of each linked list bucket from the
@@ -203,244 +481,3305 @@ int dict_bucket_delete(bucket_t **bucket, char *key, free_pair_t free_pair);
  */
 void dict_buckets_debug(bucket_t *const *buckets, uint64_t size);
 
-/** @endcond INTERNAL */
-
 /**
- * @brief This structure represents the state of a dict (hashmap) object. Upon
- * insertion, the string keys are hashed using Murmurhash1 algorithm. They are
- * then stored inside a linked list (bucket), inside an array (buckets).
+ * @brief Looks for the node matching the key inside the bucket.
  *
- * Upon key insertion, if the number of items is greater than half the size,
- * the buckets array is enlarged and all the key hashes are re-computed.
+ * @warning If a `NULL` pointer is passed for bucket, the function will crash.
  *
- * Upon key deletion, if the number of items is lower than the DICT_MIN_SIZE
- * value, the buckets array is reduced and all the key hashes are re-comupted.
+ * @param bucket The bucket in which to look for the key.
+ * @param key The key to look for in the bucket.
+ * @param key_length The length of the key.
+ * @return The matching node, or a `NULL` pointer if the key is not present.
+ */
+bucket_t *dict_bucket_find(bucket_t *bucket, const char *key,
+    uint64_t key_length);
+
+/**
+ * @brief The membership filter is a blocked Bloom filter placed in front of
+ * the buckets. A key only sets bits inside one 512 bits block, so answering
+ * whether a key is absent costs a single cache line, without touching the
+ * buckets array nor the linked lists.
  *
- * If a key is inserted twice, it's entry is overwritten to store the new value
- * associated to that key. If the entry value was already allocated, the memory
- * will not be released correctly, unless the programmer does it before using
- * the same key twice (or more).
+ * As a Bloom filter cannot forget a key, deleted entries are counted as stale
+ * and the filter is rebuilt once there are more stale entries than live ones.
  */
-typedef struct s_dict {
-    /** Total number of entries. */
-    uint64_t items;
+typedef struct s_dict_filter {
+    /** The raw allocation, kept to release the aligned blocks. */
+    void *memory;
 
-    /** Number of allocated buckets. */
-    uint64_t size;
+    /** The cache line aligned blocks, `DICT_FILTER_BLOCK_WORDS` words each. */
+    uint64_t *blocks;
 
-    /** Array of buckets linked list. */
-    bucket_t **buckets;
-} dict_t;
+    /** Number of blocks. Always a power of 2. */
+    uint64_t nblocks;
+
+    /** Number of bits set to 1 across all blocks. */
+    uint64_t bits_set;
+
+    /** Number of deleted keys which may still be reported as present. */
+    uint64_t stale;
+
+    /** Number of lookups which went through the filter. */
+    uint64_t lookups;
+
+    /** Number of lookups answered as misses by the filter alone. */
+    uint64_t rejects;
+
+    /** Number of lookups the filter let through but the buckets missed. */
+    uint64_t false_positives;
+} dict_filter_t;
 
 /**
- * @brief Allocates a new dict.
+ * @brief Allocates an empty membership filter sized for a buckets array.
  *
  * @note If it failed, returns a `NULL` pointer.
  *
- * @return The allocated dict.
+ * @param size The number of buckets of the dict the filter will front.
+ * @param allocator The allocator of the filter.
+ * @return The allocated filter.
  */
-dict_t *dict_ctor(void);
+dict_filter_t *dict_filter_ctor(uint64_t size,
+    const dict_allocator_t *allocator);
 
 /**
- * @brief Deallocates the dict.
- *
- * The `free_pair` function will be in charge to free the key of the pair, if
- * not constant, and the value, if not constant. If both are constant, you can
- * pass a `NULL` pointer as nothing has to be free'd.
- *
- * @warning If a `NULL` pointer is passed, or if the dict has already been
- * deallocated, the function will crash.
+ * @brief Deallocates the membership filter.
  *
- * @param dict The dict's pointer to deallocate.
- * @param free_pair The function to use to free pair, may be `NULL`.
+ * @param filter The filter to deallocate, may be a `NULL` pointer.
+ * @param allocator The allocator of the filter.
  */
-void dict_dtor(dict_t *dict, free_pair_t free_pair);
+void dict_filter_dtor(dict_filter_t *filter,
+    const dict_allocator_t *allocator);
 
 /**
- * @brief Insert an entry into the dict.
- *
- * The function allocates a new entry. If it was able to allocate AND insert
- * the entry, the function returns 0. If either one failed, it will return -1
- * and the dict is left unchanged.
- *
- * @warning If a `NULL` pointer is passed, or if the dict has been deallocated,
- * the function will crash.
- *
- * @note If the key is `NULL` some functions may break. Make sure it's not
- * before calling the function.
+ * @brief Records a key hash inside the membership filter.
  *
- * @param dict The dict in which to insert the entry.
- * @param key The key to refer to the value.
- * @param key_length The length of the key.
- * @param value The value refered at via the key.
- * @return 0 on success, -1 on error.
+ * @param filter The filter in which to record the hash.
+ * @param key_hash The hash of the key to record.
  */
-int dict_insert(dict_t *dict, char *key, uint64_t key_length, void *value);
+void dict_filter_add(dict_filter_t *filter, uint32_t key_hash);
 
 /**
- * @brief Deletes an entry from the dict.
- *
- * The function tries to delete an entry based on the given key. If the key was
- * not found, the function returns -1 as an error. If the entry is found, it's
- * key and value are given as parameter of the `free_pair` function to let the
- * programmer handle the memory release, if needed.
- *
- * @warning If `dict` or `key` is a `NULL` pointer, the function will crash.
- *
- * @note The key is not marked as const as it may get free'd by the `free_pair`
- * function, but bear in mind the current function will not modify the key.
- *
- * @note If the `free_pair` function is a `NULL` pointer, it's not called. It
- * may be useful if neither the key nor the value were allocated.
+ * @brief Returns whether a key hash may have been recorded in the filter.
  *
- * @param dict The dict from which the pair must be deleted.
- * @param key The key referring to the pair which must be deleted.
- * @param key_length The length of the key. If unknowned, use `strlen(key)`.
- * @param free_pair The function called to release key and value memory.
- * @return 0 on success, -1 on error.
+ * @param filter The filter to query.
+ * @param key_hash The hash of the key to look for.
+ * @return 0 if the key is definitely absent, 1 if it may be present.
  */
-int dict_delete(dict_t *dict, char *key, uint64_t key_length,
-    free_pair_t free_pair);
-
-/** @cond INTERNAL */
+int dict_filter_has(const dict_filter_t *filter, uint32_t key_hash);
 
 /**
- * @brief Resizes the dict.
- *
- * This process implies that all the key hashes must be recomputed. Depending
- * on both the size of the dict and the length of the keys, the runtime may be
- * slow. We will used `strlen` instead of storing the length of the key as an
- * entry member for the following reasons :
- *
- * 1. upon creation, there is a chance that the programmer already knows the
- *   length of the key, so that we don't have to use the `strlen` function. If
- *   they don't know the length of the key, they are responsible for using such
- *   function;
- *
- * 2. the resize opeartion is complitly abstract to the programmer;
- *
- * 3. dict object are pretty heavy in memory, it could be nice to save 8 bytes
- *   per key, knowning CPU can compute pretty fast, and that the `strlen`
- *   function is probably optimized;
- *
- * @warning If a `NULL` pointer is passed, or if the dict has been deallocated,
- * the function will crash.
- *
- * @note If the dict could not be resized, it's unchanged and -1 is returned.
- *
- * @param dict The dict to resize.
- * @return 0 on success, -1 on error.
+ * @brief The cache mode state. When enabled, the dict is bounded by a maximum
+ * number of entries and/or a memory budget, and `dict_insert` evicts entries
+ * to make room for new ones.
+ *
+ * Eviction follows the CLOCK policy : the hand sweeps the buckets in order,
+ * clearing the `DICT_BUCKET_REFERENCED` bit of the entries it passes, and
+ * evicts the first entry found without it. The bit lives inside the entry, so
+ * that no extra list has to be allocated nor maintained.
  */
-int dict_resize(dict_t *dict);
+typedef struct s_dict_cache {
+    /** Maximum number of entries, 0 when unbounded. */
+    uint64_t max_items;
 
-/** @endcond */
+    /** Maximum number of bytes charged by the entries, 0 when unbounded. */
+    uint64_t max_bytes;
 
-/**
- * @brief This structure represents the keys of the dict. It will be computed
+    /** Number of bytes currently charged by the entries. */
+    uint64_t bytes;
+
+    /** Index of the bucket the CLOCK hand points at. */
+    uint64_t hand;
+
+    /** Number of entries evicted so far. */
+    uint64_t evictions;
+
+    /** The function used to release evicted pairs, may be `NULL`. */
+    free_pair_t free_pair;
+
+    /** The function used to charge the pairs, may be `NULL`. */
+    size_pair_t size_pair;
+} dict_cache_t;
+
+/**
+ * @brief The expiry state. When enabled, entries may be given a time to live.
+ * Expired entries are treated as absent by lookups and removed lazily when
+ * met, while `dict_expire_step` sweeps a bounded number of buckets per call.
+ */
+typedef struct s_dict_expiry {
+    /** The function returning the current date. */
+    dict_clock_t clock;
+
+    /** The function used to release expired pairs, may be `NULL`. */
+    free_pair_t free_pair;
+
+    /** Index of the next bucket `dict_expire_step` will sweep. */
+    uint64_t cursor;
+
+    /** Number of entries expired so far. */
+    uint64_t expired;
+} dict_expiry_t;
+
+/**
+ * @brief A snapshot of a buckets array shared by a dict and its clones.
+ *
+ * Upon `dict_clone`, the buckets array of the dict is frozen into a snapshot
+ * that both dicts read from. The first write of a dict copies the array of
+ * pointers and marks every bucket as shared in its copy-on-write bitmap. Each
+ * shared bucket is then copied the first time the dict modifies it, so the
+ * frozen nodes are never modified nor released by any of the dicts.
+ *
+ * The snapshot is released, along with its nodes and pairs, once the last
+ * dict referring to it is deallocated.
+ */
+typedef struct s_dict_shared {
+    /** Number of dicts and snapshots referring to this snapshot. */
+    uint64_t refs;
+
+    /** Number of buckets of the frozen array. */
+    uint64_t size;
+
+    /** The frozen buckets array. */
+    bucket_t **buckets;
+
+    /** Buckets still owned by the parent snapshot, `NULL` if none. */
+    uint64_t *cow_bits;
+
+    /** The snapshot this one was copied from, `NULL` pointer if none. */
+    struct s_dict_shared *parent;
+
+    /** The packs the frozen nodes may live in, `NULL` pointer if none. */
+    struct s_dict_pack *packs;
+} dict_shared_t;
+
+/**
+ * @brief A file mapped by `dict_load_file`. The keys loaded from the file are
+ * borrowed from the mapping, so it must stay alive as long as a dict refers to
+ * it. Mappings form a reference counted list, shared with the clones.
+ */
+typedef struct s_dict_mapping {
+    /** Number of dicts and mappings referring to this mapping. */
+    uint64_t refs;
+
+    /** The address of the mapping. */
+    void *address;
+
+    /** The length of the mapping. */
+    uint64_t length;
+
+    /** The mapping loaded before this one, `NULL` pointer if none. */
+    struct s_dict_mapping *next;
+} dict_mapping_t;
+
+/**
+ * @brief A contiguous block of nodes filled by `dict_compact`, in buckets
+ * order. Packs form a reference counted list, shared with the clones, as the
+ * nodes of a snapshot may live in them.
+ */
+typedef struct s_dict_pack {
+    /** Number of dicts and packs referring to this pack. */
+    uint64_t refs;
+
+    /** The size of the pack allocation, in bytes. */
+    uint64_t bytes;
+
+    /** The pack allocated before this one, `NULL` pointer if none. */
+    struct s_dict_pack *next;
+
+    /** The nodes, followed by their inline value storage, if any. */
+    bucket_t nodes[];
+} dict_pack_t;
+
+/**
+ * @brief The progress of an incremental `dict_compact` pass.
+ */
+typedef struct s_dict_compaction {
+    /** The next bucket to compact. */
+    uint64_t cursor;
+
+    /** The number of buckets when the pass started, a resize restarts it. */
+    uint64_t size;
+
+    /**
+     * The newest pack allocated before the pass, released along with the
+     * older ones once the pass is over.
+     */
+    dict_pack_t *retired;
+
+    /**
+     * Whether a bucket shared with a clone was skipped, in which case the
+     * older packs are kept.
+     */
+    int skipped;
+} dict_compaction_t;
+
+/**
+ * @brief The magic number opening a trace file, followed by its mode on 4
+ * bytes, see `dict_trace_start`.
+ */
+#define DICT_TRACE_MAGIC "DICTTRC1"
+
+/**
+ * @brief The size of the header of a trace file : the magic number, the mode
+ * and 4 reserved bytes.
+ */
+#define DICT_TRACE_HEADER 16
+
+/**
+ * @brief The number of bytes of records buffered before they are written.
+ */
+#define DICT_TRACE_BUFFER (1 << 16)
+
+/**
+ * @brief The largest size of a record, the key bytes apart : its operation,
+ * the varint of its timestamp delta, the varint of its key length and the
+ * hash of the key.
+ */
+#define DICT_TRACE_RECORD_MAX (1 + 10 + 10 + 4)
+
+/**
+ * @brief The bit set on the operation of a record when the call failed, e.g.
+ * a lookup miss.
+ */
+#define DICT_TRACE_FAILED 0x80
+
+/**
+ * @brief The state of a trace recorder, see `dict_trace_start`.
+ */
+typedef struct s_dict_trace {
+    /** The trace file. */
+    int fd;
+
+    /** Whether the key bytes or their hashes are recorded. */
+    int mode;
+
+    /** The seed of the key hashes, never written to the trace. */
+    uint32_t seed;
+
+    /** Whether a write failed, in which case recording stopped. */
+    int failed;
+
+    /** The date of the previous record, in nanoseconds. */
+    uint64_t last;
+
+    /** The number of records. */
+    uint64_t records;
+
+    /** The records not written yet. */
+    char *buffer;
+
+    /** The number of bytes in the buffer. */
+    uint64_t buffered;
+
+    /** The size of the buffer. */
+    uint64_t capacity;
+} dict_trace_t;
+
+/**
+ * @brief The number of bytes of its compressed path an ordered index node
+ * stores. The longer paths are compared against a key of the subtree.
+ */
+#define DICT_INDEX_PREFIX 13
+
+/**
+ * @brief The kinds of ordered index nodes, by number of children.
+ */
+#define DICT_INDEX_NODE4 0
+#define DICT_INDEX_NODE16 1
+#define DICT_INDEX_NODE48 2
+#define DICT_INDEX_NODE256 3
+
+/**
+ * @brief Returns whether a child of an ordered index node is a leaf. Leaves
+ * are tagged by their lowest pointer bit, the allocations being aligned.
+ *
+ * @param P The child to check.
+ */
+#define DICT_INDEX_IS_LEAF(P) (1 & (uintptr_t) (P))
+
+/**
+ * @brief Returns the leaf a tagged child points to.
+ *
+ * @param P The tagged child.
+ */
+#define DICT_INDEX_LEAF(P) \
+    ((dict_index_leaf_t *) ((uintptr_t) (P) & ~(uintptr_t) 1))
+
+/**
+ * @brief Returns the tagged child pointing to a leaf.
+ *
+ * @param L The leaf to tag.
+ */
+#define DICT_INDEX_TAG(L) ((void *) ((uintptr_t) (L) | 1))
+
+/**
+ * @brief Returns the size of an ordered index node of the given kind.
+ *
+ * @param T The kind of node, `DICT_INDEX_NODE4` to `DICT_INDEX_NODE256`.
+ */
+#define DICT_INDEX_NODE_SIZE(T) (DICT_INDEX_NODE4 == (T) ? \
+    sizeof(dict_index_node4_t) : DICT_INDEX_NODE16 == (T) ? \
+    sizeof(dict_index_node16_t) : DICT_INDEX_NODE48 == (T) ? \
+    sizeof(dict_index_node48_t) : sizeof(dict_index_node256_t))
+
+/**
+ * @brief A key of the ordered index. The key is the one of the dict entry,
+ * whose memory does not move when the dict resizes or compacts its nodes.
+ */
+typedef struct s_dict_index_leaf {
+    /** The key of the entry. */
+    const char *key;
+
+    /** The length of the key. */
+    uint64_t key_length;
+} dict_index_leaf_t;
+
+/**
+ * @brief The header of the nodes of the ordered index, an adaptive radix tree.
+ * A node consumes the bytes of its compressed path, then one byte per child.
+ */
+typedef struct s_dict_index_node {
+    /** The key ending at this node, `NULL` pointer if none. */
+    dict_index_leaf_t *leaf;
+
+    /** The length of the compressed path. */
+    uint64_t prefix_length;
+
+    /** The number of children. */
+    uint16_t children;
+
+    /** The kind of node, `DICT_INDEX_NODE4` to `DICT_INDEX_NODE256`. */
+    uint8_t type;
+
+    /** The first bytes of the compressed path. */
+    unsigned char prefix[DICT_INDEX_PREFIX];
+} dict_index_node_t;
+
+/**
+ * @brief A node of up to 4 children, whose bytes are kept sorted.
+ */
+typedef struct s_dict_index_node4 {
+    dict_index_node_t node;
+    unsigned char keys[4];
+    void *children[4];
+} dict_index_node4_t;
+
+/**
+ * @brief A node of up to 16 children, whose bytes are kept sorted.
+ */
+typedef struct s_dict_index_node16 {
+    dict_index_node_t node;
+    unsigned char keys[16];
+    void *children[16];
+} dict_index_node16_t;
+
+/**
+ * @brief A node of up to 48 children, indexed by byte through `slots`, which
+ * holds the position of the child plus 1, or 0.
+ */
+typedef struct s_dict_index_node48 {
+    dict_index_node_t node;
+    unsigned char slots[256];
+    void *children[48];
+} dict_index_node48_t;
+
+/**
+ * @brief A node of up to 256 children, indexed by byte.
+ */
+typedef struct s_dict_index_node256 {
+    dict_index_node_t node;
+    void *children[256];
+} dict_index_node256_t;
+
+/**
+ * @brief The state of the ordered index of a dict, see `dict_enable_index`.
+ */
+typedef struct s_dict_index {
+    /** The root of the tree, a node, a tagged leaf or a `NULL` pointer. */
+    void *root;
+
+    /** The number of keys. */
+    uint64_t items;
+
+    /** The memory held by the nodes and the leaves, in bytes. */
+    uint64_t bytes;
+
+    /** The allocator of the nodes and the leaves, the one of the dict. */
+    dict_allocator_t allocator;
+} dict_index_t;
+
+/** @endcond INTERNAL */
+
+/**
+ * @brief This structure represents the state of a dict (hashmap) object. Upon
+ * insertion, the string keys are hashed using Murmurhash1 algorithm. They are
+ * then stored inside a linked list (bucket), inside an array (buckets).
+ *
+ * Upon key insertion, if the number of items is greater than half the size,
+ * the buckets array is enlarged and all the key hashes are re-computed.
+ *
+ * Upon key deletion, if the number of items is lower than the DICT_MIN_SIZE
+ * value, the buckets array is reduced and all the key hashes are re-comupted.
+ *
+ * If a key is inserted twice, it's entry is overwritten to store the new value
+ * associated to that key. If the entry value was already allocated, the memory
+ * will not be released correctly, unless the programmer does it before using
+ * the same key twice (or more).
+ */
+typedef struct s_dict {
+    /** Total number of entries. */
+    uint64_t items;
+
+    /** Number of allocated buckets. */
+    uint64_t size;
+
+    /** Array of buckets linked list. */
+    bucket_t **buckets;
+
+    /** Optional membership filter, `NULL` pointer when disabled. */
+    dict_filter_t *filter;
+
+    /** Optional cache mode state, `NULL` pointer when disabled. */
+    dict_cache_t *cache;
+
+    /** Optional expiry state, `NULL` pointer when disabled. */
+    dict_expiry_t *expiry;
+
+    /** Snapshot shared with clones, `NULL` pointer if never cloned. */
+    dict_shared_t *shared;
+
+    /** Buckets still shared with the snapshot, `NULL` if none. */
+    uint64_t *cow_bits;
+
+    /** Number of buckets copied from the snapshot so far. */
+    uint64_t cow_copies;
+
+    /** Files mapped by `dict_load_file`, `NULL` pointer if none. */
+    dict_mapping_t *mappings;
+
+    /** Packs filled by `dict_compact`, `NULL` pointer if none. */
+    dict_pack_t *packs;
+
+    /** The running `dict_compact` pass, `NULL` pointer if none. */
+    dict_compaction_t *compaction;
+
+    /** The trace recorder, `NULL` pointer when not recording. */
+    dict_trace_t *trace;
+
+    /** Optional ordered index, `NULL` pointer when disabled. */
+    dict_index_t *index;
+
+    /** The allocator of every internal allocation. */
+    dict_allocator_t allocator;
+
+    /** The seed the keys are hashed with, `HASH_SEED` by default. */
+    uint32_t seed;
+
+    /**
+     * The size of the values copied into the nodes, 0 if the values are
+     * pointers stored as is, see `dict_ctor_with_value_size`.
+     */
+    uint64_t value_size;
+
+    /**
+     * The size of the expiry date stored after the value of each node, 0
+     * until `dict_enable_expiry` is first called.
+     */
+    uint64_t expiry_size;
+} dict_t;
+
+/**
+ * @brief Allocates a new dict.
+ *
+ * @note If it failed, returns a `NULL` pointer.
+ *
+ * @return The allocated dict.
+ */
+dict_t *dict_ctor(void);
+
+/**
+ * @brief Allocates a new dict whose internal allocations, the dict itself
+ * included, all go through `allocator`. The allocator is copied, and so it is
+ * by the clones of the dict, but its context must outlive them.
+ *
+ * @note If it failed, returns a `NULL` pointer.
+ *
+ * @param allocator The allocator to use, `NULL` pointer for the standard one.
+ * @return The allocated dict.
+ */
+dict_t *dict_ctor_with_allocator(const dict_allocator_t *allocator);
+
+/**
+ * @brief Allocates a new dict storing its values inline : each value is
+ * copied into the node of its entry, rather than being a pointer to memory
+ * allocated by the caller. This saves an allocation per entry, and reading a
+ * value no longer jumps to another cache line.
+ *
+ * The `value` given to the insertion functions is then the address of the
+ * `value_size` bytes to copy, a `NULL` pointer for zeroed bytes. The values
+ * returned by the lookups, the slots of `dict_entry` and the values given to
+ * `free_pair` or the other callbacks point to the inline storage, aligned on
+ * 8 bytes. It's valid until the entry is removed or the dict compacted, and
+ * must not be released : `free_pair` may only release what the value refers
+ * to.
+ *
+ * @note If it failed, returns a `NULL` pointer.
+ *
+ * @param value_size The size of the values, in bytes.
+ * @return The allocated dict.
+ */
+dict_t *dict_ctor_with_value_size(uint64_t value_size);
+
+/**
+ * @brief Returns the allocator wrapping `malloc`, `realloc` and `free`, used
+ * by `dict_ctor`.
+ *
+ * @return The standard allocator.
+ */
+const dict_allocator_t *dict_std_allocator(void);
+
+/**
+ * @brief A chunk of memory of an arena allocator.
+ */
+typedef struct s_dict_arena_chunk {
+    /** The chunk allocated before this one, `NULL` pointer if none. */
+    struct s_dict_arena_chunk *next;
+
+    /** The number of bytes of `data`. */
+    size_t size;
+
+    /** The number of bytes of `data` handed out so far. */
+    size_t used;
+
+    /** The memory handed out by the arena. */
+    unsigned char *data;
+} dict_arena_chunk_t;
+
+/**
+ * @brief This structure represents a bump allocator: allocations are carved
+ * out of large chunks and are never released one by one, the whole arena being
+ * released at once. It suits request-scoped dicts, which do not even have to be
+ * destroyed when the arena is (unless they loaded files).
+ */
+typedef struct s_dict_arena {
+    /** The chunk allocations are carved from, `NULL` pointer if none. */
+    dict_arena_chunk_t *chunks;
+
+    /** The minimum size of a chunk. */
+    size_t chunk_size;
+
+    /** The number of bytes handed out so far. */
+    size_t allocated;
+} dict_arena_t;
+
+/**
+ * @brief Allocates a new arena.
+ *
+ * @note If it failed, returns a `NULL` pointer.
+ *
+ * @param chunk_size The minimum size of the chunks, 0 for the default one.
+ * @return The allocated arena.
+ */
+dict_arena_t *dict_arena_ctor(size_t chunk_size);
+
+/**
+ * @brief Deallocates the arena and every allocation made from it.
+ *
+ * @param arena The arena to deallocate.
+ */
+void dict_arena_dtor(dict_arena_t *arena);
+
+/**
+ * @brief The huge page size the large arrays are aligned and rounded to.
+ */
+#define DICT_HUGE_PAGE_SIZE ((size_t) 2 << 20)
+
+/**
+ * @brief Leaves the large arrays on the default NUMA policy of the process.
+ */
+#define DICT_NUMA_DEFAULT 0
+
+/**
+ * @brief Interleaves the pages of the large arrays across the NUMA nodes.
+ */
+#define DICT_NUMA_INTERLEAVE 1
+
+/**
+ * @brief Binds the pages of the large arrays to the NUMA nodes.
+ */
+#define DICT_NUMA_BIND 2
+
+/**
+ * @brief This structure represents the placement of the large arrays of an
+ * allocator made by `dict_huge_allocator`, along with its counters.
+ *
+ * Arrays of at least `threshold` bytes are mapped apart, aligned on huge page
+ * boundaries and advised to use transparent huge pages, so that random lookups
+ * across the buckets array miss the TLB less often. Their pages may also be
+ * interleaved across or bound to NUMA nodes. Whatever the kernel does not
+ * support is skipped and counted, the array remaining usable.
+ */
+typedef struct s_dict_huge_pages {
+    /** Minimum size of a mapped array, 0 for `DICT_HUGE_PAGE_SIZE`. */
+    size_t threshold;
+
+    /** Whether to fault the mapped arrays in once placed. */
+    int populate;
+
+    /** One of the `DICT_NUMA_*` policies. */
+    int numa_policy;
+
+    /** Mask of the NUMA nodes of the policy, bit N standing for node N. */
+    uint64_t numa_nodes;
+
+    /** Number of arrays mapped so far. */
+    uint64_t mapped;
+
+    /** Number of arrays the kernel refused to back with huge pages. */
+    uint64_t huge_page_failures;
+
+    /** Number of arrays the kernel refused to apply the NUMA policy to. */
+    uint64_t numa_failures;
+} dict_huge_pages_t;
+
+/**
+ * @brief Fills an allocator using the standard library for its small
+ * allocations, and mapping its large arrays according to `huge`, which must
+ * outlive the dicts using the allocator.
+ *
+ * @param huge The placement of the large arrays, receiving the counters.
+ * @param allocator The allocator to fill.
+ */
+void dict_huge_allocator(dict_huge_pages_t *huge,
+    dict_allocator_t *allocator);
+
+/**
+ * @brief Fills an allocator allocating from the arena. Its `release` function
+ * does nothing, and its `reallocate` function grows the last allocation in
+ * place when possible.
+ *
+ * @param arena The arena to allocate from.
+ * @param allocator The allocator to fill.
+ */
+void dict_arena_allocator(dict_arena_t *arena, dict_allocator_t *allocator);
+
+/**
+ * @brief Deallocates the dict.
+ *
+ * The `free_pair` function will be in charge to free the key of the pair, if
+ * not constant, and the value, if not constant. If both are constant, you can
+ * pass a `NULL` pointer as nothing has to be free'd.
+ *
+ * @warning If a `NULL` pointer is passed, or if the dict has already been
+ * deallocated, the function will crash.
+ *
+ * @param dict The dict's pointer to deallocate.
+ * @param free_pair The function to use to free pair, may be `NULL`.
+ */
+void dict_dtor(dict_t *dict, free_pair_t free_pair);
+
+/**
+ * @brief Insert an entry into the dict.
+ *
+ * The function allocates a new entry. If it was able to allocate AND insert
+ * the entry, the function returns 0. If either one failed, it will return -1
+ * and the dict is left unchanged.
+ *
+ * @warning If a `NULL` pointer is passed, or if the dict has been deallocated,
+ * the function will crash.
+ *
+ * @note If the key is `NULL` some functions may break. Make sure it's not
+ * before calling the function.
+ *
+ * @param dict The dict in which to insert the entry.
+ * @param key The key to refer to the value.
+ * @param key_length The length of the key.
+ * @param value The value refered at via the key.
+ * @return 0 on success, -1 on error.
+ */
+int dict_insert(dict_t *dict, char *key, uint64_t key_length, void *value);
+
+/**
+ * @brief Returns the value slot of the key, inserting the key with a `NULL`
+ * value if it is missing. The key is hashed once and its bucket walked once,
+ * so that read-modify-write code does not have to look the key up, delete it
+ * and insert it again.
+ *
+ * The key is only kept by the dict when `*inserted` is set to 1. Otherwise
+ * the entry already holds its own key, and `key` still belongs to the caller.
+ *
+ * @warning The slot is only valid until the dict is next modified.
+ *
+ * @note Cache mode dicts measuring their pairs with `size_pair` are not
+ * supported, as the value is written after the entry has been charged.
+ *
+ * @note The dicts storing their values inline are not supported, as writing
+ * the slot would replace the address of the storage, see `dict_entry_inline`.
+ *
+ * @note On a clone, the slot of an entry still shared with the snapshot holds
+ * the value of the snapshot. Whatever the slot holds is then released with
+ * the clone entry, so that value must be replaced, not kept, see
+ * `DICT_BUCKET_OWNS_VALUE`.
+ *
+ * @param dict The dict holding the entry.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param inserted Set to 1 if the entry was inserted, 0 if it already existed,
+ * may be `NULL`.
+ * @return The address of the entry value on success, `NULL` pointer on error.
+ */
+void **dict_entry(dict_t *dict, char *key, uint64_t key_length,
+    int *inserted);
+
+/**
+ * @brief Same as `dict_entry`, for the dicts storing their values inline :
+ * returns the storage of the value of the key, inserting the key with zeroed
+ * storage if it is missing.
+ *
+ * @warning The storage is only valid until the dict is next modified.
+ *
+ * @param dict The dict holding the entry, see `dict_ctor_with_value_size`.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param inserted Set to 1 if the entry was inserted, 0 if it already existed,
+ * may be `NULL`.
+ * @return The `value_size` bytes of storage of the entry on success, `NULL`
+ * pointer on error or if the dict does not store its values inline.
+ */
+void *dict_entry_inline(dict_t *dict, char *key, uint64_t key_length,
+    int *inserted);
+
+/**
+ * @brief Deletes an entry from the dict.
+ *
+ * The function tries to delete an entry based on the given key. If the key was
+ * not found, the function returns -1 as an error. If the entry is found, it's
+ * key and value are given as parameter of the `free_pair` function to let the
+ * programmer handle the memory release, if needed.
+ *
+ * @warning If `dict` or `key` is a `NULL` pointer, the function will crash.
+ *
+ * @note The key is not marked as const as it may get free'd by the `free_pair`
+ * function, but bear in mind the current function will not modify the key.
+ *
+ * @note If the `free_pair` function is a `NULL` pointer, it's not called. It
+ * may be useful if neither the key nor the value were allocated.
+ *
+ * @param dict The dict from which the pair must be deleted.
+ * @param key The key referring to the pair which must be deleted.
+ * @param key_length The length of the key. If unknowned, use `strlen(key)`.
+ * @param free_pair The function called to release key and value memory.
+ * @return 0 on success, -1 on error.
+ */
+int dict_delete(dict_t *dict, char *key, uint64_t key_length,
+    free_pair_t free_pair);
+
+/**
+ * @brief Makes room for `count` more entries, so that inserting them does not
+ * resize the dict on the way.
+ *
+ * @note If the dict is already large enough, it's unchanged and 0 is returned.
+ *
+ * @param dict The dict in which the entries will be inserted.
+ * @param count The number of entries about to be inserted.
+ * @return 0 on success, -1 on error.
+ */
+int dict_reserve(dict_t *dict, uint64_t count);
+
+/**
+ * @brief Moves the nodes of the dict into contiguous packs, in buckets order,
+ * so that the lookups and the scans of a dict fragmented by insertions and
+ * deletions walk neighbouring memory again. The packs left behind by the
+ * previous pass are released once the new pass is over.
+ *
+ * With a budget, a pass is done incrementally, each call moving the nodes of
+ * the next buckets, up to `budget` nodes (a bucket is never split). The pass
+ * is over once `dict->compaction` is back to a `NULL` pointer.
+ *
+ * @note The keys and values are borrowed by the dict, so only the nodes move.
+ * The buckets still shared with a clone are skipped. The value slots returned
+ * by `dict_entry` are invalidated.
+ *
+ * @param dict The dict to compact.
+ * @param budget The maximum number of nodes to move, 0 for a whole pass.
+ * @return The number of bytes released to the allocator on success, -1 on
+ * error.
+ */
+int64_t dict_compact(dict_t *dict, uint64_t budget);
+
+/**
+ * @brief Looks for the value referred at via the key.
+ *
+ * If the membership filter is enabled and rejects the key, the buckets are not
+ * read at all. If the expiry is enabled and the entry has expired, it's
+ * removed and reported as absent.
+ *
+ * @warning If `dict` or `key` is a `NULL` pointer, the function will crash.
+ *
+ * @param dict The dict in which to look for the key.
+ * @param key The key referring to the value.
+ * @param key_length The length of the key. If unknowned, use `strlen(key)`.
+ * @param value Where to store the value if found, may be `NULL`.
+ * @return 0 if the key was found, -1 otherwise.
+ */
+int dict_get(dict_t *dict, const char *key, uint64_t key_length,
+    void **value);
+
+/**
+ * @brief Returns whether a key is present in the dict.
+ *
+ * @warning If `dict` or `key` is a `NULL` pointer, the function will crash.
+ *
+ * @param dict The dict in which to look for the key.
+ * @param key The key to look for.
+ * @param key_length The length of the key. If unknowned, use `strlen(key)`.
+ * @return 1 if present, 0 if not present.
+ */
+int dict_has_key(dict_t *dict, const char *key, uint64_t key_length);
+
+/**
+ * @brief Hashes a key the way the dict does, so that a key looked up in
+ * several dicts is only hashed once, see the `*_hashed` functions. The hash
+ * can be used with every dict sharing the seed of `dict`.
+ *
+ * @param dict The dict whose seed to use.
+ * @param key The key to hash.
+ * @param key_length The length of the key.
+ * @return The hash of the key.
+ */
+dict_hash_t dict_hash_key(const dict_t *dict, const char *key,
+    uint64_t key_length);
+
+/**
+ * @brief Same as `dict_hash_key`, for a batch of keys. The keys are hashed
+ * several at once in the SIMD lanes of the CPU when it has some, with the
+ * same results as `dict_hash_key`.
+ *
+ * @param dict The dict whose seed to use.
+ * @param keys The keys to hash.
+ * @param lengths The length of each key.
+ * @param count The number of keys.
+ * @param hashes Where to store the `count` hashes.
+ */
+void dict_hash_keys(const dict_t *dict, const char *const *keys,
+    const uint64_t *lengths, uint64_t count, dict_hash_t *hashes);
+
+/**
+ * @brief Changes the seed the keys of the dict are hashed with. Dicts given
+ * distinct seeds do not accept each others hashes.
+ *
+ * @param dict The dict whose seed to change, which must be empty.
+ * @param seed The new seed.
+ * @return 0 on success, -1 if the dict is not empty or on error.
+ */
+int dict_set_seed(dict_t *dict, uint32_t seed);
+
+/**
+ * @brief Same as `dict_insert`, with the precomputed hash of the key.
+ *
+ * @param dict The dict in which to insert the entry.
+ * @param key The key to refer to the value.
+ * @param key_length The length of the key.
+ * @param key_hash The hash of the key, see `dict_hash_key`.
+ * @param value The value refered at via the key.
+ * @return 0 on success, -1 on error or if the hash was computed with another
+ * seed.
+ */
+int dict_insert_hashed(dict_t *dict, char *key, uint64_t key_length,
+    dict_hash_t key_hash, void *value);
+
+/**
+ * @brief Same as `dict_entry`, with the precomputed hash of the key.
+ *
+ * @param dict The dict holding the entry.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param key_hash The hash of the key, see `dict_hash_key`.
+ * @param inserted Set to 1 if the entry was inserted, 0 otherwise, may be
+ * `NULL`.
+ * @return The address of the entry value on success, `NULL` pointer on error
+ * or if the hash was computed with another seed.
+ */
+void **dict_entry_hashed(dict_t *dict, char *key, uint64_t key_length,
+    dict_hash_t key_hash, int *inserted);
+
+/**
+ * @brief Same as `dict_entry_inline`, with the precomputed hash of the key.
+ *
+ * @param dict The dict holding the entry.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param key_hash The hash of the key, see `dict_hash_key`.
+ * @param inserted Set to 1 if the entry was inserted, 0 otherwise, may be
+ * `NULL`.
+ * @return The storage of the entry value on success, `NULL` pointer on error,
+ * if the dict does not store its values inline or if the hash was computed
+ * with another seed.
+ */
+void *dict_entry_inline_hashed(dict_t *dict, char *key, uint64_t key_length,
+    dict_hash_t key_hash, int *inserted);
+
+/**
+ * @brief Same as `dict_delete`, with the precomputed hash of the key.
+ *
+ * @param dict The dict from which to delete the entry.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param key_hash The hash of the key, see `dict_hash_key`.
+ * @param free_pair The function to use to free the pair, may be `NULL`.
+ * @return 0 on success, -1 on error or if the hash was computed with another
+ * seed.
+ */
+int dict_delete_hashed(dict_t *dict, char *key, uint64_t key_length,
+    dict_hash_t key_hash, free_pair_t free_pair);
+
+/**
+ * @brief Same as `dict_get`, with the precomputed hash of the key.
+ *
+ * @param dict The dict in which to look for the key.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param key_hash The hash of the key, see `dict_hash_key`.
+ * @param value Where to store the value, may be `NULL`.
+ * @return 0 on success, -1 if the key was not found or if the hash was
+ * computed with another seed.
+ */
+int dict_get_hashed(dict_t *dict, const char *key, uint64_t key_length,
+    dict_hash_t key_hash, void **value);
+
+/**
+ * @brief Same as `dict_has_key`, with the precomputed hash of the key.
+ *
+ * @param dict The dict in which to look for the key.
+ * @param key The key to look for.
+ * @param key_length The length of the key.
+ * @param key_hash The hash of the key, see `dict_hash_key`.
+ * @return 1 if the key was found, 0 otherwise.
+ */
+int dict_has_key_hashed(dict_t *dict, const char *key, uint64_t key_length,
+    dict_hash_t key_hash);
+
+/**
+ * @brief Adds `delta` to the count of the key, inserting the key with a count
+ * of `delta` if it is missing. The counts are `uint64_t` stored inline, so the
+ * dict must be built by `dict_ctor_with_value_size(sizeof(uint64_t))`, and
+ * `dict_get` returns the address of the count.
+ *
+ * The key is hashed once and its bucket walked once. It's only kept by the
+ * dict when `*inserted` is set to 1, and then it must outlive the entry, like
+ * with `dict_insert`. Otherwise `key` still belongs to the caller.
+ *
+ * @param dict The counting dict.
+ * @param key The key to count.
+ * @param key_length The length of the key.
+ * @param delta The value added to the count.
+ * @param inserted Set to 1 if the key was inserted, 0 if it was already
+ * counted, may be `NULL`.
+ * @return 0 on success, -1 on error or if the values are too small to hold a
+ * count.
+ */
+int dict_incr(dict_t *dict, char *key, uint64_t key_length, uint64_t delta,
+    int *inserted);
+
+/**
+ * @brief Same as `dict_incr`, with the precomputed hash of the key.
+ *
+ * @param dict The counting dict.
+ * @param key The key to count.
+ * @param key_length The length of the key.
+ * @param key_hash The hash of the key, see `dict_hash_key`.
+ * @param delta The value added to the count.
+ * @param inserted Set to 1 if the key was inserted, 0 otherwise, may be
+ * `NULL`.
+ * @return 0 on success, -1 on error, if the values are too small to hold a
+ * count or if the hash was computed with another seed.
+ */
+int dict_incr_hashed(dict_t *dict, char *key, uint64_t key_length,
+    dict_hash_t key_hash, uint64_t delta, int *inserted);
+
+/**
+ * @brief Same as `dict_incr`, for a batch of keys, a key appearing as many
+ * times as it's counted. The keys are hashed `DICT_INCR_BATCH` at a time,
+ * see `dict_hash_keys`, and their buckets prefetched before being counted.
+ *
+ * @param dict The counting dict.
+ * @param keys The keys to count.
+ * @param lengths The length of each key.
+ * @param count The number of keys.
+ * @param delta The value added to the count of each key.
+ * @param inserted Where to store, for each key, 1 if it was inserted and is
+ * now kept by the dict, 0 otherwise, `count` flags, may be `NULL`.
+ * @return 0 on success, -1 on error, in which case the keys preceding the
+ * failing one have been counted.
+ */
+int dict_incr_many(dict_t *dict, char *const *keys, const uint64_t *lengths,
+    uint64_t count, uint64_t delta, int *inserted);
+
+/**
+ * @brief Adds the counts of a counting dict to another one, typically the
+ * partial counts of a thread into the total counts. The keys missing from
+ * `dict` are inserted with the key of their partial entry, which must then
+ * outlive both dicts.
+ *
+ * @param dict The counting dict receiving the counts.
+ * @param partial The counting dict whose counts to add, unchanged.
+ * @return 0 on success, -1 on error.
+ */
+int dict_incr_merge(dict_t *dict, const dict_t *partial);
+
+/**
+ * @brief Same as `dict_incr_many`, the keys being split across `threads`
+ * threads. Each thread counts its share into a partial dict of its own, with
+ * no locking, and the partial dicts are then merged into `dict`, in order.
+ * The partial dicts use the standard allocator.
+ *
+ * @param dict The counting dict.
+ * @param keys The keys to count.
+ * @param lengths The length of each key.
+ * @param count The number of keys.
+ * @param threads The number of threads, 0 or 1 to count in the calling
+ * thread.
+ * @param inserted Where to store, for each key, 1 if it was inserted and is
+ * now kept by the dict, 0 otherwise, `count` flags, may be `NULL`.
+ * @return 0 on success, -1 on error, in which case `dict` holds an unknown
+ * part of the counts, and `inserted` unknown flags.
+ */
+int dict_incr_parallel(dict_t *dict, char *const *keys,
+    const uint64_t *lengths, uint64_t count, uint64_t threads, int *inserted);
+
+/**
+ * @brief Calls `function` on every entry of the dict, across `threads`
+ * threads. The buckets are split into chunks of `DICT_PARALLEL_CHUNK`, dealt
+ * evenly to the threads, and a thread running out of chunks steals half of
+ * the chunks left to another one, so that uneven chains balance out. The
+ * calling thread takes part in the walk.
+ *
+ * @warning The dict must not be modified until the function returns.
+ *
+ * @note If the threads cannot be started, the remaining chunks are walked by
+ * the other threads, down to the calling thread alone.
+ *
+ * @param dict The dict to walk.
+ * @param function The function called on each entry.
+ * @param ctx The context given to `function`.
+ * @param threads The number of threads, 0 or 1 to walk the dict in the
+ * calling thread.
+ */
+void dict_parallel_foreach(const dict_t *dict, foreach_pair_t function,
+    void *ctx, uint64_t threads);
+
+/**
+ * @brief Same as `dict_parallel_foreach`, the entries being folded into an
+ * accumulator per chunk of `DICT_PARALLEL_CHUNK` buckets, with no locking.
+ * The accumulators start as copies of `acc`, which must hold the identity of
+ * `merge`, and are then merged into `acc` in chunk order. Whichever thread
+ * walks a chunk, the entries are folded and merged in the same order, so the
+ * result depends neither on the scheduling nor on the number of threads, and
+ * `merge` only has to be associative, not commutative.
+ *
+ * @param dict The dict to walk.
+ * @param reduce The function folding an entry into an accumulator.
+ * @param merge The function folding an accumulator into `acc`.
+ * @param acc The accumulator, holding the identity on entry and the result
+ * on return.
+ * @param acc_size The size of the accumulator, in bytes.
+ * @param ctx The context given to `reduce` and `merge`.
+ * @param threads The number of threads, 0 or 1 to walk the dict in the
+ * calling thread.
+ * @return 0 on success, -1 on error, in which case `acc` is unchanged.
+ */
+int dict_parallel_reduce(const dict_t *dict, reduce_pair_t reduce,
+    merge_acc_t merge, void *acc, uint64_t acc_size, void *ctx,
+    uint64_t threads);
+
+/**
+ * @brief Enables the membership filter in front of the buckets.
+ *
+ * The filter is built from the entries already present, then kept up to date
+ * by `dict_insert`, `dict_delete` and `dict_resize`. It is worth enabling when
+ * most lookups are misses, as a miss is then answered from one cache line.
+ *
+ * @note If the filter is already enabled, nothing is done and 0 is returned.
+ *
+ * @param dict The dict on which to enable the filter.
+ * @return 0 on success, -1 on error.
+ */
+int dict_enable_filter(dict_t *dict);
+
+/**
+ * @brief Disables and releases the membership filter, if any.
+ *
+ * @param dict The dict on which to disable the filter.
+ */
+void dict_disable_filter(dict_t *dict);
+
+/**
+ * @brief Turns the dict into a bounded cache.
+ *
+ * Once enabled, `dict_insert` evicts entries until the new one fits within
+ * both bounds, releasing them with `free_pair`. Entries looked up through
+ * `dict_get` since the last pass of the CLOCK hand are spared once. The
+ * entries a clone still shares with its snapshot are not marked by its
+ * lookups, so that they don't change the eviction order of the other dicts.
+ *
+ * If `size_pair` is a `NULL` pointer, each entry is charged the size of its
+ * node plus the length of its key.
+ *
+ * @note If the dict already exceeds the bounds, entries are evicted right away.
+ * An entry larger than `max_bytes` on its own is still inserted, once every
+ * other entry has been evicted. If an eviction fails (e.g. a clone failing to
+ * copy a shared bucket), -1 is returned with the cache mode enabled, and the
+ * next insertions evict the remaining entries.
+ *
+ * @note If the cache mode is already enabled, its bounds and functions are
+ * updated.
+ *
+ * @param dict The dict to turn into a cache.
+ * @param max_items The maximum number of entries, 0 for no bound.
+ * @param max_bytes The maximum number of bytes, 0 for no bound.
+ * @param free_pair The function called to release evicted pairs, may be `NULL`.
+ * @param size_pair The function used to charge the pairs, may be `NULL`.
+ * @return 0 on success, -1 on error.
+ */
+int dict_enable_cache(dict_t *dict, uint64_t max_items, uint64_t max_bytes,
+    free_pair_t free_pair, size_pair_t size_pair);
+
+/**
+ * @brief Disables the cache mode, if any. Entries are kept.
+ *
+ * @param dict The dict on which to disable the cache mode.
+ */
+void dict_disable_cache(dict_t *dict);
+
+/**
+ * @brief Enables the per-entry time to live.
+ *
+ * If `clock` is a `NULL` pointer, the monotonic clock of the system is used,
+ * in milliseconds.
+ *
+ * The expiry dates are stored in the nodes, after their value, so that the
+ * dicts which don't use them don't pay for them. The nodes are sized when
+ * the dict first enables the expiry, which must then hold no entry.
+ *
+ * @note If the expiry is already enabled, its functions are updated.
+ *
+ * @param dict The dict on which to enable the expiry.
+ * @param clock The function returning the current date, may be `NULL`.
+ * @param free_pair The function called to release expired pairs, may be
+ * `NULL`.
+ * @return 0 on success, -1 on error or if the dict holds entries whose nodes
+ * have no room for an expiry date.
+ */
+int dict_enable_expiry(dict_t *dict, dict_clock_t clock,
+    free_pair_t free_pair);
+
+/**
+ * @brief Disables the expiry, if any. Entries are kept and never expire until
+ * it is enabled again.
+ *
+ * @param dict The dict on which to disable the expiry.
+ */
+void dict_disable_expiry(dict_t *dict);
+
+/**
+ * @brief Inserts an entry which expires after `ttl`, in the clock unit.
+ *
+ * An expired entry holding the same key is released and replaced.
+ *
+ * @note If the expiry is not enabled, -1 is returned and the dict is left
+ * unchanged.
+ *
+ * @param dict The dict in which to insert the entry.
+ * @param key The key to refer to the value.
+ * @param key_length The length of the key.
+ * @param value The value refered at via the key.
+ * @param ttl The time to live of the entry, 0 if it never expires.
+ * @return 0 on success, -1 on error.
+ */
+int dict_insert_ttl(dict_t *dict, char *key, uint64_t key_length,
+    void *value, uint64_t ttl);
+
+/**
+ * @brief Sets the time to live of an existing entry.
+ *
+ * @note If the expiry is not enabled, or if the key is absent, -1 is returned.
+ *
+ * @param dict The dict holding the entry.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param ttl The time to live of the entry, 0 if it never expires.
+ * @return 0 on success, -1 on error.
+ */
+int dict_set_ttl(dict_t *dict, const char *key, uint64_t key_length,
+    uint64_t ttl);
+
+/**
+ * @brief Sweeps at most `budget` buckets for expired entries, resuming where
+ * the previous call stopped. Calling it regularly with a small budget keeps
+ * the memory of expired entries bounded without latency spikes.
+ *
+ * @note If the expiry is not enabled, nothing is done.
+ *
+ * @param dict The dict to sweep.
+ * @param budget The maximum number of buckets to sweep.
+ * @return The number of entries which were removed.
+ */
+uint64_t dict_expire_step(dict_t *dict, uint64_t budget);
+
+/**
+ * @brief Removes every entry `retain` returns 0 for, in a single pass over the
+ * buckets. Keys are not hashed again, and the dict is shrunk at most once,
+ * after the pass, instead of being checked after each removal.
+ *
+ * @note If shrinking the dict fails, it keeps its current size.
+ *
+ * @param dict The dict to filter.
+ * @param retain The function telling which entries to keep.
+ * @param ctx The context given to `retain`.
+ * @param free_pair The function called on the removed pairs, may be `NULL`.
+ * @return 0 on success, -1 if a bucket shared with a clone could not be
+ * copied, in which case the pass stops there.
+ */
+int dict_retain(dict_t *dict, retain_pair_t retain, void *ctx,
+    free_pair_t free_pair);
+
+/**
+ * @brief Removes every entry from the dict. The buckets array is kept, so
+ * that refilling the dict does not have to grow it again.
+ *
+ * @note If the dict shares buckets with a clone, it gets a new buckets array
+ * instead, the shared entries staying with the clone.
+ *
+ * @param dict The dict to clear.
+ * @param free_pair The function called on the removed pairs, may be `NULL`.
+ * @return 0 on success, -1 on error, in which case the dict is unchanged.
+ */
+int dict_clear(dict_t *dict, free_pair_t free_pair);
+
+/**
+ * @brief Returns a point-in-time copy of the dict, in constant time.
+ *
+ * Both dicts share their buckets and entries until one of them modifies a
+ * bucket, which is then copied for that dict only. Either dict may be modified
+ * or deallocated independently of the other.
+ *
+ * The pairs present at the time of the clone belong to both dicts : removing
+ * them from one dict does not call `free_pair`. They are released when the
+ * last dict sharing them is deallocated, so all of them must be deallocated
+ * using the same `free_pair` function.
+ *
+ * The cache mode and expiry settings are copied. The membership filter and
+ * the ordered index are not, as building them walks every entry : they may
+ * be enabled again on the clone. Until then, `dict_scan_prefix` and
+ * `dict_scan_range` return -1 on the clone.
+ *
+ * @note Resizing a dict copies all its shared buckets at once.
+ *
+ * @note If it failed, returns a `NULL` pointer and the dict is unchanged.
+ *
+ * @warning Dicts sharing a snapshot must not be used from different threads at
+ * the same time.
+ *
+ * @param dict The dict to clone.
+ * @return The clone.
+ */
+dict_t *dict_clone(dict_t *dict);
+
+/**
+ * @brief Loads the entries of a newline delimited file into the dict.
+ *
+ * Each line holds a key, optionally followed by a tab and a value field. The
+ * file is mapped in memory and the keys are borrowed from the mapping rather
+ * than copied : they are not NUL terminated, and the mapping stays alive until
+ * the dict (and its clones) are deallocated. The dict is pre-sized from a line
+ * count so that it does not resize while loading.
+ *
+ * If `load_value` is a `NULL` pointer, the value of an entry points to the
+ * bytes of its value field inside the mapping, up to the end of the line, or
+ * is a `NULL` pointer if the line has no value field.
+ *
+ * Empty lines are skipped, and so are the lines whose key was already present,
+ * `load_value` not being called for them.
+ *
+ * @note The dicts storing their values inline are not supported.
+ *
+ * @note The loaded keys belong to the mapping, so `free_pair` gets a `NULL`
+ * pointer key for the loaded entries. The values returned by `load_value`
+ * belong to the dict and are given to `free_pair` when their entry is removed,
+ * the values pointing inside the mapping are not, see
+ * `DICT_BUCKET_OWNS_VALUE`.
+ *
+ * @warning If `dict` or `path` is a `NULL` pointer, the function will crash.
+ *
+ * @param dict The dict in which to load the entries.
+ * @param path The path of the file to load.
+ * @param load_value The function making the values, may be `NULL`.
+ * @param ctx The context given to `load_value`.
+ * @return 0 on success, -1 on error.
+ */
+int dict_load_file(dict_t *dict, const char *path, load_value_t load_value,
+    void *ctx);
+
+/**
+ * @brief This structure represents a snapshot of the dict internal state, to
+ * help tuning it. It is filled by the `dict_stats` function.
+ */
+typedef struct s_dict_stats {
+    /** Total number of entries. */
+    uint64_t items;
+
+    /** Number of allocated buckets. */
+    uint64_t size;
+
+    /** Whether the membership filter is enabled. */
+    int filter_enabled;
+
+    /** Memory used by the membership filter, in bytes. */
+    uint64_t filter_bytes;
+
+    /** Ratio of filter bits set to 1, between 0 and 1. */
+    double filter_fill_ratio;
+
+    /** Expected false positive rate computed from the fill ratio. */
+    double filter_fpr;
+
+    /** Number of lookups which went through the filter. */
+    uint64_t filter_lookups;
+
+    /** Number of lookups answered as misses by the filter alone. */
+    uint64_t filter_rejects;
+
+    /** Number of lookups the filter let through but the buckets missed. */
+    uint64_t filter_false_positives;
+
+    /** Whether the cache mode is enabled. */
+    int cache_enabled;
+
+    /** Number of bytes charged by the entries in cache mode. */
+    uint64_t cache_bytes;
+
+    /** Number of entries evicted in cache mode. */
+    uint64_t cache_evictions;
+
+    /** Whether the expiry is enabled. */
+    int expiry_enabled;
+
+    /** Number of expired entries removed so far. */
+    uint64_t expired;
+
+    /** Whether the dict shares buckets with a clone. */
+    int shared;
+
+    /** Number of buckets copied from the shared snapshot so far. */
+    uint64_t cow_copies;
+
+    /** Whether the ordered index is enabled. */
+    int index_enabled;
+
+    /** Memory used by the ordered index, in bytes. */
+    uint64_t index_bytes;
+} dict_stats_t;
+
+/**
+ * @brief Fills the stats structure with the current state of the dict.
+ *
+ * @warning If `dict` or `stats` is a `NULL` pointer, the function will crash.
+ *
+ * @param dict The dict to inspect.
+ * @param stats The structure to fill.
+ */
+void dict_stats(const dict_t *dict, dict_stats_t *stats);
+
+/** @cond INTERNAL */
+
+/**
+ * @brief Resizes the dict.
+ *
+ * This process implies that all the key hashes must be recomputed. Depending
+ * on both the size of the dict and the length of the keys, the runtime may be
+ * slow. The length of each key is stored inside its entry, so that keys do
+ * not have to be NUL terminated (e.g. keys borrowed from a mapped file), and
+ * so that no `strlen` call is needed to re-hash them.
+ *
+ * @warning If a `NULL` pointer is passed, or if the dict has been deallocated,
+ * the function will crash.
+ *
+ * @note If the dict could not be resized, it's unchanged and -1 is returned.
+ *
+ * @param dict The dict to resize.
+ * @return 0 on success, -1 on error.
+ */
+int dict_resize(dict_t *dict);
+
+/**
+ * @brief Resizes the dict to the given number of buckets, rounded up to the
+ * next power of 2. See `dict_resize`.
+ *
+ * @param dict The dict to resize.
+ * @param new_size The minimum number of buckets.
+ * @return 0 on success, -1 on error.
+ */
+int dict_resize_to(dict_t *dict, uint64_t new_size);
+
+/**
+ * @brief This function makes sure the new size is a power of 2, and at least
+ * `DICT_MIN_SIZE`.
+ *
+ * @see https://github.com/python/cpython/blob/main/Python/hashtable.c#L108
+ *
+ * @param new_size The requested number of buckets.
+ * @return The actual new size to use.
+ */
+uint64_t dict_round_size(uint64_t new_size);
+
+/**
+ * @brief Rebuilds the membership filter from the entries of the dict, dropping
+ * the stale deleted keys.
+ *
+ * @note If the filter could not be rebuilt, it's unchanged and -1 is returned.
+ *
+ * @param dict The dict whose filter must be rebuilt.
+ * @return 0 on success, -1 on error.
+ */
+int dict_filter_rebuild(dict_t *dict);
+
+/**
+ * @brief Returns the number of bytes an entry is charged in cache mode.
+ *
+ * @param cache The cache mode state.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param value The value of the entry.
+ * @return The number of bytes charged.
+ */
+uint64_t dict_cache_charge(const dict_cache_t *cache, const char *key,
+    uint64_t key_length, const void *value);
+
+/**
+ * @brief Inserts an entry into the dict, and returns its node.
+ *
+ * This is the common part of the insertion functions, see `dict_insert`. An
+ * expired entry holding the same key is released and replaced.
+ *
+ * @param dict The dict in which to insert the entry.
+ * @param key The key to refer to the value.
+ * @param key_length The length of the key.
+ * @param value The value refered at via the key.
+ * @return The inserted node on success, `NULL` pointer on error.
+ */
+bucket_t *dict_insert_node(dict_t *dict, char *key, uint64_t key_length,
+    void *value);
+
+/**
+ * @brief Allocates a node holding an entry of the dict, sized by
+ * `DICT_NODE_SIZE`, not linked to any bucket yet, so that its allocation can
+ * fail before the dict is changed.
+ *
+ * @param dict The dict the node belongs to.
+ * @param key The key of the pair.
+ * @param key_length The length of the key.
+ * @param value The value of the pair, or the address of the bytes copied
+ * into the node if the dict stores its values inline.
+ * @return The node on success, `NULL` pointer on error.
+ */
+bucket_t *dict_bucket_node_ctor(const dict_t *dict, char *key,
+    uint64_t key_length, void *value);
+
+/**
+ * @brief Returns the node holding the key, inserting a new entry if there is
+ * none. The key is hashed and its bucket walked only once. Every insertion
+ * front-end goes through it, so it's where they are traced.
+ *
+ * @param dict The dict holding the entry.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param key_hash The hash of the key.
+ * @param value The value of the entry, if it gets inserted.
+ * @param inserted Set to 1 if the entry was inserted, 0 otherwise.
+ * @return The node of the entry on success, `NULL` pointer on error.
+ */
+bucket_t *dict_entry_node(dict_t *dict, char *key, uint64_t key_length,
+    uint32_t key_hash, void *value, int *inserted);
+
+/**
+ * @brief Unlinks a node from its bucket and releases it, keeping the dict
+ * state (items, filter, cache charge) consistent.
+ *
+ * @param dict The dict holding the node.
+ * @param link The address of the pointer to the node.
+ * @param free_pair The function called to release the pair, may be `NULL`.
+ */
+void dict_bucket_release(dict_t *dict, bucket_t **link,
+    free_pair_t free_pair);
+
+/**
+ * @brief Makes sure the dict may modify the bucket at the given index, copying
+ * it from the shared snapshot if needed.
+ *
+ * @note Any pointer to a node of that bucket must be looked up again after the
+ * call, as the nodes may have been copied.
+ *
+ * @param dict The dict about to modify the bucket.
+ * @param index The index of the bucket.
+ * @return 0 on success, -1 on error.
+ */
+int dict_cow_bucket(dict_t *dict, uint64_t index);
+
+/**
+ * @brief Drops a reference to a shared snapshot. The last reference releases
+ * the nodes owned by the snapshot, calls `free_pair` on their pairs, then drops
+ * the reference to the parent snapshot.
+ *
+ * @param shared The snapshot, may be a `NULL` pointer.
+ * @param free_pair The function called to release the pairs, may be `NULL`.
+ * @param allocator The allocator shared by the dict and its clones.
+ */
+void dict_shared_release(dict_shared_t *shared, free_pair_t free_pair,
+    const dict_allocator_t *allocator);
+
+/**
+ * @brief Drops a reference to a list of mapped files. The last reference
+ * unmaps the file, then drops the reference to the next mapping.
+ *
+ * @param mapping The mapping, may be a `NULL` pointer.
+ * @param allocator The allocator shared by the dict and its clones.
+ */
+void dict_mapping_release(dict_mapping_t *mapping,
+    const dict_allocator_t *allocator);
+
+/**
+ * @brief Drops a reference to a list of packs. The last reference releases
+ * the pack, then drops the reference to the next pack.
+ *
+ * @param pack The pack, may be a `NULL` pointer.
+ * @param allocator The allocator shared by the dict and its clones.
+ * @return The number of bytes released.
+ */
+uint64_t dict_pack_release(dict_pack_t *pack,
+    const dict_allocator_t *allocator);
+
+/**
+ * @brief Releases a node, unless it lives in a pack, see
+ * `DICT_BUCKET_PACKED`.
+ *
+ * @param allocator The allocator of the node.
+ * @param node The node to release.
+ */
+void dict_node_free(const dict_allocator_t *allocator, bucket_t *node);
+
+/**
+ * @brief Allocates a zeroed array through the allocator, like `calloc`.
+ *
+ * @param allocator The allocator to use.
+ * @param count The number of elements.
+ * @param size The size of each element.
+ * @return The allocation on success, `NULL` pointer on error or overflow.
+ */
+void *dict_alloc(const dict_allocator_t *allocator, size_t count,
+    size_t size);
+
+/**
+ * @brief Releases an allocation through the allocator, like `free`.
+ *
+ * @param allocator The allocator to use.
+ * @param ptr The allocation, may be a `NULL` pointer.
+ */
+void dict_free(const dict_allocator_t *allocator, void *ptr);
+
+/**
+ * @brief Allocates a zeroed large array through the `allocate_large` function
+ * of the allocator, or like `dict_alloc` if it has none.
+ *
+ * @param allocator The allocator to use.
+ * @param count The number of elements.
+ * @param size The size of each element.
+ * @return The allocation on success, `NULL` pointer on error or overflow.
+ */
+void *dict_alloc_large(const dict_allocator_t *allocator, size_t count,
+    size_t size);
+
+/**
+ * @brief Releases an allocation of `dict_alloc_large`, with the same count
+ * and size.
+ *
+ * @param allocator The allocator to use.
+ * @param ptr The allocation, may be a `NULL` pointer.
+ * @param count The number of elements.
+ * @param size The size of each element.
+ */
+void dict_free_large(const dict_allocator_t *allocator, void *ptr,
+    size_t count, size_t size);
+
+/**
+ * @brief The default expiry clock, reading the monotonic clock of the system.
+ *
+ * @return The current date, in milliseconds.
+ */
+uint64_t dict_clock_monotonic(void);
+
+/**
+ * @brief Evicts one entry following the CLOCK policy.
+ *
+ * @warning If the cache mode is not enabled, the function will crash.
+ *
+ * @param dict The dict from which to evict an entry.
+ * @return 0 on success, -1 if the dict is empty.
+ */
+int dict_cache_evict(dict_t *dict);
+
+/**
+ * @brief Such function prototype walks the buckets `[first, last)` of the
+ * dict on behalf of a thread of `dict_parallel_run`.
+ */
+typedef void (*dict_parallel_task_t)(const dict_t *dict, uint64_t first,
+    uint64_t last, uint64_t worker, void *ctx);
+
+/**
+ * @brief Walks the buckets of the dict across `workers` threads, the calling
+ * thread being the worker 0, with chunks stealing. If the threads cannot be
+ * set up, the calling thread walks every bucket as the worker 0.
+ *
+ * @param dict The dict to walk.
+ * @param workers The number of workers, see `DICT_PARALLEL_WORKERS`.
+ * @param task The function walking a range of buckets.
+ * @param ctx The context given to `task`.
+ */
+void dict_parallel_run(const dict_t *dict, uint64_t workers,
+    dict_parallel_task_t task, void *ctx);
+
+/** @endcond */
+
+/**
+ * @brief This structure represents the keys of the dict. It will be computed
  * each time the dict_keys() function is called. It will not be used by other
  * function to operate on the dict, as the internal dict state is known by all
  * functions.
  */
-typedef struct s_dict_keys {
-    /** Number of keys. Same value as the 'items' dict_t member. */
-    uint64_t size;
+typedef struct s_dict_keys {
+    /** Number of keys. Same value as the 'items' dict_t member. */
+    uint64_t size;
+
+    /**
+     * The keys in a string array of length 'size'.
+     *
+     * @attention DO NOT TRY TO FREE THE MEMORY OF ANY ITEM FROM THAT ARRAY.
+     */
+    const char **keys;
+
+    /**
+     * The length of each key, in an array of length 'size'. The keys are
+     * only NUL-terminated if they were inserted so.
+     */
+    uint64_t *lengths;
+
+    /** The allocator of the dict the keys were taken from. */
+    dict_allocator_t allocator;
+} dict_keys_t;
+
+/**
+ * @brief Returns the list of the keys of the dict.
+ *
+ * If an error occured during the dict_keys_t object allocation, `NULL` pointer
+ * is returned.
+ *
+ * The `dict_keys_t` object will have to be free using the `dict_free_keys`
+ * function.
+ *
+ * @warning If a `NULL` pointer is passed, or if the dict has already been
+ * deallocated, the function will crash.
+ *
+ * @warning DO NOT TRY TO FREE ANY ITEM INSIDE THE `keys` MEMBER BY YOURSELF.
+ * The `keys` array member contains references to the keys, not copies. If you
+ * free one of them, it may break the whole dict object.
+ *
+ * @note The list of keys is not ordered. The keys are taken from each bucket
+ * from 0 to the size of the dict, and each of the bucket is iterated over from
+ * head to tail (linked list). Knowing that the insertion depends on a hash, we
+ * don't know the order in which the keys will appear in the list.
+ *
+ * @param dict The dict from which to get the keys.
+ * @return The list of keys.
+ */
+dict_keys_t *dict_get_keys(const dict_t *dict);
+
+/**
+ * @brief Release memory from `dict_get_keys` allocations.
+ *
+ * If a `NULL` pointer is passed, or if the dict keys have already been
+ * deallocated, the function will crash.
+ *
+ * @param dict_keys The keys to free.
+ */
+void dict_free_keys(dict_keys_t *dict_keys);
+
+/**
+ * @brief This structure represents the values of the dict. It will be computed
+ * each time the dict_values() function is called. It will not be used by other
+ * function to operate on the dict, as the internal dict state is known by all
+ * functions.
+ */
+typedef struct s_dict_values {
+    /** Number of values. Same value as the 'items' dict_t member. */
+    uint64_t size;
+
+    /**
+     * The values in a string array of length 'size'.
+     *
+     * @attention DO NOT TRY TO FREE THE MEMORY OF ANY ITEM FROM THAT ARRAY.
+     */
+    const void **values;
+
+    /** The allocator of the dict the values were taken from. */
+    dict_allocator_t allocator;
+} dict_values_t;
+
+/**
+ * @brief Returns the list of the values of the dict.
+ *
+ * If an error occured during the dict_values_t object allocation, `NULL`
+ * pointer is returned.
+ *
+ * The `dict_values_t` object will have to be free using the `dict_free_values`
+ * function.
+ *
+ * @warning If a `NULL` pointer is passed, or if the dict has already been
+ * deallocated, the function will crash.
+ *
+ * @warning DO NOT TRY TO FREE ANY ITEM INSIDE THE `values` MEMBER BY YOURSELF.
+ * The `values` array member contains references to the values, not copies. If
+ * you free one of them, it may break the whole dict object.
+ *
+ * @note The list of values is not ordered. The values are taken from each
+ * bucket from 0 to the size of the dict, and each of the bucket is iterated
+ * over from head to tail (linked list). Knowing that the insertion depends on
+ * a hash, we don't know the order in which the values will appear in the list.
+ *
+ * @param dict The dict from which to get the values.
+ * @return The list of values.
+ */
+dict_values_t *dict_get_values(const dict_t *dict);
+
+/**
+ * @brief Release memory from `dict_get_values` allocations.
+ *
+ * If a `NULL` pointer is passed, or if the dict values have already been
+ * deallocated, the function will crash.
+ *
+ * @param dict_values The values to free.
+ */
+void dict_free_values(dict_values_t *dict_values);
+
+/** @cond INTERNAL */
+
+/**
+ * @brief The index marking the end of a compact dict linked list.
+ */
+#define DICT32_NIL UINT32_MAX
+
+/**
+ * @brief The minimum number of entries of a compact dict pool.
+ */
+#define DICT32_MIN_POOL 16
+
+/**
+ * @brief An entry of a compact dict. Entries live in one contiguous pool and
+ * link to each other through their index, so that an entry weights 24 bytes
+ * and needs no allocation of its own. Released entries are chained into a free
+ * list, their key being set to a `NULL` pointer.
+ */
+typedef struct s_dict32_entry {
+    /** The key used to refer to the value. */
+    char *key;
+
+    /** The value to store, refered at via the key. */
+    void *value;
+
+    /** The length of the key. */
+    uint32_t key_length;
+
+    /** Index of the next entry of the bucket, or of the free list. */
+    uint32_t next;
+} dict32_entry_t;
+
+/** @endcond INTERNAL */
+
+/**
+ * @brief This structure represents the state of a compact dict. It follows
+ * the design of `dict_t`, but the buckets array holds the 32 bits index of the
+ * first entry of each bucket rather than a pointer to a sentinel node, cutting
+ * the per-entry overhead from about 100 bytes to about 32 bytes.
+ *
+ * A compact dict holds less than `DICT32_NIL` entries, whose keys are shorter
+ * than 4 GiB. It does not support the optional features of `dict_t` (filter,
+ * cache mode, expiry, clones, file loading).
+ */
+typedef struct s_dict32 {
+    /** Total number of entries. */
+    uint64_t items;
+
+    /** Number of buckets. */
+    uint64_t size;
+
+    /** Index of the first entry of each bucket, `DICT32_NIL` if empty. */
+    uint32_t *heads;
+
+    /** The pool of entries. */
+    dict32_entry_t *entries;
+
+    /** Number of entries the pool can hold. */
+    uint32_t capacity;
+
+    /** Number of entries of the pool used so far, released ones included. */
+    uint32_t used;
+
+    /** Index of the first released entry, `DICT32_NIL` if none. */
+    uint32_t free_list;
+
+    /** The allocator of every internal allocation. */
+    dict_allocator_t allocator;
+} dict32_t;
+
+/**
+ * @brief Allocates a new compact dict.
+ *
+ * @note If it failed, returns a `NULL` pointer.
+ *
+ * @param allocator The allocator to use, `NULL` pointer for the standard one.
+ * @return The allocated compact dict.
+ */
+dict32_t *dict32_ctor(const dict_allocator_t *allocator);
+
+/**
+ * @brief Deallocates the compact dict.
+ *
+ * @warning If a `NULL` pointer is passed, or if the dict has already been
+ * deallocated, the function will crash.
+ *
+ * @param dict The compact dict to deallocate.
+ * @param free_pair The function to use to free pair, may be `NULL`.
+ */
+void dict32_dtor(dict32_t *dict, free_pair_t free_pair);
+
+/**
+ * @brief Inserts a new entry inside the compact dict.
+ *
+ * If the key is already present, if the dict is full, if the key is 4 GiB
+ * long or more, or if an allocation failed, -1 is returned and the dict is
+ * left unchanged.
+ *
+ * @param dict The compact dict in which to insert the entry.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param value The value of the entry.
+ * @return 0 on success, -1 on error.
+ */
+int dict32_insert(dict32_t *dict, char *key, uint64_t key_length,
+    void *value);
+
+/**
+ * @brief Looks up the value associated to the key.
+ *
+ * @param dict The compact dict to look up.
+ * @param key The key to look for.
+ * @param key_length The length of the key.
+ * @param value Where to store the value, may be a `NULL` pointer.
+ * @return 0 if the key was found, -1 otherwise.
+ */
+int dict32_get(const dict32_t *dict, const char *key, uint64_t key_length,
+    void **value);
+
+/**
+ * @brief Returns whether the key is present inside the compact dict.
+ *
+ * @param dict The compact dict to look up.
+ * @param key The key to look for.
+ * @param key_length The length of the key.
+ * @return 1 if the key is present, 0 otherwise.
+ */
+int dict32_has_key(const dict32_t *dict, const char *key,
+    uint64_t key_length);
+
+/**
+ * @brief Deletes an entry from the compact dict. Its slot of the pool is
+ * reused by the next insertions.
+ *
+ * @param dict The compact dict from which to delete the entry.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param free_pair The function to use to free pair, may be `NULL`.
+ * @return 0 on success, -1 if the key was not found.
+ */
+int dict32_delete(dict32_t *dict, char *key, uint64_t key_length,
+    free_pair_t free_pair);
+
+/**
+ * @brief Makes sure `count` more entries can be inserted without growing the
+ * pool nor resizing the buckets array.
+ *
+ * @param dict The compact dict to reserve memory for.
+ * @param count The number of entries about to be inserted.
+ * @return 0 on success, -1 on error.
+ */
+int dict32_reserve(dict32_t *dict, uint64_t count);
+
+/** @cond INTERNAL */
+
+/**
+ * @brief Resizes the buckets array of the compact dict, relinking every entry
+ * of the pool. On error, the dict is left unchanged.
+ *
+ * @param dict The compact dict to resize.
+ * @param new_size The requested number of buckets, rounded up to a power of 2.
+ * @return 0 on success, -1 on error.
+ */
+int dict32_resize_to(dict32_t *dict, uint64_t new_size);
+
+/**
+ * @brief Grows the pool of the compact dict so that it holds at least
+ * `capacity` entries. On error, the pool is left unchanged.
+ *
+ * @param dict The compact dict whose pool to grow.
+ * @param capacity The minimum number of entries of the pool.
+ * @return 0 on success, -1 on error.
+ */
+int dict32_pool_reserve(dict32_t *dict, uint64_t capacity);
+
+/**
+ * @brief Returns the index of the entry holding the key.
+ *
+ * @param dict The compact dict to look up.
+ * @param key The key to look for.
+ * @param key_length The length of the key.
+ * @return The index of the entry, `DICT32_NIL` if the key is not present.
+ */
+uint32_t dict32_find(const dict32_t *dict, const char *key,
+    uint64_t key_length);
+
+/** @endcond INTERNAL */
+
+/** @cond INTERNAL */
+
+/**
+ * @brief An entry of a set. It follows the layout of `dict32_entry_t` without
+ * the value, so that an entry weights 16 bytes. Released entries are chained
+ * into the free list, their key being set to a `NULL` pointer.
+ */
+typedef struct s_dict_set_entry {
+    /** The key, owned by the caller. */
+    char *key;
+
+    /** The length of the key. */
+    uint32_t key_length;
+
+    /** Index of the next entry of the bucket, or of the free list. */
+    uint32_t next;
+} dict_set_entry_t;
+
+/** @endcond INTERNAL */
+
+/**
+ * @brief This structure represents the state of a set, holding keys without
+ * values. It follows the design of `dict32_t`, an entry costing about 24 bytes
+ * (its slot of the pool and its share of the buckets array) rather than about
+ * 32 bytes for a compact dict, which matters when deduplicating more keys than
+ * the caches can hold.
+ *
+ * A set holds less than `DICT32_NIL` keys, each shorter than 4 GiB.
+ */
+typedef struct s_dict_set {
+    /** Total number of keys. */
+    uint64_t items;
+
+    /** Number of buckets. */
+    uint64_t size;
+
+    /** Index of the first entry of each bucket, `DICT32_NIL` if empty. */
+    uint32_t *heads;
+
+    /** The pool of entries. */
+    dict_set_entry_t *entries;
+
+    /** Number of entries the pool can hold. */
+    uint32_t capacity;
+
+    /** Number of entries of the pool used so far, released ones included. */
+    uint32_t used;
+
+    /** Index of the first released entry, `DICT32_NIL` if none. */
+    uint32_t free_list;
+
+    /** The allocator of every internal allocation. */
+    dict_allocator_t allocator;
+} dict_set_t;
+
+/**
+ * @brief Allocates a new set.
+ *
+ * @note If it failed, returns a `NULL` pointer.
+ *
+ * @param allocator The allocator to use, `NULL` pointer for the standard one.
+ * @return The allocated set.
+ */
+dict_set_t *dict_set_ctor(const dict_allocator_t *allocator);
+
+/**
+ * @brief Deallocates the set.
+ *
+ * @warning If a `NULL` pointer is passed, or if the set has already been
+ * deallocated, the function will crash.
+ *
+ * @param set The set to deallocate.
+ * @param free_key The function to use to free the keys, may be `NULL`.
+ */
+void dict_set_dtor(dict_set_t *set, free_key_t free_key);
+
+/**
+ * @brief Adds a key to the set. The key is not copied, it must outlive the
+ * set.
+ *
+ * @param set The set in which to add the key.
+ * @param key The key to add.
+ * @param key_length The length of the key.
+ * @return 0 if the key was added, 1 if it was already present, -1 if the set is
+ * full, if the key is 4 GiB long or more, or if an allocation failed.
+ */
+int dict_set_add(dict_set_t *set, char *key, uint64_t key_length);
+
+/**
+ * @brief Returns whether the key is present inside the set.
+ *
+ * @param set The set to look up.
+ * @param key The key to look for.
+ * @param key_length The length of the key.
+ * @return 1 if the key is present, 0 otherwise.
+ */
+int dict_set_contains(const dict_set_t *set, const char *key,
+    uint64_t key_length);
+
+/**
+ * @brief Removes a key from the set. Its slot of the pool is reused by the
+ * next additions.
+ *
+ * @param set The set from which to remove the key.
+ * @param key The key to remove.
+ * @param key_length The length of the key.
+ * @param free_key The function to use to free the stored key, may be `NULL`.
+ * @return 0 on success, -1 if the key was not found.
+ */
+int dict_set_remove(dict_set_t *set, const char *key, uint64_t key_length,
+    free_key_t free_key);
+
+/**
+ * @brief Makes sure `count` more keys can be added without growing the pool
+ * nor resizing the buckets array.
+ *
+ * @param set The set to reserve memory for.
+ * @param count The number of keys about to be added.
+ * @return 0 on success, -1 on error.
+ */
+int dict_set_reserve(dict_set_t *set, uint64_t count);
+
+/**
+ * @brief Adds to `set` every key of `other` it does not hold yet. The missing
+ * keys are counted first, so that the pool and the buckets array grow at most
+ * once, and so that `set` is left unchanged on error.
+ *
+ * @attention The added keys are the ones of `other`, not copies: they must
+ * outlive `set`, and must only be released through one of the two sets.
+ *
+ * @param set The set receiving the keys.
+ * @param other The set whose keys to add.
+ * @return 0 on success, -1 on error.
+ */
+int dict_set_union(dict_set_t *set, const dict_set_t *other);
+
+/**
+ * @brief Removes from `set` every key `other` does not hold.
+ *
+ * @param set The set to filter.
+ * @param other The set whose keys to keep.
+ * @param free_key The function to use to free the removed keys, may be `NULL`.
+ * @return The number of removed keys.
+ */
+uint64_t dict_set_intersection(dict_set_t *set, const dict_set_t *other,
+    free_key_t free_key);
+
+/**
+ * @brief Removes from `set` every key `other` holds.
+ *
+ * @param set The set to filter.
+ * @param other The set whose keys to remove.
+ * @param free_key The function to use to free the removed keys, may be `NULL`.
+ * @return The number of removed keys.
+ */
+uint64_t dict_set_difference(dict_set_t *set, const dict_set_t *other,
+    free_key_t free_key);
+
+/**
+ * @brief Returns the list of the keys of the set, in pool order. It has to be
+ * released with `dict_free_keys`.
+ *
+ * @note If it failed, returns a `NULL` pointer.
+ *
+ * @param set The set to get the keys from.
+ * @return The keys of the set.
+ */
+dict_keys_t *dict_set_get_keys(const dict_set_t *set);
+
+/** @cond INTERNAL */
+
+/**
+ * @brief Resizes the buckets array of the set, relinking every entry of the
+ * pool. On error, the set is left unchanged.
+ *
+ * @param set The set to resize.
+ * @param new_size The requested number of buckets, rounded up to a power of 2.
+ * @return 0 on success, -1 on error.
+ */
+int dict_set_resize_to(dict_set_t *set, uint64_t new_size);
+
+/**
+ * @brief Grows the pool of the set so that it holds at least `capacity`
+ * entries. On error, the pool is left unchanged.
+ *
+ * @param set The set whose pool to grow.
+ * @param capacity The minimum number of entries of the pool.
+ * @return 0 on success, -1 on error.
+ */
+int dict_set_pool_reserve(dict_set_t *set, uint64_t capacity);
+
+/**
+ * @brief Returns the index of the entry holding the key.
+ *
+ * @param set The set to look up.
+ * @param key The key to look for.
+ * @param key_length The length of the key.
+ * @return The index of the entry, `DICT32_NIL` if the key is not present.
+ */
+uint32_t dict_set_find(const dict_set_t *set, const char *key,
+    uint64_t key_length);
+
+/** @endcond INTERNAL */
+
+/** @cond INTERNAL */
+
+/**
+ * @brief Identifies a region holding a shared dict, and its layout version.
+ */
+#define DICT_SHM_MAGIC 0x4449435453484D31ULL
+
+/**
+ * @brief The number of size classes of the shared dict allocator, the block
+ * sizes going from 32 bytes to 2^(4 + DICT_SHM_CLASSES) bytes.
+ */
+#define DICT_SHM_CLASSES 48
+
+/**
+ * @brief The room reserved in the shared dict header for its process-shared
+ * lock, a `pthread_rwlock_t`.
+ */
+#define DICT_SHM_LOCK_SIZE 64
+
+/**
+ * @brief Returns the address of the given offset of a shared dict region, as
+ * mapped by the calling process.
+ */
+#define DICT_SHM_AT(S, O) ((void *) ((char *) (S) + (O)))
+
+/**
+ * @brief An entry of a shared dict. The key and the value are copied right
+ * after the entry, as pointers would be meaningless to the other processes.
+ */
+typedef struct s_dict_shm_entry {
+    /** Offset of the next entry of the bucket, 0 if last. */
+    uint64_t next;
+
+    /** The length of the key. */
+    uint64_t key_length;
+
+    /** The length of the value. */
+    uint64_t value_length;
+
+    /** The hash of the key, so that resizes do not hash the key again. */
+    uint32_t hash;
+
+    /** Padding, keeping the data 8 bytes aligned. */
+    uint32_t reserved;
+
+    /** The key bytes, followed by the value bytes. */
+    char data[];
+} dict_shm_entry_t;
+
+/** @endcond INTERNAL */
+
+/**
+ * @brief This structure represents a dict living in a memory region shared by
+ * several processes, such as a `shm_open` and `mmap` one. It sits at the start
+ * of the region, and everything it refers to is in the region too, through
+ * offsets from the start of the region rather than pointers, so that every
+ * process can map the region at its own address.
+ *
+ * Keys and values are copied into the region, by an allocator of its own. A
+ * process-shared readers-writer lock lets any number of processes read the
+ * dict while one of them writes to it.
+ *
+ * @note The dict does not support the optional features of `dict_t`.
+ */
+typedef struct s_dict_shm {
+    /** Must be `DICT_SHM_MAGIC`. */
+    uint64_t magic;
+
+    /** The size of the region, in bytes. */
+    uint64_t region_size;
+
+    /** Total number of entries. */
+    uint64_t items;
+
+    /** Number of buckets. */
+    uint64_t size;
+
+    /** Offset of the buckets array, holding the offset of each first entry. */
+    uint64_t buckets;
+
+    /** Offset of the first byte of the region never allocated. */
+    uint64_t top;
+
+    /** Offset of the first released block of each size class, 0 if none. */
+    uint64_t free_lists[DICT_SHM_CLASSES];
+
+    /** The seed the keys are hashed with. */
+    uint32_t seed;
+
+    /** The process-shared lock, only used through the `dict_shm_*` calls. */
+    union {
+        unsigned char bytes[DICT_SHM_LOCK_SIZE];
+        uint64_t align;
+    } lock;
+} dict_shm_t;
+
+/**
+ * @brief Builds an empty shared dict in a region. The region must be mapped
+ * shared, 16 bytes aligned, and stay mapped while the dict is used.
+ *
+ * @param region The start of the region.
+ * @param region_size The size of the region, in bytes.
+ * @return The shared dict, at the start of the region, on success. `NULL`
+ * pointer if the region is too small or if the lock could not be created.
+ */
+dict_shm_t *dict_shm_create(void *region, uint64_t region_size);
+
+/**
+ * @brief Returns the shared dict another process built in a region, the
+ * region being mapped at any address by the calling process.
+ *
+ * @param region The start of the region.
+ * @return The shared dict on success, `NULL` pointer if the region does not
+ * hold one.
+ */
+dict_shm_t *dict_shm_attach(void *region);
+
+/**
+ * @brief Releases the lock of the shared dict, once no process uses it
+ * anymore. The region itself belongs to the caller.
+ *
+ * @param shm The shared dict to destroy.
+ */
+void dict_shm_destroy(dict_shm_t *shm);
+
+/**
+ * @brief Inserts a new entry inside the shared dict, copying the key and the
+ * value into the region.
+ *
+ * @param shm The shared dict in which to insert the entry.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param value The value bytes.
+ * @param value_length The length of the value.
+ * @return 0 on success, -1 if the key is already present or if the region is
+ * full.
+ */
+int dict_shm_insert(dict_shm_t *shm, const char *key, uint64_t key_length,
+    const void *value, uint64_t value_length);
+
+/**
+ * @brief Copies the value associated to the key. The value is copied rather
+ * than pointed at, as another process may delete it once the lock is
+ * released.
+ *
+ * @param shm The shared dict to look up.
+ * @param key The key to look for.
+ * @param key_length The length of the key.
+ * @param value Where to copy the value, may be `NULL` if `capacity` is 0.
+ * @param capacity The size of `value`, at most as many bytes are copied.
+ * @return The length of the value, which may exceed `capacity`, or -1 if the
+ * key is not present.
+ */
+int64_t dict_shm_get(dict_shm_t *shm, const char *key, uint64_t key_length,
+    void *value, uint64_t capacity);
+
+/**
+ * @brief Returns whether the key is present inside the shared dict.
+ *
+ * @param shm The shared dict to look up.
+ * @param key The key to look for.
+ * @param key_length The length of the key.
+ * @return 1 if the key is present, 0 otherwise.
+ */
+int dict_shm_has_key(dict_shm_t *shm, const char *key, uint64_t key_length);
+
+/**
+ * @brief Deletes an entry from the shared dict, its memory being reused by
+ * the next insertions.
+ *
+ * @param shm The shared dict from which to delete the entry.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @return 0 on success, -1 if the key was not found.
+ */
+int dict_shm_delete(dict_shm_t *shm, const char *key, uint64_t key_length);
+
+/** @cond INTERNAL */
+
+/**
+ * @brief Allocates a block of the region. The caller must hold the write
+ * lock.
+ *
+ * @param shm The shared dict owning the region.
+ * @param size The number of bytes to allocate.
+ * @return The offset of the zeroed block on success, 0 if the region is full.
+ */
+uint64_t dict_shm_alloc(dict_shm_t *shm, uint64_t size);
+
+/**
+ * @brief Releases a block of the region into the free list of its size class.
+ * The caller must hold the write lock.
+ *
+ * @param shm The shared dict owning the region.
+ * @param offset The offset of the block, 0 being ignored.
+ */
+void dict_shm_free(dict_shm_t *shm, uint64_t offset);
+
+/**
+ * @brief Returns the link to the entry holding the key. The caller must hold
+ * the lock.
+ *
+ * @param shm The shared dict to look up.
+ * @param key The key to look for.
+ * @param key_length The length of the key.
+ * @param key_hash The hash of the key.
+ * @return The address of the offset of the entry, `NULL` pointer if the key
+ * is not present.
+ */
+uint64_t *dict_shm_find(dict_shm_t *shm, const char *key,
+    uint64_t key_length, uint32_t key_hash);
+
+/**
+ * @brief Resizes the buckets array of the shared dict. The caller must hold
+ * the write lock. On error, the dict is left unchanged.
+ *
+ * @param shm The shared dict to resize.
+ * @param new_size The requested number of buckets, rounded up to a power of 2.
+ * @return 0 on success, -1 on error.
+ */
+int dict_shm_resize_to(dict_shm_t *shm, uint64_t new_size);
+
+/** @endcond INTERNAL */
+
+/**
+ * @brief The log records are written when its buffer is full, and the
+ * operating system decides when they reach the disk.
+ */
+#define DICT_WAL_SYNC_NONE 0
+
+/**
+ * @brief The log records are written and synced to the disk by groups, once
+ * `batch` records are pending, so that a sync is shared by the whole group.
+ */
+#define DICT_WAL_SYNC_BATCH 1
+
+/**
+ * @brief Every log record is written and synced to the disk before the
+ * mutation returns.
+ */
+#define DICT_WAL_SYNC_ALWAYS 2
+
+/** @cond INTERNAL */
+
+/**
+ * @brief The size of the buffer grouping the log records before they are
+ * written.
+ */
+#define DICT_WAL_BUFFER_SIZE (64 << 10)
+
+/**
+ * @brief The number of records grouped per sync by default, with the
+ * `DICT_WAL_SYNC_BATCH` policy.
+ */
+#define DICT_WAL_BATCH 64
+
+/**
+ * @brief The log record types.
+ */
+#define DICT_WAL_PUT 1
+#define DICT_WAL_DELETE 2
+
+/**
+ * @brief The size of a log record header : a checksum, the record type, the
+ * length of the key and the length of the value.
+ */
+#define DICT_WAL_RECORD_HEADER 13
+
+/**
+ * @brief The magic bytes starting the log segments and the snapshots.
+ */
+#define DICT_WAL_LOG_MAGIC "DICTWAL1"
+#define DICT_WAL_SNAP_MAGIC "DICTSNP1"
+
+/**
+ * @brief The size of a snapshot header : the magic bytes, the generation of
+ * the last log segment it covers, and its number of entries.
+ */
+#define DICT_WAL_SNAP_HEADER 24
+
+/** @endcond INTERNAL */
+
+/**
+ * @brief A value of a durable dict. The dict owns a copy of the value bytes,
+ * the key bytes being stored right after them.
+ */
+typedef struct s_dict_wal_value {
+    /** The length of the value. */
+    uint64_t length;
+
+    /** The value bytes, followed by the key bytes. */
+    char data[];
+} dict_wal_value_t;
+
+/**
+ * @brief This structure represents a durable dict. Its mutations are appended
+ * to a log, as compact binary records, before they are acknowledged, and the
+ * dict is rebuilt from the log when it's opened again.
+ *
+ * The log is made of segments, `<path>.<generation>.log`. A compaction closes
+ * the current segment, and a child process writes the live entries into a
+ * snapshot, `<path>.snap`, from its copy-on-write view of the dict, while the
+ * parent goes on appending to the next segment. The covered segments are then
+ * removed, so that recovery only replays the snapshot and the segments
+ * written since.
+ */
+typedef struct s_dict_wal {
+    /** The entries, keyed by their key, valued by `dict_wal_value_t`. */
+    dict_t *dict;
+
+    /** The base path of the log segments and of the snapshot. */
+    char *path;
+
+    /** The file descriptor of the current log segment. */
+    int fd;
+
+    /** The pid of the running compaction, 0 if none. */
+    int compactor;
+
+    /** The generation of the current log segment. */
+    uint64_t generation;
+
+    /** One of the `DICT_WAL_SYNC_*` policies. */
+    int policy;
+
+    /** The number of records grouped per sync, see `DICT_WAL_SYNC_BATCH`. */
+    uint64_t batch;
+
+    /** The records not written yet. */
+    char *buffer;
+
+    /** The size of the buffer, grown for the records larger than it. */
+    uint64_t capacity;
+
+    /** The number of bytes used in the buffer. */
+    uint64_t buffered;
+
+    /** The number of bytes of the current log segment written so far. */
+    uint64_t written;
+
+    /** The number of records not synced yet. */
+    uint64_t pending;
+
+    /** The number of bytes of the log segments written since the snapshot. */
+    uint64_t log_bytes;
+
+    /** The number of syncs issued so far. */
+    uint64_t syncs;
+} dict_wal_t;
+
+/**
+ * @brief Opens a durable dict, recovering its entries from the newest
+ * snapshot and the log segments written since, the dict being sized for the
+ * snapshot upfront. A record torn by a crash ends the replay of its segment,
+ * and is cut from it.
+ *
+ * @param path The base path of the log segments and of the snapshot.
+ * @param policy One of the `DICT_WAL_SYNC_*` policies.
+ * @param batch The number of records grouped per sync, 0 for
+ * `DICT_WAL_BATCH`.
+ * @param allocator The allocator to use, `NULL` pointer for the standard one.
+ * @return The durable dict on success, `NULL` pointer on error.
+ */
+dict_wal_t *dict_wal_open(const char *path, int policy, uint64_t batch,
+    const dict_allocator_t *allocator);
+
+/**
+ * @brief Syncs the pending records, waits for the running compaction, and
+ * releases the durable dict.
+ *
+ * @param wal The durable dict to close.
+ * @return 0 on success, -1 if the pending records could not be synced.
+ */
+int dict_wal_close(dict_wal_t *wal);
+
+/**
+ * @brief Inserts a new entry inside the durable dict, copying the value, and
+ * logs it.
+ *
+ * @param wal The durable dict in which to insert the entry.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param value The value bytes.
+ * @param value_length The length of the value.
+ * @return 0 on success, -1 if the key is already present or on error. If only
+ * syncing the record failed, the entry is inserted nonetheless, its record
+ * staying pending.
+ */
+int dict_wal_insert(dict_wal_t *wal, const char *key, uint64_t key_length,
+    const void *value, uint64_t value_length);
+
+/**
+ * @brief Deletes an entry from the durable dict, and logs it.
+ *
+ * @param wal The durable dict from which to delete the entry.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @return 0 on success, -1 if the key was not found or on error. If only
+ * syncing the record failed, the entry is deleted nonetheless, its record
+ * staying pending.
+ */
+int dict_wal_delete(dict_wal_t *wal, const char *key, uint64_t key_length);
+
+/**
+ * @brief Looks up the value of the key.
+ *
+ * @param wal The durable dict to look up.
+ * @param key The key to look for.
+ * @param key_length The length of the key.
+ * @param value Where to store the value, valid until the entry is deleted,
+ * may be `NULL`.
+ * @return 0 if the key was found, -1 otherwise.
+ */
+int dict_wal_get(dict_wal_t *wal, const char *key, uint64_t key_length,
+    const dict_wal_value_t **value);
+
+/**
+ * @brief Writes and syncs the pending records, whatever the policy.
+ *
+ * @param wal The durable dict to sync.
+ * @return 0 on success, -1 on error.
+ */
+int dict_wal_sync(dict_wal_t *wal);
+
+/**
+ * @brief Starts a compaction in the background : the current log segment is
+ * closed, and a child process writes the snapshot covering it.
+ *
+ * @param wal The durable dict to compact.
+ * @return 0 on success, -1 if a compaction is running or on error.
+ */
+int dict_wal_compact(dict_wal_t *wal);
+
+/**
+ * @brief Waits for the running compaction, if any.
+ *
+ * @param wal The durable dict being compacted.
+ * @return 0 if no compaction was running or if it succeeded, -1 if it failed,
+ * in which case the next one covers its segments too.
+ */
+int dict_wal_compact_wait(dict_wal_t *wal);
+
+/** @cond INTERNAL */
+
+/**
+ * @brief Builds the path of a log segment, or of the snapshot if the
+ * generation is 0.
+ *
+ * @param path The base path.
+ * @param generation The generation of the segment, 0 for the snapshot.
+ * @param suffix Appended to the path, such as ".tmp".
+ * @param allocator The allocator of the path.
+ * @return The allocated path on success, `NULL` pointer on error.
+ */
+char *dict_wal_path(const char *path, uint64_t generation, const char *suffix,
+    const dict_allocator_t *allocator);
+
+/**
+ * @brief Appends a record to the log, writing and syncing it according to
+ * the policy.
+ *
+ * @param wal The durable dict being mutated.
+ * @param type The record type, `DICT_WAL_PUT` or `DICT_WAL_DELETE`.
+ * @param key The key of the record.
+ * @param key_length The length of the key.
+ * @param value The value of the record, for `DICT_WAL_PUT`.
+ * @return 0 on success, -1 if the record could not be logged, 1 if it was
+ * logged but could not be synced, in which case it stays pending.
+ */
+int dict_wal_append(dict_wal_t *wal, int type, const char *key,
+    uint64_t key_length, const dict_wal_value_t *value);
+
+/**
+ * @brief Writes the buffered records to the current log segment.
+ *
+ * @param wal The durable dict whose records to write.
+ * @param sync Whether to sync the segment to the disk afterwards.
+ * @return 0 on success, -1 on error. A failed write is cut from the segment,
+ * the records staying buffered.
+ */
+int dict_wal_flush(dict_wal_t *wal, int sync);
+
+/**
+ * @brief Encodes a record into a buffer of at least `DICT_WAL_RECORD_HEADER`
+ * plus key and value bytes.
+ *
+ * @param buffer Where to encode the record.
+ * @param type The record type.
+ * @param key The key of the record.
+ * @param key_length The length of the key.
+ * @param value The value of the record, `NULL` pointer for none.
+ * @return The number of bytes of the record.
+ */
+uint64_t dict_wal_encode(char *buffer, int type, const char *key,
+    uint64_t key_length, const dict_wal_value_t *value);
+
+/**
+ * @brief Applies the records of a mapped log segment or snapshot to the dict,
+ * stopping at the first torn or corrupted record.
+ *
+ * @param wal The durable dict being recovered.
+ * @param begin The first record.
+ * @param end The byte following the mapping.
+ * @return The number of bytes of valid records, -1 on error.
+ */
+int64_t dict_wal_replay(dict_wal_t *wal, const char *begin,
+    const char *end);
+
+/**
+ * @brief Creates a log segment, or empties it if it exists, writes its magic
+ * bytes, and syncs it along with its directory.
+ *
+ * @param path The base path.
+ * @param generation The generation of the segment.
+ * @param allocator The allocator of the path.
+ * @return The file descriptor of the segment, opened for appending, on
+ * success, -1 on error.
+ */
+int dict_wal_segment_ctor(const char *path, uint64_t generation,
+    const dict_allocator_t *allocator);
+
+/**
+ * @brief Syncs the directory holding the files of a durable dict, so that
+ * their creations, renames and removals reach the disk.
+ *
+ * @param path The base path.
+ * @param allocator The allocator of the directory path.
+ * @return 0 on success, -1 on error.
+ */
+int dict_wal_sync_dir(const char *path, const dict_allocator_t *allocator);
+
+/**
+ * @brief Rebuilds the dict from the snapshot and the log segments, and opens
+ * the segment receiving the next records.
+ *
+ * @param wal The durable dict being opened.
+ * @return 0 on success, -1 on error.
+ */
+int dict_wal_recover(dict_wal_t *wal);
+
+/**
+ * @brief Writes a snapshot of the live entries, covering the log segments up
+ * to the given generation, and removes these segments. Run by the compaction
+ * child process.
+ *
+ * @param wal The durable dict to snapshot.
+ * @param generation The last log segment covered by the snapshot.
+ * @return 0 on success, -1 on error.
+ */
+int dict_wal_write_snapshot(const dict_wal_t *wal, uint64_t generation);
+
+/**
+ * @brief Removes the log segments up to the given generation, the oldest
+ * first, so that an interrupted removal leaves no gap.
+ *
+ * @param path The base path.
+ * @param generation The last log segment to remove.
+ * @param allocator The allocator of the paths.
+ */
+void dict_wal_prune(const char *path, uint64_t generation,
+    const dict_allocator_t *allocator);
 
-    /**
-     * The keys in a string array of length 'size'.
-     *
-     * @attention DO NOT TRY TO FREE THE MEMORY OF ANY ITEM FROM THAT ARRAY.
-     */
-    const char **keys;
-} dict_keys_t;
+/**
+ * @brief Releases the value of an entry, the key bytes going with it.
+ *
+ * @param wal The durable dict owning the value.
+ * @param value The value to release.
+ */
+void dict_wal_value_dtor(const dict_wal_t *wal, dict_wal_value_t *value);
 
 /**
- * @brief Returns the list of the keys of the dict.
+ * @brief Copies a value and its key into a single block.
  *
- * If an error occured during the dict_keys_t object allocation, `NULL` pointer
- * is returned.
+ * @param wal The durable dict receiving the value.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param value The value bytes.
+ * @param value_length The length of the value.
+ * @return The value on success, `NULL` pointer on error.
+ */
+dict_wal_value_t *dict_wal_value_ctor(const dict_wal_t *wal, const char *key,
+    uint64_t key_length, const void *value, uint64_t value_length);
+
+/**
+ * @brief Inserts or replaces the value of a key, without logging it.
  *
- * The `dict_keys_t` object will have to be free using the `dict_free_keys`
- * function.
+ * @param wal The durable dict receiving the value.
+ * @param value The value, built by `dict_wal_value_ctor`.
+ * @param key_length The length of the key stored after the value.
+ * @return 0 on success, -1 on error, in which case the value is released.
+ */
+int dict_wal_put(dict_wal_t *wal, dict_wal_value_t *value,
+    uint64_t key_length);
+
+/**
+ * @brief Returns the key stored after a value.
+ */
+#define DICT_WAL_KEY(V) ((V)->data + (V)->length)
+
+/** @endcond INTERNAL */
+
+/**
+ * @brief The room reserved in the interning table for its lock, a
+ * `pthread_rwlock_t`.
+ */
+#define DICT_INTERN_LOCK_SIZE 64
+
+/**
+ * @brief An interned string.
+ */
+typedef struct s_dict_symbol {
+    /** The interned bytes, followed by a NUL byte. */
+    const char *string;
+
+    /** The length of the string, its NUL byte excluded. */
+    uint64_t length;
+} dict_symbol_t;
+
+/**
+ * @brief This structure represents a string interning table. Each distinct
+ * byte string is copied once, and given a dense `uint32_t` symbol ID, in
+ * interning order. The copies are never moved nor released before the table,
+ * so that their address is stable too.
  *
- * @warning If a `NULL` pointer is passed, or if the dict has already been
- * deallocated, the function will crash.
+ * Tables keyed on the symbol IDs, as 4 bytes binary keys, then hash and
+ * compare small keys whatever the length of the strings, and the string
+ * itself is only hashed when it's interned.
  *
- * @warning DO NOT TRY TO FREE ANY ITEM INSIDE THE `keys` MEMBER BY YOURSELF.
- * The `keys` array member contains references to the keys, not copies. If you
- * free one of them, it may break the whole dict object.
+ * The lookups may run concurrently, from several threads, with each other
+ * and with the insertions, which are serialized.
+ */
+typedef struct s_dict_intern {
+    /** The symbol ID of each string, stored inline, keyed by the copies. */
+    dict_t *dict;
+
+    /** The memory of the copies. */
+    dict_arena_t *arena;
+
+    /** The allocator carving the copies from the arena. */
+    dict_allocator_t strings;
+
+    /** The interned strings, indexed by their symbol ID. */
+    dict_symbol_t *symbols;
+
+    /** The number of interned strings. */
+    uint64_t count;
+
+    /** The number of slots of `symbols`. */
+    uint64_t capacity;
+
+    /** The lock, only used through the `dict_intern_*` calls. */
+    union {
+        unsigned char bytes[DICT_INTERN_LOCK_SIZE];
+        uint64_t align;
+    } lock;
+} dict_intern_t;
+
+/**
+ * @brief Allocates a new, empty, interning table.
  *
- * @note The list of keys is not ordered. The keys are taken from each bucket
- * from 0 to the size of the dict, and each of the bucket is iterated over from
- * head to tail (linked list). Knowing that the insertion depends on a hash, we
- * don't know the order in which the keys will appear in the list.
+ * @note If it failed, returns a `NULL` pointer.
  *
- * @param dict The dict from which to get the keys.
- * @return The list of keys.
+ * @return The allocated table.
  */
-dict_keys_t *dict_get_keys(const dict_t *dict);
+dict_intern_t *dict_intern_ctor(void);
 
 /**
- * @brief Release memory from `dict_get_keys` allocations.
+ * @brief Deallocates the interning table, along with the interned strings.
  *
- * If a `NULL` pointer is passed, or if the dict keys have already been
- * deallocated, the function will crash.
+ * @param intern The table to deallocate.
+ */
+void dict_intern_dtor(dict_intern_t *intern);
+
+/**
+ * @brief Returns the interning table shared by the whole process, built upon
+ * the first call and never deallocated.
  *
- * @param dict_keys The keys to free.
+ * @return The shared table, `NULL` pointer if it could not be built.
  */
-void dict_free_keys(dict_keys_t *dict_keys);
+dict_intern_t *dict_intern_global(void);
 
 /**
- * @brief This structure represents the values of the dict. It will be computed
- * each time the dict_values() function is called. It will not be used by other
- * function to operate on the dict, as the internal dict state is known by all
- * functions.
+ * @brief Returns the symbol ID of the string, interning it first if it's
+ * not interned yet.
+ *
+ * @param intern The interning table.
+ * @param string The bytes of the string, which are copied.
+ * @param length The length of the string.
+ * @param id Where to store the symbol ID.
+ * @return 0 on success, -1 on error or if every symbol ID is taken.
  */
-typedef struct s_dict_values {
-    /** Number of values. Same value as the 'items' dict_t member. */
-    uint64_t size;
+int dict_intern(dict_intern_t *intern, const char *string, uint64_t length,
+    uint32_t *id);
+
+/**
+ * @brief Looks up the symbol ID of the string, without interning it.
+ *
+ * @param intern The interning table.
+ * @param string The bytes of the string.
+ * @param length The length of the string.
+ * @param id Where to store the symbol ID, may be `NULL`.
+ * @return 0 if the string is interned, -1 otherwise.
+ */
+int dict_intern_find(dict_intern_t *intern, const char *string,
+    uint64_t length, uint32_t *id);
+
+/**
+ * @brief Returns the interned string of a symbol ID.
+ *
+ * @param intern The interning table.
+ * @param id The symbol ID.
+ * @param length Where to store the length of the string, may be `NULL`.
+ * @return The string, valid until the table is deallocated, `NULL` pointer
+ * if the ID is unknown.
+ */
+const char *dict_intern_string(dict_intern_t *intern, uint32_t id,
+    uint64_t *length);
+
+/**
+ * @brief Trace mode recording the bytes of the keys.
+ */
+#define DICT_TRACE_KEYS 0
+
+/**
+ * @brief Trace mode recording a 32 bits hash of the keys, along with their
+ * length, rather than their bytes. The seed of the hash is drawn when the
+ * recording starts and is not written, so that the trace can be shared
+ * without the keys, while equal keys still get equal hashes.
+ */
+#define DICT_TRACE_HASHES 1
+
+/**
+ * @brief Trace operation of the insertions : `dict_insert`, `dict_entry`,
+ * `dict_incr`, `dict_insert_ttl`, `dict_load_file` and their variants. An
+ * insertion finding the key already present is recorded as failed.
+ */
+#define DICT_TRACE_INSERT 1
+
+/**
+ * @brief Trace operation of `dict_delete` and `dict_delete_hashed`.
+ */
+#define DICT_TRACE_DELETE 2
+
+/**
+ * @brief Trace operation of the lookups : `dict_get`, `dict_has_key` and
+ * their hashed variants.
+ */
+#define DICT_TRACE_GET 3
+
+/**
+ * @brief Starts recording the insertions, deletions and lookups of the dict
+ * into a trace file, which is truncated first. Each record holds the
+ * operation, whether it failed, the time elapsed since the previous record,
+ * in nanoseconds, and the key, as set by `mode`. The records are buffered,
+ * and written by `DICT_TRACE_BUFFER` bytes.
+ *
+ * @note The clones of the dict are not recorded. If the dict is already
+ * recording, the current trace is stopped first.
+ *
+ * @param dict The dict to record.
+ * @param path The path of the trace file.
+ * @param mode `DICT_TRACE_KEYS` or `DICT_TRACE_HASHES`.
+ * @return 0 on success, -1 on error.
+ */
+int dict_trace_start(dict_t *dict, const char *path, int mode);
+
+/**
+ * @brief Stops recording the dict, writing the buffered records and closing
+ * the trace file. `dict_dtor` stops the recording too.
+ *
+ * @param dict The recorded dict.
+ * @return 0 on success, -1 if the dict was not recording or if a record
+ * could not be written, in which case the trace ends before it.
+ */
+int dict_trace_stop(dict_t *dict);
+
+/** @cond INTERNAL */
+
+/**
+ * @brief Appends a record to the trace of the dict. A failed write stops the
+ * recording, until `dict_trace_stop` reports it.
+ *
+ * @param dict The recorded dict.
+ * @param op The operation, see `DICT_TRACE_INSERT`.
+ * @param key The key of the operation.
+ * @param key_length The length of the key.
+ * @param status The value returned by the operation.
+ */
+void dict_trace_record(dict_t *dict, int op, const char *key,
+    uint64_t key_length, int status);
+
+/**
+ * @brief Writes the buffered records of a trace.
+ *
+ * @param trace The trace recorder.
+ * @return 0 on success, -1 on error, in which case the recording stops.
+ */
+int dict_trace_flush(dict_trace_t *trace);
+
+/** @endcond INTERNAL */
+
+/**
+ * @brief An operation read from a trace file.
+ */
+typedef struct s_dict_trace_op {
+    /** The operation, see `DICT_TRACE_INSERT`. */
+    int op;
+
+    /** Whether the call failed when it was recorded. */
+    int failed;
+
+    /** The date of the operation, in nanoseconds since the first one. */
+    uint64_t time;
 
     /**
-     * The values in a string array of length 'size'.
-     *
-     * @attention DO NOT TRY TO FREE THE MEMORY OF ANY ITEM FROM THAT ARRAY.
+     * The key, or for the traces of hashes, a key made of the 4 bytes of the
+     * hash, padded with zeroes up to the recorded length if it's longer.
      */
-    const void **values;
-} dict_values_t;
+    const char *key;
+
+    /** The length of the key. */
+    uint64_t key_length;
+} dict_trace_op_t;
 
 /**
- * @brief Returns the list of the values of the dict.
+ * @brief The operations of a trace file, see `dict_trace_load`.
+ */
+typedef struct s_dict_trace_ops {
+    /** The number of operations. */
+    uint64_t count;
+
+    /** The operations, in recording order. */
+    dict_trace_op_t *ops;
+
+    /** The mode of the trace, `DICT_TRACE_KEYS` or `DICT_TRACE_HASHES`. */
+    int mode;
+
+    /** The mapped trace file, the keys of `DICT_TRACE_KEYS` point in it. */
+    void *mapping;
+
+    /** The length of the mapping. */
+    uint64_t length;
+
+    /** The keys made for a trace of hashes, `NULL` pointer otherwise. */
+    char *keys;
+} dict_trace_ops_t;
+
+/**
+ * @brief Loads the operations of a trace file, to replay them. The keys stay
+ * valid until `dict_trace_ops_free`, so that they can be inserted into a dict.
+ * A record cut by a crash ends the trace.
  *
- * If an error occured during the dict_values_t object allocation, `NULL`
- * pointer is returned.
+ * @param path The path of the trace file.
+ * @return The operations on success, `NULL` pointer on error or if the file
+ * is not a trace.
+ */
+dict_trace_ops_t *dict_trace_load(const char *path);
+
+/**
+ * @brief Releases the operations loaded by `dict_trace_load`.
  *
- * The `dict_values_t` object will have to be free using the `dict_free_values`
- * function.
+ * @param ops The operations to release.
+ */
+void dict_trace_ops_free(dict_trace_ops_t *ops);
+
+/**
+ * @brief Enables the ordered index of the dict, a radix tree over its keys
+ * kept in sync by the insertions and the deletions. It serves the prefix and
+ * range scans and the sorted export of the keys, the lookups still going
+ * through the buckets.
  *
- * @warning If a `NULL` pointer is passed, or if the dict has already been
- * deallocated, the function will crash.
+ * @note If the index is already enabled, nothing is done and 0 is returned.
+ * The clones of the dict start without index.
  *
- * @warning DO NOT TRY TO FREE ANY ITEM INSIDE THE `values` MEMBER BY YOURSELF.
- * The `values` array member contains references to the values, not copies. If
- * you free one of them, it may break the whole dict object.
+ * @param dict The dict on which to enable the index.
+ * @return 0 on success, -1 on error.
+ */
+int dict_enable_index(dict_t *dict);
+
+/**
+ * @brief Disables and releases the ordered index, if any.
  *
- * @note The list of values is not ordered. The values are taken from each
- * bucket from 0 to the size of the dict, and each of the bucket is iterated
- * over from head to tail (linked list). Knowing that the insertion depends on
- * a hash, we don't know the order in which the values will appear in the list.
+ * @param dict The dict on which to disable the index.
+ */
+void dict_disable_index(dict_t *dict);
+
+/**
+ * @brief Calls `scan` on each entry whose key starts with `prefix`, in keys
+ * order (bytes compared as unsigned, a key coming before its extensions).
+ * Only the part of the index under the prefix is visited.
+ *
+ * @param dict The dict to scan.
+ * @param prefix The prefix of the keys to visit.
+ * @param prefix_length The length of the prefix, 0 to visit every entry.
+ * @param scan The function to call on the entries.
+ * @param ctx The context given to `scan`.
+ * @return 0 on success, -1 if the index is not enabled.
+ */
+int dict_scan_prefix(const dict_t *dict, const char *prefix,
+    uint64_t prefix_length, scan_pair_t scan, void *ctx);
+
+/**
+ * @brief Calls `scan` on each entry whose key is within `[from, to)`, in keys
+ * order.
+ *
+ * @param dict The dict to scan.
+ * @param from The lowest key to visit, `NULL` pointer to start from the first.
+ * @param from_length The length of `from`.
+ * @param to The key to stop at, `NULL` pointer to go up to the last.
+ * @param to_length The length of `to`.
+ * @param scan The function to call on the entries.
+ * @param ctx The context given to `scan`.
+ * @return 0 on success, -1 if the index is not enabled.
+ */
+int dict_scan_range(const dict_t *dict, const char *from,
+    uint64_t from_length, const char *to, uint64_t to_length,
+    scan_pair_t scan, void *ctx);
+
+/**
+ * @brief Returns the list of the keys of the dict, sorted. It has to be
+ * released with `dict_free_keys`.
  *
- * @param dict The dict from which to get the values.
- * @return The list of values.
+ * @note If the index is not enabled, or if an allocation failed, returns a
+ * `NULL` pointer.
+ *
+ * @param dict The dict to get the keys from.
+ * @return The sorted keys of the dict.
  */
-dict_values_t *dict_get_values(const dict_t *dict);
+dict_keys_t *dict_get_sorted_keys(const dict_t *dict);
+
+/** @cond INTERNAL */
 
 /**
- * @brief Release memory from `dict_get_values` allocations.
+ * @brief The state of a scan of the ordered index.
+ */
+typedef struct s_dict_index_scan {
+    /** The scanned dict. */
+    const dict_t *dict;
+
+    /** The lowest key to visit, `NULL` pointer if none. */
+    const char *from;
+
+    /** The length of `from`. */
+    uint64_t from_length;
+
+    /** The key to stop at, or the prefix, `NULL` pointer if none. */
+    const char *to;
+
+    /** The length of `to`. */
+    uint64_t to_length;
+
+    /** Whether `to` is a prefix every visited key starts with. */
+    int prefix;
+
+    /** The date the expired entries are skipped against. */
+    uint64_t now;
+
+    /** The function to call on the entries. */
+    scan_pair_t scan;
+
+    /** The context given to `scan`. */
+    void *ctx;
+} dict_index_scan_t;
+
+/**
+ * @brief Allocates an empty ordered index.
  *
- * If a `NULL` pointer is passed, or if the dict values have already been
- * deallocated, the function will crash.
+ * @param allocator The allocator of the index.
+ * @return The index, `NULL` pointer on error.
+ */
+dict_index_t *dict_index_ctor(const dict_allocator_t *allocator);
+
+/**
+ * @brief Releases the ordered index, a `NULL` pointer being ignored.
  *
- * @param dict_values The values to free.
+ * @param index The index to release.
  */
-void dict_free_values(dict_values_t *dict_values);
+void dict_index_dtor(dict_index_t *index);
+
+/**
+ * @brief Releases a subtree of the ordered index.
+ *
+ * @param index The index holding the subtree.
+ * @param node The root of the subtree, a node, a tagged leaf or `NULL`.
+ */
+void dict_index_release(dict_index_t *index, void *node);
+
+/**
+ * @brief Adds a key to the ordered index. On error, the index is unchanged.
+ *
+ * @param index The index receiving the key.
+ * @param key The key, which must outlive its presence in the index.
+ * @param key_length The length of the key.
+ * @return 0 on success, -1 on error.
+ */
+int dict_index_insert(dict_index_t *index, const char *key,
+    uint64_t key_length);
+
+/**
+ * @brief Removes a key from the ordered index.
+ *
+ * @param index The index holding the key.
+ * @param key The key to remove.
+ * @param key_length The length of the key.
+ * @return 0 on success, -1 if the key was not found.
+ */
+int dict_index_delete(dict_index_t *index, const char *key,
+    uint64_t key_length);
+
+/**
+ * @brief Allocates an ordered index node without children.
+ *
+ * @param index The index the node belongs to.
+ * @param type The kind of node, `DICT_INDEX_NODE4` to `DICT_INDEX_NODE256`.
+ * @return The node, `NULL` pointer on error.
+ */
+dict_index_node_t *dict_index_node_ctor(dict_index_t *index, int type);
+
+/**
+ * @brief Releases an ordered index node, leaving its children alone.
+ *
+ * @param index The index the node belongs to.
+ * @param node The node to release.
+ */
+void dict_index_node_dtor(dict_index_t *index, dict_index_node_t *node);
+
+/**
+ * @brief Returns the address of the child of the node for the given byte.
+ *
+ * @param node The node to look into.
+ * @param byte The byte of the child.
+ * @return The address of the child, `NULL` pointer if there is none.
+ */
+void **dict_index_find_child(dict_index_node_t *node, unsigned char byte);
+
+/**
+ * @brief Adds a child to the node, which is replaced by a larger one if it's
+ * full. On error, the node is unchanged.
+ *
+ * @param index The index the node belongs to.
+ * @param ref The address of the pointer to the node.
+ * @param byte The byte of the child, which must not have one yet.
+ * @param child The child to add.
+ * @return 0 on success, -1 on error.
+ */
+int dict_index_add_child(dict_index_t *index, void **ref, unsigned char byte,
+    void *child);
+
+/**
+ * @brief Removes a child from the node, which is then replaced by a smaller
+ * one if it has become sparse, and collapsed if it has a single entry left.
+ *
+ * @param index The index the node belongs to.
+ * @param ref The address of the pointer to the node.
+ * @param byte The byte of the child to remove.
+ */
+void dict_index_remove_child(dict_index_t *index, void **ref,
+    unsigned char byte);
+
+/**
+ * @brief Replaces a node holding a single entry by that entry, merging the
+ * compressed paths, or a node holding nothing by a `NULL` pointer.
+ *
+ * @param index The index the node belongs to.
+ * @param ref The address of the pointer to the node.
+ */
+void dict_index_collapse(dict_index_t *index, void **ref);
+
+/**
+ * @brief Returns the first child of the node whose byte is `*byte` or more,
+ * so that the children are iterated in bytes order by incrementing `*byte`
+ * between calls, up to 256.
+ *
+ * @param node The node to look into.
+ * @param byte The lowest byte to look for, replaced by the one of the child.
+ * @return The address of the child, `NULL` pointer if there is none.
+ */
+void **dict_index_next_child(const dict_index_node_t *node,
+    unsigned int *byte);
+
+/**
+ * @brief Returns the leaf of the smallest key of a subtree. Every key of the
+ * subtree holds the compressed paths leading to it.
+ *
+ * @param node The root of the subtree, a node or a tagged leaf.
+ * @return The leaf of the smallest key.
+ */
+const dict_index_leaf_t *dict_index_minimum(const void *node);
+
+/**
+ * @brief Returns the number of bytes of the compressed path of the node the
+ * key matches, from the given depth.
+ *
+ * @param node The node whose path to compare.
+ * @param key The key to compare.
+ * @param key_length The length of the key.
+ * @param depth The number of bytes of the key consumed by the parents.
+ * @return The number of matching bytes, `prefix_length` if the whole path
+ * matched.
+ */
+uint64_t dict_index_prefix_mismatch(const dict_index_node_t *node,
+    const char *key, uint64_t key_length, uint64_t depth);
+
+/**
+ * @brief Visits a subtree of the ordered index in keys order.
+ *
+ * @param scan The state of the scan.
+ * @param node The root of the subtree, a node, a tagged leaf or `NULL`.
+ * @param depth The number of bytes of the keys consumed by the parents.
+ * @param bounded Whether the consumed bytes equal the ones of `from`, in which
+ * case the keys lower than `from` are skipped.
+ * @return Non-zero if the scan stopped, 0 otherwise.
+ */
+int dict_index_walk(dict_index_scan_t *scan, const void *node,
+    uint64_t depth, int bounded);
+
+/** @endcond INTERNAL */
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif /* !__DICT_H_ */
@@ -0,0 +1,448 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict.hpp
+** File description:
+** Header-only C++ front-end of the dict, specialized at compile time on its
+** key and value types.
+*/
+
+#ifndef __DICT_HPP_
+#define __DICT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "dict.h"
+
+namespace dict {
+
+/** @cond INTERNAL */
+
+namespace detail {
+
+/**
+ * @brief The MurmurHash1 algorithm, as used by the C library, so that it can
+ * be inlined into the lookups.
+ *
+ * @param key The key to hash.
+ * @param length The length of the key.
+ * @param seed The seed to use for the hash.
+ * @return The hash result.
+ */
+inline std::uint32_t murmurhash1(const void *key, std::size_t length,
+    std::uint32_t seed) noexcept
+{
+    constexpr std::uint32_t m = 0xc6a4a793;
+    constexpr int r = 16;
+    std::uint32_t h = seed ^ (static_cast<std::uint32_t>(length) * m);
+    const unsigned char *data = static_cast<const unsigned char *>(key);
+    std::uint32_t block = 0;
+
+    for (; sizeof(block) <= length; length -= sizeof(block)) {
+        std::memcpy(&block, data, sizeof(block));
+        h += block;
+        h *= m;
+        h ^= h >> r;
+        data += sizeof(block);
+    }
+    if (3 == length)
+        h += data[2] << 16;
+    if (2 <= length)
+        h += data[1] << 8;
+    if (1 <= length) {
+        h += data[0];
+        h *= m;
+        h ^= h >> r;
+    }
+    h *= m;
+    h ^= h >> 10;
+    h *= m;
+    h ^= h >> 17;
+    return h;
+}
+
+/**
+ * @brief Rounds the number of buckets up to a power of 2, so that the bucket
+ * index is a mask rather than a modulo.
+ *
+ * @param size The requested number of buckets.
+ * @return The actual number of buckets to use.
+ */
+constexpr std::size_t round_size(std::size_t size) noexcept
+{
+    std::size_t rounded = 1;
+
+    if (size < DICT_MIN_SIZE)
+        return DICT_MIN_SIZE;
+    while (rounded < size)
+        rounded <<= 1;
+    return rounded;
+}
+
+} // namespace detail
+
+/** @endcond INTERNAL */
+
+/**
+ * @brief The default hash of the map keys. Only the specializations below are
+ * defined, any other key type must come with its own hash.
+ */
+template <typename K, typename = void>
+struct hash;
+
+/**
+ * @brief Hashes the string-like keys with MurmurHash1. Being transparent, a
+ * map of `std::string` can be queried with a `std::string_view` or a C string
+ * without building a temporary string.
+ */
+template <typename K>
+struct hash<K, std::enable_if_t<
+    std::is_convertible_v<const K &, std::string_view>>> {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view key) const noexcept
+    {
+        return detail::murmurhash1(key.data(), key.size(), HASH_SEED);
+    }
+};
+
+/**
+ * @brief Hashes the integral keys with a multiplicative mix, whose high bits
+ * are folded into the low bits used as the bucket index.
+ */
+template <typename K>
+struct hash<K, std::enable_if_t<std::is_integral_v<K>>> {
+    std::size_t operator()(K key) const noexcept
+    {
+        std::uint64_t mixed = static_cast<std::uint64_t>(key) * \
+            0x9E3779B97F4A7C15ULL;
+
+        return static_cast<std::size_t>(mixed ^ (mixed >> 32));
+    }
+};
+
+/**
+ * @brief The default comparison of the map keys.
+ */
+template <typename K, typename = void>
+struct equal_to : std::equal_to<> {
+};
+
+/**
+ * @brief Compares the string-like keys by content, including C strings,
+ * transparently.
+ */
+template <typename K>
+struct equal_to<K, std::enable_if_t<
+    std::is_convertible_v<const K &, std::string_view>>> {
+    using is_transparent = void;
+
+    bool operator()(std::string_view lhs, std::string_view rhs) const noexcept
+    {
+        return lhs == rhs;
+    }
+};
+
+/**
+ * @brief This class is the C++ counterpart of `dict_t`. It keeps the table
+ * design of the library (chained buckets, new entries prepended, a power of 2
+ * number of buckets, grown and shrunk according to `DICT_HIGH` and
+ * `DICT_LOW`), but the hash and the comparison are template parameters, so
+ * they are inlined into every operation.
+ *
+ * Entries are constructed in place inside their node, values only need to be
+ * movable, and they are destroyed with the map rather than through a
+ * `free_pair_t` function.
+ *
+ * @tparam K The key type.
+ * @tparam V The value type.
+ * @tparam Hash The hash of the keys.
+ * @tparam Eq The comparison of the keys.
+ */
+template <typename K, typename V, typename Hash = dict::hash<K>,
+    typename Eq = dict::equal_to<K>>
+class map {
+    /**
+     * @brief An entry of the map, linked to the next entry of its bucket.
+     * The hash is stored so that neither the resizes nor the mismatching
+     * lookups have to compare or re-hash the keys.
+     */
+    struct node {
+        node *next;
+        std::size_t hash;
+        K key;
+        V value;
+
+        template <typename KK, typename... Args>
+        node(node *next, std::size_t hash, KK &&key, Args &&...args) :
+            next(next), hash(hash), key(std::forward<KK>(key)),
+            value(std::forward<Args>(args)...)
+        {
+        }
+    };
+
+public:
+    map() : _buckets(new node *[DICT_MIN_SIZE]()), _size(DICT_MIN_SIZE)
+    {
+    }
+
+    /**
+     * @brief Builds a map able to hold `count` entries without resizing.
+     *
+     * @param count The number of entries to reserve.
+     */
+    explicit map(std::size_t count) : map()
+    {
+        reserve(count);
+    }
+
+    map(const map &) = delete;
+    map &operator=(const map &) = delete;
+
+    map(map &&other) noexcept : _buckets(std::move(other._buckets)),
+        _size(other._size), _items(other._items),
+        _hash(std::move(other._hash)), _eq(std::move(other._eq))
+    {
+        other._size = 0;
+        other._items = 0;
+    }
+
+    map &operator=(map &&other) noexcept
+    {
+        if (this != &other) {
+            clear();
+            _buckets = std::move(other._buckets);
+            _size = other._size;
+            _items = other._items;
+            _hash = std::move(other._hash);
+            _eq = std::move(other._eq);
+            other._size = 0;
+            other._items = 0;
+        }
+        return *this;
+    }
+
+    ~map()
+    {
+        clear();
+    }
+
+    /**
+     * @brief Constructs the value of `key` in place, from `args`, unless the
+     * key is already present.
+     *
+     * @param key The key of the entry.
+     * @param args The arguments given to the value constructor.
+     * @return The value of the entry, and whether it was inserted.
+     */
+    template <typename KK, typename... Args>
+    std::pair<V &, bool> try_emplace(KK &&key, Args &&...args)
+    {
+        std::size_t key_hash = _hash(key);
+        node *found = find_node(key, key_hash);
+
+        if (nullptr != found)
+            return { found->value, false };
+        if (must_grow())
+            rehash(_size * DICT_RESIZE_FACTOR);
+        node *&bucket = _buckets[key_hash & (_size - 1)];
+        bucket = new node(bucket, key_hash, std::forward<KK>(key),
+            std::forward<Args>(args)...);
+        ++_items;
+        return { bucket->value, true };
+    }
+
+    /**
+     * @brief Inserts the entry unless the key is already present, in which
+     * case the given value is dropped.
+     *
+     * @return The value of the entry, and whether it was inserted.
+     */
+    std::pair<V &, bool> insert(K key, V value)
+    {
+        return try_emplace(std::move(key), std::move(value));
+    }
+
+    /**
+     * @brief Returns the value of `key`, default-constructed if the key was
+     * not present.
+     */
+    template <typename KK>
+    V &operator[](KK &&key)
+    {
+        return try_emplace(std::forward<KK>(key)).first;
+    }
+
+    /**
+     * @brief Looks up the value of `key`.
+     *
+     * @return A pointer to the value, `nullptr` if the key is not present.
+     */
+    template <typename Q>
+    V *find(const Q &key) noexcept
+    {
+        node *found = find_node(key, _hash(key));
+
+        return nullptr == found ? nullptr : &found->value;
+    }
+
+    template <typename Q>
+    const V *find(const Q &key) const noexcept
+    {
+        return const_cast<map *>(this)->find(key);
+    }
+
+    template <typename Q>
+    bool contains(const Q &key) const noexcept
+    {
+        return nullptr != find(key);
+    }
+
+    /**
+     * @brief Destroys the entry of `key`, shrinking the map first if it has
+     * become too sparse.
+     *
+     * @return Whether the key was present.
+     */
+    template <typename Q>
+    bool erase(const Q &key)
+    {
+        std::size_t key_hash = _hash(key);
+        node **link = nullptr;
+        node *found = nullptr;
+
+        if (0 == _size)
+            return false;
+        if (_size > DICT_MIN_SIZE && \
+            static_cast<float>(_items) / _size < DICT_LOW)
+            rehash(_items * DICT_RESIZE_FACTOR);
+        link = &_buckets[key_hash & (_size - 1)];
+        for (; nullptr != *link; link = &(*link)->next)
+            if (key_hash == (*link)->hash && _eq((*link)->key, key))
+                break;
+        if (nullptr == *link)
+            return false;
+        found = *link;
+        *link = found->next;
+        delete found;
+        --_items;
+        return true;
+    }
+
+    /**
+     * @brief Makes sure `count` more entries can be inserted without a resize.
+     */
+    void reserve(std::size_t count)
+    {
+        std::size_t new_size = (_items + count) / DICT_HIGH + 1;
+
+        if (new_size > _size)
+            rehash(new_size);
+    }
+
+    /**
+     * @brief Destroys every entry, the buckets array being kept.
+     */
+    void clear() noexcept
+    {
+        node *next = nullptr;
+
+        for (std::size_t index = 0; index < _size; ++index) {
+            for (node *entry = _buckets[index]; nullptr != entry;
+                entry = next) {
+                next = entry->next;
+                delete entry;
+            }
+            _buckets[index] = nullptr;
+        }
+        _items = 0;
+    }
+
+    /**
+     * @brief Calls `function(key, value)` on every entry, in buckets order.
+     */
+    template <typename F>
+    void for_each(F &&function)
+    {
+        for (std::size_t index = 0; index < _size; ++index)
+            for (node *entry = _buckets[index]; nullptr != entry;
+                entry = entry->next)
+                function(static_cast<const K &>(entry->key), entry->value);
+    }
+
+    std::size_t size() const noexcept
+    {
+        return _items;
+    }
+
+    bool empty() const noexcept
+    {
+        return 0 == _items;
+    }
+
+    std::size_t bucket_count() const noexcept
+    {
+        return _size;
+    }
+
+private:
+    template <typename Q>
+    node *find_node(const Q &key, std::size_t key_hash) const noexcept
+    {
+        node *entry = nullptr;
+
+        if (0 == _size)
+            return nullptr;
+        entry = _buckets[key_hash & (_size - 1)];
+        for (; nullptr != entry; entry = entry->next)
+            if (key_hash == entry->hash && _eq(entry->key, key))
+                return entry;
+        return nullptr;
+    }
+
+    bool must_grow() const noexcept
+    {
+        return 0 == _size || \
+            static_cast<float>(_items) / _size > DICT_HIGH;
+    }
+
+    /**
+     * @brief Relinks every node into a new buckets array, using the stored
+     * hashes. Only the buckets array is allocated, so a failure leaves the map
+     * untouched.
+     */
+    void rehash(std::size_t new_size)
+    {
+        std::unique_ptr<node *[]> new_buckets = nullptr;
+        node *next = nullptr;
+
+        new_size = detail::round_size(new_size);
+        new_buckets.reset(new node *[new_size]());
+        for (std::size_t index = 0; index < _size; ++index)
+            for (node *entry = _buckets[index]; nullptr != entry;
+                entry = next) {
+                next = entry->next;
+                entry->next = new_buckets[entry->hash & (new_size - 1)];
+                new_buckets[entry->hash & (new_size - 1)] = entry;
+            }
+        _buckets = std::move(new_buckets);
+        _size = new_size;
+    }
+
+    std::unique_ptr<node *[]> _buckets;
+    std::size_t _size = 0;
+    std::size_t _items = 0;
+    Hash _hash;
+    Eq _eq;
+};
+
+} // namespace dict
+
+#endif /* !__DICT_HPP_ */
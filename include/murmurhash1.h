@@ -15,6 +15,9 @@
 #define M 0xc6a4a793
 #define C sizeof(uint32_t)
 
+/** The most keys `murmurhash1_many` hashes at once, for AVX-512. */
+#define MURMURHASH1_MAX_LANES 16
+
 /**
  * @brief Computes the padding of the hash when it's length is not % uint32_t.
  *
@@ -35,4 +38,18 @@ uint32_t compute_padding(const uint8_t *data, uint64_t length, uint32_t h);
  */
 uint32_t murmurhash1(const void *key, uint64_t length, uint32_t seed);
 
+/**
+ * @brief Hashes several keys, `MURMURHASH1_MAX_LANES` at most at once, in the
+ * SIMD lanes of the running CPU (AVX-512, AVX2 or NEON), falling back to
+ * `murmurhash1` otherwise. The results are the ones of `murmurhash1`.
+ *
+ * @param keys The keys to hash.
+ * @param lengths The length of each key.
+ * @param count The number of keys.
+ * @param seed The seed to use for the hashes.
+ * @param hashes Where to store the `count` hashes.
+ */
+void murmurhash1_many(const void *const *keys, const uint64_t *lengths,
+    uint64_t count, uint32_t seed, uint32_t *hashes);
+
 #endif /* !__MURMURHASH1_H_ */
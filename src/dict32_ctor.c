@@ -0,0 +1,31 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict32_ctor.c
+** File description:
+** Exposes the compact dict object constructor.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+dict32_t *dict32_ctor(const dict_allocator_t *allocator)
+{
+    dict32_t *dict = NULL;
+
+    if (NULL == allocator)
+        allocator = dict_std_allocator();
+    dict = (dict32_t *) dict_alloc(allocator, 1, sizeof(dict32_t));
+    if (NULL == dict)
+        return NULL;
+    dict->allocator = *allocator;
+    dict->heads = (uint32_t *) dict_alloc_large(allocator, DICT_MIN_SIZE,
+        sizeof(uint32_t));
+    if (NULL == dict->heads) {
+        dict_free(allocator, dict);
+        return NULL;
+    }
+    memset(dict->heads, 0xff, DICT_MIN_SIZE * sizeof(uint32_t));
+    dict->size = DICT_MIN_SIZE;
+    dict->free_list = DICT32_NIL;
+    return dict;
+}
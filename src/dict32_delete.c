@@ -0,0 +1,42 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict32_delete.c
+** File description:
+** Exposes a function used to delete an entry from a compact dict.
+*/
+
+#include "dict.h"
+#include "murmurhash1.h"
+
+int dict32_delete(dict32_t *dict, char *key, uint64_t key_length,
+    free_pair_t free_pair)
+{
+    uint32_t key_hash = 0;
+    uint32_t *link = NULL;
+    uint32_t index = 0;
+    dict32_entry_t *entry = NULL;
+
+    if (DICT_MUST_SHRINK(dict))
+        dict32_resize_to(dict, dict->items * DICT_RESIZE_FACTOR);
+    key_hash = murmurhash1(key, key_length, HASH_SEED);
+    link = &(dict->heads[DICT_BUCKET_IDX(key_hash, dict->size)]);
+    while (DICT32_NIL != *link) {
+        entry = &(dict->entries[*link]);
+        if (key_length == entry->key_length && \
+            0 == memcmp(entry->key, key, key_length))
+            break;
+        link = &(entry->next);
+    }
+    if (DICT32_NIL == *link)
+        return -1;
+    if (NULL != free_pair)
+        free_pair(entry->key, entry->value);
+    index = *link;
+    *link = entry->next;
+    entry->key = NULL;
+    entry->value = NULL;
+    entry->next = dict->free_list;
+    dict->free_list = index;
+    --dict->items;
+    return 0;
+}
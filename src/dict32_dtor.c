@@ -0,0 +1,24 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict32_dtor.c
+** File description:
+** Exposes the compact dict object destructor.
+*/
+
+#include "dict.h"
+
+void dict32_dtor(dict32_t *dict, free_pair_t free_pair)
+{
+    dict_allocator_t allocator = dict->allocator;
+    uint32_t index = 0;
+
+    if (NULL != free_pair)
+        for (; index < dict->used; ++index)
+            if (NULL != dict->entries[index].key)
+                free_pair(dict->entries[index].key,
+                    dict->entries[index].value);
+    dict_free_large(&allocator, dict->entries, dict->capacity,
+        sizeof(dict32_entry_t));
+    dict_free_large(&allocator, dict->heads, dict->size, sizeof(uint32_t));
+    dict_free(&allocator, dict);
+}
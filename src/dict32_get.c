@@ -0,0 +1,20 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict32_get.c
+** File description:
+** Exposes a function used to look up a value in a compact dict.
+*/
+
+#include "dict.h"
+
+int dict32_get(const dict32_t *dict, const char *key, uint64_t key_length,
+    void **value)
+{
+    uint32_t index = dict32_find(dict, key, key_length);
+
+    if (DICT32_NIL == index)
+        return -1;
+    if (NULL != value)
+        *value = dict->entries[index].value;
+    return 0;
+}
@@ -0,0 +1,14 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict32_has_key.c
+** File description:
+** Exposes a function used to check whether a key is in a compact dict.
+*/
+
+#include "dict.h"
+
+int dict32_has_key(const dict32_t *dict, const char *key,
+    uint64_t key_length)
+{
+    return DICT32_NIL != dict32_find(dict, key, key_length);
+}
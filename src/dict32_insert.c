@@ -0,0 +1,58 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict32_insert.c
+** File description:
+** Exposes a function used to insert an entry inside a compact dict.
+*/
+
+#include "dict.h"
+#include "murmurhash1.h"
+
+/**
+ * @brief Takes an entry from the free list, or from the end of the pool,
+ * growing it if it's full.
+ *
+ * @param dict The compact dict receiving a new entry.
+ * @return The index of the entry, `DICT32_NIL` on error.
+ */
+static
+uint32_t dict32_take_entry(dict32_t *dict)
+{
+    uint32_t index = dict->free_list;
+
+    if (DICT32_NIL != index) {
+        dict->free_list = dict->entries[index].next;
+        return index;
+    }
+    if (dict->used == dict->capacity && \
+        -1 == dict32_pool_reserve(dict, (uint64_t) dict->used + 1))
+        return DICT32_NIL;
+    return dict->used++;
+}
+
+int dict32_insert(dict32_t *dict, char *key, uint64_t key_length,
+    void *value)
+{
+    uint32_t key_hash = 0;
+    uint32_t *head = NULL;
+    uint32_t index = 0;
+
+    if (NULL == key || key_length >= UINT32_MAX || \
+        DICT32_NIL != dict32_find(dict, key, key_length))
+        return -1;
+    if (DICT_MUST_GROW(dict) && \
+        -1 == dict32_resize_to(dict, dict->size * DICT_RESIZE_FACTOR))
+        return -1;
+    index = dict32_take_entry(dict);
+    if (DICT32_NIL == index)
+        return -1;
+    key_hash = murmurhash1(key, key_length, HASH_SEED);
+    head = &(dict->heads[DICT_BUCKET_IDX(key_hash, dict->size)]);
+    dict->entries[index].key = key;
+    dict->entries[index].value = value;
+    dict->entries[index].key_length = (uint32_t) key_length;
+    dict->entries[index].next = *head;
+    *head = index;
+    ++dict->items;
+    return 0;
+}
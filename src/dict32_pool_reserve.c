@@ -0,0 +1,60 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict32_pool_reserve.c
+** File description:
+** Exposes a function used to grow the pool of entries of a compact dict.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Allocates a new pool and moves the entries into it. Used when the
+ * pool does not exist yet, or when the allocator has a large array path, which
+ * cannot resize allocations.
+ *
+ * @param dict The compact dict whose pool to grow.
+ * @param new_capacity The number of entries of the new pool.
+ * @return The new pool on success, `NULL` pointer on error.
+ */
+static
+dict32_entry_t *dict32_pool_move(dict32_t *dict, uint64_t new_capacity)
+{
+    dict32_entry_t *entries = (dict32_entry_t *) dict_alloc_large(
+        &(dict->allocator), new_capacity, sizeof(dict32_entry_t));
+
+    if (NULL == entries || NULL == dict->entries)
+        return entries;
+    memcpy(entries, dict->entries, dict->used * sizeof(dict32_entry_t));
+    dict_free_large(&(dict->allocator), dict->entries, dict->capacity,
+        sizeof(dict32_entry_t));
+    return entries;
+}
+
+int dict32_pool_reserve(dict32_t *dict, uint64_t capacity)
+{
+    uint64_t new_capacity = 0 != dict->capacity ? dict->capacity : \
+        DICT32_MIN_POOL;
+    dict32_entry_t *entries = NULL;
+
+    if (capacity <= dict->capacity)
+        return 0;
+    if (capacity >= DICT32_NIL)
+        return -1;
+    while (new_capacity < capacity)
+        new_capacity <<= 1;
+    if (new_capacity >= DICT32_NIL)
+        new_capacity = DICT32_NIL - 1;
+    if (NULL == dict->entries || NULL != dict->allocator.allocate_large)
+        entries = dict32_pool_move(dict, new_capacity);
+    else
+        entries = (dict32_entry_t *) dict->allocator.reallocate(
+            dict->allocator.ctx, dict->entries,
+            dict->capacity * sizeof(dict32_entry_t),
+            new_capacity * sizeof(dict32_entry_t));
+    if (NULL == entries)
+        return -1;
+    dict->entries = entries;
+    dict->capacity = new_capacity;
+    return 0;
+}
@@ -0,0 +1,19 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict32_reserve.c
+** File description:
+** Exposes a function used to pre-size a compact dict.
+*/
+
+#include "dict.h"
+
+int dict32_reserve(dict32_t *dict, uint64_t count)
+{
+    uint64_t new_size = (uint64_t) ((dict->items + count) / DICT_HIGH) + 1;
+
+    if (-1 == dict32_pool_reserve(dict, dict->items + count))
+        return -1;
+    if (new_size <= dict->size)
+        return 0;
+    return dict32_resize_to(dict, new_size);
+}
@@ -0,0 +1,38 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict32_resize_to.c
+** File description:
+** Exposes a function used to resize the buckets array of a compact dict.
+*/
+
+#include <string.h>
+#include "dict.h"
+#include "murmurhash1.h"
+
+int dict32_resize_to(dict32_t *dict, uint64_t new_size)
+{
+    uint32_t index = 0;
+    uint32_t key_hash = 0;
+    uint32_t *heads = NULL;
+    dict32_entry_t *entry = NULL;
+
+    new_size = dict_round_size(new_size);
+    heads = (uint32_t *) dict_alloc_large(&(dict->allocator), new_size,
+        sizeof(uint32_t));
+    if (NULL == heads)
+        return -1;
+    memset(heads, 0xff, new_size * sizeof(uint32_t));
+    for (; index < dict->used; ++index) {
+        entry = &(dict->entries[index]);
+        if (NULL == entry->key)
+            continue;
+        key_hash = murmurhash1(entry->key, entry->key_length, HASH_SEED);
+        entry->next = heads[DICT_BUCKET_IDX(key_hash, new_size)];
+        heads[DICT_BUCKET_IDX(key_hash, new_size)] = index;
+    }
+    dict_free_large(&(dict->allocator), dict->heads, dict->size,
+        sizeof(uint32_t));
+    dict->heads = heads;
+    dict->size = new_size;
+    return 0;
+}
@@ -0,0 +1,23 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_alloc.c
+** File description:
+** Exposes a function used to allocate zeroed memory through an allocator.
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "dict.h"
+
+void *dict_alloc(const dict_allocator_t *allocator, size_t count,
+    size_t size)
+{
+    void *ptr = NULL;
+
+    if (0 != size && count > SIZE_MAX / size)
+        return NULL;
+    ptr = allocator->allocate(allocator->ctx, count * size);
+    if (NULL != ptr)
+        memset(ptr, 0, count * size);
+    return ptr;
+}
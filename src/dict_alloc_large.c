@@ -0,0 +1,20 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_alloc_large.c
+** File description:
+** Exposes a function used to allocate a large zeroed array through an
+** allocator.
+*/
+
+#include <stdint.h>
+#include "dict.h"
+
+void *dict_alloc_large(const dict_allocator_t *allocator, size_t count,
+    size_t size)
+{
+    if (NULL == allocator->allocate_large)
+        return dict_alloc(allocator, count, size);
+    if (0 != size && count > SIZE_MAX / size)
+        return NULL;
+    return allocator->allocate_large(allocator->ctx, count * size);
+}
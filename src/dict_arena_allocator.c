@@ -0,0 +1,122 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_arena_allocator.c
+** File description:
+** Exposes a function used to allocate from an arena through the dict
+** allocator interface.
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Rounds a size up to the arena alignment.
+ *
+ * @param S The size to round.
+ */
+#define DICT_ARENA_ROUND(S) \
+    (((S) + DICT_ARENA_ALIGN - 1) & ~((size_t) DICT_ARENA_ALIGN - 1))
+
+/**
+ * @brief Allocates a new chunk able to hold at least `size` bytes, and makes
+ * it the chunk allocations are carved from. The remaining space of the
+ * previous chunk is given up.
+ *
+ * @param arena The arena receiving the chunk.
+ * @param size The number of bytes the chunk must be able to hold.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_arena_grow(dict_arena_t *arena, size_t size)
+{
+    size_t header = DICT_ARENA_ROUND(sizeof(dict_arena_chunk_t));
+    dict_arena_chunk_t *chunk = NULL;
+
+    if (size < arena->chunk_size)
+        size = arena->chunk_size;
+    if (size > SIZE_MAX - header)
+        return -1;
+    chunk = (dict_arena_chunk_t *) malloc(header + size);
+    if (NULL == chunk)
+        return -1;
+    chunk->next = arena->chunks;
+    chunk->size = size;
+    chunk->used = 0;
+    chunk->data = (unsigned char *) chunk + header;
+    arena->chunks = chunk;
+    return 0;
+}
+
+/**
+ * @brief Carves an allocation out of the current chunk.
+ */
+static
+void *dict_arena_allocate(void *ctx, size_t size)
+{
+    dict_arena_t *arena = (dict_arena_t *) ctx;
+    dict_arena_chunk_t *chunk = arena->chunks;
+    void *ptr = NULL;
+
+    if (size > SIZE_MAX - DICT_ARENA_ALIGN)
+        return NULL;
+    size = DICT_ARENA_ROUND(size);
+    if ((NULL == chunk || chunk->size - chunk->used < size) && \
+        -1 == dict_arena_grow(arena, size))
+        return NULL;
+    chunk = arena->chunks;
+    ptr = chunk->data + chunk->used;
+    chunk->used += size;
+    arena->allocated += size;
+    return ptr;
+}
+
+/**
+ * @brief Grows the last allocation in place if the current chunk has room
+ * left, otherwise moves it to a new allocation. Shrinking keeps the allocation
+ * as is.
+ */
+static
+void *dict_arena_reallocate(void *ctx, void *ptr, size_t old_size,
+    size_t new_size)
+{
+    dict_arena_t *arena = (dict_arena_t *) ctx;
+    dict_arena_chunk_t *chunk = arena->chunks;
+    size_t old_rounded = DICT_ARENA_ROUND(old_size);
+    void *moved = NULL;
+
+    if (NULL != ptr && new_size <= old_size)
+        return ptr;
+    if (NULL != ptr && NULL != chunk && new_size <= SIZE_MAX - \
+        DICT_ARENA_ALIGN && (unsigned char *) ptr + old_rounded == \
+        chunk->data + chunk->used && DICT_ARENA_ROUND(new_size) <= \
+        chunk->size - chunk->used + old_rounded) {
+        chunk->used += DICT_ARENA_ROUND(new_size) - old_rounded;
+        arena->allocated += DICT_ARENA_ROUND(new_size) - old_rounded;
+        return ptr;
+    }
+    moved = dict_arena_allocate(ctx, new_size);
+    if (NULL != moved && NULL != ptr)
+        memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    return moved;
+}
+
+/**
+ * @brief Does nothing, the memory being released along with the arena.
+ */
+static
+void dict_arena_release(__attribute__((unused)) void *ctx,
+    __attribute__((unused)) void *ptr)
+{
+}
+
+void dict_arena_allocator(dict_arena_t *arena, dict_allocator_t *allocator)
+{
+    allocator->allocate = dict_arena_allocate;
+    allocator->reallocate = dict_arena_reallocate;
+    allocator->release = dict_arena_release;
+    allocator->ctx = arena;
+    allocator->allocate_large = NULL;
+    allocator->release_large = NULL;
+}
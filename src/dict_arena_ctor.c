@@ -0,0 +1,19 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_arena_ctor.c
+** File description:
+** Exposes the arena allocator constructor.
+*/
+
+#include <stdlib.h>
+#include "dict.h"
+
+dict_arena_t *dict_arena_ctor(size_t chunk_size)
+{
+    dict_arena_t *arena = (dict_arena_t *) calloc(1, sizeof(dict_arena_t));
+
+    if (NULL == arena)
+        return NULL;
+    arena->chunk_size = 0 != chunk_size ? chunk_size : DICT_ARENA_CHUNK_SIZE;
+    return arena;
+}
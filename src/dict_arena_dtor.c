@@ -0,0 +1,21 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_arena_dtor.c
+** File description:
+** Exposes the arena allocator destructor.
+*/
+
+#include <stdlib.h>
+#include "dict.h"
+
+void dict_arena_dtor(dict_arena_t *arena)
+{
+    dict_arena_chunk_t *next = NULL;
+
+    while (NULL != arena->chunks) {
+        next = arena->chunks->next;
+        free(arena->chunks);
+        arena->chunks = next;
+    }
+    free(arena);
+}
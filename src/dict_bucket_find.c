@@ -0,0 +1,19 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_bucket_find.c
+** File description:
+** Exposes a function used to find the node matching a key in a bucket.
+*/
+
+#include "dict.h"
+
+bucket_t *dict_bucket_find(bucket_t *bucket, const char *key,
+    uint64_t key_length)
+{
+    while (NULL != bucket->key) {
+        if (DICT_KEY_MATCH(bucket, key, key_length))
+            return bucket;
+        bucket = bucket->next;
+    }
+    return NULL;
+}
@@ -0,0 +1,28 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_bucket_node_ctor.c
+** File description:
+** Exposes a function to allocate the node holding an entry of a dict.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+bucket_t *dict_bucket_node_ctor(const dict_t *dict, char *key,
+    uint64_t key_length, void *value)
+{
+    bucket_t *node = (bucket_t *) dict_alloc(&(dict->allocator), 1,
+        DICT_NODE_SIZE(dict));
+
+    if (NULL == node)
+        return NULL;
+    node->key = key;
+    node->key_length = (uint32_t) key_length;
+    node->value = value;
+    if (0 != dict->value_size) {
+        node->value = node + 1;
+        if (NULL != value)
+            memcpy(node->value, value, dict->value_size);
+    }
+    return node;
+}
@@ -0,0 +1,27 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_bucket_release.c
+** File description:
+** Exposes a function used to unlink and release a node of a dict.
+*/
+
+#include "dict.h"
+
+void dict_bucket_release(dict_t *dict, bucket_t **link,
+    free_pair_t free_pair)
+{
+    bucket_t *node = *link;
+
+    *link = node->next;
+    if (NULL != dict->cache)
+        dict->cache->bytes -= dict_cache_charge(dict->cache, node->key,
+            node->key_length, node->value);
+    --dict->items;
+    if (NULL != dict->index)
+        dict_index_delete(dict->index, node->key, node->key_length);
+    if (NULL != free_pair)
+        DICT_BUCKET_FREE_PAIR(free_pair, node);
+    dict_node_free(&(dict->allocator), node);
+    if (NULL != dict->filter && ++dict->filter->stale > dict->items)
+        dict_filter_rebuild(dict);
+}
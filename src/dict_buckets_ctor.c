@@ -5,17 +5,18 @@
 ** Exposes a function used to allocate a new buckets linked list array.
 */
 
-#include <stdlib.h>
 #include "dict.h"
 
-int dict_buckets_ctor(bucket_t **buckets, uint64_t size)
+int dict_buckets_ctor(bucket_t **buckets, uint64_t size,
+    const dict_allocator_t *allocator)
 {
     uint64_t index = 0;
 
     for (; index < size; ++index) {
-        buckets[index] = (bucket_t *) calloc(1, sizeof(bucket_t));
+        buckets[index] = (bucket_t *) dict_alloc(allocator, 1,
+            sizeof(bucket_t));
         if (NULL == buckets[index]) {
-            dict_buckets_dtor(buckets, index, NULL);
+            dict_buckets_dtor(buckets, index, NULL, allocator);
             return -1;
         }
     }
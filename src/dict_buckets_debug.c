@@ -20,10 +20,15 @@ void print_bucket(const bucket_t *bucket, uint64_t index)
 #endif
     while (NULL != bucket) {
 #ifndef __APPLE__
-        fprintf(stderr, "- [%lu] = %s\n", node_index, bucket->key);
+        fprintf(stderr, "- [%lu] = ", node_index);
 #else
-        fprintf(stderr, "- [%llu] = %s\n", node_index, bucket->key);
+        fprintf(stderr, "- [%llu] = ", node_index);
 #endif
+        if (NULL == bucket->key)
+            fputs("(null)", stderr);
+        else
+            fwrite(bucket->key, 1, bucket->key_length, stderr);
+        fputc('\n', stderr);
         bucket = bucket->next;
         ++node_index;
     }
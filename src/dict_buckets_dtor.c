@@ -5,44 +5,49 @@
 ** Exposes a function used to deallocate a buckets linked list array.
 */
 
-#include <stdlib.h>
 #include "dict.h"
 
 /**
  * @brief Deallocate a bucket and free it's content using `free_pair`.
  *
+ * @note The sentinel node is not given to `free_pair`, and neither is what
+ * the borrowed entries borrow, see `DICT_BUCKET_BORROWED`.
+ *
  * @note If `free_pair` is a `NULL` pointer, it means that we don't have to
  * free neither keys nor values. We branch depending on whether `free_pair` is
  * a `NULL` pointer so that we save branching on iteration.
  *
  * @param bucket The bucket to free.
  * @param free_pair The optional function to free keys and values.
+ * @param allocator The allocator of the nodes.
  */
 static
-void dict_bucket_dtor(bucket_t *bucket, free_pair_t free_pair)
+void dict_bucket_dtor(bucket_t *bucket, free_pair_t free_pair,
+    const dict_allocator_t *allocator)
 {
     bucket_t *next = NULL;
 
     if (NULL != free_pair)
         while (NULL != bucket) {
             next = bucket->next;
-            free_pair(bucket->key, bucket->value);
-            free(bucket);
+            if (NULL != bucket->key)
+                DICT_BUCKET_FREE_PAIR(free_pair, bucket);
+            dict_node_free(allocator, bucket);
             bucket = next;
         }
     else
         while (NULL != bucket) {
             next = bucket->next;
-            free(bucket);
+            dict_node_free(allocator, bucket);
             bucket = next;
         }
 }
 
 void dict_buckets_dtor(bucket_t **buckets, uint64_t size,
-    free_pair_t free_pair)
+    free_pair_t free_pair, const dict_allocator_t *allocator)
 {
     uint64_t index = 0;
 
     for (; index < size; ++index)
-        dict_bucket_dtor(buckets[index], free_pair);
+        dict_bucket_dtor(buckets[index], free_pair, allocator);
 }
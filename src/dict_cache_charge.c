@@ -0,0 +1,17 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_cache_charge.c
+** File description:
+** Exposes a function used to compute the bytes an entry is charged in cache
+** mode.
+*/
+
+#include "dict.h"
+
+uint64_t dict_cache_charge(const dict_cache_t *cache, const char *key,
+    uint64_t key_length, const void *value)
+{
+    if (NULL != cache->size_pair)
+        return cache->size_pair(key, key_length, value);
+    return sizeof(bucket_t) + key_length;
+}
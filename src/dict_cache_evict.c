@@ -0,0 +1,52 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_cache_evict.c
+** File description:
+** Exposes a function used to evict an entry from a cache mode dict.
+*/
+
+#include "dict.h"
+
+/**
+ * @brief Sweeps the bucket the CLOCK hand points at. Referenced entries lose
+ * their bit, the first unreferenced one is evicted.
+ *
+ * @param dict The dict from which to evict an entry.
+ * @return 1 if an entry was evicted, 0 otherwise, -1 on error.
+ */
+static
+int dict_cache_sweep(dict_t *dict)
+{
+    bucket_t **link = NULL;
+
+    if (-1 == dict_cow_bucket(dict, dict->cache->hand))
+        return -1;
+    link = &(dict->buckets[dict->cache->hand]);
+
+    while (NULL != (*link)->key) {
+        if (0 == ((*link)->flags & DICT_BUCKET_REFERENCED)) {
+            ++dict->cache->evictions;
+            dict_bucket_release(dict, link, dict->cache->free_pair);
+            return 1;
+        }
+        (*link)->flags &= ~DICT_BUCKET_REFERENCED;
+        link = &((*link)->next);
+    }
+    return 0;
+}
+
+int dict_cache_evict(dict_t *dict)
+{
+    dict_cache_t *cache = dict->cache;
+    int evicted = 0;
+
+    if (0 == dict->items)
+        return -1;
+    cache->hand %= dict->size;
+    evicted = dict_cache_sweep(dict);
+    while (0 == evicted) {
+        cache->hand = (cache->hand + 1) % dict->size;
+        evicted = dict_cache_sweep(dict);
+    }
+    return 1 == evicted ? 0 : -1;
+}
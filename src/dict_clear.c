@@ -0,0 +1,93 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_clear.c
+** File description:
+** Exposes a function used to remove every entry of a dict.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Releases the entries of a bucket, leaving its sentinel node alone.
+ *
+ * @param dict The dict holding the bucket.
+ * @param bucket The address of the bucket.
+ * @param free_pair The function called on the removed pairs, may be `NULL`.
+ */
+static
+void dict_clear_bucket(dict_t *dict, bucket_t **bucket,
+    free_pair_t free_pair)
+{
+    bucket_t *node = *bucket;
+    bucket_t *next = NULL;
+
+    while (NULL != node->key) {
+        next = node->next;
+        if (NULL != free_pair)
+            DICT_BUCKET_FREE_PAIR(free_pair, node);
+        dict_node_free(&(dict->allocator), node);
+        node = next;
+    }
+    *bucket = node;
+}
+
+/**
+ * @brief Gives the dict a new, empty, buckets array of the same size, for the
+ * dicts sharing buckets with a clone. The buckets it owns are released.
+ *
+ * @param dict The dict to clear.
+ * @param free_pair The function called on the removed pairs, may be `NULL`.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_clear_shared(dict_t *dict, free_pair_t free_pair)
+{
+    bucket_t **buckets = (bucket_t **) dict_alloc_large(&(dict->allocator),
+        dict->size, sizeof(bucket_t *));
+
+    if (NULL == buckets)
+        return -1;
+    if (-1 == dict_buckets_ctor(buckets, dict->size, &(dict->allocator))) {
+        dict_free_large(&(dict->allocator), buckets, dict->size,
+            sizeof(bucket_t *));
+        return -1;
+    }
+    if (dict->buckets != dict->shared->buckets) {
+        dict_owned_buckets_dtor(dict->buckets, dict->size, dict->cow_bits,
+            free_pair, &(dict->allocator));
+        dict_free_large(&(dict->allocator), dict->buckets, dict->size,
+            sizeof(bucket_t *));
+    }
+    dict_free(&(dict->allocator), dict->cow_bits);
+    dict->cow_bits = NULL;
+    dict->buckets = buckets;
+    return 0;
+}
+
+int dict_clear(dict_t *dict, free_pair_t free_pair)
+{
+    uint64_t index = 0;
+    dict_filter_t *filter = dict->filter;
+
+    if (NULL != dict->shared) {
+        if (-1 == dict_clear_shared(dict, free_pair))
+            return -1;
+    } else
+        for (; index < dict->size; ++index)
+            dict_clear_bucket(dict, &(dict->buckets[index]), free_pair);
+    dict->items = 0;
+    if (NULL != dict->index) {
+        dict_index_release(dict->index, dict->index->root);
+        dict->index->root = NULL;
+    }
+    if (NULL != dict->cache)
+        dict->cache->bytes = 0;
+    if (NULL != filter) {
+        memset(filter->blocks, 0, filter->nblocks * \
+            DICT_FILTER_BLOCK_WORDS * sizeof(uint64_t));
+        filter->bits_set = 0;
+        filter->stale = 0;
+    }
+    return 0;
+}
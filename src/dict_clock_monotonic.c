@@ -0,0 +1,19 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_clock_monotonic.c
+** File description:
+** Exposes the default clock used to expire dict entries.
+*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <time.h>
+#include "dict.h"
+
+uint64_t dict_clock_monotonic(void)
+{
+    struct timespec now = { 0 };
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000 + (uint64_t) now.tv_nsec / 1000000;
+}
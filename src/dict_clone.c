@@ -0,0 +1,104 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_clone.c
+** File description:
+** Exposes a function used to clone a dict in constant time.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Freezes the buckets array of the dict into a snapshot, unless the
+ * dict still reads from its snapshot, in which case it's shared again.
+ *
+ * @param dict The dict whose buckets array must be frozen.
+ * @return The snapshot on success, `NULL` pointer on error.
+ */
+static
+dict_shared_t *dict_freeze(dict_t *dict)
+{
+    dict_shared_t *shared = NULL;
+
+    if (NULL != dict->shared && dict->buckets == dict->shared->buckets) {
+        ++dict->shared->refs;
+        return dict->shared;
+    }
+    shared = (dict_shared_t *) dict_alloc(&(dict->allocator), 1,
+        sizeof(dict_shared_t));
+    if (NULL == shared)
+        return NULL;
+    shared->refs = 2;
+    shared->size = dict->size;
+    shared->buckets = dict->buckets;
+    shared->cow_bits = dict->cow_bits;
+    shared->parent = dict->shared;
+    shared->packs = dict->packs;
+    if (NULL != shared->packs)
+        ++shared->packs->refs;
+    dict->shared = shared;
+    dict->cow_bits = NULL;
+    return shared;
+}
+
+/**
+ * @brief Copies the optional cache mode and expiry states of the dict.
+ *
+ * @param dict The dict being cloned.
+ * @param clone The clone receiving the states.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_clone_settings(const dict_t *dict, dict_t *clone)
+{
+    if (NULL != dict->cache) {
+        clone->cache = (dict_cache_t *) dict_alloc(&(dict->allocator), 1,
+            sizeof(dict_cache_t));
+        if (NULL == clone->cache)
+            return -1;
+        memcpy(clone->cache, dict->cache, sizeof(dict_cache_t));
+    }
+    if (NULL != dict->expiry) {
+        clone->expiry = (dict_expiry_t *) dict_alloc(&(dict->allocator), 1,
+            sizeof(dict_expiry_t));
+        if (NULL == clone->expiry)
+            return -1;
+        memcpy(clone->expiry, dict->expiry, sizeof(dict_expiry_t));
+    }
+    return 0;
+}
+
+dict_t *dict_clone(dict_t *dict)
+{
+    dict_t *clone = (dict_t *) dict_alloc(&(dict->allocator), 1,
+        sizeof(dict_t));
+
+    if (NULL == clone)
+        return NULL;
+    if (-1 == dict_clone_settings(dict, clone)) {
+        dict_free(&(dict->allocator), clone->cache);
+        dict_free(&(dict->allocator), clone);
+        return NULL;
+    }
+    clone->shared = dict_freeze(dict);
+    if (NULL == clone->shared) {
+        dict_free(&(dict->allocator), clone->cache);
+        dict_free(&(dict->allocator), clone->expiry);
+        dict_free(&(dict->allocator), clone);
+        return NULL;
+    }
+    clone->allocator = dict->allocator;
+    clone->items = dict->items;
+    clone->size = dict->size;
+    clone->seed = dict->seed;
+    clone->value_size = dict->value_size;
+    clone->expiry_size = dict->expiry_size;
+    clone->buckets = clone->shared->buckets;
+    clone->mappings = dict->mappings;
+    if (NULL != clone->mappings)
+        ++clone->mappings->refs;
+    clone->packs = dict->packs;
+    if (NULL != clone->packs)
+        ++clone->packs->refs;
+    return clone;
+}
@@ -0,0 +1,207 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_compact.c
+** File description:
+** Exposes the function moving the nodes of a dict into contiguous packs.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Starts a pass, or starts it again if the dict was resized since, as
+ * the nodes were moved across the buckets.
+ *
+ * @param dict The dict being compacted.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_compact_start(dict_t *dict)
+{
+    dict_compaction_t *compaction = dict->compaction;
+
+    if (NULL == compaction) {
+        compaction = (dict_compaction_t *) dict_alloc(&(dict->allocator), 1,
+            sizeof(dict_compaction_t));
+        if (NULL == compaction)
+            return -1;
+        compaction->size = dict->size;
+        compaction->retired = dict->packs;
+        dict->compaction = compaction;
+    }
+    if (compaction->size != dict->size) {
+        compaction->cursor = 0;
+        compaction->size = dict->size;
+        compaction->retired = dict->packs;
+    }
+    return 0;
+}
+
+/**
+ * @brief Returns the size of a node, its inline value storage included.
+ *
+ * @param dict The dict holding the node.
+ * @param node The node.
+ * @return The size of the node, in bytes.
+ */
+static
+uint64_t dict_compact_node_size(const dict_t *dict, const bucket_t *node)
+{
+    return NULL == node->key ? sizeof(bucket_t) : DICT_NODE_SIZE(dict);
+}
+
+/**
+ * @brief Measures the nodes of the buckets moved by the next step, from the
+ * cursor, within the budget.
+ *
+ * @param dict The dict being compacted.
+ * @param budget The maximum number of nodes, 0 for no limit.
+ * @param end Where to store the index following the last bucket of the step.
+ * @return The size of the nodes to move, sentinel nodes included.
+ */
+static
+uint64_t dict_compact_span(dict_t *dict, uint64_t budget, uint64_t *end)
+{
+    uint64_t index = dict->compaction->cursor;
+    uint64_t count = 0;
+    uint64_t length = 0;
+    uint64_t bytes = 0;
+    uint64_t size = 0;
+    const bucket_t *node = NULL;
+
+    for (; index < dict->size; ++index) {
+        if (!DICT_OWNS_BUCKET(dict, index)) {
+            dict->compaction->skipped = 1;
+            continue;
+        }
+        length = 0;
+        size = 0;
+        for (node = dict->buckets[index]; NULL != node; node = node->next) {
+            ++length;
+            size += dict_compact_node_size(dict, node);
+        }
+        if (0 != budget && 0 != count && count + length > budget)
+            break;
+        count += length;
+        bytes += size;
+    }
+    *end = index;
+    return bytes;
+}
+
+/**
+ * @brief Moves the nodes of a bucket, in order, into the next slots of the
+ * pack. The nodes living outside of a pack are released.
+ *
+ * @param dict The dict being compacted.
+ * @param bucket The address of the bucket.
+ * @param slot The next free byte of the pack, advanced past the moved nodes.
+ * @return The number of bytes released.
+ */
+static
+uint64_t dict_compact_bucket(dict_t *dict, bucket_t **bucket, char **slot)
+{
+    bucket_t *node = *bucket;
+    bucket_t *next = NULL;
+    bucket_t *moved = NULL;
+    uint64_t size = 0;
+    uint64_t released = 0;
+
+    while (NULL != node) {
+        next = node->next;
+        size = dict_compact_node_size(dict, node);
+        moved = (bucket_t *) *slot;
+        memcpy(moved, node, size);
+        if (0 != dict->value_size && NULL != node->key)
+            moved->value = moved + 1;
+        moved->flags |= DICT_BUCKET_PACKED;
+        *bucket = moved;
+        bucket = &(moved->next);
+        if (0 == (node->flags & DICT_BUCKET_PACKED)) {
+            dict_free(&(dict->allocator), node);
+            released += size;
+        }
+        *slot += size;
+        node = next;
+    }
+    return released;
+}
+
+/**
+ * @brief Moves the nodes of the buckets of the next step into a new pack.
+ *
+ * @param dict The dict being compacted.
+ * @param budget The maximum number of nodes, 0 for no limit.
+ * @return The number of bytes released on success, -1 on error.
+ */
+static
+int64_t dict_compact_step(dict_t *dict, uint64_t budget)
+{
+    uint64_t end = 0;
+    uint64_t bytes = dict_compact_span(dict, budget, &end);
+    uint64_t index = dict->compaction->cursor;
+    uint64_t released = 0;
+    dict_pack_t *pack = NULL;
+    char *slot = NULL;
+
+    if (0 != bytes) {
+        pack = (dict_pack_t *) dict_alloc(&(dict->allocator), 1,
+            sizeof(dict_pack_t) + bytes);
+        if (NULL == pack)
+            return -1;
+        pack->refs = 1;
+        pack->bytes = sizeof(dict_pack_t) + bytes;
+        pack->next = dict->packs;
+        dict->packs = pack;
+        slot = (char *) pack->nodes;
+    }
+    for (; index < end; ++index)
+        if (DICT_OWNS_BUCKET(dict, index))
+            released += dict_compact_bucket(dict, &(dict->buckets[index]),
+                &slot);
+    dict->compaction->cursor = end;
+    return (int64_t) released;
+}
+
+/**
+ * @brief Ends the pass, releasing the packs allocated before it, unless
+ * they may still hold nodes : a bucket was skipped, or a clone refers to a
+ * pack of the pass.
+ *
+ * @param dict The dict being compacted.
+ * @return The number of bytes released.
+ */
+static
+uint64_t dict_compact_finish(dict_t *dict)
+{
+    dict_compaction_t *compaction = dict->compaction;
+    dict_pack_t **link = &(dict->packs);
+    uint64_t released = 0;
+
+    dict->compaction = NULL;
+    if (!compaction->skipped && NULL != compaction->retired) {
+        while (*link != compaction->retired && 1 == (*link)->refs)
+            link = &((*link)->next);
+        if (*link == compaction->retired) {
+            *link = NULL;
+            released = dict_pack_release(compaction->retired,
+                &(dict->allocator));
+        }
+    }
+    dict_free(&(dict->allocator), compaction);
+    return released;
+}
+
+int64_t dict_compact(dict_t *dict, uint64_t budget)
+{
+    int64_t released = 0;
+
+    if (-1 == dict_compact_start(dict))
+        return -1;
+    released = dict_compact_step(dict, budget);
+    if (-1 == released)
+        return -1;
+    if (dict->compaction->cursor < dict->size)
+        return released;
+    return released + (int64_t) dict_compact_finish(dict);
+}
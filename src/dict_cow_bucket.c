@@ -0,0 +1,113 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_cow_bucket.c
+** File description:
+** Exposes a function used to copy a bucket shared with a dict snapshot.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Gives the dict its own copy of the snapshot buckets array, with every
+ * bucket marked as shared.
+ *
+ * @param dict The dict reading from the snapshot buckets array.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_cow_buckets(dict_t *dict)
+{
+    uint64_t words = (dict->size + 63) / 64;
+    bucket_t **buckets = (bucket_t **) dict_alloc_large(&(dict->allocator),
+        dict->size, sizeof(bucket_t *));
+    uint64_t *cow_bits = (uint64_t *) dict_alloc(&(dict->allocator), words,
+        sizeof(uint64_t));
+
+    if (NULL == buckets || NULL == cow_bits) {
+        dict_free_large(&(dict->allocator), buckets, dict->size,
+            sizeof(bucket_t *));
+        dict_free(&(dict->allocator), cow_bits);
+        return -1;
+    }
+    memcpy(buckets, dict->buckets, dict->size * sizeof(bucket_t *));
+    memset(cow_bits, 0xff, words * sizeof(uint64_t));
+    dict->buckets = buckets;
+    dict->cow_bits = cow_bits;
+    return 0;
+}
+
+/**
+ * @brief Releases the nodes of a partially copied linked list.
+ *
+ * @param node The head of the copied linked list.
+ * @param allocator The allocator of the nodes.
+ */
+static
+void dict_cow_chain_dtor(bucket_t *node, const dict_allocator_t *allocator)
+{
+    bucket_t *next = NULL;
+
+    while (NULL != node) {
+        next = node->next;
+        dict_free(allocator, node);
+        node = next;
+    }
+}
+
+/**
+ * @brief Copies a bucket linked list, sentinel node included. The copied
+ * entries are marked as borrowed, as their pair still belongs to the snapshot,
+ * and are released one by one, even if the original lives in a pack. The
+ * inline values are copied along with their node.
+ *
+ * @param bucket The bucket to copy.
+ * @param dict The dict receiving the copy, holding the allocator.
+ * @return The copied bucket on success, `NULL` pointer on error.
+ */
+static
+bucket_t *dict_cow_chain(const bucket_t *bucket, const dict_t *dict)
+{
+    bucket_t *head = NULL;
+    bucket_t **tail = &head;
+    uint64_t size = 0;
+
+    do {
+        size = NULL == bucket->key ? sizeof(bucket_t) : DICT_NODE_SIZE(dict);
+        *tail = (bucket_t *) dict_alloc(&(dict->allocator), 1, size);
+        if (NULL == *tail) {
+            dict_cow_chain_dtor(head, &(dict->allocator));
+            return NULL;
+        }
+        memcpy(*tail, bucket, size);
+        if (0 != dict->value_size && NULL != bucket->key)
+            (*tail)->value = *tail + 1;
+        (*tail)->next = NULL;
+        (*tail)->flags &= ~(DICT_BUCKET_PACKED | DICT_BUCKET_OWNS_VALUE);
+        if (NULL != bucket->key)
+            (*tail)->flags |= DICT_BUCKET_BORROWED;
+        tail = &((*tail)->next);
+        bucket = bucket->next;
+    } while (NULL != bucket);
+    return head;
+}
+
+int dict_cow_bucket(dict_t *dict, uint64_t index)
+{
+    bucket_t *copy = NULL;
+
+    if (NULL == dict->shared)
+        return 0;
+    if (dict->buckets == dict->shared->buckets && \
+        -1 == dict_cow_buckets(dict))
+        return -1;
+    if (NULL == dict->cow_bits || !DICT_COW_SHARED(dict->cow_bits, index))
+        return 0;
+    copy = dict_cow_chain(dict->buckets[index], dict);
+    if (NULL == copy)
+        return -1;
+    dict->buckets[index] = copy;
+    dict->cow_bits[index / 64] &= ~((uint64_t) 1 << (index % 64));
+    ++dict->cow_copies;
+    return 0;
+}
@@ -0,0 +1,33 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_ctor_with_allocator.c
+** File description:
+** Exposes the dict object constructor taking a custom allocator.
+*/
+
+#include "dict.h"
+
+dict_t *dict_ctor_with_allocator(const dict_allocator_t *allocator)
+{
+    dict_t *dict = NULL;
+
+    if (NULL == allocator)
+        allocator = dict_std_allocator();
+    dict = (dict_t *) dict_alloc(allocator, 1, sizeof(dict_t));
+    if (NULL == dict)
+        return NULL;
+    dict->allocator = *allocator;
+    dict->buckets = (bucket_t **) dict_alloc_large(allocator, DICT_MIN_SIZE,
+        sizeof(bucket_t *));
+    if (NULL == dict->buckets || \
+        -1 == dict_buckets_ctor(dict->buckets, DICT_MIN_SIZE, allocator)) {
+        dict_free_large(allocator, dict->buckets, DICT_MIN_SIZE,
+            sizeof(bucket_t *));
+        dict_free(allocator, dict);
+        return NULL;
+    }
+    dict->items = 0;
+    dict->size = DICT_MIN_SIZE;
+    dict->seed = HASH_SEED;
+    return dict;
+}
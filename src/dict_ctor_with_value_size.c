@@ -0,0 +1,17 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_ctor_with_value_size.c
+** File description:
+** Exposes the constructor of the dicts storing their values inline.
+*/
+
+#include "dict.h"
+
+dict_t *dict_ctor_with_value_size(uint64_t value_size)
+{
+    dict_t *dict = dict_ctor_with_allocator(NULL);
+
+    if (NULL != dict)
+        dict->value_size = value_size;
+    return dict;
+}
@@ -0,0 +1,57 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_delete_hashed.c
+** File description:
+** Exposes a function used to delete a pair from a dict using the precomputed
+** hash of its key.
+*/
+
+#include "dict.h"
+
+/**
+ * @brief Deletes the entry of the key.
+ *
+ * @param dict The dict from which to delete the entry.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param key_hash The hash of the key.
+ * @param free_pair The function to use to free the pair, may be `NULL`.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_delete_entry(dict_t *dict, char *key, uint64_t key_length,
+    dict_hash_t key_hash, free_pair_t free_pair)
+{
+    uint64_t index = 0;
+    bucket_t **link = NULL;
+
+    if (key_hash.seed != dict->seed)
+        return -1;
+    if (DICT_MUST_SHRINK(dict) && -1 == dict_resize(dict))
+        return -1;
+    if (NULL != dict->filter && \
+        !dict_filter_has(dict->filter, key_hash.value))
+        return -1;
+    index = DICT_BUCKET_IDX(key_hash.value, dict->size);
+    link = dict_bucket_find_link(&(dict->buckets[index]), key, key_length);
+    if (NULL == link)
+        return -1;
+    if (NULL != dict->shared) {
+        if (-1 == dict_cow_bucket(dict, index))
+            return -1;
+        link = dict_bucket_find_link(&(dict->buckets[index]), key, key_length);
+    }
+    dict_bucket_release(dict, link, free_pair);
+    return 0;
+}
+
+int dict_delete_hashed(dict_t *dict, char *key, uint64_t key_length,
+    dict_hash_t key_hash, free_pair_t free_pair)
+{
+    int status = dict_delete_entry(dict, key, key_length, key_hash,
+        free_pair);
+
+    if (NULL != dict->trace)
+        dict_trace_record(dict, DICT_TRACE_DELETE, key, key_length, status);
+    return status;
+}
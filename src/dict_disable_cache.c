@@ -0,0 +1,14 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_disable_cache.c
+** File description:
+** Exposes a function used to disable the cache mode of a dict.
+*/
+
+#include "dict.h"
+
+void dict_disable_cache(dict_t *dict)
+{
+    dict_free(&(dict->allocator), dict->cache);
+    dict->cache = NULL;
+}
@@ -0,0 +1,14 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_disable_expiry.c
+** File description:
+** Exposes a function used to disable the expiry of dict entries.
+*/
+
+#include "dict.h"
+
+void dict_disable_expiry(dict_t *dict)
+{
+    dict_free(&(dict->allocator), dict->expiry);
+    dict->expiry = NULL;
+}
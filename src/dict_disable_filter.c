@@ -0,0 +1,14 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_disable_filter.c
+** File description:
+** Exposes a function used to disable the membership filter of a dict.
+*/
+
+#include "dict.h"
+
+void dict_disable_filter(dict_t *dict)
+{
+    dict_filter_dtor(dict->filter, &(dict->allocator));
+    dict->filter = NULL;
+}
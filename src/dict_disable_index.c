@@ -0,0 +1,14 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_disable_index.c
+** File description:
+** Exposes a function used to disable the ordered index of a dict.
+*/
+
+#include "dict.h"
+
+void dict_disable_index(dict_t *dict)
+{
+    dict_index_dtor(dict->index);
+    dict->index = NULL;
+}
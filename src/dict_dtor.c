@@ -5,12 +5,28 @@
 ** Exposes the dict object destructor.
 */
 
-#include <stdlib.h>
 #include "dict.h"
 
 void dict_dtor(dict_t *dict, free_pair_t free_pair)
 {
-    dict_buckets_dtor(dict->buckets, dict->size, free_pair);
-    free(dict->buckets);
-    free(dict);
+    dict_allocator_t allocator = dict->allocator;
+
+    if (NULL != dict->trace)
+        dict_trace_stop(dict);
+    if (NULL == dict->shared || dict->buckets != dict->shared->buckets) {
+        dict_owned_buckets_dtor(dict->buckets, dict->size, dict->cow_bits,
+            free_pair, &allocator);
+        dict_free_large(&allocator, dict->buckets, dict->size,
+            sizeof(bucket_t *));
+    }
+    dict_free(&allocator, dict->cow_bits);
+    dict_shared_release(dict->shared, free_pair, &allocator);
+    dict_mapping_release(dict->mappings, &allocator);
+    dict_pack_release(dict->packs, &allocator);
+    dict_free(&allocator, dict->compaction);
+    dict_filter_dtor(dict->filter, &allocator);
+    dict_index_dtor(dict->index);
+    dict_free(&allocator, dict->cache);
+    dict_free(&allocator, dict->expiry);
+    dict_free(&allocator, dict);
 }
@@ -0,0 +1,54 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_enable_cache.c
+** File description:
+** Exposes a function used to turn a dict into a bounded cache.
+*/
+
+#include "dict.h"
+
+/**
+ * @brief Computes the bytes charged by all the entries of the dict.
+ *
+ * @param dict The dict whose entries must be charged.
+ * @param cache The cache mode state in which to store the charge.
+ */
+static
+void dict_cache_charge_all(const dict_t *dict, dict_cache_t *cache)
+{
+    uint64_t index = 0;
+    const bucket_t *bucket = NULL;
+
+    cache->bytes = 0;
+    for (; index < dict->size; ++index) {
+        bucket = dict->buckets[index];
+        while (NULL != bucket->key) {
+            cache->bytes += dict_cache_charge(cache, bucket->key,
+                bucket->key_length, bucket->value);
+            bucket = bucket->next;
+        }
+    }
+}
+
+int dict_enable_cache(dict_t *dict, uint64_t max_items, uint64_t max_bytes,
+    free_pair_t free_pair, size_pair_t size_pair)
+{
+    dict_cache_t *cache = dict->cache;
+
+    if (NULL == cache)
+        cache = (dict_cache_t *) dict_alloc(&(dict->allocator), 1,
+            sizeof(dict_cache_t));
+    if (NULL == cache)
+        return -1;
+    cache->max_items = max_items;
+    cache->max_bytes = max_bytes;
+    cache->free_pair = free_pair;
+    cache->size_pair = size_pair;
+    dict_cache_charge_all(dict, cache);
+    dict->cache = cache;
+    while ((0 != max_items && dict->items > max_items) || \
+        (0 != max_bytes && cache->bytes > max_bytes))
+        if (-1 == dict_cache_evict(dict))
+            return -1;
+    return 0;
+}
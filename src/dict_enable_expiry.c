@@ -0,0 +1,27 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_enable_expiry.c
+** File description:
+** Exposes a function used to enable the expiry of dict entries.
+*/
+
+#include "dict.h"
+
+int dict_enable_expiry(dict_t *dict, dict_clock_t clock,
+    free_pair_t free_pair)
+{
+    dict_expiry_t *expiry = dict->expiry;
+
+    if (0 == dict->expiry_size && 0 != dict->items)
+        return -1;
+    if (NULL == expiry)
+        expiry = (dict_expiry_t *) dict_alloc(&(dict->allocator), 1,
+            sizeof(dict_expiry_t));
+    if (NULL == expiry)
+        return -1;
+    expiry->clock = NULL != clock ? clock : dict_clock_monotonic;
+    expiry->free_pair = free_pair;
+    dict->expiry = expiry;
+    dict->expiry_size = sizeof(uint64_t);
+    return 0;
+}
@@ -0,0 +1,15 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_enable_filter.c
+** File description:
+** Exposes a function used to enable the membership filter of a dict.
+*/
+
+#include "dict.h"
+
+int dict_enable_filter(dict_t *dict)
+{
+    if (NULL != dict->filter)
+        return 0;
+    return dict_filter_rebuild(dict);
+}
@@ -0,0 +1,31 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_enable_index.c
+** File description:
+** Exposes a function used to enable the ordered index of a dict.
+*/
+
+#include "dict.h"
+
+int dict_enable_index(dict_t *dict)
+{
+    dict_index_t *index = NULL;
+    const bucket_t *bucket = NULL;
+    uint64_t position = 0;
+
+    if (NULL != dict->index)
+        return 0;
+    index = dict_index_ctor(&(dict->allocator));
+    if (NULL == index)
+        return -1;
+    for (; position < dict->size; ++position)
+        for (bucket = dict->buckets[position]; NULL != bucket->key;
+            bucket = bucket->next)
+            if (-1 == dict_index_insert(index, bucket->key,
+                bucket->key_length)) {
+                dict_index_dtor(index);
+                return -1;
+            }
+    dict->index = index;
+    return 0;
+}
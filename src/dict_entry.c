@@ -0,0 +1,16 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_entry.c
+** File description:
+** Exposes a function to access the value slot of a key, inserting the key if
+** it is missing.
+*/
+
+#include "dict.h"
+
+void **dict_entry(dict_t *dict, char *key, uint64_t key_length,
+    int *inserted)
+{
+    return dict_entry_hashed(dict, key, key_length,
+        dict_hash_key(dict, key, key_length), inserted);
+}
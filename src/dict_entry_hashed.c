@@ -0,0 +1,33 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_entry_hashed.c
+** File description:
+** Exposes a function to access the value slot of a key, inserting the key if
+** it is missing, using the precomputed hash of the key.
+*/
+
+#include "dict.h"
+
+void **dict_entry_hashed(dict_t *dict, char *key, uint64_t key_length,
+    dict_hash_t key_hash, int *inserted)
+{
+    int created = 0;
+    bucket_t *node = NULL;
+
+    if (NULL != inserted)
+        *inserted = 0;
+    if (key_hash.seed != dict->seed || 0 != dict->value_size || \
+        (NULL != dict->cache && NULL != dict->cache->size_pair))
+        return NULL;
+    node = dict_entry_node(dict, key, key_length, key_hash.value, NULL,
+        &created);
+    if (NULL != inserted)
+        *inserted = created;
+    if (NULL == node)
+        return NULL;
+    if (NULL != dict->cache)
+        node->flags |= DICT_BUCKET_REFERENCED;
+    if (0 != (node->flags & DICT_BUCKET_BORROWED))
+        node->flags |= DICT_BUCKET_OWNS_VALUE;
+    return &(node->value);
+}
@@ -0,0 +1,16 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_entry_inline.c
+** File description:
+** Exposes a function to access the inline value storage of a key, inserting
+** the key if it is missing.
+*/
+
+#include "dict.h"
+
+void *dict_entry_inline(dict_t *dict, char *key, uint64_t key_length,
+    int *inserted)
+{
+    return dict_entry_inline_hashed(dict, key, key_length,
+        dict_hash_key(dict, key, key_length), inserted);
+}
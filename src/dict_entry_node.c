@@ -0,0 +1,124 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_entry_node.c
+** File description:
+** Exposes the common part of the functions inserting an entry into a dict.
+*/
+
+#include "dict.h"
+
+/**
+ * @brief Evicts entries from a cache mode dict until the new entry fits within
+ * its bounds. Called once the node of the entry is allocated, so that no entry
+ * is evicted for an insertion that fails.
+ *
+ * @param dict The cache mode dict receiving the entry.
+ * @param key The key of the new entry.
+ * @param key_length The length of the key.
+ * @param value The value of the new entry.
+ * @return The number of bytes charged by the new entry.
+ */
+static
+uint64_t dict_cache_make_room(dict_t *dict, const char *key,
+    uint64_t key_length, const void *value)
+{
+    dict_cache_t *cache = dict->cache;
+    uint64_t charge = dict_cache_charge(cache, key, key_length, value);
+
+    while ((0 != cache->max_items && dict->items >= cache->max_items) || \
+        (0 != cache->max_bytes && cache->bytes + charge > cache->max_bytes))
+        if (-1 == dict_cache_evict(dict))
+            break;
+    return charge;
+}
+
+/**
+ * @brief Looks for the live entry holding the key. An expired entry holding
+ * the key is released, so that the key can be inserted again.
+ *
+ * @param dict The dict in which the key is inserted.
+ * @param bucket_addr The address of the bucket receiving the key.
+ * @param key The key to look for.
+ * @param key_length The length of the key.
+ * @return The node holding the key, `NULL` pointer if there is none.
+ */
+static
+bucket_t *dict_holding_node(dict_t *dict, bucket_t **bucket_addr,
+    const char *key, uint64_t key_length)
+{
+    bucket_t **link = dict_bucket_find_link(bucket_addr, key, key_length);
+
+    if (NULL == link)
+        return NULL;
+    if (NULL == dict->expiry || \
+        !DICT_BUCKET_EXPIRED(dict, *link, dict->expiry->clock()))
+        return *link;
+    ++dict->expiry->expired;
+    dict_bucket_release(dict, link, dict->expiry->free_pair);
+    return NULL;
+}
+
+/**
+ * @brief Returns the node holding the key, inserting a new entry if there is
+ * none.
+ *
+ * @param dict The dict holding the entry.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param key_hash The hash of the key.
+ * @param value The value of the entry, if it gets inserted.
+ * @param inserted Set to 1 if the entry was inserted, 0 otherwise.
+ * @return The node of the entry on success, `NULL` pointer on error.
+ */
+static
+bucket_t *dict_entry_find_or_insert(dict_t *dict, char *key,
+    uint64_t key_length, uint32_t key_hash, void *value, int *inserted)
+{
+    uint64_t index = 0;
+    bucket_t **bucket_addr = NULL;
+    bucket_t *node = NULL;
+
+    *inserted = 0;
+    if (UINT32_MAX < key_length || \
+        (DICT_MUST_GROW(dict) && -1 == dict_resize(dict)))
+        return NULL;
+    index = DICT_BUCKET_IDX(key_hash, dict->size);
+    if (-1 == dict_cow_bucket(dict, index))
+        return NULL;
+    bucket_addr = &(dict->buckets[index]);
+    if (NULL == dict->filter || dict_filter_has(dict->filter, key_hash))
+        node = dict_holding_node(dict, bucket_addr, key, key_length);
+    if (NULL != node)
+        return node;
+    if (NULL != dict->index && \
+        -1 == dict_index_insert(dict->index, key, key_length))
+        return NULL;
+    node = dict_bucket_node_ctor(dict, key, key_length, value);
+    if (NULL == node) {
+        if (NULL != dict->index)
+            dict_index_delete(dict->index, key, key_length);
+        return NULL;
+    }
+    if (NULL != dict->cache)
+        dict->cache->bytes += dict_cache_make_room(dict, key, key_length,
+            value);
+    node->next = *bucket_addr;
+    *bucket_addr = node;
+    if (NULL != dict->filter)
+        dict_filter_add(dict->filter, key_hash);
+    ++dict->items;
+    *inserted = 1;
+    return *bucket_addr;
+}
+
+bucket_t *dict_entry_node(dict_t *dict, char *key, uint64_t key_length,
+    uint32_t key_hash, void *value, int *inserted)
+{
+    bucket_t *node = dict_entry_find_or_insert(dict, key, key_length,
+        key_hash, value, inserted);
+
+    if (NULL != dict->trace)
+        dict_trace_record(dict, DICT_TRACE_INSERT, key, key_length,
+            *inserted ? 0 : -1);
+    return node;
+}
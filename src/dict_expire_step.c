@@ -0,0 +1,79 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_expire_step.c
+** File description:
+** Exposes a function used to incrementally remove the expired entries of a
+** dict.
+*/
+
+#include "dict.h"
+
+/**
+ * @brief Returns whether a bucket holds at least one expired entry.
+ *
+ * @param dict The dict holding the bucket.
+ * @param bucket The bucket to look into.
+ * @param now The current date.
+ * @return 1 if an entry has expired, 0 otherwise.
+ */
+static
+int dict_bucket_has_expired(const dict_t *dict, const bucket_t *bucket,
+    uint64_t now)
+{
+    while (NULL != bucket->key) {
+        if (DICT_BUCKET_EXPIRED(dict, bucket, now))
+            return 1;
+        bucket = bucket->next;
+    }
+    return 0;
+}
+
+/**
+ * @brief Removes the expired entries of a bucket. A bucket shared with a clone
+ * is only copied if it holds expired entries.
+ *
+ * @param dict The dict holding the bucket.
+ * @param index The index of the bucket to sweep.
+ * @param now The current date.
+ * @return The number of entries which were removed.
+ */
+static
+uint64_t dict_expire_bucket(dict_t *dict, uint64_t index, uint64_t now)
+{
+    uint64_t removed = 0;
+    bucket_t **link = &(dict->buckets[index]);
+
+    if (!dict_bucket_has_expired(dict, *link, now) || \
+        -1 == dict_cow_bucket(dict, index))
+        return 0;
+    link = &(dict->buckets[index]);
+    while (NULL != (*link)->key) {
+        if (!DICT_BUCKET_EXPIRED(dict, *link, now)) {
+            link = &((*link)->next);
+            continue;
+        }
+        dict_bucket_release(dict, link, dict->expiry->free_pair);
+        ++removed;
+    }
+    return removed;
+}
+
+uint64_t dict_expire_step(dict_t *dict, uint64_t budget)
+{
+    uint64_t removed = 0;
+    uint64_t now = 0;
+    dict_expiry_t *expiry = dict->expiry;
+
+    if (NULL == expiry)
+        return 0;
+    now = expiry->clock();
+    if (budget > dict->size)
+        budget = dict->size;
+    for (; 0 < budget; --budget) {
+        expiry->cursor %= dict->size;
+        removed += dict_expire_bucket(dict, expiry->cursor, now);
+        ++expiry->cursor;
+    }
+    expiry->expired += removed;
+    return removed;
+}
@@ -0,0 +1,46 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_filter_ctor.c
+** File description:
+** Exposes the membership filter constructor.
+*/
+
+#include "dict.h"
+
+/**
+ * @brief Rounds the address up to the next cache line, so that each filter
+ * block fits exactly into one cache line.
+ *
+ * @param memory The raw allocation, with one spare block at its end.
+ * @return The aligned address inside the raw allocation.
+ */
+static
+uint64_t *align_blocks(void *memory)
+{
+    uintptr_t address = (uintptr_t) memory;
+    uintptr_t mask = DICT_FILTER_BLOCK_BITS / 8 - 1;
+
+    return (uint64_t *) ((address + mask) & ~mask);
+}
+
+dict_filter_t *dict_filter_ctor(uint64_t size,
+    const dict_allocator_t *allocator)
+{
+    uint64_t nblocks = size / DICT_FILTER_BUCKETS_PER_BLOCK;
+    dict_filter_t *filter = (dict_filter_t *) dict_alloc(allocator, 1,
+        sizeof(dict_filter_t));
+
+    if (NULL == filter)
+        return NULL;
+    if (0 == nblocks)
+        nblocks = 1;
+    filter->memory = dict_alloc(allocator, nblocks + 1,
+        DICT_FILTER_BLOCK_BITS / 8);
+    if (NULL == filter->memory) {
+        dict_free(allocator, filter);
+        return NULL;
+    }
+    filter->blocks = align_blocks(filter->memory);
+    filter->nblocks = nblocks;
+    return filter;
+}
@@ -0,0 +1,17 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_filter_dtor.c
+** File description:
+** Exposes the membership filter destructor.
+*/
+
+#include "dict.h"
+
+void dict_filter_dtor(dict_filter_t *filter,
+    const dict_allocator_t *allocator)
+{
+    if (NULL == filter)
+        return;
+    dict_free(allocator, filter->memory);
+    dict_free(allocator, filter);
+}
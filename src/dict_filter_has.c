@@ -0,0 +1,29 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_filter_has.c
+** File description:
+** Exposes a function used to query the membership filter.
+*/
+
+#include "dict.h"
+
+int dict_filter_has(const dict_filter_t *filter, uint32_t key_hash)
+{
+    uint64_t index = 0;
+    uint64_t mixed = DICT_FILTER_MIX(key_hash);
+    const uint64_t *block = NULL;
+    uint64_t position = 0;
+    uint64_t step = 0;
+
+    mixed ^= mixed >> 31;
+    block = filter->blocks + DICT_FILTER_BLOCK_WORDS * \
+        ((mixed >> 32) & (filter->nblocks - 1));
+    position = mixed % DICT_FILTER_BLOCK_BITS;
+    step = ((mixed >> 9) % DICT_FILTER_BLOCK_BITS) | 1;
+    for (; index < DICT_FILTER_HASHES; ++index) {
+        if (0 == (block[position / 64] & ((uint64_t) 1 << (position % 64))))
+            return 0;
+        position = (position + step) % DICT_FILTER_BLOCK_BITS;
+    }
+    return 1;
+}
@@ -0,0 +1,47 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_filter_rebuild.c
+** File description:
+** Exposes a function used to rebuild the membership filter of a dict.
+*/
+
+#include "dict.h"
+#include "murmurhash1.h"
+
+/**
+ * @brief Records every key of a bucket linked list inside the filter.
+ *
+ * @param bucket The bucket from which to take the keys.
+ * @param filter The filter in which to record the keys.
+ * @param seed The seed the keys are hashed with.
+ */
+static
+void dict_filter_add_bucket(const bucket_t *bucket, dict_filter_t *filter,
+    uint32_t seed)
+{
+    while (NULL != bucket->key) {
+        dict_filter_add(filter,
+            murmurhash1(bucket->key, bucket->key_length, seed));
+        bucket = bucket->next;
+    }
+}
+
+int dict_filter_rebuild(dict_t *dict)
+{
+    uint64_t index = 0;
+    dict_filter_t *filter = dict_filter_ctor(dict->size,
+        &(dict->allocator));
+
+    if (NULL == filter)
+        return -1;
+    for (; index < dict->size; ++index)
+        dict_filter_add_bucket(dict->buckets[index], filter, dict->seed);
+    if (NULL != dict->filter) {
+        filter->lookups = dict->filter->lookups;
+        filter->rejects = dict->filter->rejects;
+        filter->false_positives = dict->filter->false_positives;
+        dict_filter_dtor(dict->filter, &(dict->allocator));
+    }
+    dict->filter = filter;
+    return 0;
+}
@@ -0,0 +1,14 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_free.c
+** File description:
+** Exposes a function used to release memory through an allocator.
+*/
+
+#include "dict.h"
+
+void dict_free(const dict_allocator_t *allocator, void *ptr)
+{
+    if (NULL != ptr)
+        allocator->release(allocator->ctx, ptr);
+}
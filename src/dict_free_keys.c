@@ -5,11 +5,13 @@
 ** Exposes a function to free the allocate memory from dict_get_keys function.
 */
 
-#include <stdlib.h>
 #include "dict.h"
 
 void dict_free_keys(dict_keys_t *dict_keys)
 {
-    free(dict_keys->keys);
-    free(dict_keys);
+    dict_allocator_t allocator = dict_keys->allocator;
+
+    dict_free(&allocator, dict_keys->keys);
+    dict_free(&allocator, dict_keys->lengths);
+    dict_free(&allocator, dict_keys);
 }
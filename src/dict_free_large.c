@@ -0,0 +1,19 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_free_large.c
+** File description:
+** Exposes a function used to release a large array through an allocator.
+*/
+
+#include "dict.h"
+
+void dict_free_large(const dict_allocator_t *allocator, void *ptr,
+    size_t count, size_t size)
+{
+    if (NULL == ptr)
+        return;
+    if (NULL == allocator->release_large)
+        allocator->release(allocator->ctx, ptr);
+    else
+        allocator->release_large(allocator->ctx, ptr, count * size);
+}
@@ -6,11 +6,12 @@
 ** function.
 */
 
-#include <stdlib.h>
 #include "dict.h"
 
 void dict_free_values(dict_values_t *dict_values)
 {
-    free(dict_values->values);
-    free(dict_values);
+    dict_allocator_t allocator = dict_values->allocator;
+
+    dict_free(&allocator, dict_values->values);
+    dict_free(&allocator, dict_values);
 }
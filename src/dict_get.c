@@ -0,0 +1,16 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_get.c
+** File description:
+** Exposes a function used to get the value of a pair from a dict using the
+** key.
+*/
+
+#include "dict.h"
+
+int dict_get(dict_t *dict, const char *key, uint64_t key_length,
+    void **value)
+{
+    return dict_get_hashed(dict, key, key_length,
+        dict_hash_key(dict, key, key_length), value);
+}
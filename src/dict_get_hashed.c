@@ -0,0 +1,89 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_get_hashed.c
+** File description:
+** Exposes a function to get a value from a dict, using the precomputed hash
+** of its key.
+*/
+
+#include "dict.h"
+
+/**
+ * @brief Tells whether the node has expired, in which case it's released.
+ *
+ * @param dict The dict holding the node.
+ * @param link The address of the pointer to the node.
+ * @param index The index of the bucket holding the node.
+ * @return 1 if the node has expired, 0 otherwise.
+ */
+static
+int dict_get_expired(dict_t *dict, bucket_t **link, uint64_t index)
+{
+    const char *key = (*link)->key;
+    uint64_t key_length = (*link)->key_length;
+
+    if (NULL == dict->expiry || 0 == DICT_BUCKET_EXPIRES_AT(dict, *link) || \
+        !DICT_BUCKET_EXPIRED(dict, *link, dict->expiry->clock()))
+        return 0;
+    if (NULL != dict->shared) {
+        if (-1 == dict_cow_bucket(dict, index))
+            return 1;
+        link = dict_bucket_find_link(&(dict->buckets[index]), key,
+            key_length);
+    }
+    ++dict->expiry->expired;
+    dict_bucket_release(dict, link, dict->expiry->free_pair);
+    return 1;
+}
+
+/**
+ * @brief Looks the key up.
+ *
+ * @param dict The dict in which to look for the key.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param key_hash The hash of the key.
+ * @param value Where to store the value, may be `NULL`.
+ * @return 0 on success, -1 if the key was not found.
+ */
+static
+int dict_get_entry(dict_t *dict, const char *key, uint64_t key_length,
+    dict_hash_t key_hash, void **value)
+{
+    uint64_t index = DICT_BUCKET_IDX(key_hash.value, dict->size);
+    bucket_t **link = NULL;
+
+    if (key_hash.seed != dict->seed)
+        return -1;
+
+    if (NULL != dict->filter) {
+        ++dict->filter->lookups;
+        if (!dict_filter_has(dict->filter, key_hash.value)) {
+            ++dict->filter->rejects;
+            return -1;
+        }
+    }
+    link = dict_bucket_find_link(&(dict->buckets[index]), key, key_length);
+    if (NULL == link) {
+        if (NULL != dict->filter)
+            ++dict->filter->false_positives;
+        return -1;
+    }
+    if (dict_get_expired(dict, link, index))
+        return -1;
+    if (NULL != dict->cache && DICT_OWNS_BUCKET(dict, index))
+        (*link)->flags |= DICT_BUCKET_REFERENCED;
+    if (NULL != value)
+        *value = (*link)->value;
+    return 0;
+}
+
+int dict_get_hashed(dict_t *dict, const char *key, uint64_t key_length,
+    dict_hash_t key_hash, void **value)
+{
+    int status = dict_get_entry(dict, key, key_length, key_hash, value);
+
+    if (NULL != dict->trace)
+        dict_trace_record(dict, DICT_TRACE_GET, key, key_length, status);
+    return status;
+}
@@ -6,12 +6,12 @@
 */
 
 #include <assert.h>
-#include <stdlib.h>
 #include "dict.h"
 
 /**
  * @brief This function will extract the keys from each bucket of the dict and
- * place their reference to the `keys` member of the `keys` array.
+ * place their reference to the `keys` member of the `keys` array, and their
+ * length to the `lengths` member.
  *
  * @param dict The dict to get the keys from.
  * @param keys The keys object in which to set the keys.
@@ -25,7 +25,8 @@ void populate_keys(const dict_t *dict, dict_keys_t *keys)
     for (; index < dict->size; ++index) {
         bucket = dict->buckets[index];
         while (NULL != bucket->key) {
-            keys->keys[keys->size++] = bucket->key;
+            keys->keys[keys->size] = bucket->key;
+            keys->lengths[keys->size++] = bucket->key_length;
             bucket = bucket->next;
         }
     }
@@ -34,15 +35,22 @@ void populate_keys(const dict_t *dict, dict_keys_t *keys)
 
 dict_keys_t *dict_get_keys(const dict_t *dict)
 {
-    dict_keys_t *keys = (dict_keys_t *) calloc(1, sizeof(dict_keys_t));
+    dict_keys_t *keys = (dict_keys_t *) dict_alloc(&(dict->allocator), 1,
+        sizeof(dict_keys_t));
 
     if (NULL == keys)
         return NULL;
-    keys->keys = (const char **) calloc(dict->items, sizeof(char *));
-    if (NULL == keys->keys) {
-        free(keys);
+    keys->keys = (const char **) dict_alloc(&(dict->allocator), dict->items,
+        sizeof(char *));
+    keys->lengths = (uint64_t *) dict_alloc(&(dict->allocator), dict->items,
+        sizeof(uint64_t));
+    if (NULL == keys->keys || NULL == keys->lengths) {
+        dict_free(&(dict->allocator), keys->keys);
+        dict_free(&(dict->allocator), keys->lengths);
+        dict_free(&(dict->allocator), keys);
         return NULL;
     }
+    keys->allocator = dict->allocator;
     populate_keys(dict, keys);
     return keys;
 }
@@ -0,0 +1,49 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_get_sorted_keys.c
+** File description:
+** Exposes a function to get the sorted list of keys of a dict.
+*/
+
+#include "dict.h"
+
+/**
+ * @brief Appends a key to the keys object given as context.
+ *
+ * @return 0, so that the scan goes on.
+ */
+static
+int dict_collect_key(const char *key, uint64_t key_length,
+    __attribute__((unused)) void *value, void *ctx)
+{
+    dict_keys_t *keys = (dict_keys_t *) ctx;
+
+    keys->keys[keys->size] = key;
+    keys->lengths[keys->size++] = key_length;
+    return 0;
+}
+
+dict_keys_t *dict_get_sorted_keys(const dict_t *dict)
+{
+    dict_keys_t *keys = NULL;
+
+    if (NULL == dict->index)
+        return NULL;
+    keys = (dict_keys_t *) dict_alloc(&(dict->allocator), 1,
+        sizeof(dict_keys_t));
+    if (NULL == keys)
+        return NULL;
+    keys->keys = (const char **) dict_alloc(&(dict->allocator),
+        dict->index->items, sizeof(char *));
+    keys->lengths = (uint64_t *) dict_alloc(&(dict->allocator),
+        dict->index->items, sizeof(uint64_t));
+    if (NULL == keys->keys || NULL == keys->lengths) {
+        dict_free(&(dict->allocator), keys->keys);
+        dict_free(&(dict->allocator), keys->lengths);
+        dict_free(&(dict->allocator), keys);
+        return NULL;
+    }
+    keys->allocator = dict->allocator;
+    dict_scan_range(dict, NULL, 0, NULL, 0, dict_collect_key, keys);
+    return keys;
+}
@@ -6,7 +6,6 @@
 */
 
 #include <assert.h>
-#include <stdlib.h>
 #include "dict.h"
 
 /**
@@ -34,15 +33,18 @@ void populate_values(const dict_t *dict, dict_values_t *values)
 
 dict_values_t *dict_get_values(const dict_t *dict)
 {
-    dict_values_t *values = (dict_values_t *) calloc(1, sizeof(dict_values_t));
+    dict_values_t *values = (dict_values_t *) dict_alloc(&(dict->allocator),
+        1, sizeof(dict_values_t));
 
     if (NULL == values)
         return NULL;
-    values->values = (const void **) calloc(dict->items, sizeof(void *));
+    values->values = (const void **) dict_alloc(&(dict->allocator),
+        dict->items, sizeof(void *));
     if (NULL == values->values) {
-        free(values);
+        dict_free(&(dict->allocator), values);
         return NULL;
     }
+    values->allocator = dict->allocator;
     populate_values(dict, values);
     return values;
 }
@@ -0,0 +1,13 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_has_key.c
+** File description:
+** Exposes a function used to tell whether a key is present in a dict.
+*/
+
+#include "dict.h"
+
+int dict_has_key(dict_t *dict, const char *key, uint64_t key_length)
+{
+    return 0 == dict_get(dict, key, key_length, NULL);
+}
@@ -0,0 +1,15 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_has_key_hashed.c
+** File description:
+** Exposes a function used to check if a key exists in a dict, using its
+** precomputed hash.
+*/
+
+#include "dict.h"
+
+int dict_has_key_hashed(dict_t *dict, const char *key, uint64_t key_length,
+    dict_hash_t key_hash)
+{
+    return 0 == dict_get_hashed(dict, key, key_length, key_hash, NULL);
+}
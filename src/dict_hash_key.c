@@ -0,0 +1,19 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_hash_key.c
+** File description:
+** Exposes a function to hash a key once, for several dicts.
+*/
+
+#include "dict.h"
+#include "murmurhash1.h"
+
+dict_hash_t dict_hash_key(const dict_t *dict, const char *key,
+    uint64_t key_length)
+{
+    dict_hash_t key_hash = { 0, 0 };
+
+    key_hash.value = murmurhash1(key, key_length, dict->seed);
+    key_hash.seed = dict->seed;
+    return key_hash;
+}
@@ -0,0 +1,30 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_hash_keys.c
+** File description:
+** Exposes a function to hash a batch of keys once, for several dicts.
+*/
+
+#include "dict.h"
+#include "murmurhash1.h"
+
+void dict_hash_keys(const dict_t *dict, const char *const *keys,
+    const uint64_t *lengths, uint64_t count, dict_hash_t *hashes)
+{
+    uint32_t values[MURMURHASH1_MAX_LANES] = { 0 };
+    uint64_t chunk = 0;
+    uint64_t index = 0;
+
+    for (; 0 < count; count -= chunk) {
+        chunk = count < MURMURHASH1_MAX_LANES ? count : MURMURHASH1_MAX_LANES;
+        murmurhash1_many((const void *const *) keys, lengths, chunk,
+            dict->seed, values);
+        for (index = 0; index < chunk; ++index) {
+            hashes[index].value = values[index];
+            hashes[index].seed = dict->seed;
+        }
+        keys += chunk;
+        lengths += chunk;
+        hashes += chunk;
+    }
+}
@@ -0,0 +1,166 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_huge_allocator.c
+** File description:
+** Exposes a function used to map the large arrays of a dict on huge pages,
+** optionally placed on NUMA nodes.
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "dict.h"
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+/**
+ * @brief Rounds a size up to the huge page size.
+ *
+ * @param S The size to round.
+ */
+#define DICT_HUGE_ROUND(S) \
+    (((S) + DICT_HUGE_PAGE_SIZE - 1) & ~(DICT_HUGE_PAGE_SIZE - 1))
+
+/**
+ * @brief Maps anonymous memory aligned on a huge page boundary, by mapping one
+ * more huge page and unmapping what lies outside the aligned range.
+ *
+ * @param length The length to map, a multiple of the huge page size.
+ * @return The mapping on success, `NULL` pointer on error.
+ */
+static
+unsigned char *dict_huge_map(size_t length)
+{
+    unsigned char *raw = NULL;
+    unsigned char *aligned = NULL;
+    size_t head = 0;
+
+    if (length > SIZE_MAX - DICT_HUGE_PAGE_SIZE)
+        return NULL;
+    raw = (unsigned char *) mmap(NULL, length + DICT_HUGE_PAGE_SIZE,
+        PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == (void *) raw)
+        return NULL;
+    aligned = (unsigned char *) DICT_HUGE_ROUND((uintptr_t) raw);
+    head = aligned - raw;
+    if (0 != head)
+        munmap(raw, head);
+    munmap(aligned + length, DICT_HUGE_PAGE_SIZE - head);
+    return aligned;
+}
+
+/**
+ * @brief Applies the NUMA policy to the mapping, before any of its pages is
+ * faulted in.
+ *
+ * @param huge The placement of the large arrays.
+ * @param address The mapping.
+ * @param length The length of the mapping.
+ * @return 0 on success or if there is no policy, -1 if it failed.
+ */
+static
+int dict_huge_bind(const dict_huge_pages_t *huge, void *address,
+    size_t length)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    unsigned long nodes = (unsigned long) huge->numa_nodes;
+    int mode = DICT_NUMA_BIND == huge->numa_policy ? MPOL_BIND : \
+        MPOL_INTERLEAVE;
+
+    if (DICT_NUMA_DEFAULT == huge->numa_policy)
+        return 0;
+    return 0 == syscall(SYS_mbind, address, length, mode, &nodes,
+        sizeof(nodes) * 8 + 1, 0) ? 0 : -1;
+#else
+    (void) address;
+    (void) length;
+    return DICT_NUMA_DEFAULT == huge->numa_policy ? 0 : -1;
+#endif
+}
+
+/**
+ * @brief Faults the pages of the mapping in, so that the first lookups do not
+ * pay for it.
+ *
+ * @param address The mapping.
+ * @param length The length of the mapping.
+ */
+static
+void dict_huge_populate(unsigned char *address, size_t length)
+{
+    size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    size_t offset = 0;
+
+#ifdef MADV_POPULATE_WRITE
+    if (0 == madvise(address, length, MADV_POPULATE_WRITE))
+        return;
+#endif
+    for (; offset < length; offset += page)
+        ((volatile unsigned char *) address)[offset] = 0;
+}
+
+/**
+ * @brief Allocates a large array: mapped apart if it reaches the threshold,
+ * from the standard library otherwise.
+ */
+static
+void *dict_huge_allocate(void *ctx, size_t size)
+{
+    dict_huge_pages_t *huge = (dict_huge_pages_t *) ctx;
+    size_t threshold = 0 != huge->threshold ? huge->threshold : \
+        DICT_HUGE_PAGE_SIZE;
+    size_t length = DICT_HUGE_ROUND(size);
+    unsigned char *address = NULL;
+
+    if (size < threshold || length < size)
+        return calloc(1, size);
+    address = dict_huge_map(length);
+    if (NULL == address)
+        return NULL;
+#ifdef MADV_HUGEPAGE
+    if (-1 == madvise(address, length, MADV_HUGEPAGE))
+        ++huge->huge_page_failures;
+#else
+    ++huge->huge_page_failures;
+#endif
+    if (-1 == dict_huge_bind(huge, address, length))
+        ++huge->numa_failures;
+    if (huge->populate)
+        dict_huge_populate(address, length);
+    ++huge->mapped;
+    return address;
+}
+
+/**
+ * @brief Releases a large array, the size telling how it was allocated.
+ */
+static
+void dict_huge_release(void *ctx, void *ptr, size_t size)
+{
+    dict_huge_pages_t *huge = (dict_huge_pages_t *) ctx;
+    size_t threshold = 0 != huge->threshold ? huge->threshold : \
+        DICT_HUGE_PAGE_SIZE;
+
+    if (size < threshold || DICT_HUGE_ROUND(size) < size)
+        free(ptr);
+    else
+        munmap(ptr, DICT_HUGE_ROUND(size));
+}
+
+void dict_huge_allocator(dict_huge_pages_t *huge,
+    dict_allocator_t *allocator)
+{
+    *allocator = *dict_std_allocator();
+    allocator->ctx = huge;
+    allocator->allocate_large = dict_huge_allocate;
+    allocator->release_large = dict_huge_release;
+}
@@ -0,0 +1,15 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_incr.c
+** File description:
+** Exposes the function counting a key of a counting dict.
+*/
+
+#include "dict.h"
+
+int dict_incr(dict_t *dict, char *key, uint64_t key_length, uint64_t delta,
+    int *inserted)
+{
+    return dict_incr_hashed(dict, key, key_length,
+        dict_hash_key(dict, key, key_length), delta, inserted);
+}
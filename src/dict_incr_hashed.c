@@ -0,0 +1,26 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_incr_hashed.c
+** File description:
+** Exposes the function counting a key of a counting dict, with the
+** precomputed hash of the key.
+*/
+
+#include "dict.h"
+
+int dict_incr_hashed(dict_t *dict, char *key, uint64_t key_length,
+    dict_hash_t key_hash, uint64_t delta, int *inserted)
+{
+    uint64_t *count = NULL;
+
+    if (NULL != inserted)
+        *inserted = 0;
+    if (sizeof(uint64_t) > dict->value_size)
+        return -1;
+    count = (uint64_t *) dict_entry_inline_hashed(dict, key, key_length,
+        key_hash, inserted);
+    if (NULL == count)
+        return -1;
+    *count += delta;
+    return 0;
+}
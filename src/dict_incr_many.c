@@ -0,0 +1,37 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_incr_many.c
+** File description:
+** Exposes the function counting a batch of keys of a counting dict.
+*/
+
+#include "dict.h"
+
+int dict_incr_many(dict_t *dict, char *const *keys, const uint64_t *lengths,
+    uint64_t count, uint64_t delta, int *inserted)
+{
+    dict_hash_t hashes[DICT_INCR_BATCH];
+    uint64_t batch = 0;
+    uint64_t index = 0;
+
+    if (sizeof(uint64_t) > dict->value_size)
+        return -1;
+    for (; 0 < count; count -= batch) {
+        batch = DICT_INCR_BATCH < count ? DICT_INCR_BATCH : count;
+        dict_hash_keys(dict, (const char *const *) keys, lengths, batch,
+            hashes);
+        for (index = 0; index < batch; ++index)
+            __builtin_prefetch(dict->buckets[DICT_BUCKET_IDX(
+                hashes[index].value, dict->size)]);
+        for (index = 0; index < batch; ++index)
+            if (-1 == dict_incr_hashed(dict, keys[index], lengths[index],
+                hashes[index], delta, NULL == inserted ? NULL : \
+                inserted + index))
+                return -1;
+        keys += batch;
+        lengths += batch;
+        if (NULL != inserted)
+            inserted += batch;
+    }
+    return 0;
+}
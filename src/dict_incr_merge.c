@@ -0,0 +1,24 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_incr_merge.c
+** File description:
+** Exposes the function adding the counts of a counting dict to another one.
+*/
+
+#include "dict.h"
+
+int dict_incr_merge(dict_t *dict, const dict_t *partial)
+{
+    const bucket_t *node = NULL;
+    uint64_t index = 0;
+
+    if (sizeof(uint64_t) > partial->value_size)
+        return -1;
+    for (; index < partial->size; ++index)
+        for (node = partial->buckets[index]; NULL != node->key;
+            node = node->next)
+            if (-1 == dict_incr(dict, node->key, node->key_length,
+                *(const uint64_t *) node->value, NULL))
+                return -1;
+    return 0;
+}
@@ -0,0 +1,200 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_incr_parallel.c
+** File description:
+** Exposes the function counting a batch of keys across several threads.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include "dict.h"
+
+/**
+ * @brief The share of the keys counted by a thread.
+ */
+typedef struct s_dict_incr_share {
+    /** The partial dict of the thread, `NULL` pointer on error. */
+    dict_t *partial;
+
+    /** The first key of the share. */
+    char *const *keys;
+
+    /** The length of each key. */
+    const uint64_t *lengths;
+
+    /** The number of keys of the share. */
+    uint64_t count;
+
+    /** The index of the first key of the share among all the keys. */
+    uint64_t offset;
+
+    /**
+     * The inserted flags of all the keys, `NULL` pointer if not wanted. Each
+     * partial entry then also holds the index of its key after its count.
+     */
+    int *inserted;
+
+    /** The thread counting the share. */
+    pthread_t thread;
+
+    /** Whether the thread was started. */
+    int started;
+} dict_incr_share_t;
+
+/**
+ * @brief Stores the index of the key of each partial entry after its count,
+ * so that the key can be flagged once merged.
+ *
+ * @param share The counted share.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_incr_share_origins(dict_incr_share_t *share)
+{
+    int *inserted = share->inserted + share->offset;
+    void *value = NULL;
+    uint64_t index = 0;
+
+    for (; index < share->count; ++index) {
+        if (!inserted[index])
+            continue;
+        if (-1 == dict_get(share->partial, share->keys[index],
+            share->lengths[index], &value))
+            return -1;
+        ((uint64_t *) value)[1] = share->offset + index;
+    }
+    return 0;
+}
+
+/**
+ * @brief Counts a share of the keys into the partial dict of the thread,
+ * which is released on error.
+ *
+ * @param arg The share to count.
+ * @return A `NULL` pointer.
+ */
+static
+void *dict_incr_share(void *arg)
+{
+    dict_incr_share_t *share = (dict_incr_share_t *) arg;
+
+    if (-1 == dict_incr_many(share->partial, share->keys, share->lengths,
+        share->count, 1, NULL == share->inserted ? NULL : \
+        share->inserted + share->offset) || \
+        (NULL != share->inserted && -1 == dict_incr_share_origins(share))) {
+        dict_dtor(share->partial, NULL);
+        share->partial = NULL;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Builds the partial dict of a share, hashing the keys like the dict
+ * does.
+ *
+ * @param dict The counting dict.
+ * @param origins Whether the entries hold the index of their key.
+ * @return The partial dict on success, `NULL` pointer on error.
+ */
+static
+dict_t *dict_incr_partial(const dict_t *dict, int origins)
+{
+    dict_t *partial = dict_ctor_with_value_size(origins ? \
+        2 * sizeof(uint64_t) : dict->value_size);
+
+    if (NULL != partial)
+        dict_set_seed(partial, dict->seed);
+    return partial;
+}
+
+/**
+ * @brief Merges the partial dict of a share into the dict. When the inserted
+ * flags are wanted, the flag of the key of each partial entry is cleared if
+ * the dict already counted the key.
+ *
+ * @param dict The counting dict.
+ * @param share The share whose partial dict to merge.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_incr_merge_share(dict_t *dict, const dict_incr_share_t *share)
+{
+    const bucket_t *node = NULL;
+    uint64_t index = 0;
+    int kept = 0;
+
+    if (NULL == share->inserted)
+        return dict_incr_merge(dict, share->partial);
+    for (; index < share->partial->size; ++index)
+        for (node = share->partial->buckets[index]; NULL != node->key;
+            node = node->next) {
+            if (-1 == dict_incr(dict, node->key, node->key_length,
+                *(const uint64_t *) node->value, &kept))
+                return -1;
+            share->inserted[((const uint64_t *) node->value)[1]] = kept;
+        }
+    return 0;
+}
+
+/**
+ * @brief Waits for the threads, and merges their partial dicts in order.
+ *
+ * @param dict The counting dict.
+ * @param shares The shares of the threads.
+ * @param threads The number of threads.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_incr_join(dict_t *dict, dict_incr_share_t *shares,
+    uint64_t threads)
+{
+    uint64_t index = 0;
+    int status = 0;
+
+    for (; index < threads; ++index) {
+        if (shares[index].started)
+            pthread_join(shares[index].thread, NULL);
+        if (NULL == shares[index].partial || \
+            (0 == status && -1 == dict_incr_merge_share(dict,
+            &(shares[index]))))
+            status = -1;
+        if (NULL != shares[index].partial)
+            dict_dtor(shares[index].partial, NULL);
+    }
+    return status;
+}
+
+int dict_incr_parallel(dict_t *dict, char *const *keys,
+    const uint64_t *lengths, uint64_t count, uint64_t threads, int *inserted)
+{
+    dict_incr_share_t *shares = NULL;
+    uint64_t index = 0;
+    uint64_t offset = 0;
+    int status = 0;
+
+    if (2 > threads || count < threads)
+        return dict_incr_many(dict, keys, lengths, count, 1, inserted);
+    shares = (dict_incr_share_t *) dict_alloc(&(dict->allocator), threads,
+        sizeof(dict_incr_share_t));
+    if (NULL == shares)
+        return -1;
+    for (; index < threads; ++index) {
+        shares[index].keys = keys + offset;
+        shares[index].lengths = lengths + offset;
+        shares[index].count = (count - offset) / (threads - index);
+        shares[index].offset = offset;
+        shares[index].inserted = inserted;
+        offset += shares[index].count;
+        shares[index].partial = dict_incr_partial(dict, NULL != inserted);
+        if (NULL == shares[index].partial)
+            break;
+        shares[index].started = 0 == pthread_create(&(shares[index].thread),
+            NULL, dict_incr_share, &(shares[index]));
+        if (!shares[index].started)
+            dict_incr_share(&(shares[index]));
+    }
+    status = dict_incr_join(dict, shares, threads);
+    dict_free(&(dict->allocator), shares);
+    return status;
+}
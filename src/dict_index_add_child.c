@@ -0,0 +1,116 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_index_add_child.c
+** File description:
+** Exposes a function used to add a child to an ordered index node.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Inserts a child into an array of children whose bytes are kept
+ * sorted. The array must have room for it.
+ *
+ * @param keys The bytes of the children.
+ * @param children The children.
+ * @param count The number of children, incremented.
+ * @param byte The byte of the child.
+ * @param child The child to insert.
+ */
+static
+void dict_index_insert_sorted(unsigned char *keys, void **children,
+    uint16_t *count, unsigned char byte, void *child)
+{
+    uint16_t position = 0;
+
+    while (position < *count && keys[position] < byte)
+        ++position;
+    memmove(keys + position + 1, keys + position, *count - position);
+    memmove(children + position + 1, children + position,
+        (*count - position) * sizeof(void *));
+    keys[position] = byte;
+    children[position] = child;
+    ++*count;
+}
+
+/**
+ * @brief Replaces a full node by a node of the next kind holding the same
+ * entries.
+ *
+ * @param index The index the node belongs to.
+ * @param ref The address of the pointer to the node.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_index_grow(dict_index_t *index, void **ref)
+{
+    dict_index_node_t *node = (dict_index_node_t *) *ref;
+    dict_index_node_t *grown = dict_index_node_ctor(index, node->type + 1);
+    unsigned int byte = 0;
+    void **child = NULL;
+
+    if (NULL == grown)
+        return -1;
+    grown->leaf = node->leaf;
+    grown->prefix_length = node->prefix_length;
+    memcpy(grown->prefix, node->prefix, DICT_INDEX_PREFIX);
+    for (; NULL != (child = dict_index_next_child(node, &byte)); ++byte)
+        dict_index_add_child(index, (void **) &grown, (unsigned char) byte,
+            *child);
+    dict_index_node_dtor(index, node);
+    *ref = grown;
+    return 0;
+}
+
+/**
+ * @brief Stores a child into the first free position of a 48 children node.
+ *
+ * @param node The node receiving the child.
+ * @param byte The byte of the child.
+ * @param child The child to store.
+ */
+static
+void dict_index_add_child48(dict_index_node48_t *node, unsigned char byte,
+    void *child)
+{
+    unsigned char position = 0;
+
+    while (NULL != node->children[position])
+        ++position;
+    node->children[position] = child;
+    node->slots[byte] = position + 1;
+    ++node->node.children;
+}
+
+int dict_index_add_child(dict_index_t *index, void **ref, unsigned char byte,
+    void *child)
+{
+    dict_index_node_t *node = (dict_index_node_t *) *ref;
+    static const uint16_t capacities[] = { 4, 16, 48, 256 };
+
+    if (node->children == capacities[node->type]) {
+        if (-1 == dict_index_grow(index, ref))
+            return -1;
+        node = (dict_index_node_t *) *ref;
+    }
+    switch (node->type) {
+    case DICT_INDEX_NODE4:
+        dict_index_insert_sorted(((dict_index_node4_t *) node)->keys,
+            ((dict_index_node4_t *) node)->children, &(node->children), byte,
+            child);
+        break;
+    case DICT_INDEX_NODE16:
+        dict_index_insert_sorted(((dict_index_node16_t *) node)->keys,
+            ((dict_index_node16_t *) node)->children, &(node->children), byte,
+            child);
+        break;
+    case DICT_INDEX_NODE48:
+        dict_index_add_child48((dict_index_node48_t *) node, byte, child);
+        break;
+    default:
+        ((dict_index_node256_t *) node)->children[byte] = child;
+        ++node->children;
+    }
+    return 0;
+}
@@ -0,0 +1,57 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_index_collapse.c
+** File description:
+** Exposes a function used to collapse an ordered index node holding a single
+** entry.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Prepends the compressed path of a node and the byte of its only
+ * child to the compressed path of that child.
+ *
+ * @param node The node being collapsed.
+ * @param byte The byte of the child.
+ * @param child The child taking the place of the node.
+ */
+static
+void dict_index_merge_prefix(const dict_index_node_t *node,
+    unsigned char byte, dict_index_node_t *child)
+{
+    unsigned char merged[DICT_INDEX_PREFIX];
+    uint64_t length = node->prefix_length < DICT_INDEX_PREFIX ? \
+        node->prefix_length : DICT_INDEX_PREFIX;
+    uint64_t rest = 0;
+
+    memcpy(merged, node->prefix, length);
+    if (length < DICT_INDEX_PREFIX)
+        merged[length++] = byte;
+    rest = child->prefix_length < DICT_INDEX_PREFIX - length ? \
+        child->prefix_length : DICT_INDEX_PREFIX - length;
+    memcpy(merged + length, child->prefix, rest);
+    memcpy(child->prefix, merged, length + rest);
+    child->prefix_length += node->prefix_length + 1;
+}
+
+void dict_index_collapse(dict_index_t *index, void **ref)
+{
+    dict_index_node_t *node = (dict_index_node_t *) *ref;
+    unsigned int byte = 0;
+    void *child = NULL;
+
+    if (1 < node->children + (NULL != node->leaf))
+        return;
+    if (0 == node->children)
+        child = NULL == node->leaf ? NULL : DICT_INDEX_TAG(node->leaf);
+    else {
+        child = *dict_index_next_child(node, &byte);
+        if (!DICT_INDEX_IS_LEAF(child))
+            dict_index_merge_prefix(node, (unsigned char) byte,
+                (dict_index_node_t *) child);
+    }
+    dict_index_node_dtor(index, node);
+    *ref = child;
+}
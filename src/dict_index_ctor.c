@@ -0,0 +1,19 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_index_ctor.c
+** File description:
+** Exposes the ordered index constructor.
+*/
+
+#include "dict.h"
+
+dict_index_t *dict_index_ctor(const dict_allocator_t *allocator)
+{
+    dict_index_t *index = (dict_index_t *) dict_alloc(allocator, 1,
+        sizeof(dict_index_t));
+
+    if (NULL == index)
+        return NULL;
+    index->allocator = *allocator;
+    return index;
+}
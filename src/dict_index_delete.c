@@ -0,0 +1,94 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_index_delete.c
+** File description:
+** Exposes a function used to remove a key from an ordered index.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Returns whether the leaf holds the key.
+ *
+ * @param leaf The leaf to compare.
+ * @param key The key to look for.
+ * @param key_length The length of the key.
+ * @return 1 if the leaf holds the key, 0 otherwise.
+ */
+static
+int dict_index_leaf_match(const dict_index_leaf_t *leaf, const char *key,
+    uint64_t key_length)
+{
+    return key_length == leaf->key_length && \
+        0 == memcmp(leaf->key, key, key_length);
+}
+
+/**
+ * @brief Releases a leaf removed from the index.
+ *
+ * @param index The index the leaf belonged to.
+ * @param leaf The leaf to release.
+ */
+static
+void dict_index_leaf_dtor(dict_index_t *index, dict_index_leaf_t *leaf)
+{
+    index->bytes -= sizeof(dict_index_leaf_t);
+    --index->items;
+    dict_free(&(index->allocator), leaf);
+}
+
+/**
+ * @brief Removes a key from a subtree.
+ *
+ * @param index The index holding the key.
+ * @param ref The address of the pointer to the root of the subtree.
+ * @param key The key to remove.
+ * @param key_length The length of the key.
+ * @param depth The number of bytes of the key consumed by the parents.
+ * @return 0 on success, -1 if the key was not found.
+ */
+static
+int dict_index_delete_at(dict_index_t *index, void **ref, const char *key,
+    uint64_t key_length, uint64_t depth)
+{
+    dict_index_node_t *node = (dict_index_node_t *) *ref;
+    unsigned char byte = 0;
+    void **child = NULL;
+
+    if (DICT_INDEX_IS_LEAF(node)) {
+        if (!dict_index_leaf_match(DICT_INDEX_LEAF(node), key, key_length))
+            return -1;
+        dict_index_leaf_dtor(index, DICT_INDEX_LEAF(node));
+        *ref = NULL;
+        return 0;
+    }
+    if (node->prefix_length != dict_index_prefix_mismatch(node, key,
+        key_length, depth))
+        return -1;
+    depth += node->prefix_length;
+    if (depth == key_length) {
+        if (NULL == node->leaf)
+            return -1;
+        dict_index_leaf_dtor(index, node->leaf);
+        node->leaf = NULL;
+        dict_index_collapse(index, ref);
+        return 0;
+    }
+    byte = (unsigned char) key[depth];
+    child = dict_index_find_child(node, byte);
+    if (NULL == child || \
+        -1 == dict_index_delete_at(index, child, key, key_length, depth + 1))
+        return -1;
+    if (NULL == *child)
+        dict_index_remove_child(index, ref, byte);
+    return 0;
+}
+
+int dict_index_delete(dict_index_t *index, const char *key,
+    uint64_t key_length)
+{
+    if (NULL == index->root)
+        return -1;
+    return dict_index_delete_at(index, &(index->root), key, key_length, 0);
+}
@@ -0,0 +1,19 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_index_dtor.c
+** File description:
+** Exposes the ordered index destructor.
+*/
+
+#include "dict.h"
+
+void dict_index_dtor(dict_index_t *index)
+{
+    dict_allocator_t allocator = { 0 };
+
+    if (NULL == index)
+        return;
+    allocator = index->allocator;
+    dict_index_release(index, index->root);
+    dict_free(&allocator, index);
+}
@@ -0,0 +1,36 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_index_find_child.c
+** File description:
+** Exposes a function used to find a child of an ordered index node.
+*/
+
+#include "dict.h"
+
+void **dict_index_find_child(dict_index_node_t *node, unsigned char byte)
+{
+    dict_index_node4_t *node4 = (dict_index_node4_t *) node;
+    dict_index_node16_t *node16 = (dict_index_node16_t *) node;
+    dict_index_node48_t *node48 = (dict_index_node48_t *) node;
+    dict_index_node256_t *node256 = (dict_index_node256_t *) node;
+    uint16_t position = 0;
+
+    switch (node->type) {
+    case DICT_INDEX_NODE4:
+        for (; position < node->children; ++position)
+            if (byte == node4->keys[position])
+                return &(node4->children[position]);
+        return NULL;
+    case DICT_INDEX_NODE16:
+        for (; position < node->children; ++position)
+            if (byte == node16->keys[position])
+                return &(node16->children[position]);
+        return NULL;
+    case DICT_INDEX_NODE48:
+        return 0 == node48->slots[byte] ? NULL : \
+            &(node48->children[node48->slots[byte] - 1]);
+    default:
+        return NULL == node256->children[byte] ? NULL : \
+            &(node256->children[byte]);
+    }
+}
@@ -0,0 +1,167 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_index_insert.c
+** File description:
+** Exposes a function used to add a key to an ordered index.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Attaches a leaf to a node, as the key ending at the node or as the
+ * child of its next byte. The node must have room for it.
+ *
+ * @param index The index the node belongs to.
+ * @param node The address of the pointer to the node.
+ * @param leaf The leaf to attach.
+ * @param depth The number of bytes of the key consumed down to the node.
+ */
+static
+void dict_index_attach(dict_index_t *index, void **node,
+    dict_index_leaf_t *leaf, uint64_t depth)
+{
+    if (depth == leaf->key_length)
+        ((dict_index_node_t *) *node)->leaf = leaf;
+    else
+        dict_index_add_child(index, node,
+            (unsigned char) leaf->key[depth], DICT_INDEX_TAG(leaf));
+}
+
+/**
+ * @brief Replaces a leaf by a node holding both the leaf and the new one,
+ * whose compressed path is the bytes they share.
+ *
+ * @param index The index receiving the key.
+ * @param ref The address of the pointer to the leaf.
+ * @param leaf The leaf of the new key.
+ * @param depth The number of bytes of the key consumed by the parents.
+ * @return 0 on success, 1 if the key is already present, -1 on error.
+ */
+static
+int dict_index_split_leaf(dict_index_t *index, void **ref,
+    dict_index_leaf_t *leaf, uint64_t depth)
+{
+    dict_index_leaf_t *existing = DICT_INDEX_LEAF(*ref);
+    uint64_t limit = existing->key_length < leaf->key_length ? \
+        existing->key_length : leaf->key_length;
+    uint64_t common = depth;
+    void *node = NULL;
+
+    while (common < limit && existing->key[common] == leaf->key[common])
+        ++common;
+    if (common == existing->key_length && common == leaf->key_length)
+        return 1;
+    node = dict_index_node_ctor(index, DICT_INDEX_NODE4);
+    if (NULL == node)
+        return -1;
+    ((dict_index_node_t *) node)->prefix_length = common - depth;
+    memcpy(((dict_index_node_t *) node)->prefix, leaf->key + depth,
+        common - depth < DICT_INDEX_PREFIX ? common - depth : \
+        DICT_INDEX_PREFIX);
+    dict_index_attach(index, &node, existing, common);
+    dict_index_attach(index, &node, leaf, common);
+    *ref = node;
+    return 0;
+}
+
+/**
+ * @brief Cuts the compressed path of a node where the new key diverges from
+ * it, inserting a parent node holding the beginning of the path, the node and
+ * the new leaf.
+ *
+ * @param index The index receiving the key.
+ * @param ref The address of the pointer to the node.
+ * @param leaf The leaf of the new key.
+ * @param depth The number of bytes of the key consumed by the parents.
+ * @param matched The number of bytes of the path the key matched.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_index_split_prefix(dict_index_t *index, void **ref,
+    dict_index_leaf_t *leaf, uint64_t depth, uint64_t matched)
+{
+    dict_index_node_t *node = (dict_index_node_t *) *ref;
+    void *parent = dict_index_node_ctor(index, DICT_INDEX_NODE4);
+    const unsigned char *path = node->prefix;
+    unsigned char byte = 0;
+
+    if (NULL == parent)
+        return -1;
+    if (node->prefix_length > DICT_INDEX_PREFIX)
+        path = (const unsigned char *) dict_index_minimum(node)->key + depth;
+    ((dict_index_node_t *) parent)->prefix_length = matched;
+    memcpy(((dict_index_node_t *) parent)->prefix, path,
+        matched < DICT_INDEX_PREFIX ? matched : DICT_INDEX_PREFIX);
+    byte = path[matched];
+    node->prefix_length -= matched + 1;
+    memmove(node->prefix, path + matched + 1,
+        node->prefix_length < DICT_INDEX_PREFIX ? node->prefix_length : \
+        DICT_INDEX_PREFIX);
+    dict_index_add_child(index, &parent, byte, node);
+    dict_index_attach(index, &parent, leaf, depth + matched);
+    *ref = parent;
+    return 0;
+}
+
+/**
+ * @brief Inserts a leaf into a subtree.
+ *
+ * @param index The index receiving the key.
+ * @param ref The address of the pointer to the root of the subtree.
+ * @param leaf The leaf of the new key.
+ * @param depth The number of bytes of the key consumed by the parents.
+ * @return 0 on success, 1 if the key is already present, -1 on error.
+ */
+static
+int dict_index_insert_at(dict_index_t *index, void **ref,
+    dict_index_leaf_t *leaf, uint64_t depth)
+{
+    dict_index_node_t *node = (dict_index_node_t *) *ref;
+    uint64_t matched = 0;
+    void **child = NULL;
+
+    if (NULL == node) {
+        *ref = DICT_INDEX_TAG(leaf);
+        return 0;
+    }
+    if (DICT_INDEX_IS_LEAF(node))
+        return dict_index_split_leaf(index, ref, leaf, depth);
+    matched = dict_index_prefix_mismatch(node, leaf->key, leaf->key_length,
+        depth);
+    if (matched < node->prefix_length)
+        return dict_index_split_prefix(index, ref, leaf, depth, matched);
+    depth += node->prefix_length;
+    if (depth == leaf->key_length) {
+        if (NULL != node->leaf)
+            return 1;
+        node->leaf = leaf;
+        return 0;
+    }
+    child = dict_index_find_child(node, (unsigned char) leaf->key[depth]);
+    if (NULL != child)
+        return dict_index_insert_at(index, child, leaf, depth + 1);
+    return dict_index_add_child(index, ref, (unsigned char) leaf->key[depth],
+        DICT_INDEX_TAG(leaf));
+}
+
+int dict_index_insert(dict_index_t *index, const char *key,
+    uint64_t key_length)
+{
+    dict_index_leaf_t *leaf = (dict_index_leaf_t *) dict_alloc(
+        &(index->allocator), 1, sizeof(dict_index_leaf_t));
+    int status = 0;
+
+    if (NULL == leaf)
+        return -1;
+    leaf->key = key;
+    leaf->key_length = key_length;
+    status = dict_index_insert_at(index, &(index->root), leaf, 0);
+    if (0 != status) {
+        dict_free(&(index->allocator), leaf);
+        return 1 == status ? 0 : -1;
+    }
+    index->bytes += sizeof(dict_index_leaf_t);
+    ++index->items;
+    return 0;
+}
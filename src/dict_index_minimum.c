@@ -0,0 +1,24 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_index_minimum.c
+** File description:
+** Exposes a function used to find the smallest key of an ordered index
+** subtree.
+*/
+
+#include "dict.h"
+
+const dict_index_leaf_t *dict_index_minimum(const void *node)
+{
+    const dict_index_node_t *inner = NULL;
+    unsigned int byte = 0;
+
+    while (!DICT_INDEX_IS_LEAF(node)) {
+        inner = (const dict_index_node_t *) node;
+        if (NULL != inner->leaf)
+            return inner->leaf;
+        byte = 0;
+        node = *dict_index_next_child(inner, &byte);
+    }
+    return DICT_INDEX_LEAF(node);
+}
@@ -0,0 +1,57 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_index_next_child.c
+** File description:
+** Exposes a function used to iterate the children of an ordered index node.
+*/
+
+#include "dict.h"
+
+/**
+ * @brief Looks for the next child of a node whose bytes are kept sorted.
+ *
+ * @param keys The bytes of the children.
+ * @param children The children.
+ * @param count The number of children.
+ * @param byte The lowest byte to look for, replaced by the one of the child.
+ * @return The address of the child, `NULL` pointer if there is none.
+ */
+static
+void **dict_index_next_sorted(const unsigned char *keys, void *const *children,
+    uint16_t count, unsigned int *byte)
+{
+    uint16_t position = 0;
+
+    for (; position < count; ++position)
+        if (keys[position] >= *byte) {
+            *byte = keys[position];
+            return (void **) &(children[position]);
+        }
+    return NULL;
+}
+
+void **dict_index_next_child(const dict_index_node_t *node,
+    unsigned int *byte)
+{
+    const dict_index_node48_t *node48 = (const dict_index_node48_t *) node;
+    const dict_index_node256_t *node256 = \
+        (const dict_index_node256_t *) node;
+
+    if (DICT_INDEX_NODE4 == node->type)
+        return dict_index_next_sorted(((const dict_index_node4_t *) node)->keys,
+            ((const dict_index_node4_t *) node)->children, node->children,
+            byte);
+    if (DICT_INDEX_NODE16 == node->type)
+        return dict_index_next_sorted(
+            ((const dict_index_node16_t *) node)->keys,
+            ((const dict_index_node16_t *) node)->children, node->children,
+            byte);
+    for (; *byte < 256; ++*byte) {
+        if (DICT_INDEX_NODE48 == node->type && 0 != node48->slots[*byte])
+            return (void **) &(node48->children[node48->slots[*byte] - 1]);
+        if (DICT_INDEX_NODE256 == node->type && \
+            NULL != node256->children[*byte])
+            return (void **) &(node256->children[*byte]);
+    }
+    return NULL;
+}
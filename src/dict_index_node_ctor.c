@@ -0,0 +1,20 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_index_node_ctor.c
+** File description:
+** Exposes the ordered index node constructor.
+*/
+
+#include "dict.h"
+
+dict_index_node_t *dict_index_node_ctor(dict_index_t *index, int type)
+{
+    dict_index_node_t *node = (dict_index_node_t *) dict_alloc(
+        &(index->allocator), 1, DICT_INDEX_NODE_SIZE(type));
+
+    if (NULL == node)
+        return NULL;
+    node->type = (uint8_t) type;
+    index->bytes += DICT_INDEX_NODE_SIZE(type);
+    return node;
+}
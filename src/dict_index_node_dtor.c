@@ -0,0 +1,14 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_index_node_dtor.c
+** File description:
+** Exposes the ordered index node destructor.
+*/
+
+#include "dict.h"
+
+void dict_index_node_dtor(dict_index_t *index, dict_index_node_t *node)
+{
+    index->bytes -= DICT_INDEX_NODE_SIZE(node->type);
+    dict_free(&(index->allocator), node);
+}
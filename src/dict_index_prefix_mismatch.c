@@ -0,0 +1,26 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_index_prefix_mismatch.c
+** File description:
+** Exposes a function used to compare a key to the compressed path of an
+** ordered index node.
+*/
+
+#include "dict.h"
+
+uint64_t dict_index_prefix_mismatch(const dict_index_node_t *node,
+    const char *key, uint64_t key_length, uint64_t depth)
+{
+    const unsigned char *path = node->prefix;
+    uint64_t length = node->prefix_length;
+    uint64_t matched = 0;
+
+    if (length > DICT_INDEX_PREFIX)
+        path = (const unsigned char *) dict_index_minimum(node)->key + depth;
+    if (length > key_length - depth)
+        length = key_length - depth;
+    while (matched < length && \
+        path[matched] == (unsigned char) key[depth + matched])
+        ++matched;
+    return matched;
+}
@@ -0,0 +1,29 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_index_release.c
+** File description:
+** Exposes a function used to release a subtree of an ordered index.
+*/
+
+#include "dict.h"
+
+void dict_index_release(dict_index_t *index, void *node)
+{
+    dict_index_node_t *inner = (dict_index_node_t *) node;
+    unsigned int byte = 0;
+    void **child = NULL;
+
+    if (NULL == node)
+        return;
+    if (DICT_INDEX_IS_LEAF(node)) {
+        index->bytes -= sizeof(dict_index_leaf_t);
+        --index->items;
+        dict_free(&(index->allocator), DICT_INDEX_LEAF(node));
+        return;
+    }
+    if (NULL != inner->leaf)
+        dict_index_release(index, DICT_INDEX_TAG(inner->leaf));
+    for (; NULL != (child = dict_index_next_child(inner, &byte)); ++byte)
+        dict_index_release(index, *child);
+    dict_index_node_dtor(index, inner);
+}
@@ -0,0 +1,93 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_index_remove_child.c
+** File description:
+** Exposes a function used to remove a child from an ordered index node.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Removes a child from an array of children whose bytes are kept
+ * sorted.
+ *
+ * @param keys The bytes of the children.
+ * @param children The children.
+ * @param count The number of children, decremented.
+ * @param byte The byte of the child to remove.
+ */
+static
+void dict_index_remove_sorted(unsigned char *keys, void **children,
+    uint16_t *count, unsigned char byte)
+{
+    uint16_t position = 0;
+
+    while (keys[position] != byte)
+        ++position;
+    --*count;
+    memmove(keys + position, keys + position + 1, *count - position);
+    memmove(children + position, children + position + 1,
+        (*count - position) * sizeof(void *));
+}
+
+/**
+ * @brief Replaces a sparse node by a node of the previous kind holding the
+ * same entries. If the allocation fails, the node is kept as is.
+ *
+ * @param index The index the node belongs to.
+ * @param ref The address of the pointer to the node.
+ */
+static
+void dict_index_shrink(dict_index_t *index, void **ref)
+{
+    dict_index_node_t *node = (dict_index_node_t *) *ref;
+    dict_index_node_t *shrunk = NULL;
+    static const uint16_t thresholds[] = { 0, 3, 12, 37 };
+    unsigned int byte = 0;
+    void **child = NULL;
+
+    if (DICT_INDEX_NODE4 == node->type || \
+        node->children > thresholds[node->type])
+        return;
+    shrunk = dict_index_node_ctor(index, node->type - 1);
+    if (NULL == shrunk)
+        return;
+    shrunk->leaf = node->leaf;
+    shrunk->prefix_length = node->prefix_length;
+    memcpy(shrunk->prefix, node->prefix, DICT_INDEX_PREFIX);
+    for (; NULL != (child = dict_index_next_child(node, &byte)); ++byte)
+        dict_index_add_child(index, (void **) &shrunk, (unsigned char) byte,
+            *child);
+    dict_index_node_dtor(index, node);
+    *ref = shrunk;
+}
+
+void dict_index_remove_child(dict_index_t *index, void **ref,
+    unsigned char byte)
+{
+    dict_index_node_t *node = (dict_index_node_t *) *ref;
+    dict_index_node48_t *node48 = (dict_index_node48_t *) node;
+
+    switch (node->type) {
+    case DICT_INDEX_NODE4:
+        dict_index_remove_sorted(((dict_index_node4_t *) node)->keys,
+            ((dict_index_node4_t *) node)->children, &(node->children), byte);
+        break;
+    case DICT_INDEX_NODE16:
+        dict_index_remove_sorted(((dict_index_node16_t *) node)->keys,
+            ((dict_index_node16_t *) node)->children, &(node->children),
+            byte);
+        break;
+    case DICT_INDEX_NODE48:
+        node48->children[node48->slots[byte] - 1] = NULL;
+        node48->slots[byte] = 0;
+        --node->children;
+        break;
+    default:
+        ((dict_index_node256_t *) node)->children[byte] = NULL;
+        --node->children;
+    }
+    dict_index_shrink(index, ref);
+    dict_index_collapse(index, ref);
+}
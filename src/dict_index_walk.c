@@ -0,0 +1,125 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_index_walk.c
+** File description:
+** Exposes the function visiting an ordered index in keys order.
+*/
+
+#include <string.h>
+#include "dict.h"
+#include "murmurhash1.h"
+
+/**
+ * @brief Compares two keys, bytes as unsigned, a key coming before its
+ * extensions.
+ *
+ * @return A negative value, 0 or a positive value, as `memcmp`.
+ */
+static
+int dict_index_compare(const char *key, uint64_t key_length,
+    const char *other, uint64_t other_length)
+{
+    int order = memcmp(key, other, key_length < other_length ? key_length : \
+        other_length);
+
+    if (0 != order)
+        return order;
+    return (key_length > other_length) - (key_length < other_length);
+}
+
+/**
+ * @brief Calls the scan function on the entry of a key, unless the key is
+ * lower than `from`. The entry is looked up in the buckets, the expired ones
+ * being skipped.
+ *
+ * @param scan The state of the scan.
+ * @param leaf The leaf of the key.
+ * @param bounded Whether the key may be lower than `from`.
+ * @return Non-zero if the scan stopped, 0 otherwise.
+ */
+static
+int dict_index_visit(dict_index_scan_t *scan, const dict_index_leaf_t *leaf,
+    int bounded)
+{
+    const dict_t *dict = scan->dict;
+    bucket_t **link = NULL;
+
+    if (bounded && 0 > dict_index_compare(leaf->key, leaf->key_length,
+        scan->from, scan->from_length))
+        return 0;
+    if (NULL != scan->to && (scan->prefix ? \
+        leaf->key_length < scan->to_length || \
+        0 != memcmp(leaf->key, scan->to, scan->to_length) : \
+        0 <= dict_index_compare(leaf->key, leaf->key_length, scan->to,
+        scan->to_length)))
+        return 1;
+    link = dict_bucket_find_link(&(dict->buckets[DICT_BUCKET_IDX(
+        murmurhash1(leaf->key, leaf->key_length, dict->seed), dict->size)]),
+        leaf->key, leaf->key_length);
+    if (NULL == link || (NULL != dict->expiry && \
+        DICT_BUCKET_EXPIRED(dict, *link, scan->now)))
+        return 0;
+    return scan->scan(leaf->key, leaf->key_length, (*link)->value,
+        scan->ctx);
+}
+
+/**
+ * @brief Compares the compressed path of a node to the bytes of `from`.
+ *
+ * @param scan The state of the scan.
+ * @param node The node whose path to compare.
+ * @param depth The number of bytes of the keys consumed by the parents.
+ * @return A negative value if every key of the node is lower than `from`, 0
+ * if the path equals the bytes of `from`, a positive value if every key of
+ * the node is greater or equal to `from`.
+ */
+static
+int dict_index_path_order(const dict_index_scan_t *scan,
+    const dict_index_node_t *node, uint64_t depth)
+{
+    const unsigned char *path = node->prefix;
+    uint64_t length = node->prefix_length;
+    uint64_t position = 0;
+
+    if (length > DICT_INDEX_PREFIX)
+        path = (const unsigned char *) dict_index_minimum(node)->key + depth;
+    if (length > scan->from_length - depth)
+        length = scan->from_length - depth;
+    for (; position < length; ++position)
+        if (path[position] != (unsigned char) scan->from[depth + position])
+            return path[position] < \
+                (unsigned char) scan->from[depth + position] ? -1 : 1;
+    return length < node->prefix_length ? 1 : 0;
+}
+
+int dict_index_walk(dict_index_scan_t *scan, const void *node,
+    uint64_t depth, int bounded)
+{
+    const dict_index_node_t *inner = (const dict_index_node_t *) node;
+    unsigned int byte = 0;
+    void **child = NULL;
+    int order = 0;
+
+    if (NULL == node)
+        return 0;
+    if (DICT_INDEX_IS_LEAF(node))
+        return dict_index_visit(scan, DICT_INDEX_LEAF(node), bounded);
+    if (bounded) {
+        order = dict_index_path_order(scan, inner, depth);
+        if (0 > order)
+            return 0;
+        bounded = 0 == order && \
+            depth + inner->prefix_length < scan->from_length;
+    }
+    depth += inner->prefix_length;
+    if (!bounded && NULL != inner->leaf && \
+        dict_index_visit(scan, inner->leaf, 0))
+        return 1;
+    if (bounded)
+        byte = (unsigned char) scan->from[depth];
+    for (; NULL != (child = dict_index_next_child(inner, &byte)); ++byte)
+        if (dict_index_walk(scan, *child, depth + 1, bounded && \
+            byte == (unsigned char) scan->from[depth]))
+            return 1;
+    return 0;
+}
@@ -0,0 +1,20 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_insert_hashed.c
+** File description:
+** Exposes a function to insert an entry into a dict, using the precomputed
+** hash of its key.
+*/
+
+#include "dict.h"
+
+int dict_insert_hashed(dict_t *dict, char *key, uint64_t key_length,
+    dict_hash_t key_hash, void *value)
+{
+    int inserted = 0;
+
+    if (key_hash.seed != dict->seed)
+        return -1;
+    dict_entry_node(dict, key, key_length, key_hash.value, value, &inserted);
+    return inserted ? 0 : -1;
+}
@@ -0,0 +1,19 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_insert_node.c
+** File description:
+** Exposes the common part of the functions inserting a new entry into a dict.
+*/
+
+#include "dict.h"
+#include "murmurhash1.h"
+
+bucket_t *dict_insert_node(dict_t *dict, char *key, uint64_t key_length,
+    void *value)
+{
+    int inserted = 0;
+    bucket_t *node = dict_entry_node(dict, key, key_length,
+        murmurhash1(key, key_length, dict->seed), value, &inserted);
+
+    return inserted ? node : NULL;
+}
@@ -0,0 +1,23 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_insert_ttl.c
+** File description:
+** Exposes a function to insert an expiring entry into a dict.
+*/
+
+#include "dict.h"
+
+int dict_insert_ttl(dict_t *dict, char *key, uint64_t key_length,
+    void *value, uint64_t ttl)
+{
+    bucket_t *node = NULL;
+
+    if (NULL == dict->expiry)
+        return -1;
+    node = dict_insert_node(dict, key, key_length, value);
+    if (NULL == node)
+        return -1;
+    if (0 != ttl)
+        DICT_BUCKET_EXPIRES_AT(dict, node) = dict->expiry->clock() + ttl;
+    return 0;
+}
@@ -0,0 +1,109 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_intern.c
+** File description:
+** Exposes the function interning a string.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Makes room for one more symbol.
+ *
+ * @param intern The interning table.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_intern_grow(dict_intern_t *intern)
+{
+    const dict_allocator_t *allocator = &(intern->dict->allocator);
+    uint64_t capacity = 0 == intern->capacity ? 64 : intern->capacity * 2;
+    dict_symbol_t *symbols = NULL;
+
+    if (intern->count < intern->capacity)
+        return 0;
+    symbols = (dict_symbol_t *) allocator->reallocate(allocator->ctx,
+        intern->symbols, intern->capacity * sizeof(dict_symbol_t),
+        capacity * sizeof(dict_symbol_t));
+    if (NULL == symbols)
+        return -1;
+    intern->symbols = symbols;
+    intern->capacity = capacity;
+    return 0;
+}
+
+/**
+ * @brief Interns the string, unless another thread did it in the meantime.
+ * Called with the lock held for writing. The entry is inserted with the
+ * caller's bytes as its key, which is only replaced by the arena copy once the
+ * insertion succeeded, as the arena does not release its copies one by one.
+ *
+ * @param intern The interning table.
+ * @param string The bytes of the string.
+ * @param length The length of the string.
+ * @param key_hash The hash of the string.
+ * @param id Where to store the symbol ID.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_intern_insert(dict_intern_t *intern, const char *string,
+    uint64_t length, dict_hash_t key_hash, uint32_t *id)
+{
+    void *value = NULL;
+    char *copy = NULL;
+    bucket_t *node = NULL;
+    int inserted = 0;
+    uint32_t symbol = (uint32_t) intern->count;
+
+    if (0 == dict_get_hashed(intern->dict, string, length, key_hash,
+        &value)) {
+        *id = *(const uint32_t *) value;
+        return 0;
+    }
+    if (UINT32_MAX <= intern->count || -1 == dict_intern_grow(intern))
+        return -1;
+    node = dict_entry_node(intern->dict, (char *) string, length,
+        key_hash.value, &symbol, &inserted);
+    if (NULL == node || !inserted)
+        return -1;
+    copy = (char *) dict_alloc(&(intern->strings), length + 1, 1);
+    if (NULL == copy) {
+        dict_delete_hashed(intern->dict, (char *) string, length, key_hash,
+            NULL);
+        return -1;
+    }
+    memcpy(copy, string, length);
+    node->key = copy;
+    intern->symbols[symbol].string = copy;
+    intern->symbols[symbol].length = length;
+    ++intern->count;
+    *id = symbol;
+    return 0;
+}
+
+int dict_intern(dict_intern_t *intern, const char *string, uint64_t length,
+    uint32_t *id)
+{
+    pthread_rwlock_t *lock = (pthread_rwlock_t *) intern->lock.bytes;
+    dict_hash_t key_hash = dict_hash_key(intern->dict, string, length);
+    void *value = NULL;
+    int status = 0;
+
+    if (0 != pthread_rwlock_rdlock(lock))
+        return -1;
+    status = dict_get_hashed(intern->dict, string, length, key_hash, &value);
+    if (0 == status)
+        *id = *(const uint32_t *) value;
+    pthread_rwlock_unlock(lock);
+    if (0 == status)
+        return 0;
+    if (0 != pthread_rwlock_wrlock(lock))
+        return -1;
+    status = dict_intern_insert(intern, string, length, key_hash, id);
+    pthread_rwlock_unlock(lock);
+    return status;
+}
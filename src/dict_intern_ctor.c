@@ -0,0 +1,40 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_intern_ctor.c
+** File description:
+** Exposes the string interning table constructor.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include "dict.h"
+
+/**
+ * @brief Fails to compile if the lock does not fit in the table.
+ */
+typedef char dict_intern_lock_fits[
+    sizeof(pthread_rwlock_t) <= DICT_INTERN_LOCK_SIZE ? 1 : -1];
+
+dict_intern_t *dict_intern_ctor(void)
+{
+    dict_intern_t *intern = (dict_intern_t *) dict_alloc(
+        dict_std_allocator(), 1, sizeof(dict_intern_t));
+
+    if (NULL == intern)
+        return NULL;
+    intern->dict = dict_ctor_with_value_size(sizeof(uint32_t));
+    intern->arena = dict_arena_ctor(0);
+    if (NULL == intern->dict || NULL == intern->arena || \
+        0 != pthread_rwlock_init((pthread_rwlock_t *) intern->lock.bytes,
+        NULL)) {
+        if (NULL != intern->dict)
+            dict_dtor(intern->dict, NULL);
+        if (NULL != intern->arena)
+            dict_arena_dtor(intern->arena);
+        dict_free(dict_std_allocator(), intern);
+        return NULL;
+    }
+    dict_arena_allocator(intern->arena, &(intern->strings));
+    return intern;
+}
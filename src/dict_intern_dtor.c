@@ -0,0 +1,20 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_intern_dtor.c
+** File description:
+** Exposes the string interning table destructor.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include "dict.h"
+
+void dict_intern_dtor(dict_intern_t *intern)
+{
+    pthread_rwlock_destroy((pthread_rwlock_t *) intern->lock.bytes);
+    dict_free(&(intern->dict->allocator), intern->symbols);
+    dict_dtor(intern->dict, NULL);
+    dict_arena_dtor(intern->arena);
+    dict_free(dict_std_allocator(), intern);
+}
@@ -0,0 +1,28 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_intern_find.c
+** File description:
+** Exposes the function looking up the symbol ID of a string.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include "dict.h"
+
+int dict_intern_find(dict_intern_t *intern, const char *string,
+    uint64_t length, uint32_t *id)
+{
+    pthread_rwlock_t *lock = (pthread_rwlock_t *) intern->lock.bytes;
+    dict_hash_t key_hash = dict_hash_key(intern->dict, string, length);
+    void *value = NULL;
+    int status = 0;
+
+    if (0 != pthread_rwlock_rdlock(lock))
+        return -1;
+    status = dict_get_hashed(intern->dict, string, length, key_hash, &value);
+    if (0 == status && NULL != id)
+        *id = *(const uint32_t *) value;
+    pthread_rwlock_unlock(lock);
+    return status;
+}
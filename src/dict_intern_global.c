@@ -0,0 +1,33 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_intern_global.c
+** File description:
+** Exposes the function returning the interning table of the process.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include "dict.h"
+
+/**
+ * @brief The interning table of the process.
+ */
+static dict_intern_t *dict_intern_process = NULL;
+
+/**
+ * @brief Builds the interning table of the process, once.
+ */
+static
+void dict_intern_global_ctor(void)
+{
+    dict_intern_process = dict_intern_ctor();
+}
+
+dict_intern_t *dict_intern_global(void)
+{
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+
+    pthread_once(&once, dict_intern_global_ctor);
+    return dict_intern_process;
+}
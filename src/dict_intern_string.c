@@ -0,0 +1,28 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_intern_string.c
+** File description:
+** Exposes the function returning the string of a symbol ID.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include "dict.h"
+
+const char *dict_intern_string(dict_intern_t *intern, uint32_t id,
+    uint64_t *length)
+{
+    pthread_rwlock_t *lock = (pthread_rwlock_t *) intern->lock.bytes;
+    const char *string = NULL;
+
+    if (0 != pthread_rwlock_rdlock(lock))
+        return NULL;
+    if (id < intern->count) {
+        string = intern->symbols[id].string;
+        if (NULL != length)
+            *length = intern->symbols[id].length;
+    }
+    pthread_rwlock_unlock(lock);
+    return string;
+}
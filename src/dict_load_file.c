@@ -0,0 +1,220 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_load_file.c
+** File description:
+** Exposes a function used to load the entries of a file into a dict, keys
+** being borrowed from the mapped file.
+*/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "dict.h"
+
+/**
+ * @brief The number of bytes the kernel is asked to read ahead of the parser.
+ */
+#define DICT_LOAD_CHUNK (16 << 20)
+
+/**
+ * @brief The state of a file being loaded.
+ */
+typedef struct s_dict_loader {
+    /** The dict receiving the entries. */
+    dict_t *dict;
+
+    /** The first byte of the mapping. */
+    const char *begin;
+
+    /** The byte following the last byte of the mapping. */
+    const char *end;
+
+    /** The offset from which the next chunk must be read ahead. */
+    uint64_t next_chunk;
+
+    /** The function making the values, may be `NULL`. */
+    load_value_t load_value;
+
+    /** The context given to `load_value`. */
+    void *ctx;
+} dict_loader_t;
+
+/**
+ * @brief Counts the lines of the mapped file, the last one not necessarily
+ * ending with a newline.
+ *
+ * @param loader The loader state.
+ * @return The number of lines.
+ */
+static
+uint64_t dict_load_count(const dict_loader_t *loader)
+{
+    uint64_t count = 0;
+    const char *line = loader->begin;
+    const char *newline = NULL;
+
+    while (line < loader->end) {
+        newline = memchr(line, '\n', loader->end - line);
+        ++count;
+        if (NULL == newline)
+            break;
+        line = newline + 1;
+    }
+    return count;
+}
+
+/**
+ * @brief Maps the file and attaches the mapping to the dict, so that it stays
+ * alive as long as the dict.
+ *
+ * @param loader The loader state, receiving the bounds of the mapping.
+ * @param fd The file descriptor of the file to map.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_load_map(dict_loader_t *loader, int fd)
+{
+    struct stat info;
+    void *address = NULL;
+    dict_mapping_t *mapping = NULL;
+
+    if (-1 == fstat(fd, &info))
+        return -1;
+    if (0 == info.st_size)
+        return 0;
+    address = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED == address)
+        return -1;
+    mapping = (dict_mapping_t *) dict_alloc(&(loader->dict->allocator), 1,
+        sizeof(dict_mapping_t));
+    if (NULL == mapping) {
+        munmap(address, info.st_size);
+        return -1;
+    }
+    mapping->refs = 1;
+    mapping->address = address;
+    mapping->length = info.st_size;
+    mapping->next = loader->dict->mappings;
+    loader->dict->mappings = mapping;
+    loader->begin = (const char *) address;
+    loader->end = loader->begin + info.st_size;
+    posix_madvise(address, info.st_size, POSIX_MADV_SEQUENTIAL);
+    return 0;
+}
+
+/**
+ * @brief Asks the kernel to read the next chunk ahead once the parser reaches
+ * the current one.
+ *
+ * @param loader The loader state.
+ * @param line The line about to be parsed.
+ */
+static
+void dict_load_read_ahead(dict_loader_t *loader, const char *line)
+{
+    uint64_t offset = line - loader->begin;
+    uint64_t length = loader->end - loader->begin;
+    uintptr_t page = (uintptr_t) sysconf(_SC_PAGESIZE) - 1;
+    uintptr_t chunk = 0;
+
+    if (offset < loader->next_chunk)
+        return;
+    loader->next_chunk = offset + DICT_LOAD_CHUNK;
+    if (loader->next_chunk >= length)
+        return;
+    chunk = ((uintptr_t) loader->begin + loader->next_chunk) & ~page;
+    posix_madvise((void *) chunk, length - loader->next_chunk < \
+        DICT_LOAD_CHUNK ? length - loader->next_chunk : DICT_LOAD_CHUNK,
+        POSIX_MADV_WILLNEED);
+}
+
+/**
+ * @brief Inserts the entry held by a line, its key being borrowed from the
+ * mapping. Its value belongs to the dict when it's made by `load_value`.
+ *
+ * @param loader The loader state.
+ * @param line The first byte of the line.
+ * @param end The byte following the last byte of the line.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_load_line(dict_loader_t *loader, const char *line, const char *end)
+{
+    const char *tab = NULL;
+    const char *value = NULL;
+    bucket_t *node = NULL;
+
+    if (line < end && '\r' == end[-1])
+        --end;
+    tab = memchr(line, '\t', end - line);
+    if (NULL == tab)
+        tab = end;
+    if (line == tab)
+        return 0;
+    value = tab < end ? tab + 1 : NULL;
+    node = dict_insert_node(loader->dict, (char *) line, tab - line, NULL);
+    if (NULL == node)
+        return dict_has_key(loader->dict, line, tab - line) ? 0 : -1;
+    node->flags |= DICT_BUCKET_BORROWED;
+    if (NULL != loader->load_value) {
+        node->flags |= DICT_BUCKET_OWNS_VALUE;
+        node->value = loader->load_value(tab < end ? tab + 1 : end,
+            tab < end ? end - tab - 1 : 0, loader->ctx);
+    } else
+        node->value = (void *) value;
+    if (NULL != loader->dict->cache)
+        loader->dict->cache->bytes += dict_cache_charge(loader->dict->cache,
+            node->key, node->key_length, node->value) - \
+            dict_cache_charge(loader->dict->cache, node->key,
+            node->key_length, NULL);
+    return 0;
+}
+
+/**
+ * @brief Parses the mapped file line per line.
+ *
+ * @param loader The loader state.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_load_lines(dict_loader_t *loader)
+{
+    const char *line = loader->begin;
+    const char *newline = NULL;
+
+    while (line < loader->end) {
+        dict_load_read_ahead(loader, line);
+        newline = memchr(line, '\n', loader->end - line);
+        if (NULL == newline)
+            newline = loader->end;
+        if (-1 == dict_load_line(loader, line, newline))
+            return -1;
+        line = newline + 1;
+    }
+    return 0;
+}
+
+int dict_load_file(dict_t *dict, const char *path, load_value_t load_value,
+    void *ctx)
+{
+    int fd = -1;
+    int status = 0;
+    dict_loader_t loader = { dict, NULL, NULL, 0, load_value, ctx };
+
+    if (0 != dict->value_size)
+        return -1;
+    fd = open(path, O_RDONLY);
+    if (-1 == fd)
+        return -1;
+    status = dict_load_map(&loader, fd);
+    close(fd);
+    if (-1 == status || NULL == loader.begin)
+        return status;
+    if (-1 == dict_reserve(dict, dict_load_count(&loader)))
+        return -1;
+    return dict_load_lines(&loader);
+}
@@ -0,0 +1,24 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_mapping_release.c
+** File description:
+** Exposes a function used to drop a reference to the files mapped by a dict.
+*/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <sys/mman.h>
+#include "dict.h"
+
+void dict_mapping_release(dict_mapping_t *mapping,
+    const dict_allocator_t *allocator)
+{
+    dict_mapping_t *next = NULL;
+
+    while (NULL != mapping && 0 == --mapping->refs) {
+        munmap(mapping->address, mapping->length);
+        next = mapping->next;
+        dict_free(allocator, mapping);
+        mapping = next;
+    }
+}
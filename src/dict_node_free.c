@@ -0,0 +1,14 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_node_free.c
+** File description:
+** Exposes the function releasing a node of a dict.
+*/
+
+#include "dict.h"
+
+void dict_node_free(const dict_allocator_t *allocator, bucket_t *node)
+{
+    if (0 == (node->flags & DICT_BUCKET_PACKED))
+        dict_free(allocator, node);
+}
@@ -0,0 +1,25 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_owned_buckets_dtor.c
+** File description:
+** Exposes a function used to deallocate the buckets a dict or a snapshot
+** owns.
+*/
+
+#include "dict.h"
+
+void dict_owned_buckets_dtor(bucket_t **buckets, uint64_t size,
+    const uint64_t *cow_bits, free_pair_t free_pair,
+    const dict_allocator_t *allocator)
+{
+    uint64_t index = 0;
+
+    if (NULL == cow_bits) {
+        dict_buckets_dtor(buckets, size, free_pair, allocator);
+        return;
+    }
+    for (; index < size; ++index)
+        if (!DICT_COW_SHARED(cow_bits, index))
+            dict_buckets_dtor(&(buckets[index]), 1, free_pair,
+                allocator);
+}
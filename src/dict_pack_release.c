@@ -0,0 +1,23 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_pack_release.c
+** File description:
+** Exposes the function dropping a reference to a list of packs.
+*/
+
+#include "dict.h"
+
+uint64_t dict_pack_release(dict_pack_t *pack,
+    const dict_allocator_t *allocator)
+{
+    dict_pack_t *next = NULL;
+    uint64_t bytes = 0;
+
+    while (NULL != pack && 0 == --pack->refs) {
+        bytes += pack->bytes;
+        next = pack->next;
+        dict_free(allocator, pack);
+        pack = next;
+    }
+    return bytes;
+}
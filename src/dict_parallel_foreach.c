@@ -0,0 +1,45 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_parallel_foreach.c
+** File description:
+** Exposes the function calling a function on every entry across threads.
+*/
+
+#include "dict.h"
+
+/**
+ * @brief The function called on each entry, and its context.
+ */
+typedef struct s_dict_foreach {
+    /** The function called on each entry. */
+    foreach_pair_t function;
+
+    /** The context given to the function. */
+    void *ctx;
+} dict_foreach_t;
+
+/**
+ * @brief Calls the function on the entries of a range of buckets.
+ */
+static
+void dict_foreach_task(const dict_t *dict, uint64_t first, uint64_t last,
+    __attribute__((unused)) uint64_t worker, void *ctx)
+{
+    const dict_foreach_t *foreach = (const dict_foreach_t *) ctx;
+    const bucket_t *bucket = NULL;
+
+    for (; first < last; ++first)
+        for (bucket = dict->buckets[first]; NULL != bucket->key;
+            bucket = bucket->next)
+            foreach->function(bucket->key, bucket->key_length,
+                bucket->value, foreach->ctx);
+}
+
+void dict_parallel_foreach(const dict_t *dict, foreach_pair_t function,
+    void *ctx, uint64_t threads)
+{
+    dict_foreach_t foreach = { function, ctx };
+
+    dict_parallel_run(dict, DICT_PARALLEL_WORKERS(dict, threads),
+        dict_foreach_task, &foreach);
+}
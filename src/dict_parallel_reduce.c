@@ -0,0 +1,75 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_parallel_reduce.c
+** File description:
+** Exposes the function folding every entry into an accumulator across
+** threads.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief The functions of the reduction, and the accumulators of the chunks.
+ */
+typedef struct s_dict_reduce {
+    /** The function folding an entry into an accumulator. */
+    reduce_pair_t reduce;
+
+    /** The context given to the functions. */
+    void *ctx;
+
+    /**
+     * The accumulators of the chunks of buckets, in chunk order, so that the
+     * caller's one is left untouched on error.
+     */
+    unsigned char *accs;
+
+    /** The size of an accumulator. */
+    uint64_t acc_size;
+} dict_reduce_t;
+
+/**
+ * @brief Folds the entries of a range of buckets into the accumulators of
+ * the chunks they belong to, whichever worker walks them.
+ */
+static
+void dict_reduce_task(const dict_t *dict, uint64_t first, uint64_t last,
+    __attribute__((unused)) uint64_t worker, void *ctx)
+{
+    const dict_reduce_t *reduce = (const dict_reduce_t *) ctx;
+    void *acc = NULL;
+    const bucket_t *bucket = NULL;
+
+    for (; first < last; ++first) {
+        acc = reduce->accs + first / DICT_PARALLEL_CHUNK * reduce->acc_size;
+        for (bucket = dict->buckets[first]; NULL != bucket->key;
+            bucket = bucket->next)
+            reduce->reduce(bucket->key, bucket->key_length, bucket->value,
+                acc, reduce->ctx);
+    }
+}
+
+int dict_parallel_reduce(const dict_t *dict, reduce_pair_t reduce,
+    merge_acc_t merge, void *acc, uint64_t acc_size, void *ctx,
+    uint64_t threads)
+{
+    uint64_t chunks = (dict->size + DICT_PARALLEL_CHUNK - 1) / \
+        DICT_PARALLEL_CHUNK;
+    dict_reduce_t state = { reduce, ctx, NULL, acc_size };
+    uint64_t index = 0;
+
+    state.accs = (unsigned char *) dict_alloc(&(dict->allocator), chunks,
+        acc_size);
+    if (NULL == state.accs)
+        return -1;
+    for (; index < chunks; ++index)
+        memcpy(state.accs + index * acc_size, acc, acc_size);
+    dict_parallel_run(dict, DICT_PARALLEL_WORKERS(dict, threads),
+        dict_reduce_task, &state);
+    memcpy(acc, state.accs, acc_size);
+    for (index = 1; index < chunks; ++index)
+        merge(acc, state.accs + index * acc_size, ctx);
+    dict_free(&(dict->allocator), state.accs);
+    return 0;
+}
@@ -0,0 +1,195 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_parallel_run.c
+** File description:
+** Walks the buckets of a dict across several threads, with chunks stealing.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include "dict.h"
+
+/**
+ * @brief The chunks of buckets left to a worker, stolen from the back by the
+ * idle workers.
+ */
+typedef struct s_dict_parallel_worker {
+    /** The lock of the range of chunks. */
+    pthread_mutex_t lock;
+
+    /** The next chunk of the worker. */
+    uint64_t next;
+
+    /** The end of the range of chunks, excluded. */
+    uint64_t end;
+
+    /** The index of the worker, given to the task. */
+    uint64_t index;
+
+    /** The state shared by the workers. */
+    struct s_dict_parallel_pool *pool;
+
+    /** The thread of the worker. */
+    pthread_t thread;
+
+    /** Whether the thread was started. */
+    int started;
+} dict_parallel_worker_t;
+
+/**
+ * @brief The state shared by the workers of a walk.
+ */
+typedef struct s_dict_parallel_pool {
+    /** The dict to walk. */
+    const dict_t *dict;
+
+    /** The function walking a range of buckets. */
+    dict_parallel_task_t task;
+
+    /** The context given to the task. */
+    void *ctx;
+
+    /** The workers. */
+    dict_parallel_worker_t *workers;
+
+    /** The number of workers. */
+    uint64_t count;
+} dict_parallel_pool_t;
+
+/**
+ * @brief Takes the next chunk of a worker.
+ *
+ * @param worker The worker.
+ * @param chunk Where to store the chunk.
+ * @return 1 if a chunk was taken, 0 if the worker has none left.
+ */
+static
+int dict_parallel_take(dict_parallel_worker_t *worker, uint64_t *chunk)
+{
+    int taken = 0;
+
+    pthread_mutex_lock(&(worker->lock));
+    if (worker->next < worker->end) {
+        *chunk = worker->next++;
+        taken = 1;
+    }
+    pthread_mutex_unlock(&(worker->lock));
+    return taken;
+}
+
+/**
+ * @brief Moves half of the chunks left to another worker to an idle one,
+ * trying the workers following it first.
+ *
+ * @param pool The state of the walk.
+ * @param thief The idle worker.
+ * @return 1 if chunks were stolen, 0 if no worker has any left.
+ */
+static
+int dict_parallel_steal(dict_parallel_pool_t *pool,
+    dict_parallel_worker_t *thief)
+{
+    dict_parallel_worker_t *victim = NULL;
+    uint64_t offset = 1;
+    uint64_t first = 0;
+    uint64_t end = 0;
+
+    for (; offset < pool->count; ++offset) {
+        victim = &(pool->workers[(thief->index + offset) % pool->count]);
+        pthread_mutex_lock(&(victim->lock));
+        end = victim->end;
+        if (victim->next < end)
+            victim->end -= (end - victim->next + 1) / 2;
+        first = victim->end;
+        pthread_mutex_unlock(&(victim->lock));
+        if (first == end)
+            continue;
+        pthread_mutex_lock(&(thief->lock));
+        thief->next = first;
+        thief->end = end;
+        pthread_mutex_unlock(&(thief->lock));
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Walks the chunks of a worker, then the chunks it steals.
+ *
+ * @param arg The worker.
+ * @return A `NULL` pointer.
+ */
+static
+void *dict_parallel_work(void *arg)
+{
+    dict_parallel_worker_t *worker = (dict_parallel_worker_t *) arg;
+    dict_parallel_pool_t *pool = worker->pool;
+    uint64_t chunk = 0;
+    uint64_t last = 0;
+
+    do {
+        while (dict_parallel_take(worker, &chunk)) {
+            last = (chunk + 1) * DICT_PARALLEL_CHUNK;
+            pool->task(pool->dict, chunk * DICT_PARALLEL_CHUNK,
+                last < pool->dict->size ? last : pool->dict->size,
+                worker->index, pool->ctx);
+        }
+    } while (dict_parallel_steal(pool, worker));
+    return NULL;
+}
+
+/**
+ * @brief Deals the chunks evenly to the workers.
+ *
+ * @param pool The state of the walk.
+ * @return 0 on success, -1 if a lock could not be initialized, in which case
+ * none is left initialized.
+ */
+static
+int dict_parallel_deal(dict_parallel_pool_t *pool)
+{
+    uint64_t chunks = (pool->dict->size + DICT_PARALLEL_CHUNK - 1) / \
+        DICT_PARALLEL_CHUNK;
+    uint64_t index = 0;
+
+    for (; index < pool->count; ++index) {
+        if (0 != pthread_mutex_init(&(pool->workers[index].lock), NULL)) {
+            while (0 < index)
+                pthread_mutex_destroy(&(pool->workers[--index].lock));
+            return -1;
+        }
+        pool->workers[index].next = chunks * index / pool->count;
+        pool->workers[index].end = chunks * (index + 1) / pool->count;
+        pool->workers[index].index = index;
+        pool->workers[index].pool = pool;
+    }
+    return 0;
+}
+
+void dict_parallel_run(const dict_t *dict, uint64_t workers,
+    dict_parallel_task_t task, void *ctx)
+{
+    dict_parallel_pool_t pool = { dict, task, ctx, NULL, workers };
+    uint64_t index = 1;
+
+    if (1 < workers)
+        pool.workers = (dict_parallel_worker_t *) dict_alloc(
+            &(dict->allocator), workers, sizeof(dict_parallel_worker_t));
+    if (NULL == pool.workers || -1 == dict_parallel_deal(&pool)) {
+        dict_free(&(dict->allocator), pool.workers);
+        task(dict, 0, dict->size, 0, ctx);
+        return;
+    }
+    for (; index < workers; ++index)
+        pool.workers[index].started = 0 == pthread_create(
+            &(pool.workers[index].thread), NULL, dict_parallel_work,
+            &(pool.workers[index]));
+    dict_parallel_work(&(pool.workers[0]));
+    for (index = 1; index < workers; ++index)
+        if (pool.workers[index].started)
+            pthread_join(pool.workers[index].thread, NULL);
+    for (index = 0; index < workers; ++index)
+        pthread_mutex_destroy(&(pool.workers[index].lock));
+    dict_free(&(dict->allocator), pool.workers);
+}
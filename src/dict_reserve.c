@@ -0,0 +1,17 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_reserve.c
+** File description:
+** Exposes a function used to make room for entries about to be inserted.
+*/
+
+#include "dict.h"
+
+int dict_reserve(dict_t *dict, uint64_t count)
+{
+    uint64_t new_size = (uint64_t) ((dict->items + count) / DICT_HIGH) + 1;
+
+    if (new_size <= dict->size)
+        return 0;
+    return dict_resize_to(dict, new_size);
+}
@@ -2,11 +2,9 @@
 ** XIMAZ PROJECTS, 2024
 ** dict_resize.c
 ** File description:
-** Exposes a function to resize a dict and recompute all the key hashes.
+** Exposes functions to resize a dict and recompute all the key hashes.
 */
 
-#include <stdlib.h>
-#include <string.h>
 #include "dict.h"
 #include "murmurhash1.h"
 
@@ -18,83 +16,201 @@
  * with the buckets array itself, and it returns a `NULL` pointer.
  *
  * @param new_size The number of buckets to allocate.
+ * @param allocator The allocator of the buckets array.
  * @return The allocated buckets array on success, `NULL` pointer on error.
  */
 static
-bucket_t **compute_new_buckets(uint64_t new_size)
+bucket_t **compute_new_buckets(uint64_t new_size,
+    const dict_allocator_t *allocator)
 {
-    bucket_t **new_buckets = calloc(new_size, sizeof(bucket_t *));
+    bucket_t **new_buckets = (bucket_t **) dict_alloc_large(allocator,
+        new_size, sizeof(bucket_t *));
 
     if (NULL == new_buckets)
         return NULL;
-    if (-1 == dict_buckets_ctor(new_buckets, new_size)) {
-        free(new_buckets);
+    if (-1 == dict_buckets_ctor(new_buckets, new_size, allocator)) {
+        dict_free_large(allocator, new_buckets, new_size,
+            sizeof(bucket_t *));
         return NULL;
     }
     return new_buckets;
 }
 
+/**
+ * @brief This structure holds the nodes being moved into the new buckets
+ * array, gathered across buckets so that their keys are hashed together by
+ * `murmurhash1_many`.
+ */
+typedef struct s_dict_rehash {
+    /** The gathered nodes. */
+    bucket_t *nodes[MURMURHASH1_MAX_LANES];
+
+    /** The keys of the gathered nodes. */
+    const void *keys[MURMURHASH1_MAX_LANES];
+
+    /** The length of the keys. */
+    uint64_t lengths[MURMURHASH1_MAX_LANES];
+
+    /** The hashes of the keys. */
+    uint32_t hashes[MURMURHASH1_MAX_LANES];
+
+    /** The number of gathered nodes. */
+    uint64_t count;
+
+    /** The linked list buckets array receiving the nodes. */
+    bucket_t **new_buckets;
+
+    /** The linked list buckets array size. */
+    uint64_t new_size;
+
+    /** The membership filter receiving the keys, may be `NULL`. */
+    dict_filter_t *new_filter;
+} dict_rehash_t;
+
+/**
+ * @brief Hashes the gathered keys, and moves each node to the front of its new
+ * bucket, in the order they were gathered.
+ *
+ * @param rehash The gathered nodes.
+ * @param seed The seed the keys are hashed with.
+ */
+static
+void dict_rehash_flush(dict_rehash_t *rehash, uint32_t seed)
+{
+    uint64_t index = 0;
+    bucket_t **new_bucket = NULL;
+
+    murmurhash1_many(rehash->keys, rehash->lengths, rehash->count, seed,
+        rehash->hashes);
+    for (; index < rehash->count; ++index) {
+        new_bucket = &(rehash->new_buckets[DICT_BUCKET_IDX(
+            rehash->hashes[index], rehash->new_size)]);
+        rehash->nodes[index]->next = *new_bucket;
+        *new_bucket = rehash->nodes[index];
+        if (NULL != rehash->new_filter)
+            dict_filter_add(rehash->new_filter, rehash->hashes[index]);
+    }
+    rehash->count = 0;
+}
+
 /**
  * @brief This function iterates over a non-empty bucket linked list.
- * It looks for all it's entries, re-hash the keys and tries to place the entry
- * to a new bucket.
+ * It gathers all it's entries, so that their keys are re-hashed and each node
+ * is moved to the front of its new bucket. The nodes are relinked rather than
+ * re-allocated, so that they keep their state (e.g. eviction bits) and the
+ * resize cannot fail half-way. Only the sentinel node is left, and released,
+ * behind.
  *
  * If the new bucket was not allocated, the function will crash. The buckets
  * array must have been allocated using the dict_buckets_ctor function, which
  * itself allocates all the subsequent linked list, so that the new_bucket is
  * never a `NULL` pointer.
  *
- * @param bucket The bucket from which to scan for entries.
- * @param new_buckets The linked list buckets array receiving the entries.
- * @param new_size The linked list buckets array size.
+ * @param bucket The bucket from which to move the entries.
+ * @param rehash The gathered nodes, flushed whenever full.
+ * @param dict The dict being resized, holding the seed and the allocator.
  */
 static
-void dict_rehash_bucket(const bucket_t *bucket, bucket_t **new_buckets,
-    uint64_t new_size)
+void dict_rehash_bucket(bucket_t *bucket, dict_rehash_t *rehash,
+    const dict_t *dict)
 {
-    uint32_t key_hash = 0;
-    bucket_t **new_bucket = NULL;
+    bucket_t *next = NULL;
 
-    while (NULL != bucket && NULL != bucket->key) {
-        key_hash = murmurhash1(bucket->key, strlen(bucket->key), HASH_SEED);
-        new_bucket = &(new_buckets[DICT_BUCKET_IDX(key_hash, new_size)]);
-        dict_bucket_insert(new_bucket, bucket->key, bucket->value);
-        bucket = bucket->next;
+    while (NULL != bucket->key) {
+        next = bucket->next;
+        rehash->nodes[rehash->count] = bucket;
+        rehash->keys[rehash->count] = bucket->key;
+        rehash->lengths[rehash->count] = bucket->key_length;
+        if (MURMURHASH1_MAX_LANES == ++rehash->count)
+            dict_rehash_flush(rehash, dict->seed);
+        bucket = next;
     }
+    dict_node_free(&(dict->allocator), bucket);
 }
 
 /**
- * @brief This function makes sure the new size is a power of 2.
+ * @brief This function allocates the membership filter matching the new size
+ * of the dict, if the dict has one. The lookup counters are carried over.
  *
- * @see https://github.com/python/cpython/blob/main/Python/hashtable.c#L108
+ * @param dict The dict being resized.
+ * @param new_size The number of buckets the dict is resized to.
+ * @param new_filter Where to store the new filter, left `NULL` if disabled.
+ * @return 0 on success, -1 on error.
+ */
+static
+int compute_new_filter(const dict_t *dict, uint64_t new_size,
+    dict_filter_t **new_filter)
+{
+    *new_filter = NULL;
+    if (NULL == dict->filter)
+        return 0;
+    *new_filter = dict_filter_ctor(new_size, &(dict->allocator));
+    if (NULL == *new_filter)
+        return -1;
+    (*new_filter)->lookups = dict->filter->lookups;
+    (*new_filter)->rejects = dict->filter->rejects;
+    (*new_filter)->false_positives = dict->filter->false_positives;
+    return 0;
+}
+
+/**
+ * @brief This function copies every bucket the dict still shares with a clone,
+ * as the nodes are about to be relinked into the new buckets array.
  *
- * @return The actual new size to use.
+ * @param dict The dict being resized.
+ * @return 0 on success, -1 on error.
  */
 static
-uint64_t round_size(uint64_t new_size)
+int dict_cow_all(dict_t *dict)
 {
-    uint64_t i = 1;
+    uint64_t index = 0;
 
-    if (new_size < DICT_MIN_SIZE)
-        return DICT_MIN_SIZE;
-    while (i < new_size)
-        i <<= 1;
-    return i;
+    if (NULL == dict->shared)
+        return 0;
+    for (; index < dict->size; ++index)
+        if (-1 == dict_cow_bucket(dict, index))
+            return -1;
+    return 0;
 }
 
 int dict_resize(dict_t *dict)
+{
+    return dict_resize_to(dict, DICT_MUST_SHRINK(dict) ?
+        dict->items * DICT_RESIZE_FACTOR : dict->size * DICT_RESIZE_FACTOR);
+}
+
+int dict_resize_to(dict_t *dict, uint64_t new_size)
 {
     uint64_t index = 0;
-    uint64_t new_size = round_size(dict->size * DICT_RESIZE_FACTOR);
-    bucket_t **new_buckets = compute_new_buckets(new_size);
+    bucket_t **new_buckets = NULL;
+    dict_filter_t *new_filter = NULL;
+    dict_rehash_t rehash;
 
+    new_size = dict_round_size(new_size);
+    new_buckets = compute_new_buckets(new_size, &(dict->allocator));
     if (NULL == new_buckets)
         return -1;
+    if (-1 == dict_cow_all(dict) || \
+        -1 == compute_new_filter(dict, new_size, &new_filter)) {
+        dict_buckets_dtor(new_buckets, new_size, NULL, &(dict->allocator));
+        dict_free_large(&(dict->allocator), new_buckets, new_size,
+            sizeof(bucket_t *));
+        return -1;
+    }
+    rehash.count = 0;
+    rehash.new_buckets = new_buckets;
+    rehash.new_size = new_size;
+    rehash.new_filter = new_filter;
     for (; index < dict->size; ++index)
-        dict_rehash_bucket(dict->buckets[index], new_buckets, new_size);
-    dict_buckets_dtor(dict->buckets, dict->size, NULL);
-    free(dict->buckets);
+        dict_rehash_bucket(dict->buckets[index], &rehash, dict);
+    dict_rehash_flush(&rehash, dict->seed);
+    dict_free_large(&(dict->allocator), dict->buckets, dict->size,
+        sizeof(bucket_t *));
+    dict_free(&(dict->allocator), dict->cow_bits);
+    dict_filter_dtor(dict->filter, &(dict->allocator));
     dict->buckets = new_buckets;
+    dict->filter = new_filter;
+    dict->cow_bits = NULL;
     dict->size = new_size;
     return 0;
 }
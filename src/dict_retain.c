@@ -0,0 +1,81 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_retain.c
+** File description:
+** Exposes a function used to remove the entries of a dict matching a
+** predicate in a single pass.
+*/
+
+#include "dict.h"
+
+/**
+ * @brief Returns the link to the node at the given position of a bucket.
+ *
+ * @param bucket The address of the bucket.
+ * @param position The position of the node, from the head of the bucket.
+ * @return The address of the pointer to the node.
+ */
+static
+bucket_t **dict_retain_link(bucket_t **bucket, uint64_t position)
+{
+    for (; 0 < position; --position)
+        bucket = &((*bucket)->next);
+    return bucket;
+}
+
+/**
+ * @brief Removes the entries of a bucket `retain` does not keep. A bucket
+ * shared with a clone is only copied once an entry has to be removed.
+ *
+ * @param dict The dict holding the bucket.
+ * @param index The index of the bucket to filter.
+ * @param retain The function telling which entries to keep.
+ * @param ctx The context given to `retain`.
+ * @param free_pair The function called on the removed pairs, may be `NULL`.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_retain_bucket(dict_t *dict, uint64_t index, retain_pair_t retain,
+    void *ctx, free_pair_t free_pair)
+{
+    bucket_t **link = &(dict->buckets[index]);
+    uint64_t position = 0;
+    int owned = NULL == dict->shared;
+
+    while (NULL != (*link)->key) {
+        if (retain((*link)->key, (*link)->key_length, (*link)->value, ctx)) {
+            link = &((*link)->next);
+            ++position;
+            continue;
+        }
+        if (!owned) {
+            if (-1 == dict_cow_bucket(dict, index))
+                return -1;
+            link = dict_retain_link(&(dict->buckets[index]), position);
+            owned = 1;
+        }
+        dict_bucket_release(dict, link, free_pair);
+    }
+    return 0;
+}
+
+int dict_retain(dict_t *dict, retain_pair_t retain, void *ctx,
+    free_pair_t free_pair)
+{
+    uint64_t index = 0;
+    uint64_t items = dict->items;
+    dict_filter_t *filter = dict->filter;
+    int status = 0;
+
+    dict->filter = NULL;
+    for (; index < dict->size && 0 == status; ++index)
+        status = dict_retain_bucket(dict, index, retain, ctx, free_pair);
+    dict->filter = filter;
+    if (NULL != filter)
+        filter->stale += items - dict->items;
+    if (DICT_MUST_SHRINK(dict) && 0 == dict_resize(dict))
+        return status;
+    if (NULL != filter && filter->stale > dict->items)
+        dict_filter_rebuild(dict);
+    return status;
+}
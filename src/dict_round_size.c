@@ -0,0 +1,19 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_round_size.c
+** File description:
+** Exposes a function used to round the number of buckets of a dict.
+*/
+
+#include "dict.h"
+
+uint64_t dict_round_size(uint64_t new_size)
+{
+    uint64_t i = 1;
+
+    if (new_size < DICT_MIN_SIZE)
+        return DICT_MIN_SIZE;
+    while (i < new_size)
+        i <<= 1;
+    return i;
+}
@@ -0,0 +1,29 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_scan_prefix.c
+** File description:
+** Exposes a function used to visit the entries of a dict whose keys share a
+** prefix, in keys order.
+*/
+
+#include "dict.h"
+
+int dict_scan_prefix(const dict_t *dict, const char *prefix,
+    uint64_t prefix_length, scan_pair_t scan, void *ctx)
+{
+    dict_index_scan_t state = { 0 };
+
+    if (NULL == dict->index)
+        return -1;
+    state.dict = dict;
+    state.from = prefix;
+    state.from_length = prefix_length;
+    state.to = prefix;
+    state.to_length = prefix_length;
+    state.prefix = 1;
+    state.now = NULL == dict->expiry ? 0 : dict->expiry->clock();
+    state.scan = scan;
+    state.ctx = ctx;
+    dict_index_walk(&state, dict->index->root, 0, 0 != prefix_length);
+    return 0;
+}
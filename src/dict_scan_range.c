@@ -0,0 +1,29 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_scan_range.c
+** File description:
+** Exposes a function used to visit the entries of a dict within a range of
+** keys, in keys order.
+*/
+
+#include "dict.h"
+
+int dict_scan_range(const dict_t *dict, const char *from,
+    uint64_t from_length, const char *to, uint64_t to_length,
+    scan_pair_t scan, void *ctx)
+{
+    dict_index_scan_t state = { 0 };
+
+    if (NULL == dict->index)
+        return -1;
+    state.dict = dict;
+    state.from = from;
+    state.from_length = from_length;
+    state.to = to;
+    state.to_length = to_length;
+    state.now = NULL == dict->expiry ? 0 : dict->expiry->clock();
+    state.scan = scan;
+    state.ctx = ctx;
+    dict_index_walk(&state, dict->index->root, 0, NULL != from);
+    return 0;
+}
@@ -0,0 +1,57 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_set_add.c
+** File description:
+** Exposes a function used to add a key to a set.
+*/
+
+#include "dict.h"
+#include "murmurhash1.h"
+
+/**
+ * @brief Takes an entry from the free list, or from the end of the pool,
+ * growing it if it's full.
+ *
+ * @param set The set receiving a new entry.
+ * @return The index of the entry, `DICT32_NIL` on error.
+ */
+static
+uint32_t dict_set_take_entry(dict_set_t *set)
+{
+    uint32_t index = set->free_list;
+
+    if (DICT32_NIL != index) {
+        set->free_list = set->entries[index].next;
+        return index;
+    }
+    if (set->used == set->capacity && \
+        -1 == dict_set_pool_reserve(set, (uint64_t) set->used + 1))
+        return DICT32_NIL;
+    return set->used++;
+}
+
+int dict_set_add(dict_set_t *set, char *key, uint64_t key_length)
+{
+    uint32_t key_hash = 0;
+    uint32_t *head = NULL;
+    uint32_t index = 0;
+
+    if (NULL == key || key_length >= UINT32_MAX)
+        return -1;
+    if (DICT32_NIL != dict_set_find(set, key, key_length))
+        return 1;
+    if (DICT_MUST_GROW(set) && \
+        -1 == dict_set_resize_to(set, set->size * DICT_RESIZE_FACTOR))
+        return -1;
+    index = dict_set_take_entry(set);
+    if (DICT32_NIL == index)
+        return -1;
+    key_hash = murmurhash1(key, key_length, HASH_SEED);
+    head = &(set->heads[DICT_BUCKET_IDX(key_hash, set->size)]);
+    set->entries[index].key = key;
+    set->entries[index].key_length = (uint32_t) key_length;
+    set->entries[index].next = *head;
+    *head = index;
+    ++set->items;
+    return 0;
+}
@@ -0,0 +1,14 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_set_contains.c
+** File description:
+** Exposes a function used to know whether a key belongs to a set.
+*/
+
+#include "dict.h"
+
+int dict_set_contains(const dict_set_t *set, const char *key,
+    uint64_t key_length)
+{
+    return DICT32_NIL != dict_set_find(set, key, key_length);
+}
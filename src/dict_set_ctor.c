@@ -0,0 +1,31 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_set_ctor.c
+** File description:
+** Exposes the set object constructor.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+dict_set_t *dict_set_ctor(const dict_allocator_t *allocator)
+{
+    dict_set_t *set = NULL;
+
+    if (NULL == allocator)
+        allocator = dict_std_allocator();
+    set = (dict_set_t *) dict_alloc(allocator, 1, sizeof(dict_set_t));
+    if (NULL == set)
+        return NULL;
+    set->allocator = *allocator;
+    set->heads = (uint32_t *) dict_alloc_large(allocator, DICT_MIN_SIZE,
+        sizeof(uint32_t));
+    if (NULL == set->heads) {
+        dict_free(allocator, set);
+        return NULL;
+    }
+    memset(set->heads, 0xff, DICT_MIN_SIZE * sizeof(uint32_t));
+    set->size = DICT_MIN_SIZE;
+    set->free_list = DICT32_NIL;
+    return set;
+}
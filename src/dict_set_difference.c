@@ -0,0 +1,26 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_set_difference.c
+** File description:
+** Exposes a function used to remove the keys of a set from another one.
+*/
+
+#include "dict.h"
+
+uint64_t dict_set_difference(dict_set_t *set, const dict_set_t *other,
+    free_key_t free_key)
+{
+    uint64_t removed = 0;
+    uint32_t index = 0;
+    dict_set_entry_t *entry = NULL;
+
+    for (; index < set->used; ++index) {
+        entry = &(set->entries[index]);
+        if (NULL != entry->key && \
+            dict_set_contains(other, entry->key, entry->key_length) && \
+            0 == dict_set_remove(set, entry->key, entry->key_length,
+            free_key))
+            ++removed;
+    }
+    return removed;
+}
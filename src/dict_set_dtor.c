@@ -0,0 +1,23 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_set_dtor.c
+** File description:
+** Exposes the set object destructor.
+*/
+
+#include "dict.h"
+
+void dict_set_dtor(dict_set_t *set, free_key_t free_key)
+{
+    dict_allocator_t allocator = set->allocator;
+    uint32_t index = 0;
+
+    if (NULL != free_key)
+        for (; index < set->used; ++index)
+            if (NULL != set->entries[index].key)
+                free_key(set->entries[index].key);
+    dict_free_large(&allocator, set->entries, set->capacity,
+        sizeof(dict_set_entry_t));
+    dict_free_large(&allocator, set->heads, set->size, sizeof(uint32_t));
+    dict_free(&allocator, set);
+}
@@ -0,0 +1,26 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_set_find.c
+** File description:
+** Exposes a function used to find the entry of a key in a set.
+*/
+
+#include "dict.h"
+#include "murmurhash1.h"
+
+uint32_t dict_set_find(const dict_set_t *set, const char *key,
+    uint64_t key_length)
+{
+    uint32_t key_hash = murmurhash1(key, key_length, HASH_SEED);
+    uint32_t index = set->heads[DICT_BUCKET_IDX(key_hash, set->size)];
+    const dict_set_entry_t *entry = NULL;
+
+    while (DICT32_NIL != index) {
+        entry = &(set->entries[index]);
+        if (key_length == entry->key_length && \
+            0 == memcmp(entry->key, key, key_length))
+            return index;
+        index = entry->next;
+    }
+    return DICT32_NIL;
+}
@@ -0,0 +1,54 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_set_get_keys.c
+** File description:
+** Exposes a function to get the list of keys of a set.
+*/
+
+#include <assert.h>
+#include "dict.h"
+
+/**
+ * @brief Copies the reference and the length of each key of the pool into the
+ * `keys` and `lengths` members of the keys object.
+ *
+ * @param set The set to get the keys from.
+ * @param keys The keys object in which to set the keys.
+ */
+static
+void populate_set_keys(const dict_set_t *set, dict_keys_t *keys)
+{
+    uint32_t index = 0;
+    const dict_set_entry_t *entry = NULL;
+
+    for (; index < set->used; ++index) {
+        entry = &(set->entries[index]);
+        if (NULL == entry->key)
+            continue;
+        keys->keys[keys->size] = entry->key;
+        keys->lengths[keys->size++] = entry->key_length;
+    }
+    assert(keys->size == set->items);
+}
+
+dict_keys_t *dict_set_get_keys(const dict_set_t *set)
+{
+    dict_keys_t *keys = (dict_keys_t *) dict_alloc(&(set->allocator), 1,
+        sizeof(dict_keys_t));
+
+    if (NULL == keys)
+        return NULL;
+    keys->keys = (const char **) dict_alloc(&(set->allocator), set->items,
+        sizeof(char *));
+    keys->lengths = (uint64_t *) dict_alloc(&(set->allocator), set->items,
+        sizeof(uint64_t));
+    if (NULL == keys->keys || NULL == keys->lengths) {
+        dict_free(&(set->allocator), keys->keys);
+        dict_free(&(set->allocator), keys->lengths);
+        dict_free(&(set->allocator), keys);
+        return NULL;
+    }
+    keys->allocator = set->allocator;
+    populate_set_keys(set, keys);
+    return keys;
+}
@@ -0,0 +1,60 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_set_pool_reserve.c
+** File description:
+** Exposes a function used to grow the pool of entries of a set.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Allocates a new pool and moves the entries into it. Used when the
+ * pool does not exist yet, or when the allocator has a large array path, which
+ * cannot resize allocations.
+ *
+ * @param set The set whose pool to grow.
+ * @param new_capacity The number of entries of the new pool.
+ * @return The new pool on success, `NULL` pointer on error.
+ */
+static
+dict_set_entry_t *dict_set_pool_move(dict_set_t *set, uint64_t new_capacity)
+{
+    dict_set_entry_t *entries = (dict_set_entry_t *) dict_alloc_large(
+        &(set->allocator), new_capacity, sizeof(dict_set_entry_t));
+
+    if (NULL == entries || NULL == set->entries)
+        return entries;
+    memcpy(entries, set->entries, set->used * sizeof(dict_set_entry_t));
+    dict_free_large(&(set->allocator), set->entries, set->capacity,
+        sizeof(dict_set_entry_t));
+    return entries;
+}
+
+int dict_set_pool_reserve(dict_set_t *set, uint64_t capacity)
+{
+    uint64_t new_capacity = 0 != set->capacity ? set->capacity : \
+        DICT32_MIN_POOL;
+    dict_set_entry_t *entries = NULL;
+
+    if (capacity <= set->capacity)
+        return 0;
+    if (capacity >= DICT32_NIL)
+        return -1;
+    while (new_capacity < capacity)
+        new_capacity <<= 1;
+    if (new_capacity >= DICT32_NIL)
+        new_capacity = DICT32_NIL - 1;
+    if (NULL == set->entries || NULL != set->allocator.allocate_large)
+        entries = dict_set_pool_move(set, new_capacity);
+    else
+        entries = (dict_set_entry_t *) set->allocator.reallocate(
+            set->allocator.ctx, set->entries,
+            set->capacity * sizeof(dict_set_entry_t),
+            new_capacity * sizeof(dict_set_entry_t));
+    if (NULL == entries)
+        return -1;
+    set->entries = entries;
+    set->capacity = new_capacity;
+    return 0;
+}
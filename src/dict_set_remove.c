@@ -0,0 +1,41 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_set_remove.c
+** File description:
+** Exposes a function used to remove a key from a set.
+*/
+
+#include "dict.h"
+#include "murmurhash1.h"
+
+int dict_set_remove(dict_set_t *set, const char *key, uint64_t key_length,
+    free_key_t free_key)
+{
+    uint32_t key_hash = 0;
+    uint32_t *link = NULL;
+    uint32_t index = 0;
+    dict_set_entry_t *entry = NULL;
+
+    if (DICT_MUST_SHRINK(set))
+        dict_set_resize_to(set, set->items * DICT_RESIZE_FACTOR);
+    key_hash = murmurhash1(key, key_length, HASH_SEED);
+    link = &(set->heads[DICT_BUCKET_IDX(key_hash, set->size)]);
+    while (DICT32_NIL != *link) {
+        entry = &(set->entries[*link]);
+        if (key_length == entry->key_length && \
+            0 == memcmp(entry->key, key, key_length))
+            break;
+        link = &(entry->next);
+    }
+    if (DICT32_NIL == *link)
+        return -1;
+    if (NULL != free_key)
+        free_key(entry->key);
+    index = *link;
+    *link = entry->next;
+    entry->key = NULL;
+    entry->next = set->free_list;
+    set->free_list = index;
+    --set->items;
+    return 0;
+}
@@ -0,0 +1,19 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_set_reserve.c
+** File description:
+** Exposes a function used to pre-size a set.
+*/
+
+#include "dict.h"
+
+int dict_set_reserve(dict_set_t *set, uint64_t count)
+{
+    uint64_t new_size = (uint64_t) ((set->items + count) / DICT_HIGH) + 1;
+
+    if (-1 == dict_set_pool_reserve(set, set->items + count))
+        return -1;
+    if (new_size <= set->size)
+        return 0;
+    return dict_set_resize_to(set, new_size);
+}
@@ -0,0 +1,38 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_set_resize_to.c
+** File description:
+** Exposes a function used to resize the buckets array of a set.
+*/
+
+#include <string.h>
+#include "dict.h"
+#include "murmurhash1.h"
+
+int dict_set_resize_to(dict_set_t *set, uint64_t new_size)
+{
+    uint32_t index = 0;
+    uint32_t key_hash = 0;
+    uint32_t *heads = NULL;
+    dict_set_entry_t *entry = NULL;
+
+    new_size = dict_round_size(new_size);
+    heads = (uint32_t *) dict_alloc_large(&(set->allocator), new_size,
+        sizeof(uint32_t));
+    if (NULL == heads)
+        return -1;
+    memset(heads, 0xff, new_size * sizeof(uint32_t));
+    for (; index < set->used; ++index) {
+        entry = &(set->entries[index]);
+        if (NULL == entry->key)
+            continue;
+        key_hash = murmurhash1(entry->key, entry->key_length, HASH_SEED);
+        entry->next = heads[DICT_BUCKET_IDX(key_hash, new_size)];
+        heads[DICT_BUCKET_IDX(key_hash, new_size)] = index;
+    }
+    dict_free_large(&(set->allocator), set->heads, set->size,
+        sizeof(uint32_t));
+    set->heads = heads;
+    set->size = new_size;
+    return 0;
+}
@@ -0,0 +1,18 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_set_seed.c
+** File description:
+** Exposes a function to change the seed the keys of a dict are hashed with.
+*/
+
+#include "dict.h"
+
+int dict_set_seed(dict_t *dict, uint32_t seed)
+{
+    if (0 != dict->items)
+        return -1;
+    dict->seed = seed;
+    if (NULL != dict->filter)
+        return dict_filter_rebuild(dict);
+    return 0;
+}
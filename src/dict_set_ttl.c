@@ -0,0 +1,33 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_set_ttl.c
+** File description:
+** Exposes a function to set the time to live of an entry of a dict.
+*/
+
+#include "dict.h"
+#include "murmurhash1.h"
+
+int dict_set_ttl(dict_t *dict, const char *key, uint64_t key_length,
+    uint64_t ttl)
+{
+    uint32_t key_hash = 0;
+    uint64_t index = 0;
+    bucket_t *node = NULL;
+    uint64_t now = 0;
+
+    if (NULL == dict->expiry)
+        return -1;
+    key_hash = murmurhash1(key, key_length, dict->seed);
+    index = DICT_BUCKET_IDX(key_hash, dict->size);
+    if (-1 == dict_cow_bucket(dict, index))
+        return -1;
+    node = dict_bucket_find(dict->buckets[index], key, key_length);
+    if (NULL == node)
+        return -1;
+    now = dict->expiry->clock();
+    if (DICT_BUCKET_EXPIRED(dict, node, now))
+        return -1;
+    DICT_BUCKET_EXPIRES_AT(dict, node) = 0 == ttl ? 0 : now + ttl;
+    return 0;
+}
@@ -0,0 +1,32 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_set_union.c
+** File description:
+** Exposes a function used to add the keys of a set to another one.
+*/
+
+#include "dict.h"
+
+int dict_set_union(dict_set_t *set, const dict_set_t *other)
+{
+    uint64_t missing = 0;
+    uint32_t index = 0;
+    const dict_set_entry_t *entry = NULL;
+
+    for (; index < other->used; ++index) {
+        entry = &(other->entries[index]);
+        if (NULL != entry->key && \
+            !dict_set_contains(set, entry->key, entry->key_length))
+            ++missing;
+    }
+    if (0 == missing)
+        return 0;
+    if (-1 == dict_set_reserve(set, missing))
+        return -1;
+    for (index = 0; index < other->used; ++index) {
+        entry = &(other->entries[index]);
+        if (NULL != entry->key)
+            dict_set_add(set, entry->key, entry->key_length);
+    }
+    return 0;
+}
@@ -0,0 +1,26 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_shared_release.c
+** File description:
+** Exposes a function used to drop a reference to a dict snapshot.
+*/
+
+#include "dict.h"
+
+void dict_shared_release(dict_shared_t *shared, free_pair_t free_pair,
+    const dict_allocator_t *allocator)
+{
+    dict_shared_t *parent = NULL;
+
+    while (NULL != shared && 0 == --shared->refs) {
+        dict_owned_buckets_dtor(shared->buckets, shared->size,
+            shared->cow_bits, free_pair, allocator);
+        dict_free_large(allocator, shared->buckets, shared->size,
+            sizeof(bucket_t *));
+        dict_free(allocator, shared->cow_bits);
+        dict_pack_release(shared->packs, allocator);
+        parent = shared->parent;
+        dict_free(allocator, shared);
+        shared = parent;
+    }
+}
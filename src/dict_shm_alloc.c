@@ -0,0 +1,52 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_shm_alloc.c
+** File description:
+** Exposes the allocator of the shared dict regions.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Returns the size class of a block, each block starting with its
+ * class so that it can be released without knowing its size.
+ *
+ * @param size The number of bytes requested by the caller.
+ * @return The size class, `DICT_SHM_CLASSES` if the block is too large.
+ */
+static
+uint64_t dict_shm_class(uint64_t size)
+{
+    uint64_t class = 0;
+
+    size += sizeof(uint64_t);
+    while (class < DICT_SHM_CLASSES && ((uint64_t) 32 << class) < size)
+        ++class;
+    return class;
+}
+
+uint64_t dict_shm_alloc(dict_shm_t *shm, uint64_t size)
+{
+    uint64_t class = dict_shm_class(size);
+    uint64_t block = 0;
+    uint64_t block_size = 0;
+
+    if (DICT_SHM_CLASSES == class)
+        return 0;
+    block_size = (uint64_t) 32 << class;
+    block = shm->free_lists[class];
+    if (0 != block)
+        memcpy(&(shm->free_lists[class]), DICT_SHM_AT(shm, block),
+            sizeof(uint64_t));
+    else {
+        if (shm->region_size - shm->top < block_size)
+            return 0;
+        block = shm->top + sizeof(uint64_t);
+        shm->top += block_size;
+        memcpy(DICT_SHM_AT(shm, block - sizeof(uint64_t)), &class,
+            sizeof(uint64_t));
+    }
+    memset(DICT_SHM_AT(shm, block), 0, block_size - sizeof(uint64_t));
+    return block;
+}
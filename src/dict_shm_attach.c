@@ -0,0 +1,17 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_shm_attach.c
+** File description:
+** Exposes the function opening a dict built in a shared memory region.
+*/
+
+#include "dict.h"
+
+dict_shm_t *dict_shm_attach(void *region)
+{
+    dict_shm_t *shm = (dict_shm_t *) region;
+
+    if (NULL == region || DICT_SHM_MAGIC != shm->magic)
+        return NULL;
+    return shm;
+}
@@ -0,0 +1,59 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_shm_create.c
+** File description:
+** Exposes the function building a dict in a shared memory region.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Fails to compile if the lock does not fit in the dict header.
+ */
+typedef char dict_shm_lock_fits[
+    sizeof(pthread_rwlock_t) <= DICT_SHM_LOCK_SIZE ? 1 : -1];
+
+/**
+ * @brief Creates the process-shared lock of the dict.
+ *
+ * @param shm The shared dict holding the lock.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_shm_lock_ctor(dict_shm_t *shm)
+{
+    pthread_rwlockattr_t attributes;
+    int status = 0;
+
+    if (0 != pthread_rwlockattr_init(&attributes))
+        return -1;
+    status = pthread_rwlockattr_setpshared(&attributes,
+        PTHREAD_PROCESS_SHARED);
+    if (0 == status)
+        status = pthread_rwlock_init((pthread_rwlock_t *) shm->lock.bytes,
+            &attributes);
+    pthread_rwlockattr_destroy(&attributes);
+    return 0 == status ? 0 : -1;
+}
+
+dict_shm_t *dict_shm_create(void *region, uint64_t region_size)
+{
+    dict_shm_t *shm = (dict_shm_t *) region;
+
+    if (NULL == region || region_size < sizeof(dict_shm_t))
+        return NULL;
+    memset(shm, 0, sizeof(dict_shm_t));
+    shm->region_size = region_size;
+    shm->top = (sizeof(dict_shm_t) + 15) & ~(uint64_t) 15;
+    shm->seed = HASH_SEED;
+    shm->size = DICT_MIN_SIZE;
+    shm->buckets = dict_shm_alloc(shm, DICT_MIN_SIZE * sizeof(uint64_t));
+    if (0 == shm->buckets || -1 == dict_shm_lock_ctor(shm))
+        return NULL;
+    shm->magic = DICT_SHM_MAGIC;
+    return shm;
+}
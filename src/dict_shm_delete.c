@@ -0,0 +1,32 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_shm_delete.c
+** File description:
+** Exposes the function deleting an entry from a shared dict.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include "dict.h"
+#include "murmurhash1.h"
+
+int dict_shm_delete(dict_shm_t *shm, const char *key, uint64_t key_length)
+{
+    pthread_rwlock_t *lock = (pthread_rwlock_t *) shm->lock.bytes;
+    uint32_t key_hash = murmurhash1(key, key_length, shm->seed);
+    uint64_t *link = NULL;
+    uint64_t offset = 0;
+
+    if (0 != pthread_rwlock_wrlock(lock))
+        return -1;
+    link = dict_shm_find(shm, key, key_length, key_hash);
+    if (NULL != link) {
+        offset = *link;
+        *link = ((dict_shm_entry_t *) DICT_SHM_AT(shm, offset))->next;
+        dict_shm_free(shm, offset);
+        --shm->items;
+    }
+    pthread_rwlock_unlock(lock);
+    return NULL == link ? -1 : 0;
+}
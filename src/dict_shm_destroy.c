@@ -0,0 +1,17 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_shm_destroy.c
+** File description:
+** Exposes the function releasing the lock of a shared dict.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include "dict.h"
+
+void dict_shm_destroy(dict_shm_t *shm)
+{
+    shm->magic = 0;
+    pthread_rwlock_destroy((pthread_rwlock_t *) shm->lock.bytes);
+}
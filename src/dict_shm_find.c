@@ -0,0 +1,25 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_shm_find.c
+** File description:
+** Exposes the function looking a key up in a shared dict.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+uint64_t *dict_shm_find(dict_shm_t *shm, const char *key,
+    uint64_t key_length, uint32_t key_hash)
+{
+    uint64_t *link = (uint64_t *) DICT_SHM_AT(shm, shm->buckets) + \
+        DICT_BUCKET_IDX(key_hash, shm->size);
+    dict_shm_entry_t *entry = NULL;
+
+    for (; 0 != *link; link = &(entry->next)) {
+        entry = (dict_shm_entry_t *) DICT_SHM_AT(shm, *link);
+        if (key_hash == entry->hash && key_length == entry->key_length && \
+            0 == memcmp(entry->data, key, key_length))
+            return link;
+    }
+    return NULL;
+}
@@ -0,0 +1,22 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_shm_free.c
+** File description:
+** Exposes the function releasing the blocks of a shared dict region.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+void dict_shm_free(dict_shm_t *shm, uint64_t offset)
+{
+    uint64_t class = 0;
+
+    if (0 == offset)
+        return;
+    memcpy(&class, DICT_SHM_AT(shm, offset - sizeof(uint64_t)),
+        sizeof(uint64_t));
+    memcpy(DICT_SHM_AT(shm, offset), &(shm->free_lists[class]),
+        sizeof(uint64_t));
+    shm->free_lists[class] = offset;
+}
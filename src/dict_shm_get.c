@@ -0,0 +1,37 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_shm_get.c
+** File description:
+** Exposes the function copying a value out of a shared dict.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <string.h>
+#include "dict.h"
+#include "murmurhash1.h"
+
+int64_t dict_shm_get(dict_shm_t *shm, const char *key, uint64_t key_length,
+    void *value, uint64_t capacity)
+{
+    pthread_rwlock_t *lock = (pthread_rwlock_t *) shm->lock.bytes;
+    uint32_t key_hash = murmurhash1(key, key_length, shm->seed);
+    uint64_t *link = NULL;
+    dict_shm_entry_t *entry = NULL;
+    int64_t length = -1;
+
+    if (0 != pthread_rwlock_rdlock(lock))
+        return -1;
+    link = dict_shm_find(shm, key, key_length, key_hash);
+    if (NULL != link) {
+        entry = (dict_shm_entry_t *) DICT_SHM_AT(shm, *link);
+        length = (int64_t) entry->value_length;
+        if (0 != capacity)
+            memcpy(value, entry->data + key_length,
+                capacity < entry->value_length ? capacity :
+                entry->value_length);
+    }
+    pthread_rwlock_unlock(lock);
+    return length;
+}
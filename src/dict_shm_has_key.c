@@ -0,0 +1,13 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_shm_has_key.c
+** File description:
+** Exposes the function checking if a key exists in a shared dict.
+*/
+
+#include "dict.h"
+
+int dict_shm_has_key(dict_shm_t *shm, const char *key, uint64_t key_length)
+{
+    return -1 != dict_shm_get(shm, key, key_length, NULL, 0);
+}
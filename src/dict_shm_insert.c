@@ -0,0 +1,72 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_shm_insert.c
+** File description:
+** Exposes the function inserting an entry into a shared dict.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <string.h>
+#include "dict.h"
+#include "murmurhash1.h"
+
+/**
+ * @brief Links a new entry, holding copies of the key and the value, at the
+ * front of its bucket. The caller holds the write lock.
+ *
+ * @param shm The shared dict in which to insert the entry.
+ * @param key The key of the entry.
+ * @param key_length The length of the key.
+ * @param key_hash The hash of the key.
+ * @param value The value bytes.
+ * @param value_length The length of the value.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_shm_link(dict_shm_t *shm, const char *key, uint64_t key_length,
+    uint32_t key_hash, const void *value, uint64_t value_length)
+{
+    uint64_t *bucket = NULL;
+    uint64_t offset = 0;
+    dict_shm_entry_t *entry = NULL;
+
+    if (UINT64_MAX - sizeof(dict_shm_entry_t) - key_length < value_length)
+        return -1;
+    offset = dict_shm_alloc(shm, sizeof(dict_shm_entry_t) + key_length + \
+        value_length);
+    if (0 == offset)
+        return -1;
+    entry = (dict_shm_entry_t *) DICT_SHM_AT(shm, offset);
+    entry->key_length = key_length;
+    entry->value_length = value_length;
+    entry->hash = key_hash;
+    memcpy(entry->data, key, key_length);
+    if (0 != value_length)
+        memcpy(entry->data + key_length, value, value_length);
+    bucket = (uint64_t *) DICT_SHM_AT(shm, shm->buckets) + \
+        DICT_BUCKET_IDX(key_hash, shm->size);
+    entry->next = *bucket;
+    *bucket = offset;
+    ++shm->items;
+    return 0;
+}
+
+int dict_shm_insert(dict_shm_t *shm, const char *key, uint64_t key_length,
+    const void *value, uint64_t value_length)
+{
+    pthread_rwlock_t *lock = (pthread_rwlock_t *) shm->lock.bytes;
+    uint32_t key_hash = murmurhash1(key, key_length, shm->seed);
+    int status = -1;
+
+    if (0 != pthread_rwlock_wrlock(lock))
+        return -1;
+    if (NULL == dict_shm_find(shm, key, key_length, key_hash) && \
+        (!DICT_MUST_GROW(shm) || \
+        0 == dict_shm_resize_to(shm, shm->size * DICT_RESIZE_FACTOR)))
+        status = dict_shm_link(shm, key, key_length, key_hash, value,
+            value_length);
+    pthread_rwlock_unlock(lock);
+    return status;
+}
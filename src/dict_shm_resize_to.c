@@ -0,0 +1,40 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_shm_resize_to.c
+** File description:
+** Exposes the function resizing the buckets array of a shared dict.
+*/
+
+#include "dict.h"
+
+int dict_shm_resize_to(dict_shm_t *shm, uint64_t new_size)
+{
+    uint64_t *old_buckets = (uint64_t *) DICT_SHM_AT(shm, shm->buckets);
+    uint64_t *new_buckets = NULL;
+    uint64_t offset = 0;
+    uint64_t index = 0;
+    uint64_t current = 0;
+    uint64_t *bucket = NULL;
+    dict_shm_entry_t *entry = NULL;
+
+    new_size = dict_round_size(new_size);
+    if (UINT64_MAX / sizeof(uint64_t) < new_size)
+        return -1;
+    offset = dict_shm_alloc(shm, new_size * sizeof(uint64_t));
+    if (0 == offset)
+        return -1;
+    new_buckets = (uint64_t *) DICT_SHM_AT(shm, offset);
+    for (; index < shm->size; ++index)
+        while (0 != old_buckets[index]) {
+            current = old_buckets[index];
+            entry = (dict_shm_entry_t *) DICT_SHM_AT(shm, current);
+            old_buckets[index] = entry->next;
+            bucket = &(new_buckets[DICT_BUCKET_IDX(entry->hash, new_size)]);
+            entry->next = *bucket;
+            *bucket = current;
+        }
+    dict_shm_free(shm, shm->buckets);
+    shm->buckets = offset;
+    shm->size = new_size;
+    return 0;
+}
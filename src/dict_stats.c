@@ -0,0 +1,60 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_stats.c
+** File description:
+** Exposes a function used to inspect the internal state of a dict.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+/**
+ * @brief Fills the membership filter part of the stats.
+ *
+ * The expected false positive rate is the probability for the
+ * `DICT_FILTER_HASHES` bits of a missing key to all be set already.
+ *
+ * @param filter The filter to inspect.
+ * @param stats The structure to fill.
+ */
+static
+void dict_filter_stats(const dict_filter_t *filter, dict_stats_t *stats)
+{
+    uint64_t index = 0;
+    uint64_t total_bits = filter->nblocks * DICT_FILTER_BLOCK_BITS;
+
+    stats->filter_enabled = 1;
+    stats->filter_bytes = sizeof(dict_filter_t) + \
+        (filter->nblocks + 1) * (DICT_FILTER_BLOCK_BITS / 8);
+    stats->filter_fill_ratio = (double) filter->bits_set / (double) total_bits;
+    stats->filter_fpr = 1.0;
+    for (; index < DICT_FILTER_HASHES; ++index)
+        stats->filter_fpr *= stats->filter_fill_ratio;
+    stats->filter_lookups = filter->lookups;
+    stats->filter_rejects = filter->rejects;
+    stats->filter_false_positives = filter->false_positives;
+}
+
+void dict_stats(const dict_t *dict, dict_stats_t *stats)
+{
+    memset(stats, 0, sizeof(dict_stats_t));
+    stats->items = dict->items;
+    stats->size = dict->size;
+    if (NULL != dict->filter)
+        dict_filter_stats(dict->filter, stats);
+    if (NULL != dict->cache) {
+        stats->cache_enabled = 1;
+        stats->cache_bytes = dict->cache->bytes;
+        stats->cache_evictions = dict->cache->evictions;
+    }
+    if (NULL != dict->expiry) {
+        stats->expiry_enabled = 1;
+        stats->expired = dict->expiry->expired;
+    }
+    if (NULL != dict->index) {
+        stats->index_enabled = 1;
+        stats->index_bytes = sizeof(dict_index_t) + dict->index->bytes;
+    }
+    stats->shared = NULL != dict->shared;
+    stats->cow_copies = dict->cow_copies;
+}
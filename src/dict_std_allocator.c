@@ -0,0 +1,47 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_std_allocator.c
+** File description:
+** Exposes the allocator wrapping the standard library allocation functions.
+*/
+
+#include <stdlib.h>
+#include "dict.h"
+
+/**
+ * @brief Allocates memory with `malloc`.
+ */
+static
+void *dict_std_allocate(__attribute__((unused)) void *ctx, size_t size)
+{
+    return malloc(size);
+}
+
+/**
+ * @brief Resizes memory with `realloc`.
+ */
+static
+void *dict_std_reallocate(__attribute__((unused)) void *ctx, void *ptr,
+    __attribute__((unused)) size_t old_size, size_t new_size)
+{
+    return realloc(ptr, new_size);
+}
+
+/**
+ * @brief Releases memory with `free`.
+ */
+static
+void dict_std_release(__attribute__((unused)) void *ctx, void *ptr)
+{
+    free(ptr);
+}
+
+const dict_allocator_t *dict_std_allocator(void)
+{
+    static const dict_allocator_t allocator = {
+        dict_std_allocate, dict_std_reallocate, dict_std_release, NULL,
+        NULL, NULL
+    };
+
+    return &allocator;
+}
@@ -0,0 +1,35 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_trace_flush.c
+** File description:
+** Exposes the function writing the buffered records of a trace.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <unistd.h>
+#include "dict.h"
+
+int dict_trace_flush(dict_trace_t *trace)
+{
+    const char *buffer = trace->buffer;
+    uint64_t size = trace->buffered;
+    ssize_t written = 0;
+
+    if (trace->failed)
+        return -1;
+    while (0 < size) {
+        written = write(trace->fd, buffer, size);
+        if (-1 == written && EINTR == errno)
+            continue;
+        if (-1 == written) {
+            trace->failed = 1;
+            return -1;
+        }
+        buffer += written;
+        size -= written;
+    }
+    trace->buffered = 0;
+    return 0;
+}
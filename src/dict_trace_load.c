@@ -0,0 +1,192 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_trace_load.c
+** File description:
+** Exposes the function loading the operations of a trace file.
+*/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "dict.h"
+
+/**
+ * @brief Decodes an integer encoded on 7 bits per byte.
+ *
+ * @param cursor The bytes to decode, moved past the integer.
+ * @param end The end of the bytes.
+ * @param value Where to store the integer.
+ * @return 0 on success, -1 if the integer is cut or too large.
+ */
+static
+int dict_trace_read_varint(const unsigned char **cursor,
+    const unsigned char *end, uint64_t *value)
+{
+    uint64_t shift = 0;
+
+    *value = 0;
+    for (; *cursor < end && shift < 64; shift += 7) {
+        *value |= (uint64_t) (**cursor & 0x7F) << shift;
+        if (0 == (*(*cursor)++ & 0x80))
+            return 0;
+    }
+    return -1;
+}
+
+/**
+ * @brief Decodes a record.
+ *
+ * @param cursor The bytes to decode, moved past the record.
+ * @param end The end of the bytes.
+ * @param mode The mode of the trace.
+ * @param op Where to store the operation. The key points to the recorded
+ * bytes, that is to the hash for the traces of hashes.
+ * @return 0 on success, -1 if the record is cut or invalid.
+ */
+static
+int dict_trace_decode(const unsigned char **cursor, const unsigned char *end,
+    int mode, dict_trace_op_t *op)
+{
+    uint64_t delta = 0;
+    uint64_t bytes = 0;
+
+    if (*cursor >= end)
+        return -1;
+    op->op = **cursor & ~DICT_TRACE_FAILED;
+    op->failed = 0 != (**cursor & DICT_TRACE_FAILED);
+    ++*cursor;
+    if (DICT_TRACE_INSERT > op->op || DICT_TRACE_GET < op->op || \
+        -1 == dict_trace_read_varint(cursor, end, &delta) || \
+        -1 == dict_trace_read_varint(cursor, end, &(op->key_length)) || \
+        UINT32_MAX < op->key_length)
+        return -1;
+    bytes = DICT_TRACE_KEYS == mode ? op->key_length : 4;
+    if ((uint64_t) (end - *cursor) < bytes)
+        return -1;
+    op->time += delta;
+    op->key = (const char *) *cursor;
+    *cursor += bytes;
+    return 0;
+}
+
+/**
+ * @brief Counts the records of the trace, along with the room needed by the
+ * keys made for a trace of hashes.
+ *
+ * @param ops The trace, receiving the number of records.
+ * @return The room needed by the keys, in bytes.
+ */
+static
+uint64_t dict_trace_count(dict_trace_ops_t *ops)
+{
+    const unsigned char *cursor = (const unsigned char *) ops->mapping + \
+        DICT_TRACE_HEADER;
+    const unsigned char *end = (const unsigned char *) ops->mapping + \
+        ops->length;
+    dict_trace_op_t op = { 0, 0, 0, NULL, 0 };
+    uint64_t bytes = 0;
+
+    while (0 == dict_trace_decode(&cursor, end, ops->mode, &op)) {
+        ++ops->count;
+        bytes += 4 < op.key_length ? op.key_length : 4;
+    }
+    return bytes;
+}
+
+/**
+ * @brief Decodes the records, making the keys of a trace of hashes : the 4
+ * bytes of the hash padded with zeroes up to the recorded length.
+ *
+ * @param ops The trace, whose operations and keys are allocated.
+ */
+static
+void dict_trace_fill(dict_trace_ops_t *ops)
+{
+    const unsigned char *cursor = (const unsigned char *) ops->mapping + \
+        DICT_TRACE_HEADER;
+    const unsigned char *end = (const unsigned char *) ops->mapping + \
+        ops->length;
+    dict_trace_op_t op = { 0, 0, 0, NULL, 0 };
+    char *key = ops->keys;
+    uint64_t index = 0;
+
+    for (; index < ops->count; ++index) {
+        dict_trace_decode(&cursor, end, ops->mode, &op);
+        if (DICT_TRACE_HASHES == ops->mode) {
+            memcpy(key, op.key, 4);
+            op.key = key;
+            op.key_length = 4 < op.key_length ? op.key_length : 4;
+            key += op.key_length;
+        }
+        ops->ops[index] = op;
+    }
+}
+
+/**
+ * @brief Maps the trace file and checks its header.
+ *
+ * @param ops The trace, receiving the mapping and the mode.
+ * @param path The path of the trace file.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_trace_map(dict_trace_ops_t *ops, const char *path)
+{
+    int fd = open(path, O_RDONLY);
+    struct stat info;
+    uint32_t mode = 0;
+
+    if (-1 == fd)
+        return -1;
+    if (-1 == fstat(fd, &info) || DICT_TRACE_HEADER > info.st_size) {
+        close(fd);
+        return -1;
+    }
+    ops->mapping = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == ops->mapping) {
+        ops->mapping = NULL;
+        return -1;
+    }
+    ops->length = info.st_size;
+    memcpy(&mode, (const char *) ops->mapping + sizeof(DICT_TRACE_MAGIC) - 1,
+        sizeof(mode));
+    ops->mode = (int) mode;
+    if (0 != memcmp(ops->mapping, DICT_TRACE_MAGIC,
+        sizeof(DICT_TRACE_MAGIC) - 1) || \
+        (DICT_TRACE_KEYS != ops->mode && DICT_TRACE_HASHES != ops->mode))
+        return -1;
+    posix_madvise(ops->mapping, ops->length, POSIX_MADV_SEQUENTIAL);
+    return 0;
+}
+
+dict_trace_ops_t *dict_trace_load(const char *path)
+{
+    const dict_allocator_t *allocator = dict_std_allocator();
+    dict_trace_ops_t *ops = (dict_trace_ops_t *) dict_alloc(allocator, 1,
+        sizeof(dict_trace_ops_t));
+    uint64_t bytes = 0;
+
+    if (NULL == ops)
+        return NULL;
+    if (-1 == dict_trace_map(ops, path)) {
+        dict_trace_ops_free(ops);
+        return NULL;
+    }
+    bytes = dict_trace_count(ops);
+    ops->ops = (dict_trace_op_t *) dict_alloc(allocator, ops->count + 1,
+        sizeof(dict_trace_op_t));
+    if (DICT_TRACE_HASHES == ops->mode)
+        ops->keys = (char *) dict_alloc(allocator, bytes + 1, 1);
+    if (NULL == ops->ops || \
+        (DICT_TRACE_HASHES == ops->mode && NULL == ops->keys)) {
+        dict_trace_ops_free(ops);
+        return NULL;
+    }
+    dict_trace_fill(ops);
+    return ops;
+}
@@ -0,0 +1,20 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_trace_ops_free.c
+** File description:
+** Exposes the function releasing the operations of a trace file.
+*/
+
+#include <sys/mman.h>
+#include "dict.h"
+
+void dict_trace_ops_free(dict_trace_ops_t *ops)
+{
+    const dict_allocator_t *allocator = dict_std_allocator();
+
+    if (NULL != ops->mapping)
+        munmap(ops->mapping, ops->length);
+    dict_free(allocator, ops->ops);
+    dict_free(allocator, ops->keys);
+    dict_free(allocator, ops);
+}
@@ -0,0 +1,110 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_trace_record.c
+** File description:
+** Exposes the function appending a record to the trace of a dict.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <string.h>
+#include <time.h>
+#include "dict.h"
+#include "murmurhash1.h"
+
+/**
+ * @brief Encodes an integer on 7 bits per byte, the high bit of each byte
+ * telling whether another one follows.
+ *
+ * @param buffer Where to encode the integer, at least 10 bytes.
+ * @param value The integer to encode.
+ * @return The number of bytes written.
+ */
+static
+uint64_t dict_trace_varint(char *buffer, uint64_t value)
+{
+    uint64_t size = 0;
+
+    for (; 0x80 <= value; value >>= 7)
+        buffer[size++] = (char) ((value & 0x7F) | 0x80);
+    buffer[size++] = (char) value;
+    return size;
+}
+
+/**
+ * @brief Returns the time elapsed since the previous record.
+ *
+ * @param trace The trace recorder.
+ * @return The elapsed time, in nanoseconds.
+ */
+static
+uint64_t dict_trace_delta(dict_trace_t *trace)
+{
+    struct timespec now = { 0, 0 };
+    uint64_t date = 0;
+    uint64_t delta = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    date = (uint64_t) now.tv_sec * 1000000000ULL + now.tv_nsec;
+    delta = date > trace->last ? date - trace->last : 0;
+    trace->last = date;
+    return delta;
+}
+
+/**
+ * @brief Makes room for a record in the buffer, writing the buffered records
+ * first, and growing the buffer if the record is larger than it.
+ *
+ * @param dict The recorded dict.
+ * @param size The largest size of the record.
+ * @return 0 on success, -1 on error, in which case the recording stops.
+ */
+static
+int dict_trace_reserve(dict_t *dict, uint64_t size)
+{
+    dict_trace_t *trace = dict->trace;
+    char *buffer = NULL;
+
+    if (trace->capacity - trace->buffered >= size)
+        return 0;
+    if (-1 == dict_trace_flush(trace))
+        return -1;
+    if (trace->capacity >= size)
+        return 0;
+    buffer = (char *) dict->allocator.reallocate(dict->allocator.ctx,
+        trace->buffer, trace->capacity, size);
+    if (NULL == buffer) {
+        trace->failed = 1;
+        return -1;
+    }
+    trace->buffer = buffer;
+    trace->capacity = size;
+    return 0;
+}
+
+void dict_trace_record(dict_t *dict, int op, const char *key,
+    uint64_t key_length, int status)
+{
+    dict_trace_t *trace = dict->trace;
+    uint64_t bytes = DICT_TRACE_KEYS == trace->mode ? key_length : 4;
+    uint32_t hash = 0;
+    char *record = NULL;
+
+    if (trace->failed || \
+        -1 == dict_trace_reserve(dict, DICT_TRACE_RECORD_MAX + bytes))
+        return;
+    record = trace->buffer + trace->buffered;
+    record[0] = (char) (op | (-1 == status ? DICT_TRACE_FAILED : 0));
+    record += 1;
+    record += dict_trace_varint(record, dict_trace_delta(trace));
+    record += dict_trace_varint(record, key_length);
+    if (DICT_TRACE_KEYS == trace->mode)
+        memcpy(record, key, key_length);
+    else {
+        hash = murmurhash1(key, key_length, trace->seed);
+        memcpy(record, &hash, sizeof(hash));
+    }
+    record += bytes;
+    trace->buffered = record - trace->buffer;
+    ++trace->records;
+}
@@ -0,0 +1,79 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_trace_start.c
+** File description:
+** Exposes the function starting to record the operations of a dict.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "dict.h"
+
+/**
+ * @brief Draws the seed of the key hashes from the clock and the address of
+ * the recorder, as it only has to differ between traces.
+ *
+ * @param trace The trace recorder.
+ * @return The seed.
+ */
+static
+uint32_t dict_trace_seed(const dict_trace_t *trace)
+{
+    uint64_t seed = (uint64_t) trace->last ^ (uint64_t) (uintptr_t) trace;
+
+    seed *= 0x9E3779B97F4A7C15ULL;
+    return (uint32_t) (seed ^ (seed >> 32));
+}
+
+/**
+ * @brief Buffers the header of the trace.
+ *
+ * @param trace The trace recorder.
+ */
+static
+void dict_trace_header(dict_trace_t *trace)
+{
+    uint32_t mode = (uint32_t) trace->mode;
+
+    memset(trace->buffer, 0, DICT_TRACE_HEADER);
+    memcpy(trace->buffer, DICT_TRACE_MAGIC, sizeof(DICT_TRACE_MAGIC) - 1);
+    memcpy(trace->buffer + sizeof(DICT_TRACE_MAGIC) - 1, &mode,
+        sizeof(mode));
+    trace->buffered = DICT_TRACE_HEADER;
+}
+
+int dict_trace_start(dict_t *dict, const char *path, int mode)
+{
+    dict_trace_t *trace = NULL;
+    struct timespec now = { 0, 0 };
+
+    if ((DICT_TRACE_KEYS != mode && DICT_TRACE_HASHES != mode) || \
+        (NULL != dict->trace && -1 == dict_trace_stop(dict)))
+        return -1;
+    trace = (dict_trace_t *) dict_alloc(&(dict->allocator), 1,
+        sizeof(dict_trace_t));
+    if (NULL == trace)
+        return -1;
+    trace->buffer = (char *) dict_alloc(&(dict->allocator), 1,
+        DICT_TRACE_BUFFER);
+    trace->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (NULL == trace->buffer || -1 == trace->fd) {
+        if (-1 != trace->fd)
+            close(trace->fd);
+        dict_free(&(dict->allocator), trace->buffer);
+        dict_free(&(dict->allocator), trace);
+        return -1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    trace->last = (uint64_t) now.tv_sec * 1000000000ULL + now.tv_nsec;
+    trace->mode = mode;
+    trace->seed = dict_trace_seed(trace);
+    trace->capacity = DICT_TRACE_BUFFER;
+    dict_trace_header(trace);
+    dict->trace = trace;
+    return 0;
+}
@@ -0,0 +1,27 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_trace_stop.c
+** File description:
+** Exposes the function stopping the recording of a dict.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <unistd.h>
+#include "dict.h"
+
+int dict_trace_stop(dict_t *dict)
+{
+    dict_trace_t *trace = dict->trace;
+    int status = 0;
+
+    if (NULL == trace)
+        return -1;
+    status = dict_trace_flush(trace);
+    if (0 != close(trace->fd))
+        status = -1;
+    dict_free(&(dict->allocator), trace->buffer);
+    dict_free(&(dict->allocator), trace);
+    dict->trace = NULL;
+    return status;
+}
@@ -0,0 +1,58 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_append.c
+** File description:
+** Exposes the function logging a mutation of a durable dict.
+*/
+
+#include "dict.h"
+
+/**
+ * @brief Makes room for a record in the buffer, writing the buffered records
+ * first, and growing the buffer if the record is larger than it.
+ *
+ * @param wal The durable dict being mutated.
+ * @param size The size of the record.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_wal_reserve(dict_wal_t *wal, uint64_t size)
+{
+    char *buffer = NULL;
+
+    if (wal->capacity - wal->buffered >= size)
+        return 0;
+    if (-1 == dict_wal_flush(wal, 0))
+        return -1;
+    if (wal->capacity >= size)
+        return 0;
+    buffer = (char *) wal->dict->allocator.reallocate(wal->dict->allocator.ctx,
+        wal->buffer, wal->capacity, size);
+    if (NULL == buffer)
+        return -1;
+    wal->buffer = buffer;
+    wal->capacity = size;
+    return 0;
+}
+
+int dict_wal_append(dict_wal_t *wal, int type, const char *key,
+    uint64_t key_length, const dict_wal_value_t *value)
+{
+    uint64_t size = DICT_WAL_RECORD_HEADER + key_length;
+
+    if (UINT32_MAX < key_length || \
+        (NULL != value && UINT32_MAX < value->length))
+        return -1;
+    if (NULL != value)
+        size += value->length;
+    if (-1 == dict_wal_reserve(wal, size))
+        return -1;
+    wal->buffered += dict_wal_encode(wal->buffer + wal->buffered, type, key,
+        key_length, value);
+    wal->log_bytes += size;
+    ++wal->pending;
+    if (DICT_WAL_SYNC_ALWAYS == wal->policy || \
+        (DICT_WAL_SYNC_BATCH == wal->policy && wal->pending >= wal->batch))
+        return -1 == dict_wal_flush(wal, 1) ? 1 : 0;
+    return 0;
+}
@@ -0,0 +1,46 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_close.c
+** File description:
+** Exposes the function closing a durable dict.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <unistd.h>
+#include "dict.h"
+
+/**
+ * @brief Releases the values of every entry, along with their keys.
+ *
+ * @param wal The durable dict being closed.
+ */
+static
+void dict_wal_values_dtor(dict_wal_t *wal)
+{
+    bucket_t *node = NULL;
+    uint64_t index = 0;
+
+    for (; index < wal->dict->size; ++index)
+        for (node = wal->dict->buckets[index]; NULL != node->key;
+            node = node->next)
+            dict_wal_value_dtor(wal, (dict_wal_value_t *) node->value);
+}
+
+int dict_wal_close(dict_wal_t *wal)
+{
+    dict_allocator_t allocator = wal->dict->allocator;
+    int status = 0;
+
+    dict_wal_compact_wait(wal);
+    if (-1 != wal->fd) {
+        status = dict_wal_flush(wal, 1);
+        close(wal->fd);
+    }
+    dict_wal_values_dtor(wal);
+    dict_free(&allocator, wal->buffer);
+    dict_free(&allocator, wal->path);
+    dict_dtor(wal->dict, NULL);
+    dict_free(&allocator, wal);
+    return status;
+}
@@ -0,0 +1,38 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_compact.c
+** File description:
+** Exposes the function starting the compaction of a durable dict.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <unistd.h>
+#include "dict.h"
+
+int dict_wal_compact(dict_wal_t *wal)
+{
+    int fd = -1;
+    pid_t pid = 0;
+
+    if (0 != wal->compactor || \
+        -1 == dict_wal_flush(wal, DICT_WAL_SYNC_NONE != wal->policy))
+        return -1;
+    fd = dict_wal_segment_ctor(wal->path, wal->generation + 1,
+        &(wal->dict->allocator));
+    if (-1 == fd)
+        return -1;
+    pid = fork();
+    if (-1 == pid) {
+        close(fd);
+        return -1;
+    }
+    if (0 == pid)
+        _exit(-1 == dict_wal_write_snapshot(wal, wal->generation) ? 1 : 0);
+    close(wal->fd);
+    wal->fd = fd;
+    ++wal->generation;
+    wal->written = sizeof(DICT_WAL_LOG_MAGIC) - 1;
+    wal->compactor = (int) pid;
+    return 0;
+}
@@ -0,0 +1,30 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_compact_wait.c
+** File description:
+** Exposes the function waiting for the compaction of a durable dict.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <sys/wait.h>
+#include "dict.h"
+
+int dict_wal_compact_wait(dict_wal_t *wal)
+{
+    int status = 0;
+    pid_t waited = 0;
+
+    if (0 == wal->compactor)
+        return 0;
+    do
+        waited = waitpid((pid_t) wal->compactor, &status, 0);
+    while (-1 == waited && EINTR == errno);
+    wal->compactor = 0;
+    if (-1 == waited || !WIFEXITED(status) || 0 != WEXITSTATUS(status))
+        return -1;
+    wal->log_bytes = wal->written + wal->buffered - \
+        (sizeof(DICT_WAL_LOG_MAGIC) - 1);
+    return 0;
+}
@@ -0,0 +1,25 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_delete.c
+** File description:
+** Exposes the function deleting an entry from a durable dict.
+*/
+
+#include "dict.h"
+
+int dict_wal_delete(dict_wal_t *wal, const char *key, uint64_t key_length)
+{
+    dict_hash_t key_hash = dict_hash_key(wal->dict, key, key_length);
+    void *value = NULL;
+    int status = 0;
+
+    if (-1 == dict_get_hashed(wal->dict, key, key_length, key_hash, &value))
+        return -1;
+    status = dict_wal_append(wal, DICT_WAL_DELETE, key, key_length, NULL);
+    if (-1 == status)
+        return -1;
+    dict_delete_hashed(wal->dict, DICT_WAL_KEY((dict_wal_value_t *) value),
+        key_length, key_hash, NULL);
+    dict_wal_value_dtor(wal, (dict_wal_value_t *) value);
+    return 0 == status ? 0 : -1;
+}
@@ -0,0 +1,32 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_encode.c
+** File description:
+** Exposes the function encoding the log records of a durable dict.
+*/
+
+#include <string.h>
+#include "dict.h"
+#include "murmurhash1.h"
+
+uint64_t dict_wal_encode(char *buffer, int type, const char *key,
+    uint64_t key_length, const dict_wal_value_t *value)
+{
+    uint32_t checksum = 0;
+    uint32_t length = (uint32_t) key_length;
+    uint8_t kind = (uint8_t) type;
+    uint64_t size = DICT_WAL_RECORD_HEADER + key_length;
+
+    memcpy(buffer + 4, &kind, 1);
+    memcpy(buffer + 5, &length, 4);
+    length = NULL == value ? 0 : (uint32_t) value->length;
+    memcpy(buffer + 9, &length, 4);
+    memcpy(buffer + DICT_WAL_RECORD_HEADER, key, key_length);
+    if (0 != length) {
+        memcpy(buffer + size, value->data, length);
+        size += length;
+    }
+    checksum = murmurhash1(buffer + 4, size - 4, HASH_SEED);
+    memcpy(buffer, &checksum, 4);
+    return size;
+}
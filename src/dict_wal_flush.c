@@ -0,0 +1,74 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_flush.c
+** File description:
+** Exposes the function writing the buffered records of a durable dict.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include "dict.h"
+
+/**
+ * @brief Writes the whole buffer, resuming the partial writes.
+ *
+ * @param fd The file descriptor to write to.
+ * @param buffer The bytes to write.
+ * @param size The number of bytes to write.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_wal_write_all(int fd, const char *buffer, uint64_t size)
+{
+    ssize_t written = 0;
+
+    while (0 < size) {
+        written = write(fd, buffer, size);
+        if (-1 == written && EINTR == errno)
+            continue;
+        if (-1 == written)
+            return -1;
+        buffer += written;
+        size -= written;
+    }
+    return 0;
+}
+
+/**
+ * @brief Syncs the data of a file to the disk.
+ *
+ * @param fd The file descriptor to sync.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_wal_datasync(int fd)
+{
+#ifdef __APPLE__
+    return fsync(fd);
+#else
+    return fdatasync(fd);
+#endif
+}
+
+int dict_wal_flush(dict_wal_t *wal, int sync)
+{
+    if (0 != wal->buffered) {
+        if (-1 == dict_wal_write_all(wal->fd, wal->buffer, wal->buffered)) {
+            if (-1 == ftruncate(wal->fd, (off_t) wal->written))
+                return -1;
+            return -1;
+        }
+        wal->written += wal->buffered;
+        wal->buffered = 0;
+    }
+    if (!sync || 0 == wal->pending)
+        return 0;
+    if (-1 == dict_wal_datasync(wal->fd))
+        return -1;
+    ++wal->syncs;
+    wal->pending = 0;
+    return 0;
+}
@@ -0,0 +1,20 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_get.c
+** File description:
+** Exposes the function looking up a value of a durable dict.
+*/
+
+#include "dict.h"
+
+int dict_wal_get(dict_wal_t *wal, const char *key, uint64_t key_length,
+    const dict_wal_value_t **value)
+{
+    void *found = NULL;
+
+    if (-1 == dict_get(wal->dict, key, key_length, &found))
+        return -1;
+    if (NULL != value)
+        *value = (const dict_wal_value_t *) found;
+    return 0;
+}
@@ -0,0 +1,34 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_insert.c
+** File description:
+** Exposes the function inserting an entry into a durable dict.
+*/
+
+#include "dict.h"
+
+int dict_wal_insert(dict_wal_t *wal, const char *key, uint64_t key_length,
+    const void *value, uint64_t value_length)
+{
+    dict_hash_t key_hash = dict_hash_key(wal->dict, key, key_length);
+    dict_wal_value_t *copy = NULL;
+    int status = 0;
+
+    if (dict_has_key_hashed(wal->dict, key, key_length, key_hash))
+        return -1;
+    copy = dict_wal_value_ctor(wal, key, key_length, value, value_length);
+    if (NULL == copy)
+        return -1;
+    if (-1 == dict_insert_hashed(wal->dict, DICT_WAL_KEY(copy), key_length,
+        key_hash, copy)) {
+        dict_wal_value_dtor(wal, copy);
+        return -1;
+    }
+    status = dict_wal_append(wal, DICT_WAL_PUT, key, key_length, copy);
+    if (-1 == status) {
+        dict_delete_hashed(wal->dict, DICT_WAL_KEY(copy), key_length,
+            key_hash, NULL);
+        dict_wal_value_dtor(wal, copy);
+    }
+    return 0 == status ? 0 : -1;
+}
@@ -0,0 +1,39 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_open.c
+** File description:
+** Exposes the function opening a durable dict.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+dict_wal_t *dict_wal_open(const char *path, int policy, uint64_t batch,
+    const dict_allocator_t *allocator)
+{
+    dict_t *dict = dict_ctor_with_allocator(allocator);
+    dict_wal_t *wal = NULL;
+
+    if (NULL == dict)
+        return NULL;
+    wal = (dict_wal_t *) dict_alloc(&(dict->allocator), 1, sizeof(dict_wal_t));
+    if (NULL == wal) {
+        dict_dtor(dict, NULL);
+        return NULL;
+    }
+    wal->dict = dict;
+    wal->fd = -1;
+    wal->policy = policy;
+    wal->batch = 0 == batch ? DICT_WAL_BATCH : batch;
+    wal->capacity = DICT_WAL_BUFFER_SIZE;
+    wal->path = dict_wal_path(path, 0, "", &(dict->allocator));
+    wal->buffer = (char *) dict_alloc(&(dict->allocator), wal->capacity, 1);
+    if (NULL != wal->path)
+        wal->path[strlen(wal->path) - strlen(".snap")] = '\0';
+    if (NULL == wal->path || NULL == wal->buffer || \
+        -1 == dict_wal_recover(wal)) {
+        dict_wal_close(wal);
+        return NULL;
+    }
+    return wal;
+}
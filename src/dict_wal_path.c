@@ -0,0 +1,26 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_path.c
+** File description:
+** Exposes the function naming the files of a durable dict.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "dict.h"
+
+char *dict_wal_path(const char *path, uint64_t generation, const char *suffix,
+    const dict_allocator_t *allocator)
+{
+    uint64_t size = strlen(path) + strlen(suffix) + 32;
+    char *result = (char *) dict_alloc(allocator, size, sizeof(char));
+
+    if (NULL == result)
+        return NULL;
+    if (0 == generation)
+        snprintf(result, size, "%s.snap%s", path, suffix);
+    else
+        snprintf(result, size, "%s.%llu.log%s", path,
+            (unsigned long long) generation, suffix);
+    return result;
+}
@@ -0,0 +1,46 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_prune.c
+** File description:
+** Exposes the function removing the log segments covered by a snapshot.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <unistd.h>
+#include "dict.h"
+
+/**
+ * @brief Tells whether a log segment exists.
+ *
+ * @param path The base path.
+ * @param generation The generation of the segment.
+ * @param allocator The allocator of the path.
+ * @return 1 if the segment exists, 0 otherwise.
+ */
+static
+int dict_wal_exists(const char *path, uint64_t generation,
+    const dict_allocator_t *allocator)
+{
+    char *segment = dict_wal_path(path, generation, "", allocator);
+    int exists = NULL != segment && 0 == access(segment, F_OK);
+
+    dict_free(allocator, segment);
+    return exists;
+}
+
+void dict_wal_prune(const char *path, uint64_t generation,
+    const dict_allocator_t *allocator)
+{
+    uint64_t oldest = generation;
+    char *segment = NULL;
+
+    while (1 < oldest && dict_wal_exists(path, oldest - 1, allocator))
+        --oldest;
+    for (; 0 < oldest && oldest <= generation; ++oldest) {
+        segment = dict_wal_path(path, oldest, "", allocator);
+        if (NULL != segment)
+            unlink(segment);
+        dict_free(allocator, segment);
+    }
+}
@@ -0,0 +1,27 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_put.c
+** File description:
+** Exposes the function setting the value of a key of a durable dict.
+*/
+
+#include "dict.h"
+
+int dict_wal_put(dict_wal_t *wal, dict_wal_value_t *value,
+    uint64_t key_length)
+{
+    char *key = DICT_WAL_KEY(value);
+    dict_hash_t key_hash = dict_hash_key(wal->dict, key, key_length);
+    void *old = NULL;
+
+    if (0 == dict_get_hashed(wal->dict, key, key_length, key_hash, &old)) {
+        dict_delete_hashed(wal->dict, key, key_length, key_hash, NULL);
+        dict_wal_value_dtor(wal, (dict_wal_value_t *) old);
+    }
+    if (-1 == dict_insert_hashed(wal->dict, key, key_length, key_hash,
+        value)) {
+        dict_wal_value_dtor(wal, value);
+        return -1;
+    }
+    return 0;
+}
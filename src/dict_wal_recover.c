@@ -0,0 +1,179 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_recover.c
+** File description:
+** Exposes the function rebuilding a durable dict from its files.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "dict.h"
+
+/**
+ * @brief The length of the magic bytes starting a log segment.
+ */
+#define DICT_WAL_MAGIC_LENGTH (sizeof(DICT_WAL_LOG_MAGIC) - 1)
+
+/**
+ * @brief Maps a whole file, read-only.
+ *
+ * @param fd The file descriptor of the file.
+ * @param size Where to store the size of the file.
+ * @return The mapping on success, `NULL` pointer on error or if the file is
+ * empty.
+ */
+static
+char *dict_wal_map(int fd, uint64_t *size)
+{
+    struct stat status;
+    void *mapping = NULL;
+
+    *size = 0;
+    if (-1 == fstat(fd, &status) || 0 == status.st_size)
+        return NULL;
+    *size = (uint64_t) status.st_size;
+    mapping = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+    return MAP_FAILED == mapping ? NULL : (char *) mapping;
+}
+
+/**
+ * @brief Loads the snapshot, if any, the dict being sized for its entries
+ * upfront.
+ *
+ * @param wal The durable dict being recovered.
+ * @param covered Where to store the last log segment covered by the
+ * snapshot, 0 if there is none.
+ * @return 0 on success, -1 on error or if the snapshot is corrupted.
+ */
+static
+int dict_wal_load_snapshot(dict_wal_t *wal, uint64_t *covered)
+{
+    char *path = dict_wal_path(wal->path, 0, "", &(wal->dict->allocator));
+    int fd = NULL == path ? -1 : open(path, O_RDONLY);
+    uint64_t size = 0;
+    uint64_t count = 0;
+    char *mapping = NULL;
+    int status = -1;
+
+    *covered = 0;
+    dict_free(&(wal->dict->allocator), path);
+    if (-1 == fd)
+        return NULL == path ? -1 : 0;
+    mapping = dict_wal_map(fd, &size);
+    close(fd);
+    if (NULL != mapping && DICT_WAL_SNAP_HEADER <= size && \
+        0 == memcmp(mapping, DICT_WAL_SNAP_MAGIC, DICT_WAL_MAGIC_LENGTH)) {
+        memcpy(covered, mapping + 8, sizeof(uint64_t));
+        memcpy(&count, mapping + 16, sizeof(uint64_t));
+        if (0 == dict_reserve(wal->dict, count) && \
+            (int64_t) (size - DICT_WAL_SNAP_HEADER) == dict_wal_replay(wal,
+            mapping + DICT_WAL_SNAP_HEADER, mapping + size))
+            status = 0;
+    }
+    if (NULL != mapping)
+        munmap(mapping, size);
+    return status;
+}
+
+/**
+ * @brief Replays a log segment, cutting its torn tail, if any.
+ *
+ * @param wal The durable dict being recovered.
+ * @param fd The file descriptor of the segment, opened for reading and
+ * appending.
+ * @return The size of the valid part of the segment on success, -1 on error
+ * or if it is not a log segment. A segment torn before the end of its magic
+ * bytes is started again.
+ */
+static
+int64_t dict_wal_load_segment(dict_wal_t *wal, int fd)
+{
+    uint64_t size = 0;
+    char *mapping = dict_wal_map(fd, &size);
+    int64_t valid = 0;
+
+    if (NULL == mapping && 0 != size)
+        return -1;
+    if (DICT_WAL_MAGIC_LENGTH > size) {
+        if (NULL != mapping)
+            munmap(mapping, size);
+        if (-1 == ftruncate(fd, 0) || DICT_WAL_MAGIC_LENGTH != \
+            write(fd, DICT_WAL_LOG_MAGIC, DICT_WAL_MAGIC_LENGTH))
+            return -1;
+        return DICT_WAL_MAGIC_LENGTH;
+    }
+    if (0 != memcmp(mapping, DICT_WAL_LOG_MAGIC, DICT_WAL_MAGIC_LENGTH)) {
+        munmap(mapping, size);
+        return -1;
+    }
+    valid = dict_wal_replay(wal, mapping + DICT_WAL_MAGIC_LENGTH,
+        mapping + size);
+    munmap(mapping, size);
+    if (-1 == valid)
+        return -1;
+    valid += DICT_WAL_MAGIC_LENGTH;
+    if ((uint64_t) valid < size && -1 == ftruncate(fd, (off_t) valid))
+        return -1;
+    return valid;
+}
+
+/**
+ * @brief Replays the log segments written since the snapshot, keeping the
+ * last one open to receive the next records.
+ *
+ * @param wal The durable dict being recovered.
+ * @param generation The first log segment to replay.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_wal_load_segments(dict_wal_t *wal, uint64_t generation)
+{
+    char *path = NULL;
+    int fd = -1;
+    int64_t valid = 0;
+
+    for (;; ++generation) {
+        path = dict_wal_path(wal->path, generation, "",
+            &(wal->dict->allocator));
+        if (NULL == path)
+            return -1;
+        fd = open(path, O_RDWR | O_APPEND);
+        dict_free(&(wal->dict->allocator), path);
+        if (-1 == fd)
+            return 0;
+        valid = dict_wal_load_segment(wal, fd);
+        if (-1 == valid) {
+            close(fd);
+            return -1;
+        }
+        if (-1 != wal->fd)
+            close(wal->fd);
+        wal->fd = fd;
+        wal->generation = generation;
+        wal->written = (uint64_t) valid;
+        wal->log_bytes += (uint64_t) valid - DICT_WAL_MAGIC_LENGTH;
+    }
+}
+
+int dict_wal_recover(dict_wal_t *wal)
+{
+    uint64_t covered = 0;
+
+    if (-1 == dict_wal_load_snapshot(wal, &covered))
+        return -1;
+    dict_wal_prune(wal->path, covered, &(wal->dict->allocator));
+    if (-1 == dict_wal_load_segments(wal, covered + 1))
+        return -1;
+    if (-1 != wal->fd)
+        return 0;
+    wal->fd = dict_wal_segment_ctor(wal->path, covered + 1,
+        &(wal->dict->allocator));
+    wal->generation = covered + 1;
+    wal->written = DICT_WAL_MAGIC_LENGTH;
+    return -1 == wal->fd ? -1 : 0;
+}
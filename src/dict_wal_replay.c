@@ -0,0 +1,70 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_replay.c
+** File description:
+** Exposes the function applying the log records of a durable dict.
+*/
+
+#include <string.h>
+#include "dict.h"
+#include "murmurhash1.h"
+
+/**
+ * @brief Applies a single record.
+ *
+ * @param wal The durable dict being recovered.
+ * @param type The record type.
+ * @param key The key of the record.
+ * @param key_length The length of the key.
+ * @param value The value bytes, followed by `value_length` bytes.
+ * @param value_length The length of the value.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_wal_apply(dict_wal_t *wal, uint8_t type, const char *key,
+    uint32_t key_length, const char *value, uint32_t value_length)
+{
+    dict_wal_value_t *copy = NULL;
+
+    if (DICT_WAL_DELETE == type) {
+        if (0 == dict_get(wal->dict, key, key_length, (void **) &copy)) {
+            dict_delete(wal->dict, DICT_WAL_KEY(copy), key_length, NULL);
+            dict_wal_value_dtor(wal, copy);
+        }
+        return 0;
+    }
+    copy = dict_wal_value_ctor(wal, key, key_length, value, value_length);
+    if (NULL == copy)
+        return -1;
+    return dict_wal_put(wal, copy, key_length);
+}
+
+int64_t dict_wal_replay(dict_wal_t *wal, const char *begin,
+    const char *end)
+{
+    const char *record = begin;
+    uint32_t checksum = 0;
+    uint8_t type = 0;
+    uint32_t key_length = 0;
+    uint32_t value_length = 0;
+
+    while (DICT_WAL_RECORD_HEADER <= end - record) {
+        memcpy(&checksum, record, 4);
+        memcpy(&type, record + 4, 1);
+        memcpy(&key_length, record + 5, 4);
+        memcpy(&value_length, record + 9, 4);
+        if ((uint64_t) (end - record) - DICT_WAL_RECORD_HEADER < \
+            (uint64_t) key_length + value_length || \
+            (DICT_WAL_PUT != type && DICT_WAL_DELETE != type) || \
+            checksum != murmurhash1(record + 4, DICT_WAL_RECORD_HEADER - 4 + \
+            (uint64_t) key_length + value_length, HASH_SEED))
+            break;
+        if (-1 == dict_wal_apply(wal, type, record + DICT_WAL_RECORD_HEADER,
+            key_length, record + DICT_WAL_RECORD_HEADER + key_length,
+            value_length))
+            return -1;
+        record += DICT_WAL_RECORD_HEADER + (uint64_t) key_length + \
+            value_length;
+    }
+    return record - begin;
+}
@@ -0,0 +1,33 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_segment_ctor.c
+** File description:
+** Exposes the function creating a log segment of a durable dict.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <unistd.h>
+#include "dict.h"
+
+int dict_wal_segment_ctor(const char *path, uint64_t generation,
+    const dict_allocator_t *allocator)
+{
+    char *segment = dict_wal_path(path, generation, "", allocator);
+    int fd = -1;
+
+    if (NULL == segment)
+        return -1;
+    fd = open(segment, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    dict_free(allocator, segment);
+    if (-1 == fd)
+        return -1;
+    if (sizeof(DICT_WAL_LOG_MAGIC) - 1 != write(fd, DICT_WAL_LOG_MAGIC,
+        sizeof(DICT_WAL_LOG_MAGIC) - 1) || -1 == fsync(fd) || \
+        -1 == dict_wal_sync_dir(path, allocator)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
@@ -0,0 +1,13 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_sync.c
+** File description:
+** Exposes the function syncing the pending records of a durable dict.
+*/
+
+#include "dict.h"
+
+int dict_wal_sync(dict_wal_t *wal)
+{
+    return dict_wal_flush(wal, 1);
+}
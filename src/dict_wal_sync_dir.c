@@ -0,0 +1,36 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_sync_dir.c
+** File description:
+** Exposes the function syncing the directory of a durable dict.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include "dict.h"
+
+int dict_wal_sync_dir(const char *path, const dict_allocator_t *allocator)
+{
+    const char *slash = strrchr(path, '/');
+    uint64_t length = NULL == slash ? 1 : (uint64_t) (slash - path) + 1;
+    char *directory = (char *) dict_alloc(allocator, length + 1, 1);
+    int fd = -1;
+    int status = -1;
+
+    if (NULL == directory)
+        return -1;
+    if (NULL == slash)
+        directory[0] = '.';
+    else
+        memcpy(directory, path, length);
+    fd = open(directory, O_RDONLY);
+    dict_free(allocator, directory);
+    if (-1 == fd)
+        return -1;
+    status = fsync(fd);
+    close(fd);
+    return status;
+}
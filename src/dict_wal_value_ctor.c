@@ -0,0 +1,27 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_value_ctor.c
+** File description:
+** Exposes the function copying a value of a durable dict.
+*/
+
+#include <string.h>
+#include "dict.h"
+
+dict_wal_value_t *dict_wal_value_ctor(const dict_wal_t *wal, const char *key,
+    uint64_t key_length, const void *value, uint64_t value_length)
+{
+    dict_wal_value_t *copy = NULL;
+
+    if (UINT64_MAX - sizeof(dict_wal_value_t) - key_length < value_length)
+        return NULL;
+    copy = (dict_wal_value_t *) dict_alloc(&(wal->dict->allocator), 1,
+        sizeof(dict_wal_value_t) + value_length + key_length);
+    if (NULL == copy)
+        return NULL;
+    copy->length = value_length;
+    if (0 != value_length)
+        memcpy(copy->data, value, value_length);
+    memcpy(DICT_WAL_KEY(copy), key, key_length);
+    return copy;
+}
@@ -0,0 +1,13 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_value_dtor.c
+** File description:
+** Exposes the function releasing a value of a durable dict.
+*/
+
+#include "dict.h"
+
+void dict_wal_value_dtor(const dict_wal_t *wal, dict_wal_value_t *value)
+{
+    dict_free(&(wal->dict->allocator), value);
+}
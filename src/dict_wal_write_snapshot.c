@@ -0,0 +1,107 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_wal_write_snapshot.c
+** File description:
+** Exposes the function writing the snapshot of a durable dict.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "dict.h"
+
+/**
+ * @brief Writes every live entry as a record.
+ *
+ * @param wal The durable dict to snapshot.
+ * @param stream The snapshot being written.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_wal_write_entries(const dict_wal_t *wal, FILE *stream)
+{
+    const dict_allocator_t *allocator = &(wal->dict->allocator);
+    uint64_t capacity = DICT_WAL_BUFFER_SIZE;
+    char *record = (char *) dict_alloc(allocator, capacity, 1);
+    const dict_wal_value_t *value = NULL;
+    uint64_t size = 0;
+    uint64_t index = 0;
+    bucket_t *node = NULL;
+
+    for (; NULL != record && index < wal->dict->size; ++index)
+        for (node = wal->dict->buckets[index]; NULL != node->key;
+            node = node->next) {
+            value = (const dict_wal_value_t *) node->value;
+            size = DICT_WAL_RECORD_HEADER + node->key_length + value->length;
+            if (size > capacity) {
+                dict_free(allocator, record);
+                capacity = size;
+                record = (char *) dict_alloc(allocator, capacity, 1);
+                if (NULL == record)
+                    return -1;
+            }
+            dict_wal_encode(record, DICT_WAL_PUT, node->key, node->key_length,
+                value);
+            if (1 != fwrite(record, size, 1, stream)) {
+                dict_free(allocator, record);
+                return -1;
+            }
+        }
+    if (NULL == record)
+        return -1;
+    dict_free(allocator, record);
+    return 0;
+}
+
+/**
+ * @brief Writes the snapshot into a file, and syncs it.
+ *
+ * @param wal The durable dict to snapshot.
+ * @param generation The last log segment covered by the snapshot.
+ * @param path The path of the file.
+ * @return 0 on success, -1 on error.
+ */
+static
+int dict_wal_write_file(const dict_wal_t *wal, uint64_t generation,
+    const char *path)
+{
+    FILE *stream = fopen(path, "wb");
+    char header[DICT_WAL_SNAP_HEADER] = { 0 };
+    int status = 0;
+
+    if (NULL == stream)
+        return -1;
+    memcpy(header, DICT_WAL_SNAP_MAGIC, sizeof(DICT_WAL_SNAP_MAGIC) - 1);
+    memcpy(header + 8, &generation, sizeof(uint64_t));
+    memcpy(header + 16, &(wal->dict->items), sizeof(uint64_t));
+    if (1 != fwrite(header, sizeof(header), 1, stream) || \
+        -1 == dict_wal_write_entries(wal, stream) || 0 != fflush(stream) || \
+        -1 == fsync(fileno(stream)))
+        status = -1;
+    if (0 != fclose(stream))
+        status = -1;
+    return status;
+}
+
+int dict_wal_write_snapshot(const dict_wal_t *wal, uint64_t generation)
+{
+    const dict_allocator_t *allocator = &(wal->dict->allocator);
+    char *temporary = dict_wal_path(wal->path, 0, ".tmp", allocator);
+    char *snapshot = dict_wal_path(wal->path, 0, "", allocator);
+    int status = -1;
+
+    if (NULL != temporary && NULL != snapshot && \
+        0 == dict_wal_write_file(wal, generation, temporary) && \
+        0 == rename(temporary, snapshot) && \
+        0 == dict_wal_sync_dir(wal->path, allocator)) {
+        dict_wal_prune(wal->path, generation, allocator);
+        status = 0;
+    }
+    if (-1 == status && NULL != temporary)
+        unlink(temporary);
+    dict_free(allocator, temporary);
+    dict_free(allocator, snapshot);
+    return status;
+}
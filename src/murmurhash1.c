@@ -7,6 +7,7 @@
 */
 
 #include <stdint.h>
+#include <string.h>
 #include "murmurhash1.h"
 
 inline
@@ -29,9 +30,11 @@ uint32_t murmurhash1(const void *key, uint64_t length, uint32_t seed)
 {
     uint32_t h = seed ^ (length * M);
     const uint8_t *data = (const uint8_t *) key;
+    uint32_t block = 0;
 
     while (C <= length) {
-        h += *(uint32_t *) data;
+        memcpy(&block, data, sizeof(block));
+        h += block;
         h *= M;
         h ^= h >> R;
         data += C;
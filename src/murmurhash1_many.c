@@ -0,0 +1,371 @@
+/*
+** XIMAZ PROJECTS, 2024
+** murmurhash1_many.c
+** File description:
+** The MurmurHash1 algorithm, hashing several keys at once in SIMD lanes.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include "murmurhash1.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+    #define MURMURHASH1_X86
+    #include <immintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__)
+    #define MURMURHASH1_NEON
+    #include <arm_neon.h>
+#endif
+
+/**
+ * @brief Such function prototype hashes a full group of keys, one per lane.
+ */
+typedef void (*murmurhash1_kernel_t)(const void *const *keys,
+    const uint64_t *lengths, uint32_t seed, uint32_t *hashes);
+
+/**
+ * @brief This structure holds the kernel selected for the running CPU.
+ */
+typedef struct s_murmurhash1_dispatch {
+    /** The kernel, `NULL` pointer for the scalar algorithm only. */
+    murmurhash1_kernel_t kernel;
+
+    /** The number of keys the kernel hashes at once. */
+    uint64_t lanes;
+
+    /**
+     * The length the longest key of a group must reach for the kernel to
+     * beat the scalar algorithm, see `bench_murmurhash1`.
+     */
+    uint64_t min_length;
+} murmurhash1_dispatch_t;
+
+/**
+ * @brief The per-lane state the kernels cannot compute in vector registers,
+ * as every key is read from its own address.
+ */
+typedef struct s_murmurhash1_lanes {
+    /** The length of the keys, truncated as in the scalar algorithm. */
+    uint32_t lengths[MURMURHASH1_MAX_LANES];
+
+    /** The number of whole blocks of the keys. */
+    uint32_t counts[MURMURHASH1_MAX_LANES];
+
+    /** The trailing bytes of the keys, summed as in `compute_padding`. */
+    uint32_t tails[MURMURHASH1_MAX_LANES];
+
+    /** Whether the keys have trailing bytes, as all-ones masks. */
+    uint32_t padded[MURMURHASH1_MAX_LANES];
+
+    /** The largest number of whole blocks among the keys. */
+    uint32_t most;
+} murmurhash1_lanes_t;
+
+/**
+ * @brief Prepares the lanes of a group of keys.
+ *
+ * @param lanes The lanes to fill.
+ * @param keys The keys of the group.
+ * @param lengths The lengths of the keys.
+ * @param count The number of keys in the group.
+ * @return 0 on success, -1 if a key is too long for the 32 bits lanes.
+ */
+static
+int murmurhash1_lanes_ctor(murmurhash1_lanes_t *lanes,
+    const void *const *keys, const uint64_t *lengths, uint64_t count)
+{
+    uint64_t lane = 0;
+    const uint8_t *data = NULL;
+    uint64_t rest = 0;
+
+    lanes->most = 0;
+    for (; lane < count; ++lane) {
+        if (UINT32_MAX < lengths[lane])
+            return -1;
+        data = (const uint8_t *) keys[lane];
+        rest = lengths[lane] % C;
+        lanes->lengths[lane] = (uint32_t) lengths[lane];
+        lanes->counts[lane] = (uint32_t) (lengths[lane] / C);
+        data += lengths[lane] - rest;
+        lanes->tails[lane] = (3 == rest ? (uint32_t) data[2] << 16 : 0) + \
+            (2 <= rest ? (uint32_t) data[1] << 8 : 0) + \
+            (1 <= rest ? data[0] : 0);
+        lanes->padded[lane] = 0 == rest ? 0 : UINT32_MAX;
+        if (lanes->counts[lane] > lanes->most)
+            lanes->most = lanes->counts[lane];
+    }
+    return 0;
+}
+
+#if defined(MURMURHASH1_X86)
+
+/**
+ * @brief Mixes 8 hashes, as done after every block of the scalar algorithm.
+ */
+__attribute__((target("avx2")))
+static
+__m256i murmurhash1_mix_avx2(__m256i h, __m256i m, int shift)
+{
+    h = _mm256_mullo_epi32(h, m);
+    return _mm256_xor_si256(h, _mm256_srli_epi32(h, shift));
+}
+
+/**
+ * @brief Hashes 8 keys at once in AVX2 lanes.
+ */
+__attribute__((target("avx2")))
+static
+void murmurhash1_avx2(const void *const *keys, const uint64_t *lengths,
+    uint32_t seed, uint32_t *hashes)
+{
+    murmurhash1_lanes_t lanes;
+    __m256i m = _mm256_set1_epi32((int) M);
+    __m256i h;
+    __m256i counts;
+    __m256i active;
+    __m256i low = _mm256_loadu_si256((const __m256i *) keys);
+    __m256i high = _mm256_loadu_si256((const __m256i *) (keys + 4));
+    __m256i blocks;
+    uint32_t step = 0;
+
+    if (-1 == murmurhash1_lanes_ctor(&lanes, keys, lengths, 8)) {
+        for (; step < 8; ++step)
+            hashes[step] = murmurhash1(keys[step], lengths[step], seed);
+        return;
+    }
+    h = _mm256_xor_si256(_mm256_set1_epi32((int) seed), _mm256_mullo_epi32(
+        _mm256_loadu_si256((const __m256i *) lanes.lengths), m));
+    counts = _mm256_loadu_si256((const __m256i *) lanes.counts);
+    for (; step < lanes.most; ++step) {
+        active = _mm256_cmpgt_epi32(counts, _mm256_set1_epi32((int) step));
+        blocks = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm256_mask_i64gather_epi32(_mm_setzero_si128(), NULL, low,
+            _mm256_castsi256_si128(active), 1)), _mm256_mask_i64gather_epi32(
+            _mm_setzero_si128(), NULL, high,
+            _mm256_extracti128_si256(active, 1), 1), 1);
+        h = _mm256_blendv_epi8(h, murmurhash1_mix_avx2(_mm256_add_epi32(h,
+            blocks), m, R), active);
+        low = _mm256_add_epi64(low, _mm256_set1_epi64x(C));
+        high = _mm256_add_epi64(high, _mm256_set1_epi64x(C));
+    }
+    h = _mm256_add_epi32(h, _mm256_loadu_si256((const __m256i *) lanes.tails));
+    h = _mm256_blendv_epi8(h, murmurhash1_mix_avx2(h, m, R),
+        _mm256_loadu_si256((const __m256i *) lanes.padded));
+    h = murmurhash1_mix_avx2(murmurhash1_mix_avx2(h, m, 10), m, 17);
+    _mm256_storeu_si256((__m256i *) hashes, h);
+}
+
+/**
+ * @brief Mixes 16 hashes, as done after every block of the scalar algorithm.
+ */
+__attribute__((target("avx512f")))
+static
+__m512i murmurhash1_mix_avx512(__m512i h, __m512i m, unsigned int shift)
+{
+    h = _mm512_mullo_epi32(h, m);
+    return _mm512_xor_si512(h, _mm512_srli_epi32(h, shift));
+}
+
+/**
+ * @brief Hashes 16 keys at once in AVX-512 lanes.
+ */
+__attribute__((target("avx512f")))
+static
+void murmurhash1_avx512(const void *const *keys, const uint64_t *lengths,
+    uint32_t seed, uint32_t *hashes)
+{
+    murmurhash1_lanes_t lanes;
+    __m512i m = _mm512_set1_epi32((int) M);
+    __m512i h;
+    __m512i counts;
+    __mmask16 active = 0;
+    __m512i low = _mm512_loadu_si512(keys);
+    __m512i high = _mm512_loadu_si512(keys + 8);
+    __m512i blocks;
+    uint32_t step = 0;
+
+    if (-1 == murmurhash1_lanes_ctor(&lanes, keys, lengths, 16)) {
+        for (; step < 16; ++step)
+            hashes[step] = murmurhash1(keys[step], lengths[step], seed);
+        return;
+    }
+    h = _mm512_xor_si512(_mm512_set1_epi32((int) seed),
+        _mm512_mullo_epi32(_mm512_loadu_si512(lanes.lengths), m));
+    counts = _mm512_loadu_si512(lanes.counts);
+    for (; step < lanes.most; ++step) {
+        active = _mm512_cmpgt_epu32_mask(counts,
+            _mm512_set1_epi32((int) step));
+        blocks = _mm512_inserti64x4(_mm512_castsi256_si512(
+            _mm512_mask_i64gather_epi32(_mm256_setzero_si256(),
+            (__mmask8) active, low, NULL, 1)), _mm512_mask_i64gather_epi32(
+            _mm256_setzero_si256(), (__mmask8) (active >> 8), high, NULL, 1),
+            1);
+        h = _mm512_mask_blend_epi32(active, h, murmurhash1_mix_avx512(
+            _mm512_add_epi32(h, blocks), m, R));
+        low = _mm512_add_epi64(low, _mm512_set1_epi64(C));
+        high = _mm512_add_epi64(high, _mm512_set1_epi64(C));
+    }
+    h = _mm512_add_epi32(h, _mm512_loadu_si512(lanes.tails));
+    active = _mm512_test_epi32_mask(_mm512_loadu_si512(lanes.padded),
+        _mm512_loadu_si512(lanes.padded));
+    h = _mm512_mask_blend_epi32(active, h, murmurhash1_mix_avx512(h, m, R));
+    h = murmurhash1_mix_avx512(murmurhash1_mix_avx512(h, m, 10), m, 17);
+    _mm512_storeu_si512(hashes, h);
+}
+
+#elif defined(MURMURHASH1_NEON)
+
+/**
+ * @brief Loads the given block of a key, 0 past its end.
+ *
+ * @param key The key to read.
+ * @param lanes The lanes of the group of the key.
+ * @param lane The lane of the key.
+ * @param step The index of the block to load.
+ * @return The block.
+ */
+static
+uint32_t murmurhash1_block(const void *key, const murmurhash1_lanes_t *lanes,
+    uint64_t lane, uint32_t step)
+{
+    uint32_t block = 0;
+
+    if (step < lanes->counts[lane])
+        memcpy(&block, (const uint8_t *) key + (uint64_t) step * C, C);
+    return block;
+}
+
+/**
+ * @brief Mixes 4 hashes, as done after every block of the scalar algorithm.
+ */
+static
+uint32x4_t murmurhash1_mix_neon(uint32x4_t h, uint32x4_t m, int shift)
+{
+    h = vmulq_u32(h, m);
+    if (10 == shift)
+        return veorq_u32(h, vshrq_n_u32(h, 10));
+    if (17 == shift)
+        return veorq_u32(h, vshrq_n_u32(h, 17));
+    return veorq_u32(h, vshrq_n_u32(h, R));
+}
+
+/**
+ * @brief Hashes 4 keys at once in NEON lanes.
+ */
+static
+void murmurhash1_neon(const void *const *keys, const uint64_t *lengths,
+    uint32_t seed, uint32_t *hashes)
+{
+    murmurhash1_lanes_t lanes;
+    uint32x4_t m = vdupq_n_u32(M);
+    uint32x4_t h;
+    uint32x4_t counts;
+    uint32x4_t blocks = vdupq_n_u32(0);
+    uint32_t step = 0;
+
+    if (-1 == murmurhash1_lanes_ctor(&lanes, keys, lengths, 4)) {
+        for (; step < 4; ++step)
+            hashes[step] = murmurhash1(keys[step], lengths[step], seed);
+        return;
+    }
+    h = veorq_u32(vdupq_n_u32(seed), vmulq_u32(vld1q_u32(lanes.lengths), m));
+    counts = vld1q_u32(lanes.counts);
+    for (; step < lanes.most; ++step) {
+        blocks = vsetq_lane_u32(murmurhash1_block(keys[0], &lanes, 0, step),
+            blocks, 0);
+        blocks = vsetq_lane_u32(murmurhash1_block(keys[1], &lanes, 1, step),
+            blocks, 1);
+        blocks = vsetq_lane_u32(murmurhash1_block(keys[2], &lanes, 2, step),
+            blocks, 2);
+        blocks = vsetq_lane_u32(murmurhash1_block(keys[3], &lanes, 3, step),
+            blocks, 3);
+        h = vbslq_u32(vcgtq_u32(counts, vdupq_n_u32(step)),
+            murmurhash1_mix_neon(vaddq_u32(h, blocks), m, R), h);
+    }
+    h = vaddq_u32(h, vld1q_u32(lanes.tails));
+    h = vbslq_u32(vld1q_u32(lanes.padded), murmurhash1_mix_neon(h, m, R), h);
+    h = murmurhash1_mix_neon(murmurhash1_mix_neon(h, m, 10), m, 17);
+    vst1q_u32(hashes, h);
+}
+
+#endif
+
+/**
+ * @brief The kernel selected for the running CPU, filled once by
+ * `murmurhash1_select`, whatever the number of threads hashing.
+ */
+static murmurhash1_dispatch_t murmurhash1_dispatch = { NULL, 1, 0 };
+
+/**
+ * @brief Guards the selection of the kernel.
+ */
+static pthread_once_t murmurhash1_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Selects the widest kernel the running CPU supports.
+ */
+static
+void murmurhash1_select(void)
+{
+#if defined(MURMURHASH1_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        murmurhash1_dispatch.kernel = murmurhash1_avx512;
+        murmurhash1_dispatch.lanes = 16;
+        murmurhash1_dispatch.min_length = 16;
+    } else if (__builtin_cpu_supports("avx2")) {
+        murmurhash1_dispatch.kernel = murmurhash1_avx2;
+        murmurhash1_dispatch.lanes = 8;
+        murmurhash1_dispatch.min_length = 64;
+    }
+#elif defined(MURMURHASH1_NEON)
+    murmurhash1_dispatch.kernel = murmurhash1_neon;
+    murmurhash1_dispatch.lanes = 4;
+    murmurhash1_dispatch.min_length = 32;
+#endif
+}
+
+/**
+ * @brief Tells whether a group of keys is long enough for the kernel to beat
+ * the scalar algorithm, as every lane waits for the longest key.
+ *
+ * @param lengths The lengths of the keys of the group.
+ * @param dispatch The selected kernel.
+ * @return 1 if the kernel should hash the group, 0 otherwise.
+ */
+static
+int murmurhash1_worth(const uint64_t *lengths,
+    const murmurhash1_dispatch_t *dispatch)
+{
+    uint64_t lane = 0;
+
+    for (; lane < dispatch->lanes; ++lane)
+        if (dispatch->min_length <= lengths[lane])
+            return 1;
+    return 0;
+}
+
+void murmurhash1_many(const void *const *keys, const uint64_t *lengths,
+    uint64_t count, uint32_t seed, uint32_t *hashes)
+{
+    const murmurhash1_dispatch_t *dispatch = &murmurhash1_dispatch;
+    uint64_t index = 0;
+    uint64_t lane = 0;
+
+    pthread_once(&murmurhash1_once, murmurhash1_select);
+    for (; NULL != dispatch->kernel && index + dispatch->lanes <= count;
+        index += dispatch->lanes) {
+        if (murmurhash1_worth(lengths + index, dispatch)) {
+            dispatch->kernel(keys + index, lengths + index, seed,
+                hashes + index);
+            continue;
+        }
+        for (lane = index; lane < index + dispatch->lanes; ++lane)
+            hashes[lane] = murmurhash1(keys[lane], lengths[lane], seed);
+    }
+    for (; index < count; ++index)
+        hashes[index] = murmurhash1(keys[index], lengths[index], seed);
+}
@@ -0,0 +1,104 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict32.c
+** File description:
+** Unit tests for the compact dict.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+#include "tests_helpers.h"
+
+#define KEYS_COUNT 10000
+
+Test(dict32, insert_get_delete)
+{
+    dict32_t *dict = dict32_ctor(NULL);
+    char *key = NULL;
+    void *value = NULL;
+    int index = 0;
+
+    cr_assert(ne(ptr, NULL, dict));
+    for (; index < KEYS_COUNT; ++index) {
+        key = make_key(index);
+        cr_expect(eq(int, 0, dict32_insert(dict, key, strlen(key),
+            (void *) (intptr_t) index)));
+    }
+    cr_expect(eq(int, -1, dict32_insert(dict, "KEY0", 4, NULL)));
+    cr_expect(eq(u64, KEYS_COUNT, DICT_SIZE(dict)));
+    cr_expect(eq(int, 0, dict32_get(dict, "KEY1234", 7, &value)));
+    cr_expect(eq(int, 1234, (int) (intptr_t) value));
+    cr_expect(eq(int, 0, dict32_has_key(dict, "KEY10000", 8)));
+    released = 0;
+    for (index = 0; index < KEYS_COUNT - 10; ++index) {
+        key = make_key(index);
+        cr_expect(eq(int, 0, dict32_delete(dict, key, strlen(key),
+            free_key)));
+        free(key);
+    }
+    cr_expect(eq(int, KEYS_COUNT - 10, released));
+    cr_expect(eq(int, -1, dict32_delete(dict, "KEY0", 4, free_key)));
+    cr_expect(eq(u64, 10, DICT_SIZE(dict)));
+    cr_expect(gt(u64, KEYS_COUNT, dict->size));
+    cr_expect(eq(int, 1, dict32_has_key(dict, "KEY9999", 7)));
+    released = 0;
+    dict32_dtor(dict, free_key);
+    cr_expect(eq(int, 10, released));
+}
+
+Test(dict32, reuses_released_entries)
+{
+    dict32_t *dict = dict32_ctor(NULL);
+    uint32_t capacity = 0;
+    char *key = NULL;
+    int index = 0;
+    int round = 0;
+
+    cr_assert(eq(int, 0, dict32_reserve(dict, 100)));
+    capacity = dict->capacity;
+    cr_expect(le(u32, 100, capacity));
+    for (; round < 10; ++round) {
+        for (index = 0; index < 100; ++index) {
+            key = make_key(index);
+            cr_expect(eq(int, 0, dict32_insert(dict, key, strlen(key),
+                NULL)));
+        }
+        for (index = 0; index < 100; ++index) {
+            key = make_key(index);
+            cr_expect(eq(int, 0, dict32_delete(dict, key, strlen(key),
+                free_key)));
+            free(key);
+        }
+    }
+    cr_expect(eq(u32, capacity, dict->capacity));
+    cr_expect(ge(u32, 100, dict->used));
+    dict32_dtor(dict, free_key);
+}
+
+Test(dict32, arena_allocator)
+{
+    dict_arena_t *arena = dict_arena_ctor(0);
+    dict_allocator_t allocator = { 0 };
+    dict32_t *dict = NULL;
+    int index = 0;
+    char *key = NULL;
+
+    dict_arena_allocator(arena, &allocator);
+    dict = dict32_ctor(&allocator);
+    for (; index < KEYS_COUNT; ++index) {
+        key = allocator.allocate(allocator.ctx, 16);
+        snprintf(key, 16, "KEY%d", index);
+        cr_expect(eq(int, 0, dict32_insert(dict, key, strlen(key), NULL)));
+    }
+    for (index = 0; index < KEYS_COUNT; index += 7) {
+        char lookup[16];
+
+        snprintf(lookup, sizeof(lookup), "KEY%d", index);
+        cr_expect(eq(int, 1, dict32_has_key(dict, lookup, strlen(lookup))));
+    }
+    dict_arena_dtor(arena);
+}
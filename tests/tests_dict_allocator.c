@@ -0,0 +1,139 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_allocator.c
+** File description:
+** Unit tests for the dict pluggable allocator and the arena allocator.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+
+#define KEYS_COUNT 1000
+
+typedef struct s_counting {
+    int allocations;
+    int releases;
+    int budget;
+} counting_t;
+
+static
+void *counting_allocate(void *ctx, size_t size)
+{
+    counting_t *counting = (counting_t *) ctx;
+
+    if (0 == counting->budget)
+        return NULL;
+    --counting->budget;
+    ++counting->allocations;
+    return malloc(size);
+}
+
+static
+void *counting_reallocate(__attribute__((unused)) void *ctx, void *ptr,
+    __attribute__((unused)) size_t old_size, size_t new_size)
+{
+    return realloc(ptr, new_size);
+}
+
+static
+void counting_release(void *ctx, void *ptr)
+{
+    ++((counting_t *) ctx)->releases;
+    free(ptr);
+}
+
+static
+int fill(dict_t *dict, char keys[KEYS_COUNT][16])
+{
+    int index = 0;
+
+    for (; index < KEYS_COUNT; ++index) {
+        snprintf(keys[index], 16, "KEY%d", index);
+        if (-1 == dict_insert(dict, keys[index], strlen(keys[index]), NULL))
+            return -1;
+    }
+    return 0;
+}
+
+Test(dict_allocator, every_allocation_is_routed)
+{
+    static char keys[KEYS_COUNT][16];
+    counting_t counting = { 0, 0, -1 };
+    dict_allocator_t allocator = { counting_allocate, counting_reallocate,
+        counting_release, &counting, NULL, NULL };
+    dict_t *dict = dict_ctor_with_allocator(&allocator);
+    dict_t *clone = NULL;
+    dict_keys_t *dict_keys = NULL;
+    int index = 0;
+
+    cr_assert(ne(ptr, NULL, dict));
+    cr_expect(eq(int, 0, dict_enable_filter(dict)));
+    cr_expect(eq(int, 0, fill(dict, keys)));
+    clone = dict_clone(dict);
+    cr_assert(ne(ptr, NULL, clone));
+    for (index = 0; index < KEYS_COUNT / 2; ++index)
+        cr_expect(eq(int, 0, dict_delete(clone, keys[index],
+            strlen(keys[index]), NULL)));
+    dict_keys = dict_get_keys(clone);
+    cr_expect(eq(u64, KEYS_COUNT / 2, dict_keys->size));
+    dict_free_keys(dict_keys);
+    dict_dtor(dict, NULL);
+    dict_dtor(clone, NULL);
+    cr_expect(lt(int, 0, counting.allocations));
+    cr_expect(eq(int, counting.allocations, counting.releases));
+}
+
+Test(dict_allocator, failing_allocations)
+{
+    static char keys[KEYS_COUNT][16];
+    counting_t counting = { 0, 0, 0 };
+    dict_allocator_t allocator = { counting_allocate, counting_reallocate,
+        counting_release, &counting, NULL, NULL };
+    dict_t *dict = dict_ctor_with_allocator(&allocator);
+    int budget = 0;
+
+    cr_expect(eq(ptr, NULL, dict));
+    for (; NULL == dict; ++budget) {
+        counting.budget = budget;
+        dict = dict_ctor_with_allocator(&allocator);
+    }
+    counting.budget = 100;
+    cr_expect(eq(int, -1, fill(dict, keys)));
+    counting.budget = -1;
+    dict_dtor(dict, NULL);
+    cr_expect(eq(int, counting.allocations, counting.releases));
+}
+
+Test(dict_allocator, arena)
+{
+    static char keys[KEYS_COUNT][16];
+    dict_arena_t *arena = dict_arena_ctor(4096);
+    dict_allocator_t allocator = { 0 };
+    dict_t *dict = NULL;
+    char *grown = NULL;
+    char *moved = NULL;
+
+    cr_assert(ne(ptr, NULL, arena));
+    dict_arena_allocator(arena, &allocator);
+    dict = dict_ctor_with_allocator(&allocator);
+    cr_assert(ne(ptr, NULL, dict));
+    cr_expect(eq(int, 0, fill(dict, keys)));
+    cr_expect(eq(int, 1, dict_has_key(dict, "KEY999", 6)));
+    cr_expect(lt(sz, KEYS_COUNT * sizeof(bucket_t), arena->allocated));
+    grown = (char *) allocator.allocate(allocator.ctx, 10);
+    memcpy(grown, "0123456789", 10);
+    cr_expect(eq(ptr, grown, allocator.reallocate(allocator.ctx, grown, 10,
+        100)));
+    cr_expect(eq(ptr, grown, allocator.reallocate(allocator.ctx, grown, 100,
+        50)));
+    cr_expect(eq(int, 0, (intptr_t) grown % DICT_ARENA_ALIGN));
+    allocator.allocate(allocator.ctx, 1);
+    moved = (char *) allocator.reallocate(allocator.ctx, grown, 50, 8192);
+    cr_expect(ne(ptr, grown, moved));
+    cr_expect(eq(int, 0, memcmp(moved, "0123456789", 10)));
+    dict_arena_dtor(arena);
+}
@@ -0,0 +1,53 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_amalgamated.c
+** File description:
+** Unit tests for the single header distribution, whose functions are
+** static inline copies living in this translation unit only.
+*/
+
+#include "dict_amalgamated.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+
+#define KEYS_COUNT 10000
+
+Test(dict_amalgamated, inserts_gets_and_deletes)
+{
+    static char keys[KEYS_COUNT][16];
+    dict_t *dict = dict_ctor();
+    void *value = NULL;
+    int index = 0;
+    int length = 0;
+
+    for (; index < KEYS_COUNT; ++index) {
+        length = snprintf(keys[index], sizeof(keys[index]), "key%d", index);
+        cr_assert(eq(int, 0, dict_insert(dict, keys[index], length,
+            keys[index])));
+    }
+    cr_assert(eq(u64, KEYS_COUNT, dict->items));
+    for (index = 0; index < KEYS_COUNT; index += 2) {
+        cr_assert(eq(int, 0, dict_get(dict, keys[index],
+            strlen(keys[index]), &value)));
+        cr_assert(eq(ptr, keys[index], value));
+        cr_assert(eq(int, 0, dict_delete(dict, keys[index],
+            strlen(keys[index]), NULL)));
+    }
+    cr_assert(eq(u64, KEYS_COUNT / 2, dict->items));
+    cr_assert(eq(int, 0, dict_has_key(dict, "key0", 4)));
+    cr_assert(eq(int, 1, dict_has_key(dict, "key1", 4)));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_amalgamated, hashes_like_the_library)
+{
+    dict_t *dict = dict_ctor();
+
+    cr_assert(eq(u32, 1637579608, murmurhash1("Hello, World !!", 15, 0)));
+    cr_assert(eq(u32, murmurhash1("Hello, World !!", 15, HASH_SEED),
+        dict_hash_key(dict, "Hello, World !!", 15).value));
+    dict_dtor(dict, NULL);
+}
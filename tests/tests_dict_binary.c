@@ -0,0 +1,112 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_binary.c
+** File description:
+** Unit tests for the binary keys, holding zeros and not NUL-terminated.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+#include "tests_helpers.h"
+
+#define KEYS_COUNT 200
+
+static
+uint64_t size_key(__attribute__((unused)) const char *key,
+    uint64_t key_length, __attribute__((unused)) const void *value)
+{
+    return key_length;
+}
+
+/**
+ * @brief Builds an exact-size key, without terminator, made of zeros but for
+ * its last byte, so that keys only differ after their embedded zeros.
+ */
+static
+char *make_binary_key(int index)
+{
+    char *key = malloc(8);
+
+    memset(key, 0, 8);
+    key[6] = (char) (index / 256);
+    key[7] = (char) (index % 256);
+    return key;
+}
+
+Test(dict_binary, embedded_zeros)
+{
+    dict_t *dict = dict_ctor();
+    char *key = NULL;
+    void *value = NULL;
+    int index = 0;
+
+    for (; index < KEYS_COUNT; ++index)
+        cr_expect(eq(int, 0, dict_insert(dict, make_binary_key(index), 8,
+            (void *) (uintptr_t) index)));
+    cr_expect(eq(int, KEYS_COUNT, DICT_SIZE(dict)));
+    for (index = 0; index < KEYS_COUNT; index += 7) {
+        key = make_binary_key(index);
+        cr_expect(eq(int, 0, dict_get(dict, key, 8, &value)));
+        cr_expect(eq(int, index, (int) (uintptr_t) value));
+        cr_expect(eq(int, 0, dict_has_key(dict, key, 7)));
+        cr_expect(eq(int, 0, dict_delete(dict, key, 8, free_key)));
+        cr_expect(eq(int, 0, dict_has_key(dict, key, 8)));
+        free(key);
+    }
+    dict_dtor(dict, free_key);
+}
+
+Test(dict_binary, zero_copy_slices)
+{
+    const char payload[] = { 'u', 's', 'e', 'r', 'i', 'd', '4', '2' };
+    dict_t *dict = dict_ctor();
+    dict_keys_t *keys = NULL;
+
+    cr_expect(eq(int, 0, dict_insert(dict, (char *) payload, 4, NULL)));
+    cr_expect(eq(int, 0, dict_insert(dict, (char *) payload + 4, 2, NULL)));
+    cr_expect(eq(int, 0, dict_insert(dict, (char *) payload, 6, NULL)));
+    cr_expect(eq(int, 1, dict_has_key(dict, "user", 4)));
+    cr_expect(eq(int, 1, dict_has_key(dict, "id", 2)));
+    cr_expect(eq(int, 1, dict_has_key(dict, "userid", 6)));
+    cr_expect(eq(int, 0, dict_has_key(dict, "us", 2)));
+    keys = dict_get_keys(dict);
+    cr_assert(ne(ptr, NULL, keys));
+    cr_expect(eq(u64, 3, keys->size));
+    cr_expect(eq(u64, 12, keys->lengths[0] + keys->lengths[1] + \
+        keys->lengths[2]));
+    dict_free_keys(keys);
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_binary, empty_key)
+{
+    dict_t *dict = dict_ctor();
+
+    cr_expect(eq(int, -1, dict_delete(dict, "", 0, NULL)));
+    cr_expect(eq(int, 0, dict_has_key(dict, "", 0)));
+    cr_expect(eq(int, 0, dict_insert(dict, "", 0, NULL)));
+    cr_expect(eq(int, 1, dict_has_key(dict, "", 0)));
+    cr_expect(eq(int, 0, dict_delete(dict, "", 0, NULL)));
+    cr_expect(eq(int, -1, dict_delete(dict, "", 0, NULL)));
+    cr_expect(eq(int, 0, DICT_SIZE(dict)));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_binary, cache_charges_key_length)
+{
+    dict_t *dict = dict_ctor();
+    char *key = make_binary_key(1);
+
+    cr_assert(eq(int, 0, dict_enable_cache(dict, 0, 16, free_key,
+        size_key)));
+    cr_expect(eq(int, 0, dict_insert(dict, key, 8, NULL)));
+    cr_expect(eq(u64, 8, dict->cache->bytes));
+    cr_expect(eq(int, 0, dict_insert(dict, make_binary_key(2), 8, NULL)));
+    cr_expect(eq(int, 0, dict_insert(dict, make_binary_key(3), 8, NULL)));
+    cr_expect(eq(int, 2, DICT_SIZE(dict)));
+    cr_expect(eq(u64, 16, dict->cache->bytes));
+    dict_dtor(dict, free_key);
+}
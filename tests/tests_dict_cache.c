@@ -0,0 +1,167 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_cache.c
+** File description:
+** Unit tests for the dict cache mode.
+*/
+
+#include <stdlib.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+
+static int evicted = 0;
+
+static
+void count_evicted(__attribute__((unused)) char *key,
+    __attribute__((unused)) void *value)
+{
+    ++evicted;
+}
+
+static
+uint64_t charge_ten(__attribute__((unused)) const char *key,
+    __attribute__((unused)) uint64_t key_length,
+    __attribute__((unused)) const void *value)
+{
+    return 10;
+}
+
+static
+void *budget_allocate(void *ctx, size_t size)
+{
+    int *budget = (int *) ctx;
+
+    if (0 == *budget)
+        return NULL;
+    --*budget;
+    return malloc(size);
+}
+
+static
+void *budget_reallocate(__attribute__((unused)) void *ctx, void *ptr,
+    __attribute__((unused)) size_t old_size, size_t new_size)
+{
+    return realloc(ptr, new_size);
+}
+
+static
+void budget_release(__attribute__((unused)) void *ctx, void *ptr)
+{
+    free(ptr);
+}
+
+Test(dict_cache, bounded_by_items)
+{
+    dict_t *dict = dict_ctor();
+    dict_stats_t stats = { 0 };
+
+    evicted = 0;
+    cr_assert(eq(int, 0, dict_enable_cache(dict, 4, 0, count_evicted,
+        NULL)));
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY0", 4, NULL)));
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY1", 4, NULL)));
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY2", 4, NULL)));
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY3", 4, NULL)));
+    cr_expect(eq(int, 0, evicted));
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY4", 4, NULL)));
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY5", 4, NULL)));
+    cr_expect(eq(int, 2, evicted));
+    cr_expect(eq(int, 4, DICT_SIZE(dict)));
+    cr_expect(eq(int, 1, dict_has_key(dict, "KEY5", 4)));
+    dict_stats(dict, &stats);
+    cr_expect(eq(int, 1, stats.cache_enabled));
+    cr_expect(eq(u64, 2, stats.cache_evictions));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_cache, referenced_entries_are_spared)
+{
+    int index = 0;
+    dict_t *dict = dict_ctor();
+    char *KEYS[] = { "KEY0", "KEY1", "KEY2", "KEY3", "KEY4", "KEY5" };
+
+    dict_enable_cache(dict, 4, 0, NULL, NULL);
+    for (; index < 4; ++index)
+        dict_insert(dict, KEYS[index], 4, NULL);
+    cr_expect(eq(int, 1, dict_has_key(dict, "KEY2", 4)));
+    for (; index < 6; ++index) {
+        dict_insert(dict, KEYS[index], 4, NULL);
+        cr_expect(eq(int, 1, dict_has_key(dict, "KEY2", 4)));
+    }
+    cr_expect(eq(int, 4, DICT_SIZE(dict)));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_cache, bounded_by_bytes)
+{
+    dict_t *dict = dict_ctor();
+    dict_stats_t stats = { 0 };
+
+    dict_insert(dict, "KEY0", 4, NULL);
+    dict_insert(dict, "KEY1", 4, NULL);
+    dict_insert(dict, "KEY2", 4, NULL);
+    evicted = 0;
+    cr_assert(eq(int, 0, dict_enable_cache(dict, 0, 25, count_evicted,
+        charge_ten)));
+    cr_expect(eq(int, 1, evicted));
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY3", 4, NULL)));
+    cr_expect(eq(int, 2, evicted));
+    cr_expect(eq(int, 0, dict_delete(dict, "KEY3", 4, NULL)));
+    dict_stats(dict, &stats);
+    cr_expect(eq(u64, 10, stats.cache_bytes));
+    dict_disable_cache(dict);
+    dict_stats(dict, &stats);
+    cr_expect(eq(int, 0, stats.cache_enabled));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_cache, failed_insertion_evicts_nothing)
+{
+    int budget = -1;
+    dict_allocator_t allocator = { budget_allocate, budget_reallocate,
+        budget_release, &budget, NULL, NULL };
+    dict_t *dict = dict_ctor_with_allocator(&allocator);
+
+    evicted = 0;
+    cr_assert(eq(int, 0, dict_enable_cache(dict, 4, 0, count_evicted,
+        NULL)));
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY0", 4, NULL)));
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY1", 4, NULL)));
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY2", 4, NULL)));
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY3", 4, NULL)));
+    budget = 0;
+    cr_expect(eq(int, -1, dict_insert(dict, "KEY4", 4, NULL)));
+    cr_expect(eq(int, 0, evicted));
+    cr_expect(eq(int, 4, DICT_SIZE(dict)));
+    budget = -1;
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY4", 4, NULL)));
+    cr_expect(eq(int, 1, evicted));
+    cr_expect(eq(int, 4, DICT_SIZE(dict)));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_cache, failed_eviction_is_reported)
+{
+    int budget = -1;
+    dict_allocator_t allocator = { budget_allocate, budget_reallocate,
+        budget_release, &budget, NULL, NULL };
+    dict_t *dict = dict_ctor_with_allocator(&allocator);
+    dict_t *clone = NULL;
+
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY0", 4, NULL)));
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY1", 4, NULL)));
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY2", 4, NULL)));
+    clone = dict_clone(dict);
+    cr_assert(ne(ptr, NULL, clone));
+    cr_assert(eq(int, 0, dict_enable_cache(clone, 0, 0, NULL, NULL)));
+    budget = 0;
+    cr_expect(eq(int, -1, dict_enable_cache(clone, 1, 0, NULL, NULL)));
+    cr_expect(eq(int, 3, DICT_SIZE(clone)));
+    budget = -1;
+    cr_expect(eq(int, 0, dict_enable_cache(clone, 1, 0, NULL, NULL)));
+    cr_expect(eq(int, 1, DICT_SIZE(clone)));
+    cr_expect(eq(int, 3, DICT_SIZE(dict)));
+    dict_dtor(clone, NULL);
+    dict_dtor(dict, NULL);
+}
@@ -0,0 +1,152 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_clone.c
+** File description:
+** Unit tests for the dict copy-on-write clone.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+#include "tests_helpers.h"
+
+#define KEYS_COUNT 100
+
+Test(dict_clone, snapshot_is_isolated)
+{
+    dict_t *dict = make_index_dict(KEYS_COUNT);
+    dict_t *clone = dict_clone(dict);
+    dict_stats_t stats = { 0 };
+
+    cr_assert(ne(ptr, NULL, clone));
+    cr_expect(eq(ptr, dict->buckets, clone->buckets));
+    cr_expect(eq(int, KEYS_COUNT, DICT_SIZE(clone)));
+    cr_expect(eq(int, 0, dict_delete(dict, "KEY1", 4, free_key)));
+    cr_expect(eq(int, 0, dict_insert(dict, strdup("NEW"), 3, NULL)));
+    cr_expect(eq(int, 0, dict_has_key(dict, "KEY1", 4)));
+    cr_expect(eq(int, 1, dict_has_key(clone, "KEY1", 4)));
+    cr_expect(eq(int, 0, dict_has_key(clone, "NEW", 3)));
+    cr_expect(eq(int, KEYS_COUNT, DICT_SIZE(clone)));
+    cr_expect(eq(int, KEYS_COUNT, DICT_SIZE(dict)));
+    dict_stats(dict, &stats);
+    cr_expect(eq(int, 1, stats.shared));
+    cr_expect(le(u64, stats.cow_copies, 2));
+    dict_stats(clone, &stats);
+    cr_expect(eq(u64, 0, stats.cow_copies));
+    released = 0;
+    dict_dtor(dict, free_key);
+    cr_expect(eq(int, 1, released));
+    cr_expect(eq(int, 1, dict_has_key(clone, "KEY2", 4)));
+    dict_dtor(clone, free_key);
+    cr_expect(eq(int, KEYS_COUNT + 1, released));
+}
+
+Test(dict_clone, both_sides_write_and_resize)
+{
+    int index = 0;
+    dict_t *dict = make_index_dict(KEYS_COUNT);
+    dict_t *clone = dict_clone(dict);
+    dict_t *second = NULL;
+    char key[16] = { 0 };
+
+    for (; index < KEYS_COUNT / 2; ++index) {
+        snprintf(key, sizeof(key), "KEY%d", index);
+        cr_expect(eq(int, 0, dict_delete(clone, key, strlen(key), free_key)));
+    }
+    second = dict_clone(clone);
+    for (index = 0; index < KEYS_COUNT; ++index) {
+        snprintf(key, sizeof(key), "MORE%d", index);
+        dict_insert(dict, strdup(key), strlen(key), NULL);
+    }
+    cr_expect(eq(int, KEYS_COUNT * 2, DICT_SIZE(dict)));
+    cr_expect(eq(int, KEYS_COUNT / 2, DICT_SIZE(clone)));
+    cr_expect(eq(int, KEYS_COUNT / 2, DICT_SIZE(second)));
+    cr_expect(eq(int, 1, dict_has_key(dict, "KEY0", 4)));
+    cr_expect(eq(int, 0, dict_has_key(clone, "KEY0", 4)));
+    cr_expect(eq(int, 1, dict_has_key(second, "KEY99", 5)));
+    released = 0;
+    dict_dtor(clone, free_key);
+    dict_dtor(dict, free_key);
+    cr_expect(eq(int, KEYS_COUNT, released));
+    dict_dtor(second, free_key);
+    cr_expect(eq(int, KEYS_COUNT * 2, released));
+}
+
+/**
+ * @brief Returns whether the node of the key in the buckets was referenced by
+ * a cache lookup.
+ */
+static
+int is_referenced(const dict_t *dict, bucket_t **buckets, const char *key)
+{
+    const bucket_t *node = dict_bucket_find(buckets[DICT_BUCKET_IDX(
+        dict_hash_key(dict, key, strlen(key)).value, dict->size)], key,
+        strlen(key));
+
+    cr_assert(ne(ptr, NULL, node));
+    return 0 != (node->flags & DICT_BUCKET_REFERENCED);
+}
+
+Test(dict_clone, lookups_leave_the_snapshot_untouched)
+{
+    dict_t *dict = make_index_dict(KEYS_COUNT);
+    dict_t *clone = NULL;
+    bucket_t **snapshot = NULL;
+    uint64_t index = 0;
+
+    cr_assert(eq(int, 0, dict_enable_cache(dict, 2 * KEYS_COUNT, 0, NULL,
+        NULL)));
+    clone = dict_clone(dict);
+    cr_assert(ne(ptr, NULL, clone));
+    snapshot = dict->shared->buckets;
+    cr_assert(eq(int, 0, dict_get(clone, "KEY1", 4, NULL)));
+    cr_assert(eq(int, 0, dict_get(dict, "KEY2", 4, NULL)));
+    cr_expect(eq(int, 0, is_referenced(dict, snapshot, "KEY1")));
+    cr_expect(eq(int, 0, is_referenced(dict, snapshot, "KEY2")));
+    index = DICT_BUCKET_IDX(dict_hash_key(dict, "KEY2", 4).value, dict->size);
+    cr_assert(eq(int, 0, dict_cow_bucket(dict, index)));
+    cr_assert(eq(int, 0, dict_get(dict, "KEY2", 4, NULL)));
+    cr_expect(eq(int, 1, is_referenced(dict, dict->buckets, "KEY2")));
+    cr_expect(eq(int, 0, is_referenced(dict, snapshot, "KEY2")));
+    dict_dtor(clone, NULL);
+    dict_dtor(dict, free_key);
+}
+
+/** The number of values released by `free_value`. */
+static int freed = 0;
+
+/**
+ * @brief Releases a pair whose key and value are both allocated, counting the
+ * released values.
+ */
+static
+void free_value(char *key, void *value)
+{
+    free(key);
+    free(value);
+    ++freed;
+}
+
+Test(dict_clone, entry_slot_values_are_released)
+{
+    dict_t *dict = dict_ctor();
+    dict_t *clone = NULL;
+    void **slot = NULL;
+    int inserted = 1;
+
+    cr_assert(eq(int, 0, dict_insert(dict, strdup("KEY"), 3, malloc(16))));
+    clone = dict_clone(dict);
+    cr_assert(ne(ptr, NULL, clone));
+    slot = dict_entry(clone, "KEY", 3, &inserted);
+    cr_assert(ne(ptr, NULL, slot));
+    cr_expect(eq(int, 0, inserted));
+    *slot = malloc(16);
+    freed = 0;
+    dict_dtor(clone, free_value);
+    cr_expect(eq(int, 1, freed));
+    dict_dtor(dict, free_value);
+    cr_expect(eq(int, 2, freed));
+}
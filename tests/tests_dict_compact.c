@@ -0,0 +1,177 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_compact.c
+** File description:
+** Unit tests for the dict compaction.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+#include "tests_helpers.h"
+
+#define KEYS_COUNT 1000
+
+static
+void delete_index(dict_t *dict, uintptr_t index, free_pair_t free_pair)
+{
+    char key[16] = { 0 };
+
+    snprintf(key, sizeof(key), "KEY%lu", (unsigned long) index);
+    dict_delete(dict, key, strlen(key), free_pair);
+}
+
+/**
+ * @brief Builds a dict fragmented by deletions, holding the odd indexes.
+ */
+static
+dict_t *make_dict(void)
+{
+    dict_t *dict = make_index_dict(KEYS_COUNT);
+    uintptr_t index = 0;
+
+    for (; index < KEYS_COUNT; index += 2)
+        delete_index(dict, index, free_key);
+    return dict;
+}
+
+/**
+ * @brief Checks that every bucket is laid out contiguously, in order.
+ */
+static
+int is_packed(const dict_t *dict)
+{
+    const bucket_t *node = NULL;
+    uint64_t index = 0;
+
+    for (; index < dict->size; ++index)
+        for (node = dict->buckets[index]; NULL != node; node = node->next)
+            if (0 == (node->flags & DICT_BUCKET_PACKED) || \
+                (NULL != node->next && node + 1 != node->next))
+                return 0;
+    return 1;
+}
+
+Test(dict_compact, full_pass_packs_every_node)
+{
+    dict_t *dict = make_dict();
+    uintptr_t index = 0;
+    int64_t reclaimed = dict_compact(dict, 0);
+
+    cr_assert(eq(i64, (int64_t) ((dict->items + dict->size) * \
+        sizeof(bucket_t)), reclaimed));
+    cr_assert(eq(ptr, NULL, dict->compaction));
+    cr_assert(eq(int, 1, is_packed(dict)));
+    cr_assert(eq(ptr, dict->packs->nodes, dict->buckets[0]));
+    cr_assert(eq(u64, sizeof(dict_pack_t) + (dict->items + dict->size) * \
+        sizeof(bucket_t), dict->packs->bytes));
+    for (; index < KEYS_COUNT; ++index)
+        cr_assert(eq(int, index % 2, has_index(dict, index)));
+    released = 0;
+    dict_dtor(dict, free_key);
+    cr_assert(eq(int, KEYS_COUNT / 2, released));
+}
+
+Test(dict_compact, packed_nodes_survive_mutations)
+{
+    dict_t *dict = make_dict();
+    uintptr_t index = 0;
+
+    dict_compact(dict, 0);
+    for (index = 1; index < KEYS_COUNT; index += 4)
+        delete_index(dict, index, free_key);
+    for (index = 0; index < KEYS_COUNT; index += 2)
+        insert_index(dict, index);
+    for (index = 0; index < KEYS_COUNT; ++index)
+        cr_assert(eq(int, 1 != index % 4, has_index(dict, index)));
+    dict_clear(dict, free_key);
+    cr_assert(eq(u64, 0, dict->items));
+    dict_dtor(dict, free_key);
+}
+
+Test(dict_compact, second_pass_releases_the_first_packs)
+{
+    dict_t *dict = make_dict();
+    uint64_t first = 0;
+
+    dict_compact(dict, 0);
+    first = dict->packs->bytes;
+    cr_assert(eq(i64, (int64_t) first, dict_compact(dict, 0)));
+    cr_assert(eq(ptr, NULL, dict->packs->next));
+    cr_assert(eq(int, 1, is_packed(dict)));
+    dict_dtor(dict, free_key);
+}
+
+Test(dict_compact, incremental_pass_moves_within_budget)
+{
+    dict_t *dict = make_dict();
+    uintptr_t index = 0;
+    int steps = 0;
+
+    dict_compact(dict, 0);
+    do {
+        cr_assert(ge(i64, dict_compact(dict, 64), 0));
+        cr_assert(le(u64, dict->packs->bytes,
+            sizeof(dict_pack_t) + 64 * sizeof(bucket_t)));
+        ++steps;
+    } while (NULL != dict->compaction);
+    cr_assert(gt(int, steps, 1));
+    for (; index < KEYS_COUNT; ++index)
+        cr_assert(eq(int, index % 2, has_index(dict, index)));
+    dict_dtor(dict, free_key);
+}
+
+Test(dict_compact, resize_restarts_the_pass)
+{
+    dict_t *dict = make_dict();
+    uintptr_t index = 0;
+
+    dict_compact(dict, 16);
+    cr_assert(ne(ptr, NULL, dict->compaction));
+    for (index = KEYS_COUNT; index < 4 * KEYS_COUNT; ++index)
+        cr_assert(eq(int, 0, insert_index(dict, index)));
+    while (0 <= dict_compact(dict, 128) && NULL != dict->compaction)
+        continue;
+    cr_assert(eq(int, 1, is_packed(dict)));
+    for (index = 0; index < 4 * KEYS_COUNT; ++index)
+        cr_assert(eq(int, index >= KEYS_COUNT || index % 2,
+            has_index(dict, index)));
+    dict_dtor(dict, free_key);
+}
+
+Test(dict_compact, clone_keeps_its_nodes)
+{
+    dict_t *dict = make_dict();
+    dict_t *clone = NULL;
+    uintptr_t index = 0;
+
+    dict_compact(dict, 0);
+    clone = dict_clone(dict);
+    for (index = 1; index < KEYS_COUNT; index += 4)
+        delete_index(dict, index, NULL);
+    insert_index(clone, 0);
+    cr_assert(ge(i64, dict_compact(clone, 0), 0));
+    cr_assert(ge(i64, dict_compact(dict, 0), 0));
+    dict_dtor(dict, NULL);
+    for (index = 1; index < KEYS_COUNT; index += 2)
+        cr_assert(eq(int, 1, has_index(clone, index)));
+    cr_assert(eq(int, 1, has_index(clone, 0)));
+    dict_dtor(clone, free_key);
+}
+
+Test(dict_compact, snapshot_keeps_the_retired_packs)
+{
+    dict_t *dict = make_dict();
+    dict_t *clone = NULL;
+
+    dict_compact(dict, 0);
+    clone = dict_clone(dict);
+    cr_assert(eq(int, 0, dict_resize_to(dict, 64)));
+    cr_assert(ge(i64, dict_compact(dict, 0), 0));
+    dict_dtor(clone, NULL);
+    cr_assert(eq(int, 1, has_index(dict, 1)));
+    dict_dtor(dict, free_key);
+}
@@ -0,0 +1,117 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_expiry.c
+** File description:
+** Unit tests for the dict entries expiry.
+*/
+
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+#include "tests_helpers.h"
+
+static uint64_t fake_now = 0;
+
+static
+uint64_t fake_clock(void)
+{
+    return fake_now;
+}
+
+static
+void count_released(__attribute__((unused)) char *key,
+    __attribute__((unused)) void *value)
+{
+    ++released;
+}
+
+Test(dict_expiry, lazy_removal)
+{
+    dict_t *dict = dict_ctor();
+
+    fake_now = 100;
+    released = 0;
+    cr_expect(eq(int, -1, dict_insert_ttl(dict, "KEY0", 4, NULL, 10)));
+    cr_assert(eq(int, 0, dict_enable_expiry(dict, fake_clock,
+        count_released)));
+    cr_expect(eq(int, 0, dict_insert_ttl(dict, "KEY0", 4, NULL, 10)));
+    cr_expect(eq(int, 0, dict_insert_ttl(dict, "KEY1", 4, NULL, 0)));
+    cr_expect(eq(int, 1, dict_has_key(dict, "KEY0", 4)));
+    fake_now = 110;
+    cr_expect(eq(int, 0, dict_has_key(dict, "KEY0", 4)));
+    cr_expect(eq(int, 1, dict_has_key(dict, "KEY1", 4)));
+    cr_expect(eq(int, 1, released));
+    cr_expect(eq(int, 1, DICT_SIZE(dict)));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_expiry, reinsert_expired_key)
+{
+    dict_t *dict = dict_ctor();
+
+    fake_now = 0;
+    released = 0;
+    dict_enable_expiry(dict, fake_clock, count_released);
+    cr_expect(eq(int, 0, dict_insert_ttl(dict, "KEY0", 4, NULL, 5)));
+    cr_expect(eq(int, -1, dict_insert(dict, "KEY0", 4, NULL)));
+    fake_now = 5;
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY0", 4, NULL)));
+    cr_expect(eq(int, 1, released));
+    cr_expect(eq(int, 0, dict_set_ttl(dict, "KEY0", 4, 1)));
+    cr_expect(eq(int, -1, dict_set_ttl(dict, "KEY1", 4, 1)));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_expiry, incremental_step)
+{
+    uint64_t removed = 0;
+    uint64_t steps = 0;
+    dict_t *dict = dict_ctor();
+    dict_stats_t stats = { 0 };
+    char *KEYS[] = { "KEY0", "KEY1", "KEY2", "KEY3", "KEY4", "KEY5" };
+
+    fake_now = 0;
+    released = 0;
+    dict_enable_expiry(dict, fake_clock, count_released);
+    for (; steps < 6; ++steps)
+        dict_insert_ttl(dict, KEYS[steps], 4, NULL, steps < 4 ? 1 : 0);
+    fake_now = 1;
+    for (steps = 0; steps * 4 < dict->size; ++steps)
+        removed += dict_expire_step(dict, 4);
+    cr_expect(eq(u64, 4, removed));
+    cr_expect(eq(int, 4, released));
+    cr_expect(eq(int, 2, DICT_SIZE(dict)));
+    cr_expect(eq(u64, 0, dict_expire_step(dict, 1000)));
+    dict_stats(dict, &stats);
+    cr_expect(eq(int, 1, stats.expiry_enabled));
+    cr_expect(eq(u64, 4, stats.expired));
+    dict_disable_expiry(dict);
+    cr_expect(eq(u64, 0, dict_expire_step(dict, 1000)));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_expiry, dates_only_cost_the_expiring_dicts)
+{
+    dict_t *dict = dict_ctor_with_value_size(sizeof(uint64_t));
+    uint64_t count = 42;
+    uint64_t node_size = DICT_NODE_SIZE(dict);
+    void *value = NULL;
+
+    fake_now = 0;
+    cr_expect(eq(sz, 3 * sizeof(void *) + sizeof(uint64_t),
+        sizeof(bucket_t)));
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY0", 4, &count)));
+    cr_expect(eq(int, -1, dict_enable_expiry(dict, fake_clock, NULL)));
+    cr_expect(eq(int, 0, dict_delete(dict, "KEY0", 4, NULL)));
+    cr_assert(eq(int, 0, dict_enable_expiry(dict, fake_clock, NULL)));
+    cr_expect(eq(u64, node_size + sizeof(uint64_t), DICT_NODE_SIZE(dict)));
+    cr_expect(eq(int, 0, dict_insert_ttl(dict, "KEY0", 4, &count, 5)));
+    cr_expect(eq(int, 0, dict_get(dict, "KEY0", 4, &value)));
+    cr_expect(eq(u64, 42, *(uint64_t *) value));
+    fake_now = 5;
+    cr_expect(eq(int, 0, dict_has_key(dict, "KEY0", 4)));
+    dict_disable_expiry(dict);
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY1", 4, &count)));
+    cr_expect(eq(int, 0, dict_enable_expiry(dict, fake_clock, NULL)));
+    dict_dtor(dict, NULL);
+}
@@ -0,0 +1,96 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_filter.c
+** File description:
+** Unit tests for the dict membership filter.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+#include "tests_helpers.h"
+
+#define KEYS_COUNT 1000
+
+static
+char *make_prefixed_key(const char *prefix, int index)
+{
+    char *key = malloc(32);
+
+    snprintf(key, 32, "%s%d", prefix, index);
+    return key;
+}
+
+Test(dict_filter, no_false_negatives)
+{
+    int index = 0;
+    dict_t *dict = dict_ctor();
+    char key[32] = { 0 };
+
+    cr_assert(eq(int, 0, dict_enable_filter(dict)));
+    for (; index < KEYS_COUNT; ++index) {
+        snprintf(key, sizeof(key), "KEY%d", index);
+        cr_expect(eq(int, 0, dict_insert(dict, make_prefixed_key("KEY", index),
+            strlen(key), NULL)));
+    }
+    for (index = 0; index < KEYS_COUNT; ++index) {
+        snprintf(key, sizeof(key), "KEY%d", index);
+        cr_expect(eq(int, 1, dict_has_key(dict, key, strlen(key))));
+    }
+    cr_expect(eq(int, -1, dict_insert(dict, "KEY0", 4, NULL)));
+    dict_dtor(dict, free_key);
+}
+
+Test(dict_filter, rejects_misses)
+{
+    int index = 0;
+    dict_t *dict = dict_ctor();
+    dict_stats_t stats = { 0 };
+    char key[32] = { 0 };
+
+    for (; index < KEYS_COUNT; ++index) {
+        snprintf(key, sizeof(key), "KEY%d", index);
+        dict_insert(dict, make_prefixed_key("KEY", index), strlen(key), NULL);
+    }
+    cr_assert(eq(int, 0, dict_enable_filter(dict)));
+    for (index = 0; index < KEYS_COUNT; ++index) {
+        snprintf(key, sizeof(key), "MISS%d", index);
+        cr_expect(eq(int, 0, dict_has_key(dict, key, strlen(key))));
+    }
+    dict_stats(dict, &stats);
+    cr_expect(eq(int, 1, stats.filter_enabled));
+    cr_expect(eq(u64, KEYS_COUNT, stats.filter_lookups));
+    cr_expect(eq(u64, KEYS_COUNT, stats.filter_rejects + \
+        stats.filter_false_positives));
+    cr_expect(lt(u64, stats.filter_false_positives, KEYS_COUNT / 20));
+    cr_expect(gt(u64, stats.filter_bytes, 0));
+    cr_expect(lt(dbl, stats.filter_fpr, 0.05));
+    dict_disable_filter(dict);
+    dict_stats(dict, &stats);
+    cr_expect(eq(int, 0, stats.filter_enabled));
+    dict_dtor(dict, free_key);
+}
+
+Test(dict_filter, rebuilt_on_delete)
+{
+    int index = 0;
+    dict_t *dict = dict_ctor();
+    char key[32] = { 0 };
+
+    dict_enable_filter(dict);
+    for (; index < KEYS_COUNT; ++index) {
+        snprintf(key, sizeof(key), "KEY%d", index);
+        dict_insert(dict, make_prefixed_key("KEY", index), strlen(key), NULL);
+    }
+    for (index = 0; index < KEYS_COUNT - 1; ++index) {
+        snprintf(key, sizeof(key), "KEY%d", index);
+        cr_expect(eq(int, 0, dict_delete(dict, key, strlen(key), free_key)));
+    }
+    cr_expect(le(u64, dict->filter->stale, dict->items));
+    cr_expect(eq(int, 1, dict_has_key(dict, "KEY999", 6)));
+    cr_expect(eq(int, 0, dict_has_key(dict, "KEY0", 4)));
+    cr_expect(eq(int, -1, dict_delete(dict, "KEY0", 4, free_key)));
+    dict_dtor(dict, free_key);
+}
@@ -0,0 +1,28 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_get.c
+** File description:
+** Unit tests for the dict get and has_key functions.
+*/
+
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+
+Test(dict_get, passing)
+{
+    dict_t *dict = dict_ctor();
+    char *my_value = "Hello, World !";
+    void *value = NULL;
+
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY0", 4, (void *) my_value)));
+    cr_expect(eq(int, 0, dict_insert(dict, "KEY1", 4, NULL)));
+    cr_expect(eq(int, 0, dict_get(dict, "KEY0", 4, &value)));
+    cr_expect(eq(ptr, (void *) my_value, value));
+    cr_expect(eq(int, 0, dict_get(dict, "KEY1", 4, &value)));
+    cr_expect(eq(ptr, NULL, value));
+    cr_expect(eq(int, -1, dict_get(dict, "KEY2", 4, &value)));
+    cr_expect(eq(int, 1, dict_has_key(dict, "KEY0", 4)));
+    cr_expect(eq(int, 0, dict_has_key(dict, "KEY2", 4)));
+    dict_dtor(dict, NULL);
+}
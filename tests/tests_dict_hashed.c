@@ -0,0 +1,86 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_hashed.c
+** File description:
+** Unit tests for the precomputed hash functions.
+*/
+
+#include <string.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+
+Test(dict_hashed, shared_across_dicts)
+{
+    dict_t *users = dict_ctor();
+    dict_t *features = dict_ctor();
+    dict_hash_t key_hash = dict_hash_key(users, "KEY", 3);
+    void *value = NULL;
+    int inserted = 0;
+
+    cr_expect(eq(int, 0, dict_insert_hashed(users, "KEY", 3, key_hash,
+        (void *) 1)));
+    cr_expect(eq(int, -1, dict_insert_hashed(users, "KEY", 3, key_hash,
+        (void *) 1)));
+    *dict_entry_hashed(features, "KEY", 3, key_hash, &inserted) = (void *) 2;
+    cr_expect(eq(int, 1, inserted));
+    cr_expect(eq(int, 0, dict_get(users, "KEY", 3, &value)));
+    cr_expect(eq(u64, 1, (uintptr_t) value));
+    cr_expect(eq(int, 0, dict_get_hashed(features, "KEY", 3, key_hash,
+        &value)));
+    cr_expect(eq(u64, 2, (uintptr_t) value));
+    cr_expect(eq(int, 0, dict_delete_hashed(users, "KEY", 3, key_hash,
+        NULL)));
+    cr_expect(eq(int, 0, dict_has_key_hashed(users, "KEY", 3, key_hash)));
+    cr_expect(eq(int, 1, dict_has_key_hashed(features, "KEY", 3, key_hash)));
+    dict_dtor(users, NULL);
+    dict_dtor(features, NULL);
+}
+
+Test(dict_hashed, rejects_other_seed)
+{
+    dict_t *dict = dict_ctor();
+    dict_t *seeded = dict_ctor();
+    dict_hash_t key_hash = dict_hash_key(dict, "KEY", 3);
+
+    cr_expect(eq(int, 0, dict_set_seed(seeded, 42)));
+    cr_expect(eq(int, 0, dict_insert(seeded, "KEY", 3, NULL)));
+    cr_expect(eq(int, -1, dict_set_seed(seeded, 0)));
+    cr_expect(eq(int, 1, dict_has_key(seeded, "KEY", 3)));
+    cr_expect(eq(int, 0, dict_has_key_hashed(seeded, "KEY", 3, key_hash)));
+    cr_expect(eq(int, -1, dict_insert_hashed(seeded, "NEW", 3,
+        dict_hash_key(dict, "NEW", 3), NULL)));
+    cr_expect(eq(ptr, NULL, dict_entry_hashed(seeded, "KEY", 3, key_hash,
+        NULL)));
+    cr_expect(eq(int, -1, dict_delete_hashed(seeded, "KEY", 3, key_hash,
+        NULL)));
+    cr_expect(eq(int, 0, dict_insert_hashed(seeded, "NEW", 3,
+        dict_hash_key(seeded, "NEW", 3), NULL)));
+    cr_expect(eq(int, 2, DICT_SIZE(seeded)));
+    dict_dtor(dict, NULL);
+    dict_dtor(seeded, NULL);
+}
+
+Test(dict_hashed, batch_matches_single)
+{
+    dict_t *dict = dict_ctor();
+    const char *keys[] = { "", "a", "ab", "abc", "abcd", "abcde", "abcdef",
+        "abcdefg", "abcdefgh", "abcdefghi", "abcdefghij", "abcdefghijk",
+        "abcdefghijkl", "abcdefghijklm", "abcdefghijklmn", "abcdefghijklmno",
+        "abcdefghijklmnop", "abcdefghijklmnopq" };
+    uint64_t lengths[18] = { 0 };
+    dict_hash_t hashes[18];
+    dict_hash_t single;
+    uint64_t index = 0;
+
+    dict_set_seed(dict, 7);
+    for (; index < 18; ++index)
+        lengths[index] = strlen(keys[index]);
+    dict_hash_keys(dict, keys, lengths, 18, hashes);
+    for (index = 0; index < 18; ++index) {
+        single = dict_hash_key(dict, keys[index], lengths[index]);
+        cr_expect(eq(u32, single.value, hashes[index].value));
+        cr_expect(eq(u32, 7, hashes[index].seed));
+    }
+    dict_dtor(dict, NULL);
+}
@@ -0,0 +1,70 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_huge.c
+** File description:
+** Unit tests for the huge page allocator of the large arrays.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+#include "tests_helpers.h"
+
+#define KEYS_COUNT 20000
+
+Test(dict_huge_allocator, dict)
+{
+    dict_huge_pages_t huge = { 4096, 1, DICT_NUMA_INTERLEAVE, 1, 0, 0, 0 };
+    dict_allocator_t allocator = { 0 };
+    dict_t *dict = NULL;
+    dict_t *clone = NULL;
+    char *key = NULL;
+    int index = 0;
+
+    dict_huge_allocator(&huge, &allocator);
+    dict = dict_ctor_with_allocator(&allocator);
+    cr_assert(ne(ptr, NULL, dict));
+    for (; index < KEYS_COUNT; ++index) {
+        key = make_key(index);
+        cr_expect(eq(int, 0, dict_insert(dict, key, strlen(key), NULL)));
+    }
+    cr_expect(lt(u64, 0, huge.mapped));
+    cr_expect(eq(int, 0, (uintptr_t) dict->buckets % DICT_HUGE_PAGE_SIZE));
+    clone = dict_clone(dict);
+    cr_expect(eq(int, 0, dict_delete(clone, "KEY42", 5, NULL)));
+    cr_expect(eq(int, 1, dict_has_key(dict, "KEY42", 5)));
+    cr_expect(eq(int, 0, dict_has_key(clone, "KEY42", 5)));
+    dict_dtor(clone, NULL);
+    for (index = 0; index < KEYS_COUNT - 1; ++index) {
+        key = make_key(index);
+        cr_expect(eq(int, 0, dict_delete(dict, key, strlen(key), free_key)));
+        free(key);
+    }
+    cr_expect(eq(int, 1, dict_has_key(dict, "KEY19999", 8)));
+    dict_dtor(dict, free_key);
+}
+
+Test(dict_huge_allocator, dict32_unsupported_node)
+{
+    dict_huge_pages_t huge = { 4096, 0, DICT_NUMA_BIND, (uint64_t) 1 << 63,
+        0, 0, 0 };
+    dict_allocator_t allocator = { 0 };
+    dict32_t *dict = NULL;
+    char *key = NULL;
+    int index = 0;
+
+    dict_huge_allocator(&huge, &allocator);
+    dict = dict32_ctor(&allocator);
+    cr_assert(ne(ptr, NULL, dict));
+    for (; index < KEYS_COUNT; ++index) {
+        key = make_key(index);
+        cr_expect(eq(int, 0, dict32_insert(dict, key, strlen(key), NULL)));
+    }
+    cr_expect(lt(u64, 0, huge.mapped));
+    cr_expect(eq(u64, huge.mapped, huge.numa_failures));
+    cr_expect(eq(int, 1, dict32_has_key(dict, "KEY12345", 8)));
+    dict32_dtor(dict, free_key);
+}
@@ -0,0 +1,188 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_incr.c
+** File description:
+** Unit tests for the counting dicts.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+
+#define WORDS_COUNT 50
+#define TOKENS_COUNT 20000
+
+static char words[WORDS_COUNT][16] = { { 0 } };
+
+/**
+ * @brief Fills a token stream where the word `i` appears `i + 1` times per
+ * `WORDS_COUNT * (WORDS_COUNT + 1) / 2` tokens.
+ */
+static
+uint64_t make_tokens(char **tokens, uint64_t *lengths, uint64_t *expected)
+{
+    uint64_t count = 0;
+    int word = 0;
+    int repeat = 0;
+
+    for (word = 0; word < WORDS_COUNT; ++word)
+        snprintf(words[word], sizeof(words[word]), "word%d", word);
+    while (count < TOKENS_COUNT)
+        for (word = 0; word < WORDS_COUNT; ++word)
+            for (repeat = 0; repeat <= word && count < TOKENS_COUNT;
+                ++repeat) {
+                tokens[count] = words[word];
+                lengths[count] = strlen(words[word]);
+                ++expected[word];
+                ++count;
+            }
+    return count;
+}
+
+static
+uint64_t get_count(dict_t *dict, int word)
+{
+    void *count = NULL;
+
+    if (-1 == dict_get(dict, words[word], strlen(words[word]), &count))
+        return 0;
+    return *(uint64_t *) count;
+}
+
+Test(dict_incr, counts_and_adds_deltas)
+{
+    dict_t *dict = dict_ctor_with_value_size(sizeof(uint64_t));
+    void *count = NULL;
+
+    cr_assert(eq(int, 0, dict_incr(dict, "apple", 5, 1, NULL)));
+    cr_assert(eq(int, 0, dict_incr(dict, "apple", 5, 1, NULL)));
+    cr_assert(eq(int, 0, dict_incr(dict, "pear", 4, 10, NULL)));
+    cr_assert(eq(int, 0, dict_incr(dict, "apple", 5, 3, NULL)));
+    cr_assert(eq(u64, 2, dict->items));
+    cr_assert(eq(int, 0, dict_get(dict, "apple", 5, &count)));
+    cr_assert(eq(u64, 5, *(uint64_t *) count));
+    cr_assert(eq(int, 0, dict_get(dict, "pear", 4, &count)));
+    cr_assert(eq(u64, 10, *(uint64_t *) count));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_incr, rejects_pointer_values)
+{
+    dict_t *dict = dict_ctor();
+    char *keys[1] = { "apple" };
+    uint64_t lengths[1] = { 5 };
+
+    cr_assert(eq(int, -1, dict_incr(dict, "apple", 5, 1, NULL)));
+    cr_assert(eq(int, -1, dict_incr_many(dict, keys, lengths, 1, 1, NULL)));
+    cr_assert(eq(u64, 0, dict->items));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_incr, batch_matches_single_increments)
+{
+    static char *tokens[TOKENS_COUNT];
+    static uint64_t lengths[TOKENS_COUNT];
+    uint64_t expected[WORDS_COUNT] = { 0 };
+    uint64_t count = make_tokens(tokens, lengths, expected);
+    dict_t *dict = dict_ctor_with_value_size(sizeof(uint64_t));
+    int word = 0;
+
+    cr_assert(eq(int, 0, dict_incr_many(dict, tokens, lengths, count, 2,
+        NULL)));
+    cr_assert(eq(u64, WORDS_COUNT, dict->items));
+    for (; word < WORDS_COUNT; ++word)
+        cr_assert(eq(u64, 2 * expected[word], get_count(dict, word)));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_incr, merge_adds_partial_counts)
+{
+    dict_t *dict = dict_ctor_with_value_size(sizeof(uint64_t));
+    dict_t *partial = dict_ctor_with_value_size(sizeof(uint64_t));
+    void *count = NULL;
+
+    dict_incr(dict, "apple", 5, 2, NULL);
+    dict_incr(partial, "apple", 5, 3, NULL);
+    dict_incr(partial, "pear", 4, 1, NULL);
+    cr_assert(eq(int, 0, dict_incr_merge(dict, partial)));
+    cr_assert(eq(int, 0, dict_get(dict, "apple", 5, &count)));
+    cr_assert(eq(u64, 5, *(uint64_t *) count));
+    cr_assert(eq(int, 0, dict_get(dict, "pear", 4, &count)));
+    cr_assert(eq(u64, 1, *(uint64_t *) count));
+    cr_assert(eq(u64, 2, partial->items));
+    dict_dtor(partial, NULL);
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_incr, parallel_matches_serial)
+{
+    static char *tokens[TOKENS_COUNT];
+    static uint64_t lengths[TOKENS_COUNT];
+    uint64_t expected[WORDS_COUNT] = { 0 };
+    uint64_t count = make_tokens(tokens, lengths, expected);
+    dict_t *dict = dict_ctor_with_value_size(sizeof(uint64_t));
+    int word = 0;
+
+    dict_set_seed(dict, 1234);
+    cr_assert(eq(int, 0, dict_incr_parallel(dict, tokens, lengths, count,
+        4, NULL)));
+    cr_assert(eq(int, 0, dict_incr_parallel(dict, tokens, lengths, 3, 8,
+        NULL)));
+    for (; word < WORDS_COUNT; ++word)
+        cr_assert(eq(u64, expected[word] + (0 == word) + 2 * (1 == word),
+            get_count(dict, word)));
+    dict_dtor(dict, NULL);
+}
+
+/**
+ * @brief Checks that exactly the first occurrence of each word was flagged as
+ * inserted, the dict being empty before the count.
+ */
+static
+void assert_first_occurrences(char **tokens, uint64_t count,
+    const int *inserted)
+{
+    int seen[WORDS_COUNT] = { 0 };
+    uint64_t index = 0;
+    int word = 0;
+
+    for (; index < count; ++index) {
+        word = atoi(tokens[index] + 4);
+        cr_assert(eq(int, !seen[word], inserted[index]));
+        seen[word] = 1;
+    }
+}
+
+Test(dict_incr, reports_kept_keys)
+{
+    static char *tokens[TOKENS_COUNT];
+    static uint64_t lengths[TOKENS_COUNT];
+    static int inserted[TOKENS_COUNT];
+    uint64_t expected[WORDS_COUNT] = { 0 };
+    uint64_t count = make_tokens(tokens, lengths, expected);
+    dict_t *dict = dict_ctor_with_value_size(sizeof(uint64_t));
+    int kept = -1;
+
+    cr_assert(eq(int, 0, dict_incr(dict, "apple", 5, 1, &kept)));
+    cr_assert(eq(int, 1, kept));
+    cr_assert(eq(int, 0, dict_incr(dict, "apple", 5, 1, &kept)));
+    cr_assert(eq(int, 0, kept));
+    dict_dtor(dict, NULL);
+    dict = dict_ctor_with_value_size(sizeof(uint64_t));
+    cr_assert(eq(int, 0, dict_incr_many(dict, tokens, lengths, count, 1,
+        inserted)));
+    assert_first_occurrences(tokens, count, inserted);
+    dict_dtor(dict, NULL);
+    dict = dict_ctor_with_value_size(sizeof(uint64_t));
+    memset(inserted, 0xff, sizeof(inserted));
+    cr_assert(eq(int, 0, dict_incr_parallel(dict, tokens, lengths, count, 4,
+        inserted)));
+    assert_first_occurrences(tokens, count, inserted);
+    cr_assert(eq(u64, WORDS_COUNT, dict->items));
+    for (kept = 0; kept < WORDS_COUNT; ++kept)
+        cr_assert(eq(u64, expected[kept], get_count(dict, kept)));
+    dict_dtor(dict, NULL);
+}
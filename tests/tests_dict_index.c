@@ -0,0 +1,266 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_index.c
+** File description:
+** Unit tests for the ordered index of the dict.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+
+#define KEYS_COUNT 2000
+#define OPS_COUNT 20000
+
+static char pool[KEYS_COUNT][64];
+
+/**
+ * @brief Fills the key pool with paths sharing prefixes of various lengths,
+ * some longer than what an index node stores, some keys being the prefix of
+ * others.
+ */
+static
+void make_pool(void)
+{
+    static const char *segments[] = { "", "a/", "ab/",
+        "a-very-long-shared-segment/", "z" };
+    int index = 0;
+
+    for (; index < KEYS_COUNT; ++index)
+        snprintf(pool[index], sizeof(pool[index]), "/tenant/%d/%s%d",
+            index % 13, segments[index % 5], index / 65);
+}
+
+/**
+ * @brief Collects the keys given to the scan into a keys object with enough
+ * room, stopping once `limit` keys were seen, if not 0.
+ */
+typedef struct s_collected {
+    const char *keys[KEYS_COUNT];
+    uint64_t lengths[KEYS_COUNT];
+    uint64_t size;
+    uint64_t limit;
+} collected_t;
+
+static
+int collect(const char *key, uint64_t key_length,
+    __attribute__((unused)) void *value, void *ctx)
+{
+    collected_t *collected = (collected_t *) ctx;
+
+    collected->keys[collected->size] = key;
+    collected->lengths[collected->size++] = key_length;
+    return 0 != collected->limit && collected->size == collected->limit;
+}
+
+static
+int compare_keys(const void *lhs, const void *rhs)
+{
+    return strcmp(*(const char *const *) lhs, *(const char *const *) rhs);
+}
+
+/**
+ * @brief Checks the sorted keys of the dict against the sorted present keys
+ * of the pool.
+ */
+static
+void expect_sorted(const dict_t *dict, const int *present)
+{
+    const char *expected[KEYS_COUNT];
+    uint64_t count = 0;
+    dict_keys_t *keys = dict_get_sorted_keys(dict);
+    int index = 0;
+
+    cr_assert(ne(ptr, NULL, keys));
+    for (; index < KEYS_COUNT; ++index)
+        if (present[index])
+            expected[count++] = pool[index];
+    qsort(expected, count, sizeof(char *), compare_keys);
+    cr_assert(eq(u64, count, keys->size));
+    for (index = 0; (uint64_t) index < count; ++index)
+        cr_expect(eq(ptr, (void *) expected[index],
+            (void *) keys->keys[index]));
+    dict_free_keys(keys);
+}
+
+Test(dict_index, random_operations)
+{
+    dict_t *dict = dict_ctor();
+    int present[KEYS_COUNT] = { 0 };
+    int index = 0;
+    int op = 0;
+
+    make_pool();
+    srand(42);
+    for (index = 0; index < KEYS_COUNT; index += 3) {
+        dict_insert(dict, pool[index], strlen(pool[index]), pool[index]);
+        present[index] = 1;
+    }
+    cr_assert(eq(int, 0, dict_enable_index(dict)));
+    cr_expect(eq(int, 0, dict_enable_index(dict)));
+    expect_sorted(dict, present);
+    for (; op < OPS_COUNT; ++op) {
+        index = rand() % KEYS_COUNT;
+        if (rand() % 2)
+            cr_expect(eq(int, present[index] ? -1 : 0, dict_insert(dict,
+                pool[index], strlen(pool[index]), pool[index])));
+        else
+            cr_expect(eq(int, present[index] ? 0 : -1, dict_delete(dict,
+                pool[index], strlen(pool[index]), NULL)));
+        present[index] = dict_has_key(dict, pool[index],
+            strlen(pool[index]));
+        if (0 == op % 5000)
+            expect_sorted(dict, present);
+    }
+    expect_sorted(dict, present);
+    for (index = 0; index < KEYS_COUNT; ++index)
+        dict_delete(dict, pool[index], strlen(pool[index]), NULL);
+    cr_expect(eq(ptr, NULL, dict->index->root));
+    cr_expect(eq(u64, 0, dict->index->bytes));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_index, prefix_scan)
+{
+    dict_t *dict = dict_ctor();
+    collected_t collected = { { 0 }, { 0 }, 0, 0 };
+    const char *prefix = "/tenant/4/a";
+    uint64_t expected = 0;
+    int index = 0;
+
+    make_pool();
+    cr_assert(eq(int, 0, dict_enable_index(dict)));
+    for (; index < KEYS_COUNT; ++index) {
+        dict_insert(dict, pool[index], strlen(pool[index]), pool[index]);
+        expected += 0 == strncmp(pool[index], prefix, strlen(prefix));
+    }
+    cr_assert(eq(int, 0, dict_scan_prefix(dict, prefix, strlen(prefix),
+        collect, &collected)));
+    cr_expect(eq(u64, expected, collected.size));
+    for (index = 0; (uint64_t) index < collected.size; ++index) {
+        cr_expect(eq(int, 0, strncmp(collected.keys[index], prefix,
+            strlen(prefix))));
+        if (0 < index)
+            cr_expect(lt(int, 0, strcmp(collected.keys[index],
+                collected.keys[index - 1])));
+    }
+    collected.size = 0;
+    dict_scan_prefix(dict, "/tenant/4/a-very-long-shared-segment/3", 38,
+        collect, &collected);
+    cr_expect(eq(u64, 2, collected.size));
+    cr_expect(eq(str, "/tenant/4/a-very-long-shared-segment/3",
+        (char *) collected.keys[0]));
+    cr_expect(eq(str, "/tenant/4/a-very-long-shared-segment/30",
+        (char *) collected.keys[1]));
+    collected.size = 0;
+    dict_scan_prefix(dict, "/tenant/4/b", 11, collect, &collected);
+    cr_expect(eq(u64, 0, collected.size));
+    collected.size = 0;
+    collected.limit = 5;
+    dict_scan_prefix(dict, "", 0, collect, &collected);
+    cr_expect(eq(u64, 5, collected.size));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_index, clones_start_without_index)
+{
+    dict_t *dict = dict_ctor();
+    dict_t *clone = NULL;
+    collected_t collected = { { 0 }, { 0 }, 0, 0 };
+
+    cr_assert(eq(int, 0, dict_enable_index(dict)));
+    cr_assert(eq(int, 0, dict_insert(dict, "/tenant/1/a", 11, NULL)));
+    cr_assert(eq(int, 0, dict_insert(dict, "/tenant/2/a", 11, NULL)));
+    clone = dict_clone(dict);
+    cr_assert(ne(ptr, NULL, clone));
+    cr_expect(eq(int, -1, dict_scan_prefix(clone, "/tenant/1/", 10, collect,
+        &collected)));
+    cr_assert(eq(int, 0, dict_enable_index(clone)));
+    cr_expect(eq(int, 0, dict_scan_prefix(clone, "/tenant/1/", 10, collect,
+        &collected)));
+    cr_expect(eq(u64, 1, collected.size));
+    dict_dtor(clone, NULL);
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_index, range_scan)
+{
+    dict_t *dict = dict_ctor();
+    collected_t collected = { { 0 }, { 0 }, 0, 0 };
+    const char *from = "/tenant/10/ab/";
+    const char *to = "/tenant/11/a/3";
+    uint64_t expected = 0;
+    int index = 0;
+
+    make_pool();
+    cr_expect(eq(int, -1, dict_scan_range(dict, NULL, 0, NULL, 0, collect,
+        &collected)));
+    cr_expect(eq(ptr, NULL, dict_get_sorted_keys(dict)));
+    cr_assert(eq(int, 0, dict_enable_index(dict)));
+    for (; index < KEYS_COUNT; ++index) {
+        dict_insert(dict, pool[index], strlen(pool[index]), pool[index]);
+        expected += 0 <= strcmp(pool[index], from) && \
+            0 > strcmp(pool[index], to);
+    }
+    cr_assert(eq(int, 0, dict_scan_range(dict, from, strlen(from), to,
+        strlen(to), collect, &collected)));
+    cr_expect(eq(u64, expected, collected.size));
+    for (index = 0; (uint64_t) index < collected.size; ++index) {
+        cr_expect(le(int, 0, strcmp(collected.keys[index], from)));
+        cr_expect(gt(int, 0, strcmp(collected.keys[index], to)));
+    }
+    collected.size = 0;
+    dict_scan_range(dict, NULL, 0, "/tenant/0/", 10, collect, &collected);
+    cr_expect(eq(u64, 0, collected.size));
+    dict_scan_range(dict, "/tenant/9/z90", 13, NULL, 0, collect,
+        &collected);
+    cr_expect(eq(u64, 0, collected.size));
+    dict_scan_range(dict, "/tenant/9/z9", 12, NULL, 0, collect, &collected);
+    cr_expect(eq(u64, 1, collected.size));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_index, node_kinds)
+{
+    dict_t *dict = dict_ctor();
+    unsigned char bytes[256];
+    dict_keys_t *keys = NULL;
+    dict_stats_t stats;
+    int index = 0;
+
+    cr_assert(eq(int, 0, dict_enable_index(dict)));
+    for (; index < 256; ++index) {
+        bytes[index] = (unsigned char) (255 - index);
+        cr_expect(eq(int, 0, dict_insert(dict, (char *) &bytes[index], 1,
+            NULL)));
+    }
+    keys = dict_get_sorted_keys(dict);
+    cr_assert(eq(u64, 256, keys->size));
+    for (index = 0; index < 256; ++index)
+        cr_expect(eq(int, index, *(const unsigned char *) keys->keys[index]));
+    dict_free_keys(keys);
+    cr_expect(eq(int, DICT_INDEX_NODE256,
+        ((dict_index_node_t *) dict->index->root)->type));
+    for (index = 0; index < 250; ++index)
+        cr_expect(eq(int, 0, dict_delete(dict, (char *) &bytes[index], 1,
+            NULL)));
+    cr_expect(eq(int, DICT_INDEX_NODE16,
+        ((dict_index_node_t *) dict->index->root)->type));
+    keys = dict_get_sorted_keys(dict);
+    cr_assert(eq(u64, 6, keys->size));
+    for (index = 0; index < 6; ++index)
+        cr_expect(eq(int, index, *(const unsigned char *) keys->keys[index]));
+    dict_free_keys(keys);
+    dict_stats(dict, &stats);
+    cr_expect(eq(int, 1, stats.index_enabled));
+    cr_expect(lt(u64, 0, stats.index_bytes));
+    dict_clear(dict, NULL);
+    cr_expect(eq(ptr, NULL, dict->index->root));
+    dict_disable_index(dict);
+    dict_stats(dict, &stats);
+    cr_expect(eq(int, 0, stats.index_enabled));
+    dict_dtor(dict, NULL);
+}
@@ -0,0 +1,164 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_inline.c
+** File description:
+** Unit tests for the dicts storing their values inline.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+#include "tests_helpers.h"
+
+#define KEYS_COUNT 1000
+
+typedef struct s_point {
+    uint64_t x;
+    uint64_t y;
+    char name[12];
+} point_t;
+
+static
+void insert_point(dict_t *dict, uint64_t index)
+{
+    char *key = make_key(index);
+    point_t point = { index, index * 2, "point" };
+
+    cr_assert(eq(int, 0, dict_insert(dict, key, strlen(key), &point)));
+}
+
+static
+point_t *get_point(dict_t *dict, uint64_t index)
+{
+    char key[16] = { 0 };
+    void *value = NULL;
+
+    snprintf(key, sizeof(key), "KEY%lu", (unsigned long) index);
+    if (-1 == dict_get(dict, key, strlen(key), &value))
+        return NULL;
+    return (point_t *) value;
+}
+
+static
+int check_point(dict_t *dict, uint64_t index)
+{
+    point_t *point = get_point(dict, index);
+
+    return NULL != point && index == point->x && 2 * index == point->y && \
+        0 == strcmp("point", point->name);
+}
+
+static
+dict_t *make_dict(void)
+{
+    dict_t *dict = dict_ctor_with_value_size(sizeof(point_t));
+    uint64_t index = 0;
+
+    cr_assert(ne(ptr, NULL, dict));
+    for (; index < KEYS_COUNT; ++index)
+        insert_point(dict, index);
+    return dict;
+}
+
+Test(dict_inline, values_are_copied_into_the_nodes)
+{
+    dict_t *dict = make_dict();
+    uint64_t index = 0;
+    point_t *point = NULL;
+
+    for (; index < KEYS_COUNT; ++index)
+        cr_assert(eq(int, 1, check_point(dict, index)));
+    point = get_point(dict, 7);
+    point->y = 42;
+    cr_assert(eq(u64, 42, get_point(dict, 7)->y));
+    released = 0;
+    dict_dtor(dict, free_key);
+    cr_assert(eq(int, KEYS_COUNT, released));
+}
+
+Test(dict_inline, null_value_is_zeroed)
+{
+    dict_t *dict = dict_ctor_with_value_size(sizeof(point_t));
+    dict_t *pointers = dict_ctor();
+    int inserted = 0;
+    point_t *point = NULL;
+
+    cr_assert(eq(int, 0, dict_insert(dict, "zero", 4, NULL)));
+    cr_assert(eq(int, 0, dict_get(dict, "zero", 4, (void **) &point)));
+    cr_assert(eq(u64, 0, point->x));
+    cr_assert(eq(ptr, NULL, dict_entry(dict, "entry", 5, &inserted)));
+    cr_assert(eq(int, 0, inserted));
+    point = (point_t *) dict_entry_inline(dict, "entry", 5, &inserted);
+    cr_assert(eq(int, 1, inserted));
+    cr_assert(eq(u64, 0, point->y));
+    point->x = 3;
+    cr_assert(eq(int, 0, dict_get(dict, "entry", 5, (void **) &point)));
+    cr_assert(eq(u64, 3, point->x));
+    cr_assert(eq(ptr, point, dict_entry_inline(dict, "entry", 5, &inserted)));
+    cr_assert(eq(int, 0, inserted));
+    cr_assert(eq(ptr, NULL, dict_entry_inline(pointers, "entry", 5, NULL)));
+    dict_dtor(pointers, NULL);
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_inline, deletions_and_resizes_keep_values)
+{
+    dict_t *dict = make_dict();
+    char key[16] = { 0 };
+    uint64_t index = 0;
+
+    for (; index < KEYS_COUNT; index += 2) {
+        snprintf(key, sizeof(key), "KEY%lu", (unsigned long) index);
+        cr_assert(eq(int, 0, dict_delete(dict, key, strlen(key), free_key)));
+    }
+    for (index = 0; index < KEYS_COUNT; ++index)
+        cr_assert(eq(int, index % 2, check_point(dict, index)));
+    dict_dtor(dict, free_key);
+}
+
+Test(dict_inline, compaction_moves_values)
+{
+    dict_t *dict = make_dict();
+    uint64_t index = 0;
+    point_t *point = NULL;
+
+    point = get_point(dict, 5);
+    cr_assert(ge(i64, dict_compact(dict, 0), 0));
+    cr_assert(ne(ptr, point, get_point(dict, 5)));
+    for (; index < KEYS_COUNT; ++index)
+        cr_assert(eq(int, 1, check_point(dict, index)));
+    get_point(dict, 5)->x = 6;
+    cr_assert(eq(u64, 6, get_point(dict, 5)->x));
+    insert_point(dict, KEYS_COUNT);
+    cr_assert(eq(int, 1, check_point(dict, KEYS_COUNT)));
+    dict_dtor(dict, free_key);
+}
+
+Test(dict_inline, clone_copies_values_on_write)
+{
+    dict_t *dict = make_dict();
+    dict_t *clone = dict_clone(dict);
+    uint64_t index = 0;
+
+    cr_assert(ne(ptr, NULL, clone));
+    for (; index < KEYS_COUNT; ++index)
+        cr_assert(eq(int, 1, check_point(clone, index)));
+    for (index = 0; index < KEYS_COUNT; ++index)
+        insert_point(dict, KEYS_COUNT + index);
+    dict_dtor(dict, free_key);
+    for (index = 0; index < KEYS_COUNT; ++index)
+        cr_assert(eq(int, 1, check_point(clone, index)));
+    cr_assert(eq(ptr, NULL, get_point(clone, KEYS_COUNT)));
+    dict_dtor(clone, free_key);
+}
+
+Test(dict_inline, load_file_is_rejected)
+{
+    dict_t *dict = dict_ctor_with_value_size(8);
+
+    cr_assert(eq(int, -1, dict_load_file(dict, "/dev/null", NULL, NULL)));
+    dict_dtor(dict, NULL);
+}
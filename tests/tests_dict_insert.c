@@ -27,3 +27,47 @@ Test(dict_insert, passing)
     cr_expect(eq(int, -1, dict_insert(dict, "KEY9", 4, (void *) my_value)));
     dict_dtor(dict, NULL);
 }
+
+Test(dict_entry, counts_in_place)
+{
+    dict_t *dict = dict_ctor();
+    char *words[] = { "a", "b", "a", "c", "a", "b" };
+    void **slot = NULL;
+    void *value = NULL;
+    int inserted = 0;
+    int index = 0;
+
+    for (; index < 6; ++index) {
+        slot = dict_entry(dict, words[index], 1, &inserted);
+        cr_assert(ne(ptr, NULL, slot));
+        cr_expect(eq(int, NULL == *slot, inserted));
+        *slot = (void *) ((uintptr_t) *slot + 1);
+    }
+    cr_expect(eq(int, 3, DICT_SIZE(dict)));
+    cr_expect(eq(int, 0, dict_get(dict, "a", 1, &value)));
+    cr_expect(eq(u64, 3, (uintptr_t) value));
+    cr_expect(eq(int, 0, dict_get(dict, "b", 1, &value)));
+    cr_expect(eq(u64, 2, (uintptr_t) value));
+    cr_expect(eq(int, -1, dict_insert(dict, "c", 1, NULL)));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_entry, does_not_write_through_clone)
+{
+    dict_t *dict = dict_ctor();
+    dict_t *clone = NULL;
+    void *value = NULL;
+    int inserted = 1;
+
+    dict_insert(dict, "KEY", 3, (void *) 1);
+    clone = dict_clone(dict);
+    cr_assert(ne(ptr, NULL, clone));
+    *dict_entry(dict, "KEY", 3, &inserted) = (void *) 2;
+    cr_expect(eq(int, 0, inserted));
+    cr_expect(eq(int, 0, dict_get(clone, "KEY", 3, &value)));
+    cr_expect(eq(u64, 1, (uintptr_t) value));
+    cr_expect(eq(int, 0, dict_get(dict, "KEY", 3, &value)));
+    cr_expect(eq(u64, 2, (uintptr_t) value));
+    dict_dtor(dict, NULL);
+    dict_dtor(clone, NULL);
+}
@@ -0,0 +1,162 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_intern.c
+** File description:
+** Unit tests for the string interning table.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+
+#define WORDS_COUNT 1000
+#define THREADS_COUNT 4
+
+static char words[WORDS_COUNT][16] = { { 0 } };
+
+/**
+ * @brief The arguments of a thread interning every word.
+ */
+typedef struct s_intern_thread {
+    dict_intern_t *intern;
+    uint32_t ids[WORDS_COUNT];
+    int status;
+} intern_thread_t;
+
+static
+void *intern_words(void *arg)
+{
+    intern_thread_t *thread = (intern_thread_t *) arg;
+    int word = 0;
+
+    for (; word < WORDS_COUNT; ++word)
+        thread->status |= dict_intern(thread->intern, words[word],
+            strlen(words[word]), &(thread->ids[word]));
+    return NULL;
+}
+
+Test(dict_intern, assigns_dense_ids)
+{
+    dict_intern_t *intern = dict_intern_ctor();
+    uint32_t first = 0;
+    uint32_t second = 0;
+    uint32_t again = 0;
+
+    cr_assert(eq(int, 0, dict_intern(intern, "apple", 5, &first)));
+    cr_assert(eq(int, 0, dict_intern(intern, "pear", 4, &second)));
+    cr_assert(eq(int, 0, dict_intern(intern, "apple", 5, &again)));
+    cr_assert(eq(u32, 0, first));
+    cr_assert(eq(u32, 1, second));
+    cr_assert(eq(u32, first, again));
+    cr_assert(eq(u64, 2, intern->count));
+    dict_intern_dtor(intern);
+}
+
+Test(dict_intern, returns_stable_copies)
+{
+    dict_intern_t *intern = dict_intern_ctor();
+    char buffer[16] = "banana";
+    const char *string = NULL;
+    uint64_t length = 0;
+    uint32_t id = 0;
+    uint32_t other = 0;
+    int word = 0;
+
+    dict_intern(intern, buffer, 6, &id);
+    string = dict_intern_string(intern, id, &length);
+    memset(buffer, 0, sizeof(buffer));
+    for (; word < WORDS_COUNT; ++word) {
+        snprintf(buffer, sizeof(buffer), "word%d", word);
+        dict_intern(intern, buffer, strlen(buffer), &other);
+    }
+    cr_assert(eq(ptr, (void *) string,
+        (void *) dict_intern_string(intern, id, NULL)));
+    cr_assert(eq(u64, 6, length));
+    cr_assert(eq(str, "banana", (char *) string));
+    cr_assert(eq(ptr, NULL, (void *) dict_intern_string(intern,
+        WORDS_COUNT + 1, NULL)));
+    dict_intern_dtor(intern);
+}
+
+Test(dict_intern, finds_without_interning)
+{
+    dict_intern_t *intern = dict_intern_ctor();
+    uint32_t id = 0;
+    uint32_t found = 42;
+
+    cr_assert(eq(int, -1, dict_intern_find(intern, "kiwi", 4, &found)));
+    cr_assert(eq(u32, 42, found));
+    cr_assert(eq(u64, 0, intern->count));
+    dict_intern(intern, "kiwi", 4, &id);
+    cr_assert(eq(int, 0, dict_intern_find(intern, "kiwi", 4, &found)));
+    cr_assert(eq(u32, id, found));
+    cr_assert(eq(int, 0, dict_intern_find(intern, "kiwi", 4, NULL)));
+    dict_intern_dtor(intern);
+}
+
+Test(dict_intern, handles_binary_strings)
+{
+    dict_intern_t *intern = dict_intern_ctor();
+    uint64_t length = 0;
+    uint32_t first = 0;
+    uint32_t second = 0;
+    uint32_t empty = 0;
+
+    dict_intern(intern, "a\0b", 3, &first);
+    dict_intern(intern, "a\0c", 3, &second);
+    dict_intern(intern, "", 0, &empty);
+    cr_assert(ne(u32, first, second));
+    cr_assert(eq(int, 0, memcmp("a\0c", dict_intern_string(intern, second,
+        &length), 3)));
+    cr_assert(eq(u64, 3, length));
+    cr_assert(eq(str, "", (char *) dict_intern_string(intern, empty, NULL)));
+    dict_intern_dtor(intern);
+}
+
+Test(dict_intern, concurrent_interning_agrees)
+{
+    static intern_thread_t threads[THREADS_COUNT];
+    pthread_t handles[THREADS_COUNT];
+    dict_intern_t *intern = dict_intern_ctor();
+    int thread = 0;
+    int word = 0;
+
+    for (; word < WORDS_COUNT; ++word)
+        snprintf(words[word], sizeof(words[word]), "word%d", word);
+    for (thread = 0; thread < THREADS_COUNT; ++thread) {
+        threads[thread].intern = intern;
+        pthread_create(&(handles[thread]), NULL, intern_words,
+            &(threads[thread]));
+    }
+    for (thread = 0; thread < THREADS_COUNT; ++thread)
+        pthread_join(handles[thread], NULL);
+    cr_assert(eq(u64, WORDS_COUNT, intern->count));
+    for (thread = 0; thread < THREADS_COUNT; ++thread) {
+        cr_assert(eq(int, 0, threads[thread].status));
+        for (word = 0; word < WORDS_COUNT; ++word)
+            cr_assert(eq(u32, threads[0].ids[word],
+                threads[thread].ids[word]));
+    }
+    for (word = 0; word < WORDS_COUNT; ++word)
+        cr_assert(eq(str, words[word], (char *) dict_intern_string(intern,
+            threads[0].ids[word], NULL)));
+    dict_intern_dtor(intern);
+}
+
+Test(dict_intern, global_table_is_shared)
+{
+    uint32_t id = 0;
+    uint32_t found = 0;
+
+    cr_assert(eq(ptr, dict_intern_global(), dict_intern_global()));
+    cr_assert(eq(int, 0, dict_intern(dict_intern_global(), "global", 6,
+        &id)));
+    cr_assert(eq(int, 0, dict_intern_find(dict_intern_global(), "global", 6,
+        &found)));
+    cr_assert(eq(u32, id, found));
+}
@@ -0,0 +1,157 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_load.c
+** File description:
+** Unit tests for the dict file loader.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+
+static
+void write_file(char *path, const char *content)
+{
+    int fd = mkstemp(path);
+
+    cr_assert(ne(int, -1, fd));
+    cr_assert(eq(int, (int) strlen(content),
+        (int) write(fd, content, strlen(content))));
+    close(fd);
+}
+
+static
+void *parse_value(const char *bytes, uint64_t length, void *ctx)
+{
+    char buffer[32] = { 0 };
+
+    ++*(int *) ctx;
+    memcpy(buffer, bytes, length < 31 ? length : 31);
+    return (void *) (intptr_t) atoi(buffer);
+}
+
+Test(dict_load_file, borrowed_values)
+{
+    char path[] = "/tmp/tests_dict_load_XXXXXX";
+    dict_t *dict = dict_ctor();
+    void *value = NULL;
+
+    write_file(path, "KEY0\tzero\nKEY1\r\n\nKEY2\tHello, World !");
+    cr_expect(eq(int, 0, dict_load_file(dict, path, NULL, NULL)));
+    unlink(path);
+    cr_expect(eq(u64, 3, dict->items));
+    cr_expect(eq(int, 0, dict_get(dict, "KEY0", 4, &value)));
+    cr_expect(eq(int, 0, strncmp("zero\n", (const char *) value, 5)));
+    cr_expect(eq(int, 0, dict_get(dict, "KEY1", 4, &value)));
+    cr_expect(eq(ptr, NULL, value));
+    cr_expect(eq(int, 0, dict_get(dict, "KEY2", 4, &value)));
+    cr_expect(eq(int, 0, strncmp("Hello, World !", (const char *) value,
+        14)));
+    cr_expect(eq(int, 0, dict_has_key(dict, "KEY", 3)));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_load_file, load_value_and_duplicates)
+{
+    char path[] = "/tmp/tests_dict_load_XXXXXX";
+    dict_t *dict = dict_ctor();
+    void *value = NULL;
+    int calls = 0;
+    int index = 0;
+    char key[16] = { 0 };
+    char content[4096] = { 0 };
+
+    for (; index < 200; ++index)
+        snprintf(content + strlen(content), sizeof(content) - \
+            strlen(content), "K%d\t%d\n", index % 150, index);
+    write_file(path, content);
+    cr_expect(eq(int, 0, dict_insert(dict, "K0", 2, NULL)));
+    cr_expect(eq(int, 0, dict_load_file(dict, path, parse_value, &calls)));
+    unlink(path);
+    cr_expect(eq(u64, 150, dict->items));
+    cr_expect(eq(int, 149, calls));
+    for (index = 1; index < 150; ++index) {
+        snprintf(key, sizeof(key), "K%d", index);
+        cr_expect(eq(int, 0, dict_get(dict, key, strlen(key), &value)));
+        cr_expect(eq(int, index, (int) (intptr_t) value));
+    }
+    cr_expect(eq(int, 0, dict_delete(dict, "K1", 2, NULL)));
+    cr_expect(eq(int, 0, dict_has_key(dict, "K1", 2)));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_load_file, clone_outlives_dict)
+{
+    char path[] = "/tmp/tests_dict_load_XXXXXX";
+    dict_t *dict = dict_ctor();
+    dict_t *clone = NULL;
+
+    write_file(path, "KEY0\nKEY1\n");
+    cr_expect(eq(int, 0, dict_load_file(dict, path, NULL, NULL)));
+    unlink(path);
+    clone = dict_clone(dict);
+    dict_dtor(dict, NULL);
+    cr_expect(eq(int, 1, dict_has_key(clone, "KEY1", 4)));
+    dict_dtor(clone, NULL);
+}
+
+/** The number of values released by `free_loaded`. */
+static int freed = 0;
+
+static
+void *copy_value(const char *bytes, uint64_t length,
+    __attribute__((unused)) void *ctx)
+{
+    char *value = malloc(length + 1);
+
+    cr_assert(ne(ptr, NULL, value));
+    memcpy(value, bytes, length);
+    value[length] = '\0';
+    return value;
+}
+
+static
+void free_loaded(char *key, void *value)
+{
+    cr_expect(eq(ptr, NULL, key));
+    free(value);
+    ++freed;
+}
+
+Test(dict_load_file, loaded_values_are_released)
+{
+    char path[] = "/tmp/tests_dict_load_XXXXXX";
+    dict_t *dict = dict_ctor();
+    dict_t *clone = NULL;
+
+    write_file(path, "KEY0\tzero\nKEY1\tone\nKEY2\ttwo\n");
+    cr_expect(eq(int, 0, dict_load_file(dict, path, copy_value, NULL)));
+    unlink(path);
+    freed = 0;
+    cr_expect(eq(int, 0, dict_delete(dict, "KEY0", 4, free_loaded)));
+    cr_expect(eq(int, 1, freed));
+    clone = dict_clone(dict);
+    cr_assert(ne(ptr, NULL, clone));
+    cr_expect(eq(int, 0, dict_delete(clone, "KEY1", 4, free_loaded)));
+    cr_expect(eq(int, 1, freed));
+    dict_dtor(clone, free_loaded);
+    cr_expect(eq(int, 1, freed));
+    dict_dtor(dict, free_loaded);
+    cr_expect(eq(int, 3, freed));
+}
+
+Test(dict_load_file, failing)
+{
+    dict_t *dict = dict_ctor();
+
+    cr_expect(eq(int, -1, dict_load_file(dict, "/nonexistent/file", NULL,
+        NULL)));
+    cr_expect(eq(u64, 0, dict->items));
+    dict_dtor(dict, NULL);
+}
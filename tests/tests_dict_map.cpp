@@ -0,0 +1,94 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_map.cpp
+** File description:
+** Unit tests for the header-only C++ front-end of the dict.
+*/
+
+#include <memory>
+#include <string>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.hpp"
+
+static int destroyed = 0;
+
+struct tracked {
+    int value;
+
+    explicit tracked(int value) : value(value)
+    {
+    }
+
+    tracked(tracked &&other) noexcept : value(other.value)
+    {
+        other.value = -1;
+    }
+
+    tracked(const tracked &) = delete;
+
+    ~tracked()
+    {
+        if (-1 != value)
+            ++destroyed;
+    }
+};
+
+Test(dict_map, insert_find_erase)
+{
+    dict::map<std::string, int> map;
+    std::string key;
+
+    for (int index = 0; index < 1000; ++index)
+        cr_expect(map.insert("KEY" + std::to_string(index), index).second);
+    cr_expect(eq(sz, 1000, map.size()));
+    cr_expect_not(map.insert("KEY0", 42).second);
+    cr_expect(eq(int, 0, *map.find("KEY0")));
+    cr_expect(eq(int, 999, *map.find(std::string_view("KEY999"))));
+    cr_expect(eq(ptr, nullptr, map.find("KEY1000")));
+    for (int index = 0; index < 990; ++index) {
+        key = "KEY" + std::to_string(index);
+        cr_expect(map.erase(key));
+    }
+    cr_expect_not(map.erase("KEY0"));
+    cr_expect(eq(sz, 10, map.size()));
+    cr_expect(map.contains("KEY995"));
+    cr_expect(lt(sz, map.bucket_count(), 1024));
+}
+
+Test(dict_map, integral_keys)
+{
+    dict::map<std::uint64_t, std::uint64_t> map(10000);
+    std::size_t buckets = map.bucket_count();
+    std::uint64_t sum = 0;
+
+    for (std::uint64_t index = 0; index < 10000; ++index)
+        map[index] += index;
+    cr_expect(eq(sz, buckets, map.bucket_count()));
+    map.for_each([&sum](std::uint64_t, std::uint64_t &value) {
+        sum += value;
+    });
+    cr_expect(eq(u64, 49995000, sum));
+}
+
+Test(dict_map, move_only_values)
+{
+    destroyed = 0;
+    {
+        dict::map<std::string, tracked> map;
+        dict::map<std::string, std::unique_ptr<int>> owners;
+
+        cr_expect(map.try_emplace("KEY0", 0).second);
+        cr_expect(map.try_emplace(std::string("KEY1"), 1).second);
+        cr_expect_not(map.try_emplace("KEY1", 2).second);
+        cr_expect(map.erase("KEY0"));
+        cr_expect(eq(int, 1, destroyed));
+        dict::map<std::string, tracked> moved(std::move(map));
+        cr_expect(eq(sz, 0, map.size()));
+        cr_expect(eq(int, 1, moved.find("KEY1")->value));
+        cr_expect(map.try_emplace("KEY2", 2).second);
+        owners.insert("KEY0", std::make_unique<int>(42));
+        cr_expect(eq(int, 42, **owners.find("KEY0")));
+    }
+    cr_expect(eq(int, 3, destroyed));
+}
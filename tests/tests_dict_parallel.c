@@ -0,0 +1,173 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_parallel.c
+** File description:
+** Unit tests for the parallel walks over the dict entries.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+
+#define KEYS_COUNT 100000
+
+static char keys[KEYS_COUNT][16] = { { 0 } };
+
+/**
+ * @brief The accumulator of the tests reductions.
+ */
+typedef struct s_sum {
+    uint64_t entries;
+    uint64_t total;
+} sum_t;
+
+/**
+ * @brief Builds a counting dict where the key `i` is worth `i`.
+ */
+static
+dict_t *make_dict(uint64_t count)
+{
+    dict_t *dict = dict_ctor_with_value_size(sizeof(uint64_t));
+    uint64_t index = 0;
+
+    for (; index < count; ++index) {
+        snprintf(keys[index], sizeof(keys[index]), "key%llu",
+            (unsigned long long) index);
+        dict_insert(dict, keys[index], strlen(keys[index]), &index);
+    }
+    return dict;
+}
+
+static
+void visit(__attribute__((unused)) const char *key,
+    __attribute__((unused)) uint64_t key_length, void *value, void *ctx)
+{
+    *(uint64_t *) value += *(const uint64_t *) ctx;
+}
+
+static
+void add(__attribute__((unused)) const char *key,
+    __attribute__((unused)) uint64_t key_length, void *value, void *acc,
+    __attribute__((unused)) void *ctx)
+{
+    ++((sum_t *) acc)->entries;
+    ((sum_t *) acc)->total += *(const uint64_t *) value;
+}
+
+static
+void merge(void *acc, const void *partial, __attribute__((unused)) void *ctx)
+{
+    ((sum_t *) acc)->entries += ((const sum_t *) partial)->entries;
+    ((sum_t *) acc)->total += ((const sum_t *) partial)->total;
+}
+
+/**
+ * @brief The accumulator of an order sensitive reduction : the polynomial
+ * hash of the values in walk order, merged by concatenation, so that `merge`
+ * is associative but not commutative.
+ */
+typedef struct s_sequence {
+    uint64_t hash;
+    uint64_t power;
+} sequence_t;
+
+static
+void append(__attribute__((unused)) const char *key,
+    __attribute__((unused)) uint64_t key_length, void *value, void *acc,
+    __attribute__((unused)) void *ctx)
+{
+    ((sequence_t *) acc)->hash = ((sequence_t *) acc)->hash * 31 + \
+        *(const uint64_t *) value;
+    ((sequence_t *) acc)->power *= 31;
+}
+
+static
+void concat(void *acc, const void *partial, __attribute__((unused)) void *ctx)
+{
+    ((sequence_t *) acc)->hash = ((sequence_t *) acc)->hash * \
+        ((const sequence_t *) partial)->power + \
+        ((const sequence_t *) partial)->hash;
+    ((sequence_t *) acc)->power *= ((const sequence_t *) partial)->power;
+}
+
+Test(dict_parallel, foreach_visits_each_entry_once)
+{
+    dict_t *dict = make_dict(KEYS_COUNT);
+    uint64_t delta = KEYS_COUNT;
+    void *value = NULL;
+    uint64_t index = 0;
+
+    cr_assert(lt(u64, 4, dict->size / DICT_PARALLEL_CHUNK));
+    dict_parallel_foreach(dict, visit, &delta, 4);
+    for (; index < KEYS_COUNT; ++index) {
+        cr_assert(eq(int, 0, dict_get(dict, keys[index],
+            strlen(keys[index]), &value)));
+        cr_assert(eq(u64, index + KEYS_COUNT, *(uint64_t *) value));
+    }
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_parallel, reduce_matches_serial)
+{
+    dict_t *dict = make_dict(KEYS_COUNT);
+    sum_t serial = { 0, 0 };
+    sum_t parallel = { 0, 0 };
+    sum_t many = { 0, 0 };
+
+    cr_assert(eq(int, 0, dict_parallel_reduce(dict, add, merge, &serial,
+        sizeof(sum_t), NULL, 0)));
+    cr_assert(eq(int, 0, dict_parallel_reduce(dict, add, merge, &parallel,
+        sizeof(sum_t), NULL, 3)));
+    cr_assert(eq(int, 0, dict_parallel_reduce(dict, add, merge, &many,
+        sizeof(sum_t), NULL, 1000)));
+    cr_assert(eq(u64, KEYS_COUNT, serial.entries));
+    cr_assert(eq(u64, (uint64_t) KEYS_COUNT * (KEYS_COUNT - 1) / 2,
+        serial.total));
+    cr_assert(eq(int, 0, memcmp(&serial, &parallel, sizeof(sum_t))));
+    cr_assert(eq(int, 0, memcmp(&serial, &many, sizeof(sum_t))));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_parallel, small_dicts_are_walked_inline)
+{
+    dict_t *dict = make_dict(10);
+    dict_t *empty = dict_ctor();
+    sum_t sum = { 0, 0 };
+
+    cr_assert(eq(u64, 1, DICT_PARALLEL_WORKERS(dict, 8)));
+    cr_assert(eq(int, 0, dict_parallel_reduce(dict, add, merge, &sum,
+        sizeof(sum_t), NULL, 8)));
+    cr_assert(eq(u64, 10, sum.entries));
+    cr_assert(eq(u64, 45, sum.total));
+    cr_assert(eq(int, 0, dict_parallel_reduce(empty, add, merge, &sum,
+        sizeof(sum_t), NULL, 8)));
+    cr_assert(eq(u64, 10, sum.entries));
+    dict_dtor(empty, NULL);
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_parallel, reduce_does_not_depend_on_the_scheduling)
+{
+    dict_t *dict = make_dict(KEYS_COUNT);
+    sequence_t serial = { 0, 1 };
+    sequence_t parallel = { 0, 1 };
+    const bucket_t *bucket = NULL;
+    uint64_t index = 0;
+    int round = 0;
+
+    for (; index < dict->size; ++index)
+        for (bucket = dict->buckets[index]; NULL != bucket->key;
+            bucket = bucket->next)
+            append(bucket->key, bucket->key_length, bucket->value, &serial,
+                NULL);
+    for (; round < 8; ++round) {
+        parallel.hash = 0;
+        parallel.power = 1;
+        cr_assert(eq(int, 0, dict_parallel_reduce(dict, append, concat,
+            &parallel, sizeof(sequence_t), NULL, 1 + round % 4)));
+        cr_assert(eq(u64, serial.hash, parallel.hash));
+    }
+    dict_dtor(dict, NULL);
+}
@@ -0,0 +1,117 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_retain.c
+** File description:
+** Unit tests for the dict bulk predicate delete and clear.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+#include "tests_helpers.h"
+
+#define KEYS_COUNT 1000
+
+static
+int keep_even(__attribute__((unused)) const char *key,
+    __attribute__((unused)) uint64_t key_length, void *value,
+    __attribute__((unused)) void *ctx)
+{
+    return 0 == (uintptr_t) value % 2;
+}
+
+static
+int keep_below(__attribute__((unused)) const char *key,
+    __attribute__((unused)) uint64_t key_length, void *value, void *ctx)
+{
+    return (uintptr_t) value < *(uintptr_t *) ctx;
+}
+
+Test(dict_retain, removes_rejected_entries)
+{
+    dict_t *dict = make_index_dict(KEYS_COUNT);
+    uintptr_t index = 0;
+
+    released = 0;
+    cr_expect(eq(int, 0, dict_retain(dict, keep_even, NULL, free_key)));
+    cr_expect(eq(int, KEYS_COUNT / 2, released));
+    cr_expect(eq(int, KEYS_COUNT / 2, DICT_SIZE(dict)));
+    for (; index < KEYS_COUNT; ++index)
+        cr_expect(eq(int, index % 2 == 0, has_index(dict, index)));
+    dict_dtor(dict, free_key);
+    cr_expect(eq(int, KEYS_COUNT, released));
+}
+
+Test(dict_retain, shrinks_once_and_keeps_filter)
+{
+    dict_t *dict = make_index_dict(KEYS_COUNT);
+    uintptr_t limit = 10;
+    uint64_t size = dict->size;
+
+    cr_assert(eq(int, 0, dict_enable_filter(dict)));
+    cr_expect(eq(int, 0, dict_retain(dict, keep_below, &limit, free_key)));
+    cr_expect(eq(int, 10, DICT_SIZE(dict)));
+    cr_expect(lt(u64, dict->size, size));
+    cr_expect(eq(int, 1, has_index(dict, 9)));
+    cr_expect(eq(int, 0, has_index(dict, 10)));
+    cr_expect(le(u64, dict->filter->stale, dict->items));
+    dict_dtor(dict, free_key);
+}
+
+Test(dict_retain, leaves_clone_untouched)
+{
+    dict_t *dict = make_index_dict(KEYS_COUNT);
+    dict_t *clone = dict_clone(dict);
+
+    cr_assert(ne(ptr, NULL, clone));
+    released = 0;
+    cr_expect(eq(int, 0, dict_retain(dict, keep_even, NULL, free_key)));
+    cr_expect(eq(int, 0, released));
+    cr_expect(eq(int, KEYS_COUNT / 2, DICT_SIZE(dict)));
+    cr_expect(eq(int, KEYS_COUNT, DICT_SIZE(clone)));
+    cr_expect(eq(int, 0, has_index(dict, 1)));
+    cr_expect(eq(int, 1, has_index(clone, 1)));
+    dict_dtor(dict, free_key);
+    dict_dtor(clone, free_key);
+    cr_expect(eq(int, KEYS_COUNT, released));
+}
+
+Test(dict_clear, keeps_buckets)
+{
+    dict_t *dict = make_index_dict(KEYS_COUNT);
+    uint64_t size = dict->size;
+
+    cr_assert(eq(int, 0, dict_enable_filter(dict)));
+    released = 0;
+    cr_expect(eq(int, 0, dict_clear(dict, free_key)));
+    cr_expect(eq(int, KEYS_COUNT, released));
+    cr_expect(eq(int, 0, DICT_SIZE(dict)));
+    cr_expect(eq(u64, size, dict->size));
+    cr_expect(eq(int, 0, has_index(dict, 0)));
+    cr_expect(eq(u64, 0, dict->filter->bits_set));
+    cr_expect(eq(int, 0, dict_insert(dict, strdup("KEY0"), 4, NULL)));
+    cr_expect(eq(int, 1, has_index(dict, 0)));
+    dict_dtor(dict, free_key);
+}
+
+Test(dict_clear, leaves_clone_untouched)
+{
+    dict_t *dict = make_index_dict(KEYS_COUNT);
+    dict_t *clone = dict_clone(dict);
+
+    cr_assert(ne(ptr, NULL, clone));
+    cr_expect(eq(int, 0, dict_delete(dict, "KEY1", 4, free_key)));
+    cr_expect(eq(int, 0, dict_insert(dict, strdup("NEW"), 3, NULL)));
+    released = 0;
+    cr_expect(eq(int, 0, dict_clear(dict, free_key)));
+    cr_expect(eq(int, 1, released));
+    cr_expect(eq(int, 0, DICT_SIZE(dict)));
+    cr_expect(eq(int, KEYS_COUNT, DICT_SIZE(clone)));
+    cr_expect(eq(int, 1, has_index(clone, 2)));
+    dict_dtor(dict, free_key);
+    dict_dtor(clone, free_key);
+    cr_expect(eq(int, KEYS_COUNT + 1, released));
+}
@@ -0,0 +1,161 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_set.c
+** File description:
+** Unit tests for the set.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+#include "tests_helpers.h"
+
+#define KEYS_COUNT 10000
+
+/**
+ * @brief Releases a key allocated by `make_key`, as the sets do.
+ */
+static
+void free_set_key(char *key)
+{
+    free_key(key, NULL);
+}
+
+static char shared_keys[1000][16];
+
+static
+void count_key(__attribute__((unused)) char *key)
+{
+    ++released;
+}
+
+/**
+ * @brief Builds a set holding the shared keys of the indexes from `start` to
+ * `end`, stepping by `step`, so that the sets can exchange keys.
+ */
+static
+dict_set_t *make_set(int start, int end, int step)
+{
+    dict_set_t *set = dict_set_ctor(NULL);
+    char *key = NULL;
+
+    for (; start < end; start += step) {
+        key = shared_keys[start];
+        snprintf(key, 16, "KEY%d", start);
+        cr_assert(eq(int, 0, dict_set_add(set, key, strlen(key))));
+    }
+    return set;
+}
+
+Test(dict_set, add_contains_remove)
+{
+    dict_set_t *set = dict_set_ctor(NULL);
+    char *key = NULL;
+    int index = 0;
+
+    cr_assert(ne(ptr, NULL, set));
+    for (; index < KEYS_COUNT; ++index) {
+        key = make_key(index);
+        cr_expect(eq(int, 0, dict_set_add(set, key, strlen(key))));
+    }
+    cr_expect(eq(int, 1, dict_set_add(set, "KEY0", 4)));
+    cr_expect(eq(int, -1, dict_set_add(set, NULL, 0)));
+    cr_expect(eq(u64, KEYS_COUNT, DICT_SIZE(set)));
+    cr_expect(eq(int, 1, dict_set_contains(set, "KEY1234", 7)));
+    cr_expect(eq(int, 0, dict_set_contains(set, "KEY10000", 8)));
+    released = 0;
+    for (index = 0; index < KEYS_COUNT - 10; ++index) {
+        key = make_key(index);
+        cr_expect(eq(int, 0, dict_set_remove(set, key, strlen(key),
+            free_set_key)));
+        free(key);
+    }
+    cr_expect(eq(int, KEYS_COUNT - 10, released));
+    cr_expect(eq(int, -1, dict_set_remove(set, "KEY0", 4, free_set_key)));
+    cr_expect(eq(u64, 10, DICT_SIZE(set)));
+    cr_expect(gt(u64, KEYS_COUNT, set->size));
+    cr_expect(eq(int, 1, dict_set_contains(set, "KEY9999", 7)));
+    released = 0;
+    dict_set_dtor(set, free_set_key);
+    cr_expect(eq(int, 10, released));
+}
+
+Test(dict_set, reuses_released_entries)
+{
+    dict_set_t *set = dict_set_ctor(NULL);
+    uint32_t capacity = 0;
+    char *key = NULL;
+    int index = 0;
+    int round = 0;
+
+    cr_assert(eq(int, 0, dict_set_reserve(set, 100)));
+    capacity = set->capacity;
+    cr_expect(le(u32, 100, capacity));
+    for (; round < 10; ++round) {
+        for (index = 0; index < 100; ++index) {
+            key = make_key(index);
+            cr_expect(eq(int, 0, dict_set_add(set, key, strlen(key))));
+        }
+        for (index = 0; index < 100; ++index) {
+            key = make_key(index);
+            cr_expect(eq(int, 0, dict_set_remove(set, key, strlen(key),
+                free_set_key)));
+            free(key);
+        }
+    }
+    cr_expect(eq(u32, capacity, set->capacity));
+    cr_expect(ge(u32, 100, set->used));
+    dict_set_dtor(set, free_set_key);
+}
+
+Test(dict_set, union_of_sets)
+{
+    dict_set_t *evens = make_set(0, 1000, 2);
+    dict_set_t *thirds = make_set(0, 1000, 3);
+    dict_keys_t *keys = NULL;
+    uint64_t index = 0;
+
+    cr_expect(eq(int, 0, dict_set_union(evens, thirds)));
+    cr_expect(eq(u64, 500 + 334 - 167, DICT_SIZE(evens)));
+    cr_expect(eq(int, 1, dict_set_contains(evens, "KEY9", 4)));
+    cr_expect(eq(int, 1, dict_set_contains(evens, "KEY998", 6)));
+    cr_expect(eq(int, 0, dict_set_contains(evens, "KEY7", 4)));
+    cr_expect(eq(int, 0, dict_set_union(evens, thirds)));
+    cr_expect(eq(u64, 667, DICT_SIZE(evens)));
+    keys = dict_set_get_keys(evens);
+    cr_assert(ne(ptr, NULL, keys));
+    cr_expect(eq(u64, 667, keys->size));
+    for (; index < keys->size; ++index)
+        cr_expect(eq(int, 1, dict_set_contains(evens, keys->keys[index],
+            keys->lengths[index])));
+    dict_free_keys(keys);
+    dict_set_dtor(evens, NULL);
+    dict_set_dtor(thirds, NULL);
+}
+
+Test(dict_set, intersection_and_difference)
+{
+    dict_set_t *evens = make_set(0, 1000, 2);
+    dict_set_t *odds = make_set(1, 1000, 2);
+    dict_set_t *thirds = make_set(0, 1000, 3);
+
+    released = 0;
+    cr_expect(eq(u64, 500 - 167, dict_set_intersection(evens, thirds,
+        count_key)));
+    cr_expect(eq(int, 500 - 167, released));
+    cr_expect(eq(u64, 167, DICT_SIZE(evens)));
+    cr_expect(eq(int, 1, dict_set_contains(evens, "KEY6", 4)));
+    cr_expect(eq(int, 0, dict_set_contains(evens, "KEY4", 4)));
+    cr_expect(eq(u64, 167, dict_set_difference(thirds, odds, NULL)));
+    cr_expect(eq(u64, 167, DICT_SIZE(thirds)));
+    cr_expect(eq(int, 0, dict_set_contains(thirds, "KEY3", 4)));
+    cr_expect(eq(int, 1, dict_set_contains(thirds, "KEY6", 4)));
+    cr_expect(eq(u64, 167, dict_set_difference(evens, evens, NULL)));
+    cr_expect(eq(u64, 0, DICT_SIZE(evens)));
+    dict_set_dtor(evens, NULL);
+    dict_set_dtor(odds, NULL);
+    dict_set_dtor(thirds, NULL);
+}
@@ -0,0 +1,162 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_shm.c
+** File description:
+** Unit tests for the dict shared by processes.
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+
+#define REGION_SIZE (16 << 20)
+#define KEYS_COUNT 5000
+#define READERS 4
+
+static
+void *map_region(void)
+{
+    void *region = mmap(NULL, REGION_SIZE, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    cr_assert(ne(ptr, MAP_FAILED, region));
+    return region;
+}
+
+static
+int insert_key(dict_shm_t *shm, const char *prefix, int index)
+{
+    char key[32] = { 0 };
+    int length = snprintf(key, sizeof(key), "%s%d", prefix, index);
+
+    return dict_shm_insert(shm, key, length, &index, sizeof(index));
+}
+
+static
+int check_key(dict_shm_t *shm, const char *prefix, int index)
+{
+    char key[32] = { 0 };
+    int length = snprintf(key, sizeof(key), "%s%d", prefix, index);
+    int value = -1;
+
+    return sizeof(int) == dict_shm_get(shm, key, length, &value,
+        sizeof(value)) && index == value;
+}
+
+/**
+ * @brief Checks every stable key `rounds` times, from a forked process.
+ */
+static
+int run_reader(void *region, int rounds)
+{
+    dict_shm_t *shm = dict_shm_attach(region);
+    int index = 0;
+
+    if (NULL == shm)
+        return 1;
+    for (; 0 < rounds; --rounds)
+        for (index = 0; index < KEYS_COUNT; ++index)
+            if (!check_key(shm, "stable", index))
+                return 1;
+    return 0;
+}
+
+Test(dict_shm, local_operations)
+{
+    void *region = map_region();
+    dict_shm_t *shm = dict_shm_create(region, REGION_SIZE);
+    int index = 0;
+    int value = 0;
+
+    cr_assert(ne(ptr, NULL, shm));
+    for (; index < KEYS_COUNT; ++index)
+        cr_expect(eq(int, 0, insert_key(shm, "key", index)));
+    cr_expect(eq(int, -1, insert_key(shm, "key", 0)));
+    cr_expect(eq(u64, KEYS_COUNT, shm->items));
+    cr_expect(eq(int, 1, check_key(shm, "key", KEYS_COUNT - 1)));
+    cr_expect(eq(int, 0, dict_shm_delete(shm, "key1", 4)));
+    cr_expect(eq(int, -1, dict_shm_delete(shm, "key1", 4)));
+    cr_expect(eq(int, 0, dict_shm_has_key(shm, "key1", 4)));
+    cr_expect(eq(int, 1, dict_shm_has_key(shm, "key2", 4)));
+    cr_expect(eq(i64, sizeof(int), dict_shm_get(shm, "key2", 4, &value, 1)));
+    cr_expect(eq(int, 0, insert_key(shm, "key", 1)));
+    cr_expect(eq(int, 1, check_key(shm, "key", 1)));
+    dict_shm_destroy(shm);
+    munmap(region, REGION_SIZE);
+}
+
+Test(dict_shm, position_independent)
+{
+    void *region = map_region();
+    void *copy = map_region();
+    dict_shm_t *shm = dict_shm_create(region, REGION_SIZE);
+    int index = 0;
+
+    cr_assert(ne(ptr, NULL, shm));
+    cr_expect(eq(ptr, NULL, dict_shm_attach(copy)));
+    for (; index < 100; ++index)
+        insert_key(shm, "key", index);
+    memcpy(copy, region, REGION_SIZE);
+    munmap(region, REGION_SIZE);
+    shm = dict_shm_attach(copy);
+    cr_assert(ne(ptr, NULL, shm));
+    for (index = 0; index < 100; ++index)
+        cr_expect(eq(int, 1, check_key(shm, "key", index)));
+    munmap(copy, REGION_SIZE);
+}
+
+Test(dict_shm, region_full)
+{
+    char region[4096] __attribute__((aligned(16)));
+    dict_shm_t *shm = dict_shm_create(region, sizeof(region));
+    int index = 0;
+
+    cr_assert(ne(ptr, NULL, shm));
+    while (0 == insert_key(shm, "key", index))
+        ++index;
+    cr_expect(gt(int, index, 0));
+    cr_expect(eq(u64, index, shm->items));
+    cr_expect(eq(int, 1, check_key(shm, "key", index - 1)));
+    cr_expect(eq(ptr, NULL, dict_shm_create(region, 64)));
+}
+
+Test(dict_shm, forked_readers_and_writer)
+{
+    void *region = map_region();
+    dict_shm_t *shm = dict_shm_create(region, REGION_SIZE);
+    pid_t readers[READERS] = { 0 };
+    int status = 0;
+    int index = 0;
+
+    cr_assert(ne(ptr, NULL, shm));
+    for (; index < KEYS_COUNT; ++index)
+        insert_key(shm, "stable", index);
+    for (index = 0; index < READERS; ++index) {
+        readers[index] = fork();
+        cr_assert(ne(int, -1, readers[index]));
+        if (0 == readers[index])
+            _exit(run_reader(region, 20));
+    }
+    for (index = 0; index < KEYS_COUNT * 4; ++index) {
+        insert_key(shm, "churn", index);
+        if (0 == index % 3)
+            dict_shm_delete(shm, "churn0", 6);
+    }
+    for (index = 0; index < READERS; ++index) {
+        cr_expect(eq(int, readers[index], waitpid(readers[index], &status,
+            0)));
+        cr_expect(eq(int, 1, WIFEXITED(status)));
+        cr_expect(eq(int, 0, WEXITSTATUS(status)));
+    }
+    cr_expect(eq(u64, KEYS_COUNT * 5 - 1, shm->items));
+    dict_shm_destroy(shm);
+    munmap(region, REGION_SIZE);
+}
@@ -0,0 +1,199 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_trace.c
+** File description:
+** Unit tests for the trace recorder.
+*/
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+
+#define KEYS_COUNT 20000
+
+/**
+ * @brief Builds a fresh trace path inside a temporary directory.
+ */
+static
+void make_path(char *path, uint64_t size)
+{
+    char directory[] = "/tmp/dict_trace_XXXXXX";
+
+    cr_assert(ne(ptr, NULL, mkdtemp(directory)));
+    snprintf(path, size, "%s/trace", directory);
+}
+
+/**
+ * @brief Records a few operations on the keys `apple` and `pear`.
+ */
+static
+void record(const char *path, int mode)
+{
+    dict_t *dict = dict_ctor();
+
+    cr_assert(eq(int, 0, dict_trace_start(dict, path, mode)));
+    dict_insert(dict, "apple", 5, NULL);
+    dict_get(dict, "apple", 5, NULL);
+    dict_has_key(dict, "pear", 4);
+    dict_delete(dict, "apple", 5, NULL);
+    dict_delete(dict, "apple", 5, NULL);
+    cr_assert(eq(int, 0, dict_trace_stop(dict)));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_trace, records_keys)
+{
+    char path[64] = { 0 };
+    dict_trace_ops_t *ops = NULL;
+    const int expected[5][2] = { { DICT_TRACE_INSERT, 0 },
+        { DICT_TRACE_GET, 0 }, { DICT_TRACE_GET, 1 },
+        { DICT_TRACE_DELETE, 0 }, { DICT_TRACE_DELETE, 1 } };
+    int index = 0;
+
+    make_path(path, sizeof(path));
+    record(path, DICT_TRACE_KEYS);
+    ops = dict_trace_load(path);
+    cr_assert(ne(ptr, NULL, ops));
+    cr_assert(eq(int, DICT_TRACE_KEYS, ops->mode));
+    cr_assert(eq(u64, 5, ops->count));
+    for (; index < 5; ++index) {
+        cr_assert(eq(int, expected[index][0], ops->ops[index].op));
+        cr_assert(eq(int, expected[index][1], ops->ops[index].failed));
+        if (0 < index)
+            cr_assert(le(u64, ops->ops[index - 1].time,
+                ops->ops[index].time));
+    }
+    cr_assert(eq(u64, 4, ops->ops[2].key_length));
+    cr_assert(eq(int, 0, memcmp("pear", ops->ops[2].key, 4)));
+    cr_assert(eq(int, 0, memcmp("apple", ops->ops[4].key, 5)));
+    dict_trace_ops_free(ops);
+}
+
+Test(dict_trace, records_hashes_without_keys)
+{
+    char path[64] = { 0 };
+    char bytes[256] = { 0 };
+    dict_trace_ops_t *ops = NULL;
+    ssize_t length = 0;
+    int fd = 0;
+
+    make_path(path, sizeof(path));
+    record(path, DICT_TRACE_HASHES);
+    fd = open(path, O_RDONLY);
+    length = read(fd, bytes, sizeof(bytes));
+    close(fd);
+    cr_assert(eq(ptr, NULL, memmem(bytes, length, "apple", 5)));
+    cr_assert(eq(ptr, NULL, memmem(bytes, length, "pear", 4)));
+    ops = dict_trace_load(path);
+    cr_assert(ne(ptr, NULL, ops));
+    cr_assert(eq(int, DICT_TRACE_HASHES, ops->mode));
+    cr_assert(eq(u64, 5, ops->count));
+    cr_assert(eq(u64, 5, ops->ops[0].key_length));
+    cr_assert(eq(u64, 4, ops->ops[2].key_length));
+    cr_assert(eq(int, 0, memcmp(ops->ops[0].key, ops->ops[4].key, 5)));
+    cr_assert(ne(int, 0, memcmp(ops->ops[0].key, ops->ops[2].key, 4)));
+    cr_assert(ne(ptr, (void *) ops->ops[0].key, (void *) ops->ops[1].key));
+    dict_trace_ops_free(ops);
+}
+
+Test(dict_trace, replays_large_traces)
+{
+    static char keys[KEYS_COUNT][16];
+    char path[64] = { 0 };
+    dict_t *dict = dict_ctor();
+    dict_t *replayed = dict_ctor();
+    dict_trace_ops_t *ops = NULL;
+    uint64_t index = 0;
+    int length = 0;
+
+    make_path(path, sizeof(path));
+    cr_assert(eq(int, 0, dict_trace_start(dict, path, DICT_TRACE_KEYS)));
+    for (; index < KEYS_COUNT; ++index) {
+        length = snprintf(keys[index], sizeof(keys[index]), "key%llu",
+            (unsigned long long) index);
+        dict_insert(dict, keys[index], length, NULL);
+        if (0 == index % 3)
+            dict_delete(dict, keys[index], length, NULL);
+    }
+    dict_dtor(dict, NULL);
+    ops = dict_trace_load(path);
+    cr_assert(ne(ptr, NULL, ops));
+    cr_assert(eq(u64, KEYS_COUNT + (KEYS_COUNT + 2) / 3, ops->count));
+    for (index = 0; index < ops->count; ++index)
+        if (DICT_TRACE_INSERT == ops->ops[index].op)
+            dict_insert(replayed, (char *) ops->ops[index].key,
+                ops->ops[index].key_length, NULL);
+        else
+            dict_delete(replayed, (char *) ops->ops[index].key,
+                ops->ops[index].key_length, NULL);
+    cr_assert(eq(u64, KEYS_COUNT - (KEYS_COUNT + 2) / 3, replayed->items));
+    dict_dtor(replayed, NULL);
+    dict_trace_ops_free(ops);
+}
+
+Test(dict_trace, stops_at_a_cut_record)
+{
+    char path[64] = { 0 };
+    dict_trace_ops_t *ops = NULL;
+    struct stat info;
+
+    make_path(path, sizeof(path));
+    record(path, DICT_TRACE_KEYS);
+    stat(path, &info);
+    cr_assert(eq(int, 0, truncate(path, info.st_size - 2)));
+    ops = dict_trace_load(path);
+    cr_assert(ne(ptr, NULL, ops));
+    cr_assert(eq(u64, 4, ops->count));
+    dict_trace_ops_free(ops);
+    cr_assert(eq(int, 0, truncate(path, 4)));
+    cr_assert(eq(ptr, NULL, dict_trace_load(path)));
+}
+
+Test(dict_trace, rejects_invalid_calls)
+{
+    dict_t *dict = dict_ctor();
+
+    cr_assert(eq(int, -1, dict_trace_stop(dict)));
+    cr_assert(eq(int, -1, dict_trace_start(dict, "/tmp/trace", 42)));
+    cr_assert(eq(int, -1, dict_trace_start(dict,
+        "/nonexistent/directory/trace", DICT_TRACE_KEYS)));
+    cr_assert(eq(ptr, NULL, dict->trace));
+    cr_assert(eq(ptr, NULL, dict_trace_load("/nonexistent/trace")));
+    dict_dtor(dict, NULL);
+}
+
+Test(dict_trace, records_every_insertion)
+{
+    char path[64] = { 0 };
+    dict_trace_ops_t *ops = NULL;
+    dict_t *dict = dict_ctor_with_value_size(sizeof(uint64_t));
+    const int failed[4] = { 0, 1, 1, 0 };
+    int index = 0;
+
+    make_path(path, sizeof(path));
+    cr_assert(eq(int, 0, dict_enable_expiry(dict, NULL, NULL)));
+    cr_assert(eq(int, 0, dict_trace_start(dict, path, DICT_TRACE_KEYS)));
+    cr_assert(ne(ptr, NULL, dict_entry_inline(dict, "apple", 5, NULL)));
+    cr_assert(eq(int, 0, dict_incr(dict, "apple", 5, 1, NULL)));
+    cr_assert(eq(int, -1, dict_insert_ttl(dict, "apple", 5, NULL, 10)));
+    cr_assert(eq(int, 0, dict_insert_ttl(dict, "pear", 4, NULL, 10)));
+    cr_assert(eq(int, 0, dict_trace_stop(dict)));
+    dict_dtor(dict, NULL);
+    ops = dict_trace_load(path);
+    cr_assert(ne(ptr, NULL, ops));
+    cr_assert(eq(u64, 4, ops->count));
+    for (; index < 4; ++index) {
+        cr_assert(eq(int, DICT_TRACE_INSERT, ops->ops[index].op));
+        cr_assert(eq(int, failed[index], ops->ops[index].failed));
+    }
+    cr_assert(eq(int, 0, memcmp("pear", ops->ops[3].key, 4)));
+    dict_trace_ops_free(ops);
+}
@@ -0,0 +1,238 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_dict_wal.c
+** File description:
+** Unit tests for the durable dict.
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <criterion/criterion.h>
+#include <criterion/new/assert.h>
+#include "dict.h"
+
+#define KEYS_COUNT 2000
+
+/**
+ * @brief Builds a fresh base path inside a temporary directory.
+ */
+static
+void make_path(char *path, uint64_t size)
+{
+    char directory[] = "/tmp/dict_wal_XXXXXX";
+
+    cr_assert(ne(ptr, NULL, mkdtemp(directory)));
+    snprintf(path, size, "%s/db", directory);
+}
+
+static
+int put_key(dict_wal_t *wal, int index)
+{
+    char key[32] = { 0 };
+    int length = snprintf(key, sizeof(key), "key:%d", index);
+
+    return dict_wal_insert(wal, key, length, &index, sizeof(index));
+}
+
+static
+int check_key(dict_wal_t *wal, int index)
+{
+    char key[32] = { 0 };
+    int length = snprintf(key, sizeof(key), "key:%d", index);
+    const dict_wal_value_t *value = NULL;
+
+    return 0 == dict_wal_get(wal, key, length, &value) && \
+        sizeof(int) == value->length && 0 == memcmp(value->data, &index,
+        sizeof(int));
+}
+
+static
+int delete_key(dict_wal_t *wal, int index)
+{
+    char key[32] = { 0 };
+    int length = snprintf(key, sizeof(key), "key:%d", index);
+
+    return dict_wal_delete(wal, key, length);
+}
+
+static
+uint64_t file_size(const char *path, uint64_t generation)
+{
+    char *file = dict_wal_path(path, generation, "",
+        dict_std_allocator());
+    struct stat status;
+    int found = stat(file, &status);
+
+    free(file);
+    return 0 == found ? (uint64_t) status.st_size : 0;
+}
+
+static
+void check_round_trip(int policy)
+{
+    char path[64] = { 0 };
+    dict_wal_t *wal = NULL;
+    int index = 0;
+
+    make_path(path, sizeof(path));
+    wal = dict_wal_open(path, policy, 0, NULL);
+    cr_assert(ne(ptr, NULL, wal));
+    for (index = 0; index < KEYS_COUNT; ++index)
+        cr_assert(eq(int, 0, put_key(wal, index)));
+    cr_assert(eq(int, -1, put_key(wal, 0)));
+    cr_assert(eq(int, 0, dict_wal_close(wal)));
+    wal = dict_wal_open(path, policy, 0, NULL);
+    cr_assert(ne(ptr, NULL, wal));
+    cr_assert(eq(u64, KEYS_COUNT, wal->dict->items));
+    for (index = 0; index < KEYS_COUNT; ++index)
+        cr_assert(eq(int, 1, check_key(wal, index)));
+    dict_wal_close(wal);
+}
+
+Test(dict_wal, round_trip_sync_none)
+{
+    check_round_trip(DICT_WAL_SYNC_NONE);
+}
+
+Test(dict_wal, round_trip_sync_batch)
+{
+    check_round_trip(DICT_WAL_SYNC_BATCH);
+}
+
+Test(dict_wal, round_trip_sync_always)
+{
+    check_round_trip(DICT_WAL_SYNC_ALWAYS);
+}
+
+Test(dict_wal, batch_groups_syncs)
+{
+    char path[64] = { 0 };
+    dict_wal_t *wal = NULL;
+    int index = 0;
+
+    make_path(path, sizeof(path));
+    wal = dict_wal_open(path, DICT_WAL_SYNC_BATCH, 10, NULL);
+    for (index = 0; index < 95; ++index)
+        put_key(wal, index);
+    cr_assert(eq(u64, 9, wal->syncs));
+    cr_assert(eq(u64, 5, wal->pending));
+    cr_assert(eq(int, 0, dict_wal_sync(wal)));
+    cr_assert(eq(u64, 10, wal->syncs));
+    cr_assert(eq(u64, 0, wal->pending));
+    dict_wal_close(wal);
+}
+
+Test(dict_wal, delete_is_persisted)
+{
+    char path[64] = { 0 };
+    dict_wal_t *wal = NULL;
+    int index = 0;
+
+    make_path(path, sizeof(path));
+    wal = dict_wal_open(path, DICT_WAL_SYNC_BATCH, 0, NULL);
+    for (index = 0; index < KEYS_COUNT; ++index)
+        put_key(wal, index);
+    for (index = 0; index < KEYS_COUNT; index += 2)
+        cr_assert(eq(int, 0, delete_key(wal, index)));
+    cr_assert(eq(int, -1, delete_key(wal, 0)));
+    put_key(wal, 0);
+    dict_wal_close(wal);
+    wal = dict_wal_open(path, DICT_WAL_SYNC_BATCH, 0, NULL);
+    cr_assert(eq(u64, KEYS_COUNT / 2 + 1, wal->dict->items));
+    cr_assert(eq(int, 1, check_key(wal, 0)));
+    for (index = 1; index < KEYS_COUNT; ++index)
+        cr_assert(eq(int, index % 2, check_key(wal, index)));
+    dict_wal_close(wal);
+}
+
+Test(dict_wal, compaction_keeps_entries)
+{
+    char path[64] = { 0 };
+    dict_wal_t *wal = NULL;
+    int index = 0;
+
+    make_path(path, sizeof(path));
+    wal = dict_wal_open(path, DICT_WAL_SYNC_BATCH, 0, NULL);
+    for (index = 0; index < KEYS_COUNT; ++index)
+        put_key(wal, index);
+    for (index = 0; index < KEYS_COUNT; index += 2)
+        delete_key(wal, index);
+    cr_assert(eq(int, 0, dict_wal_compact(wal)));
+    cr_assert(eq(int, -1, dict_wal_compact(wal)));
+    for (index = KEYS_COUNT; index < KEYS_COUNT + 100; ++index)
+        put_key(wal, index);
+    cr_assert(eq(int, 0, dict_wal_compact_wait(wal)));
+    cr_assert(eq(u64, 0, file_size(path, 1)));
+    cr_assert(ne(u64, 0, file_size(path, 0)));
+    cr_assert(eq(u64, 2, wal->generation));
+    dict_wal_close(wal);
+    wal = dict_wal_open(path, DICT_WAL_SYNC_BATCH, 0, NULL);
+    cr_assert(ne(ptr, NULL, wal));
+    cr_assert(eq(u64, KEYS_COUNT / 2 + 100, wal->dict->items));
+    for (index = 0; index < KEYS_COUNT + 100; ++index)
+        cr_assert(eq(int, index >= KEYS_COUNT || index % 2,
+            check_key(wal, index)));
+    dict_wal_close(wal);
+}
+
+Test(dict_wal, torn_tail_is_cut)
+{
+    char path[64] = { 0 };
+    char *segment = NULL;
+    dict_wal_t *wal = NULL;
+    uint64_t size = 0;
+    int fd = -1;
+
+    make_path(path, sizeof(path));
+    wal = dict_wal_open(path, DICT_WAL_SYNC_ALWAYS, 0, NULL);
+    put_key(wal, 1);
+    put_key(wal, 2);
+    dict_wal_close(wal);
+    size = file_size(path, 1);
+    segment = dict_wal_path(path, 1, "", dict_std_allocator());
+    fd = open(segment, O_WRONLY);
+    cr_assert(eq(int, 0, ftruncate(fd, (off_t) size - 3)));
+    close(fd);
+    wal = dict_wal_open(path, DICT_WAL_SYNC_ALWAYS, 0, NULL);
+    cr_assert(ne(ptr, NULL, wal));
+    cr_assert(eq(int, 1, check_key(wal, 1)));
+    cr_assert(eq(int, 0, check_key(wal, 2)));
+    cr_assert(eq(u64, size - (DICT_WAL_RECORD_HEADER + 5 + sizeof(int)),
+        file_size(path, 1)));
+    cr_assert(eq(int, 0, put_key(wal, 2)));
+    dict_wal_close(wal);
+    wal = dict_wal_open(path, DICT_WAL_SYNC_ALWAYS, 0, NULL);
+    cr_assert(eq(int, 1, check_key(wal, 2)));
+    dict_wal_close(wal);
+    free(segment);
+}
+
+Test(dict_wal, corrupted_record_stops_replay)
+{
+    char path[64] = { 0 };
+    char *segment = NULL;
+    dict_wal_t *wal = NULL;
+    int fd = -1;
+
+    make_path(path, sizeof(path));
+    wal = dict_wal_open(path, DICT_WAL_SYNC_ALWAYS, 0, NULL);
+    put_key(wal, 1);
+    put_key(wal, 2);
+    dict_wal_close(wal);
+    segment = dict_wal_path(path, 1, "", dict_std_allocator());
+    fd = open(segment, O_WRONLY);
+    cr_assert(eq(int, 1, (int) pwrite(fd, "X", 1, (off_t) file_size(path, 1)
+        - 1)));
+    close(fd);
+    wal = dict_wal_open(path, DICT_WAL_SYNC_ALWAYS, 0, NULL);
+    cr_assert(eq(int, 1, check_key(wal, 1)));
+    cr_assert(eq(int, 0, check_key(wal, 2)));
+    dict_wal_close(wal);
+    free(segment);
+}
@@ -59,3 +59,27 @@ Test(murmurhash1, passing_with_same_pointer)
 
     cr_expect(eq(int, hash1, hash2));
 }
+
+Test(murmurhash1_many, matches_scalar)
+{
+    char data[256] = { 0 };
+    const void *keys[200] = { 0 };
+    uint64_t lengths[200] = { 0 };
+    uint32_t hashes[200] = { 0 };
+    uint64_t index = 0;
+
+    for (; index < sizeof(data); ++index)
+        data[index] = (char) (index * 31 + 7);
+    for (index = 0; index < 200; ++index) {
+        keys[index] = data + index % 13;
+        lengths[index] = (index * 7) % 67;
+    }
+    murmurhash1_many(keys, lengths, 200, 0x5EED, hashes);
+    for (index = 0; index < 200; ++index)
+        cr_expect(eq(u32, murmurhash1(keys[index], lengths[index], 0x5EED),
+            hashes[index]));
+    murmurhash1_many(keys, lengths, 3, SEED, hashes);
+    for (index = 0; index < 3; ++index)
+        cr_expect(eq(u32, murmurhash1(keys[index], lengths[index], SEED),
+            hashes[index]));
+}
@@ -0,0 +1,66 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_helpers.c
+** File description:
+** Helpers shared by the unit tests building dicts of numbered keys.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tests_helpers.h"
+
+int released = 0;
+
+void free_key(char *key, __attribute__((unused)) void *value)
+{
+    ++released;
+    free(key);
+}
+
+char *make_key(uint64_t index)
+{
+    char *key = malloc(24);
+
+    if (NULL != key)
+        snprintf(key, 24, "KEY%llu", (unsigned long long) index);
+    return key;
+}
+
+int insert_index(dict_t *dict, uintptr_t index)
+{
+    char *key = make_key(index);
+
+    if (NULL == key)
+        return -1;
+    if (-1 == dict_insert(dict, key, strlen(key), (void *) index)) {
+        free(key);
+        return -1;
+    }
+    return 0;
+}
+
+int has_index(dict_t *dict, uintptr_t index)
+{
+    char key[24] = { 0 };
+    void *value = NULL;
+
+    snprintf(key, sizeof(key), "KEY%llu", (unsigned long long) index);
+    return 0 == dict_get(dict, key, strlen(key), &value) && \
+        index == (uintptr_t) value;
+}
+
+dict_t *make_index_dict(uint64_t count)
+{
+    dict_t *dict = dict_ctor();
+    uint64_t index = 0;
+
+    if (NULL == dict)
+        return NULL;
+    for (; index < count; ++index)
+        if (-1 == insert_index(dict, index)) {
+            dict_dtor(dict, free_key);
+            return NULL;
+        }
+    return dict;
+}
@@ -0,0 +1,64 @@
+/*
+** XIMAZ PROJECTS, 2024
+** tests_helpers.h
+** File description:
+** Helpers shared by the unit tests building dicts of numbered keys.
+*/
+
+#ifndef __TESTS_HELPERS_H_
+#define __TESTS_HELPERS_H_
+
+#include <stdint.h>
+#include "dict.h"
+
+/** The number of keys released by `free_key`, reset by the tests. */
+extern int released;
+
+/**
+ * @brief Releases a key allocated by `make_key`, counting it in `released`.
+ *
+ * @param key The key to release.
+ * @param value The value of the pair, unused.
+ */
+void free_key(char *key, void *value);
+
+/**
+ * @brief Allocates the key `KEY<index>`, to be released by `free_key`.
+ *
+ * @param index The number of the key.
+ * @return The allocated key, `NULL` pointer on error.
+ */
+char *make_key(uint64_t index);
+
+/**
+ * @brief Inserts the key `KEY<index>`, allocated by `make_key`, with `index`
+ * as its value.
+ *
+ * @note The key is released if it could not be inserted.
+ *
+ * @param dict The dict receiving the key.
+ * @param index The number of the key.
+ * @return 0 on success, -1 on error.
+ */
+int insert_index(dict_t *dict, uintptr_t index);
+
+/**
+ * @brief Returns whether the key `KEY<index>` is present with `index` as its
+ * value.
+ *
+ * @param dict The dict in which to look for the key.
+ * @param index The number of the key.
+ * @return 1 if the key is present, 0 otherwise.
+ */
+int has_index(dict_t *dict, uintptr_t index);
+
+/**
+ * @brief Builds a dict holding the keys `KEY0` to `KEY<count - 1>`, inserted
+ * by `insert_index`.
+ *
+ * @param count The number of keys.
+ * @return The dict on success, `NULL` pointer on error.
+ */
+dict_t *make_index_dict(uint64_t count);
+
+#endif /* !__TESTS_HELPERS_H_ */
@@ -0,0 +1,360 @@
+/*
+** XIMAZ PROJECTS, 2024
+** dict_replay.c
+** File description:
+** Replays a trace recorded by dict_trace_start against an engine, and
+** reports its throughput, latency percentiles and memory.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+#include "dict.h"
+
+/**
+ * @brief The room kept before each allocation to remember its size.
+ */
+#define REPLAY_HEADER 16
+
+/**
+ * @brief The bytes allocated by an engine.
+ */
+typedef struct s_replay_memory {
+    /** The bytes currently allocated. */
+    uint64_t current;
+
+    /** The largest number of bytes allocated at once. */
+    uint64_t peak;
+} replay_memory_t;
+
+/**
+ * @brief An engine replaying the operations, behind a common interface.
+ */
+typedef struct s_replay_engine {
+    /** The name given on the command line. */
+    const char *name;
+
+    /** Builds the engine, allocating through `allocator`. */
+    void *(*ctor)(const dict_allocator_t *allocator);
+
+    /** Releases the engine. */
+    void (*dtor)(void *engine);
+
+    /** Replays an operation, returns what the engine call returned. */
+    int (*run)(void *engine, const dict_trace_op_t *op);
+} replay_engine_t;
+
+/**
+ * @brief Returns a monotonic timestamp in nanoseconds.
+ */
+static
+uint64_t replay_now(void)
+{
+    struct timespec now = { 0, 0 };
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+/**
+ * @brief Allocates through `malloc`, counting the allocated bytes.
+ */
+static
+void *replay_allocate(void *ctx, size_t size)
+{
+    replay_memory_t *memory = (replay_memory_t *) ctx;
+    char *ptr = (char *) malloc(REPLAY_HEADER + size);
+
+    if (NULL == ptr)
+        return NULL;
+    memcpy(ptr, &size, sizeof(size));
+    memory->current += size;
+    if (memory->current > memory->peak)
+        memory->peak = memory->current;
+    return ptr + REPLAY_HEADER;
+}
+
+/**
+ * @brief Resizes through `realloc`, counting the allocated bytes.
+ */
+static
+void *replay_reallocate(void *ctx, void *ptr, size_t old_size,
+    size_t new_size)
+{
+    replay_memory_t *memory = (replay_memory_t *) ctx;
+    char *resized = NULL;
+
+    if (NULL == ptr)
+        return replay_allocate(ctx, new_size);
+    resized = (char *) realloc((char *) ptr - REPLAY_HEADER,
+        REPLAY_HEADER + new_size);
+    if (NULL == resized)
+        return NULL;
+    memcpy(resized, &new_size, sizeof(new_size));
+    memory->current += new_size - old_size;
+    if (memory->current > memory->peak)
+        memory->peak = memory->current;
+    return resized + REPLAY_HEADER;
+}
+
+/**
+ * @brief Releases through `free`, counting the allocated bytes.
+ */
+static
+void replay_release(void *ctx, void *ptr)
+{
+    replay_memory_t *memory = (replay_memory_t *) ctx;
+    size_t size = 0;
+
+    memcpy(&size, (char *) ptr - REPLAY_HEADER, sizeof(size));
+    memory->current -= size;
+    free((char *) ptr - REPLAY_HEADER);
+}
+
+static
+void *replay_dict_ctor(const dict_allocator_t *allocator)
+{
+    return dict_ctor_with_allocator(allocator);
+}
+
+static
+void *replay_filter_ctor(const dict_allocator_t *allocator)
+{
+    dict_t *dict = dict_ctor_with_allocator(allocator);
+
+    if (NULL != dict && -1 == dict_enable_filter(dict)) {
+        dict_dtor(dict, NULL);
+        return NULL;
+    }
+    return dict;
+}
+
+/**
+ * @brief Builds a dict storing 8 bytes values inline, like
+ * `dict_ctor_with_value_size` does, with the counting allocator.
+ */
+static
+void *replay_inline_ctor(const dict_allocator_t *allocator)
+{
+    dict_t *dict = dict_ctor_with_allocator(allocator);
+
+    if (NULL != dict)
+        dict->value_size = sizeof(uint64_t);
+    return dict;
+}
+
+static
+void replay_dict_dtor(void *engine)
+{
+    dict_dtor((dict_t *) engine, NULL);
+}
+
+static
+int replay_dict_run(void *engine, const dict_trace_op_t *op)
+{
+    dict_t *dict = (dict_t *) engine;
+
+    if (DICT_TRACE_INSERT == op->op)
+        return dict_insert(dict, (char *) op->key, op->key_length,
+            (void *) &(op->time));
+    if (DICT_TRACE_DELETE == op->op)
+        return dict_delete(dict, (char *) op->key, op->key_length, NULL);
+    return dict_get(dict, op->key, op->key_length, NULL);
+}
+
+static
+void *replay_dict32_ctor(const dict_allocator_t *allocator)
+{
+    return dict32_ctor(allocator);
+}
+
+static
+void replay_dict32_dtor(void *engine)
+{
+    dict32_dtor((dict32_t *) engine, NULL);
+}
+
+static
+int replay_dict32_run(void *engine, const dict_trace_op_t *op)
+{
+    dict32_t *dict = (dict32_t *) engine;
+
+    if (DICT_TRACE_INSERT == op->op)
+        return dict32_insert(dict, (char *) op->key, op->key_length,
+            (void *) &(op->time));
+    if (DICT_TRACE_DELETE == op->op)
+        return dict32_delete(dict, (char *) op->key, op->key_length, NULL);
+    return dict32_get(dict, op->key, op->key_length, NULL);
+}
+
+/**
+ * @brief The engines a trace can be replayed against.
+ */
+static const replay_engine_t replay_engines[] = {
+    { "dict", replay_dict_ctor, replay_dict_dtor, replay_dict_run },
+    { "filter", replay_filter_ctor, replay_dict_dtor, replay_dict_run },
+    { "inline", replay_inline_ctor, replay_dict_dtor, replay_dict_run },
+    { "dict32", replay_dict32_ctor, replay_dict32_dtor, replay_dict32_run },
+    { NULL, NULL, NULL, NULL },
+};
+
+static
+int replay_compare(const void *lhs, const void *rhs)
+{
+    uint64_t left = *(const uint64_t *) lhs;
+    uint64_t right = *(const uint64_t *) rhs;
+
+    return (left > right) - (left < right);
+}
+
+/**
+ * @brief Replays the trace without timing each operation, for the
+ * throughput and the memory.
+ *
+ * @return 0 on success, 1 on error.
+ */
+static
+int replay_throughput(const replay_engine_t *engine,
+    const dict_trace_ops_t *ops)
+{
+    replay_memory_t memory = { 0, 0 };
+    dict_allocator_t allocator = { replay_allocate, replay_reallocate,
+        replay_release, &memory, NULL, NULL };
+    void *instance = engine->ctor(&allocator);
+    uint64_t mismatches = 0;
+    uint64_t index = 0;
+    uint64_t start = 0;
+    uint64_t elapsed = 0;
+
+    if (NULL == instance)
+        return 1;
+    start = replay_now();
+    for (; index < ops->count; ++index)
+        mismatches += (-1 == engine->run(instance, &(ops->ops[index]))) != \
+            ops->ops[index].failed;
+    elapsed = replay_now() - start;
+    printf("throughput      %12.0f ops/s (%.2f ns/op)\n",
+        elapsed ? 1e9 * ops->count / elapsed : 0.0,
+        ops->count ? (double) elapsed / ops->count : 0.0);
+    printf("memory          %12llu bytes, %llu bytes at peak\n",
+        (unsigned long long) memory.current,
+        (unsigned long long) memory.peak);
+    printf("mismatches      %12llu results differing from the trace\n",
+        (unsigned long long) mismatches);
+    engine->dtor(instance);
+    return 0;
+}
+
+/**
+ * @brief Replays the trace again on a fresh engine, timing each operation.
+ *
+ * @return 0 on success, 1 on error.
+ */
+static
+int replay_latency(const replay_engine_t *engine, const dict_trace_ops_t *ops)
+{
+    replay_memory_t memory = { 0, 0 };
+    dict_allocator_t allocator = { replay_allocate, replay_reallocate,
+        replay_release, &memory, NULL, NULL };
+    uint64_t *latencies = (uint64_t *) malloc((ops->count + 1) * \
+        sizeof(uint64_t));
+    void *instance = engine->ctor(&allocator);
+    const double ranks[] = { 0.5, 0.9, 0.99, 0.999, 1.0 };
+    uint64_t index = 0;
+    uint64_t start = 0;
+
+    if (NULL == latencies || NULL == instance) {
+        free(latencies);
+        if (NULL != instance)
+            engine->dtor(instance);
+        return 1;
+    }
+    for (; index < ops->count; ++index) {
+        start = replay_now();
+        engine->run(instance, &(ops->ops[index]));
+        latencies[index] = replay_now() - start;
+    }
+    engine->dtor(instance);
+    qsort(latencies, ops->count, sizeof(uint64_t), replay_compare);
+    for (index = 0; 0 < ops->count && index < 5; ++index)
+        printf("latency p%-6g %12llu ns\n", 100 * ranks[index],
+            (unsigned long long) latencies[(uint64_t) (ranks[index] * \
+            (ops->count - 1))]);
+    free(latencies);
+    return 0;
+}
+
+/**
+ * @brief Prints the content of the trace.
+ */
+static
+void replay_summary(const dict_trace_ops_t *ops)
+{
+    uint64_t counts[DICT_TRACE_GET + 1] = { 0 };
+    uint64_t failed[DICT_TRACE_GET + 1] = { 0 };
+    uint64_t index = 0;
+
+    for (; index < ops->count; ++index) {
+        ++counts[ops->ops[index].op];
+        failed[ops->ops[index].op] += ops->ops[index].failed;
+    }
+    printf("trace           %12llu ops over %.3f s, %s\n",
+        (unsigned long long) ops->count,
+        ops->count ? ops->ops[ops->count - 1].time / 1e9 : 0.0,
+        DICT_TRACE_KEYS == ops->mode ? "keys" : "hashes");
+    printf("inserts         %12llu (%llu failed)\n",
+        (unsigned long long) counts[DICT_TRACE_INSERT],
+        (unsigned long long) failed[DICT_TRACE_INSERT]);
+    printf("deletes         %12llu (%llu failed)\n",
+        (unsigned long long) counts[DICT_TRACE_DELETE],
+        (unsigned long long) failed[DICT_TRACE_DELETE]);
+    printf("lookups         %12llu (%llu missed)\n",
+        (unsigned long long) counts[DICT_TRACE_GET],
+        (unsigned long long) failed[DICT_TRACE_GET]);
+}
+
+/**
+ * @brief Finds the engine given on the command line.
+ *
+ * @return The engine, `NULL` pointer if there is no such engine.
+ */
+static
+const replay_engine_t *replay_engine(const char *name)
+{
+    const replay_engine_t *engine = replay_engines;
+
+    for (; NULL != engine->name; ++engine)
+        if (0 == strcmp(engine->name, name))
+            return engine;
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    const replay_engine_t *engine = replay_engines;
+    dict_trace_ops_t *ops = NULL;
+    struct rusage usage;
+    int status = 0;
+
+    if (4 == argc && 0 == strcmp("-e", argv[1]))
+        engine = replay_engine(argv[2]);
+    if ((2 != argc && 4 != argc) || NULL == engine) {
+        fprintf(stderr, "usage: %s [-e dict|filter|inline|dict32] trace\n",
+            argv[0]);
+        return 1;
+    }
+    ops = dict_trace_load(argv[argc - 1]);
+    if (NULL == ops) {
+        fprintf(stderr, "%s: cannot load the trace\n", argv[argc - 1]);
+        return 1;
+    }
+    printf("engine          %12s\n", engine->name);
+    replay_summary(ops);
+    status = replay_throughput(engine, ops) || replay_latency(engine, ops);
+    getrusage(RUSAGE_SELF, &usage);
+    printf("max rss         %12ld KiB\n", usage.ru_maxrss);
+    dict_trace_ops_free(ops);
+    return status;
+}